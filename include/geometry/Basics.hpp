@@ -15,6 +15,11 @@
 #include <vector>
 #include <cmath>		// Ceil
 #include <type_traits>	// Template type
+#include <functional>	// Parallel function
+#include <memory>		// Copy on write
+#include <thread>		// Thread pool
+#include <mutex>
+#include <condition_variable>
 
 namespace Geometry {
 
@@ -111,6 +116,177 @@ std::string MatrixPrint(const Eigen::MatrixXd& matrix);
 /// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance), <c>False</c> otherwise. </returns>
 bool AreEquals(const Eigen::MatrixXd& matrix1, const Eigen::MatrixXd& matrix2, double precision = 1e-6);
 
+/// <summary>	Eigen decomposition of a symmetric matrix (only the lower triangular part is used) with ascending eigen values.\n
+/// The tridiagonalization and QR iterations of <c>Eigen::SelfAdjointEigenSolver</c> are made in the output and buffer memory,
+/// so there is no allocation if the outputs and the buffer have already the good size.
+/// </summary>
+/// <param name="matrix">			The symmetric matrix. </param>
+/// <param name="values">			The eigen values (size N). </param>
+/// <param name="vectors">			The eigen vectors by column (size NxN). </param>
+/// <param name="buffer">			The buffer (size 3N). </param>
+/// <param name="computeVectors">	Compute the eigen vectors (the <c>vectors</c> matrix is used as buffer otherwise). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool SelfAdjointEigen(const Eigen::MatrixXd& matrix, Eigen::VectorXd& values, Eigen::MatrixXd& vectors, Eigen::VectorXd& buffer, bool computeVectors = true);
+
+/// <summary>	Eigen values of several symmetric matrices of the same size (only the lower triangular parts are used) with ascending eigen values.\n
+/// The QL iterations of the matrices are interleaved (the eigen values of one small matrix are limited by the latency of the divisions, not by the number of operations),
+/// there is no allocation if the outputs and the buffer have already the good size.
+/// </summary>
+/// <param name="matrices">	The matrices packed by columns (size \f$ N \times (K N) \f$), destroyed. </param>
+/// <param name="values">	The eigen values of each matrix by column (size \f$ N \times K \f$). </param>
+/// <param name="buffer">	The buffer (size \f$ N \times 2K \f$). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	The tridiagonal eigen values are computed with root free QL iterations (as <c>dsterf</c> of LAPACK), not with the QR iterations of <c>Eigen::SelfAdjointEigenSolver</c>
+/// used by <see cref="SelfAdjointEigen" />, the results are the same up to the rounding errors. </remarks>
+bool SelfAdjointEigenValues(Eigen::MatrixXd& matrices, Eigen::MatrixXd& values, Eigen::MatrixXd& buffer);
+
+/// <summary>	Buffers of the computations on symmetric matrices without allocation (see <see cref="SelfAdjointEigen" /> and <see cref="SelfAdjointFunction" />). </summary>
+struct SSymmetricBuffers
+{
+	Eigen::MatrixXd matrix;		///< Intermediate matrix (NxN).
+	Eigen::MatrixXd product;	///< Intermediate product (NxN).
+	Eigen::MatrixXd vectors;	///< Eigen vectors (NxN).
+	Eigen::VectorXd values;		///< Eigen values (N).
+	Eigen::VectorXd eigen;		///< Buffer of the eigen decomposition (3N).
+
+	/// <summary>	Resize the buffers for NxN matrices. </summary>
+	/// <param name="n">	The size of the matrices. </param>
+	void resize(const Eigen::Index n)
+	{
+		matrix.resize(n, n);
+		product.resize(n, n);
+		vectors.resize(n, n);
+		values.resize(n);
+		eigen.resize(3 * n);
+	}
+};
+
+/// <summary>	Apply a function on the eigen values of a symmetric matrix \f$ f(M) = V f\left(\Lambda\right) V^{\mathsf{T}} \f$ (logarithm, exponential, power...) without allocation if the buffers have already the good size. </summary>
+/// <param name="matrix">		The symmetric matrix (it can be <c>buffers.matrix</c>). </param>
+/// <param name="out">			The result (it can be the input matrix, but not <c>buffers.product</c> or <c>buffers.vectors</c>). </param>
+/// <param name="function">		The function applied on each eigen value. </param>
+/// <param name="buffers">		The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+template <typename TFunction>
+bool SelfAdjointFunction(const Eigen::MatrixXd& matrix, Eigen::MatrixXd& out, TFunction function, SSymmetricBuffers& buffers)
+{
+	if (!SelfAdjointEigen(matrix, buffers.values, buffers.vectors, buffers.eigen)) { return false; }
+	for (Eigen::Index i = 0; i < buffers.values.size(); ++i) { buffers.values[i] = function(buffers.values[i]); }
+	buffers.product.noalias() = buffers.vectors * buffers.values.asDiagonal();
+	out.noalias()             = buffers.product * buffers.vectors.transpose();
+	return true;
+}
+
+//**************************************************
+//******************** Parallel ********************
+//**************************************************
+/// <summary>	Number of threads used by <see cref="ParallelFor" /> for a range. </summary>
+/// <param name="n">			The size of the range. </param>
+/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	The number of threads (between 1 and n). </returns>
+size_t ParallelThreadCount(size_t n, size_t nbThreads = 0);
+
+/// <summary>	Split the range [0;n[ in contiguous blocks and apply the function on each block in its own thread (the first block is made in the calling thread). </summary>
+/// <param name="n">			The size of the range. </param>
+/// <param name="function">		The function to apply with the first index, the last index (excluded) and the index of the thread. </param>
+/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+/// <remarks>	The function must be thread safe, the number of threads is given by <see cref="ParallelThreadCount" /> (used to prepare one buffer by thread). </remarks>
+void ParallelFor(size_t n, const std::function<void(size_t, size_t, size_t)>& function, size_t nbThreads = 0);
+
+/// <summary>	Persistent threads for the repeated parallel loops (same split as <see cref="ParallelFor" /> without creation of threads for each loop).
+
+/// The threads are created by the first loops which need them and wait for the next loop until the destruction of the pool.
+/// </summary>
+/// <remarks>	One loop at a time : the pool must not be used by several threads concurrently. The copies of a pool have their own threads (created on demand). </remarks>
+class CThreadPool
+{
+public:
+	CThreadPool() = default;										///< Initializes a new instance of the <see cref="CThreadPool"/> class without thread.
+	CThreadPool(const CThreadPool& /*obj*/) { }						///< Initializes a new instance of the <see cref="CThreadPool"/> class without thread (the threads aren't copied).
+	CThreadPool& operator=(const CThreadPool& /*obj*/) { return *this; }	///< Keep the threads of the pool (the threads aren't copied).
+	~CThreadPool();													///< Finalizes an instance of the <see cref="CThreadPool"/> class (stop and join the threads).
+
+	/// <summary>	Split the range [0;n[ in contiguous blocks and apply the function on each block with the threads of the pool (the first block is made in the calling thread). </summary>
+	/// <param name="n">			The size of the range. </param>
+	/// <param name="function">		The function to apply with the first index, the last index (excluded) and the index of the thread. </param>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <remarks>	The function must be thread safe, the number of threads is given by <see cref="ParallelThreadCount" /> (used to prepare one buffer by thread). </remarks>
+	void run(size_t n, const std::function<void(size_t, size_t, size_t)>& function, size_t nbThreads = 0);
+
+	size_t size() const { return m_threads.size(); }				///< Get the number of threads of the pool (without the calling thread).
+
+protected:
+	/// <summary>	Loop of a thread of the pool : wait a new loop and apply the function on its block. </summary>
+	/// <param name="job">			The index of the block of the thread (from 1, the block 0 is for the calling thread). </param>
+	/// <param name="generation">	The last loop seen by the thread. </param>
+	void work(size_t job, size_t generation);
+
+	std::vector<std::thread> m_threads;								///< Threads of the pool
+	std::mutex m_mutex;												///< Mutex of the state of the loop
+	std::condition_variable m_start;								///< Notification of a new loop (or the stop)
+	std::condition_variable m_done;									///< Notification of the end of the blocks of the threads
+	const std::function<void(size_t, size_t, size_t)>* m_function = nullptr;	///< Function of the current loop
+	size_t m_n          = 0;										///< Size of the range of the current loop
+	size_t m_nbBlock    = 0;										///< Number of blocks of the current loop
+	size_t m_generation = 0;										///< Index of the current loop
+	size_t m_pending    = 0;										///< Number of blocks not finished by the threads
+	bool m_stop         = false;									///< Define if the threads must stop
+};
+
+//**********************************************
+//******************** Data ********************
+//**********************************************
+/// <summary>	Value shared with copy on write : the copy of the value is only a shared pointer until one side modifies it. </summary>
+/// <typeparam name="T">	The type of the value (large immutable members of the classifiers : reference, weights, datasets...). </typeparam>
+/// <remarks>
+/// The readers use <see cref="get" />, the modifications use <see cref="write" /> (copy of the value if it's shared)
+/// or <see cref="replace" /> (new value if it's shared, for a value fully overwritten).\n
+/// As <c>std::shared_ptr</c>, the copies of one value can be read and modified in several threads, but one instance must not be modified while it's read.
+/// </remarks>
+template <typename T>
+class CCopyOnWrite
+{
+public:
+	CCopyOnWrite() = default;														///< Initializes a new instance without value (empty value).
+	CCopyOnWrite(const T& value) : m_value(std::make_shared<T>(value)) {}			///< Initializes a new instance with a copy of the value.
+	CCopyOnWrite(T&& value) : m_value(std::make_shared<T>(std::move(value))) {}	///< Initializes a new instance with the value.
+
+	/// <summary>	Get the value. </summary>
+	/// <returns>	The value (an empty value if nothing is set). </returns>
+	const T& get() const
+	{
+		static const T EMPTY = T();
+		return m_value ? *m_value : EMPTY;
+	}
+
+	/// <summary>	Get the value to modify it, the value is copied if it's shared with another instance. </summary>
+	/// <returns>	The value only owned by this instance. </returns>
+	T& write()
+	{
+		if (!m_value) { m_value = std::make_shared<T>(); }
+		else if (m_value.use_count() > 1) { m_value = std::make_shared<T>(*m_value); }
+		return *m_value;
+	}
+
+	/// <summary>	Get the value to overwrite it, a new empty value is created if it's shared with another instance (no copy). </summary>
+	/// <returns>	The value only owned by this instance. </returns>
+	T& replace()
+	{
+		if (!m_value || m_value.use_count() > 1) { m_value = std::make_shared<T>(); }
+		return *m_value;
+	}
+
+	void set(const T& value) { replace() = value; }									///< Set the value.
+	void set(T&& value) { m_value = std::make_shared<T>(std::move(value)); }		///< Set the value.
+	bool isShared() const { return m_value.use_count() > 1; }						///< Check if the value is shared with another instance.
+
+	const T& operator*() const { return get(); }									///< Get the value.
+	const T* operator->() const { return &get(); }									///< Access to the value.
+
+protected:
+	std::shared_ptr<T> m_value;	///< The shared value.
+};
+
 //*************************************************************
 //******************** Index Manipulations ********************
 //*************************************************************
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <Eigen/Dense>
+#include "geometry/classifier/CClassStatistics.hpp"
 
 namespace Geometry {
 
@@ -26,6 +27,13 @@ namespace Geometry {
 /// <remarks>	Inspired by <a href="http://scikit-learn.org">sklearn</a> <a href="https://scikit-learn.org/stable/modules/generated/sklearn.discriminant_analysis.LinearDiscriminantAnalysis.html">LinearDiscriminantAnalysis</a> (<a href="https://github.com/scikit-learn/scikit-learn/blob/master/COPYING">License</a>). </remarks>
 bool LSQR(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& weight);
 
+/// <summary>	 Compute the weight of Linear Discriminant Analysis with Least squares (LSQR) Solver from the sufficient statistics of each class. </summary>
+/// <param name="statistics">	The statistics of each class (see <see cref="CClassStatistics" />). </param>
+/// <param name="weight">		The wight to apply. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	Same result as <see cref="LSQR(const std::vector<std::vector<Eigen::RowVectorXd>>&, Eigen::MatrixXd&)" /> with the vectors used to build the statistics. </remarks>
+bool LSQR(const std::vector<CClassStatistics>& statistics, Eigen::MatrixXd& weight);
+
 /// <summary>	 Compute Least squares (LSQR) Weight and transform to FgDA Weight. \n
 ///	\f[ W_{\text{FgDA}} = W^{\mathsf{T}} \times (W \times W^{\mathsf{T}})^{-1} \times W \f]
 /// </summary>
@@ -35,6 +43,33 @@ bool LSQR(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::M
 /// <remarks>	Method inspired by the work of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>). </remarks>
 bool FgDACompute(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& weight);
 
+/// <summary>	 Compute Least squares (LSQR) Weight and transform to FgDA Weight as a low-rank factor pair. \n
+///	\f[ W_{\text{FgDA}} = U \times V^{\mathsf{T}} \quad \text{with} \quad U = W^{\mathsf{T}} \times (W \times W^{\mathsf{T}})^{-1} \quad \text{and} \quad V = W^{\mathsf{T}} \f]
+/// </summary>
+/// <param name="datasets">	The data set one class by row and trials on colums. </param>
+/// <param name="u">		The left factor (\f$ F \times K \f$ with \f$ F \f$ the number of features and \f$ K \f$ the rank of the LSQR Weight). </param>
+/// <param name="v">		The right factor (\f$ F \times K \f$). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	The dense \f$ F \times F \f$ weight is never formed, the rank is at most the number of classes. </remarks>
+bool FgDACompute(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& u, Eigen::MatrixXd& v);
+
+/// <summary>	 Compute the FgDA Weight as a low-rank factor pair from the sufficient statistics of each class. </summary>
+/// <param name="statistics">	The statistics of each class (see <see cref="CClassStatistics" />). </param>
+/// <param name="u">			The left factor. </param>
+/// <param name="v">			The right factor. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	The cost doesn't depend on the number of vectors used to build the statistics. </remarks>
+bool FgDACompute(const std::vector<CClassStatistics>& statistics, Eigen::MatrixXd& u, Eigen::MatrixXd& v);
+
+/// <summary>	 Factorize a dense FgDA Weight as a low-rank factor pair \f$ W_{\text{FgDA}} = U \times V^{\mathsf{T}} \f$ (with a SVD). </summary>
+/// <param name="weight">		The dense Weight. </param>
+/// <param name="u">			The left factor. </param>
+/// <param name="v">			The right factor. </param>
+/// <param name="tolerance">	Singular values below <c>tolerance</c> times the greatest singular value are discarded. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	Used to load a FgDA weight saved in dense format. </remarks>
+bool FgDAFactorize(const Eigen::MatrixXd& weight, Eigen::MatrixXd& u, Eigen::MatrixXd& v, double tolerance = 1e-6);
+
 /// <summary>	 Apply the weight on the vector. (just a matrix product) </summary>
 /// <param name="in">		Sample to transform. </param>
 /// <param name="out">		Transformed Sample. </param>
@@ -43,4 +78,21 @@ bool FgDACompute(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, E
 /// <remarks>	Method inspired by the work of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>). </remarks>
 bool FgDAApply(const Eigen::RowVectorXd& in, Eigen::RowVectorXd& out, const Eigen::MatrixXd& weight);
 
+/// <summary>	 Apply the low-rank weight on the vector. \f[ \text{out} = (\text{in} \times U) \times V^{\mathsf{T}} \f] </summary>
+/// <param name="in">	Sample to transform. </param>
+/// <param name="out">	Transformed Sample. </param>
+/// <param name="u">	The left factor of the Weight. </param>
+/// <param name="v">	The right factor of the Weight. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	\f$ \mathcal{O}(F \times K) \f$ instead of \f$ \mathcal{O}(F^2) \f$ for the dense weight. </remarks>
+bool FgDAApply(const Eigen::RowVectorXd& in, Eigen::RowVectorXd& out, const Eigen::MatrixXd& u, const Eigen::MatrixXd& v);
+
+/// <summary>	Find the closest class and compute the probabilities from the distances (personnal method of the MDM classifiers). \n
+///	\f[ \mathcal{P}_i = \frac{d_\text{min} / d_i}{\sum_k d_\text{min} / d_k} \f]
+/// </summary>
+/// <param name="distance">		The distance of the sample with each class. </param>
+/// <param name="classId">		The closest class. </param>
+/// <param name="probability">	The probability of the sample with each class. </param>
+void DistancesToProbabilities(const std::vector<double>& distance, size_t& classId, std::vector<double>& probability);
+
 }  // namespace Geometry
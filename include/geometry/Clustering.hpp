@@ -0,0 +1,54 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file Clustering.hpp
+/// \brief All functions to cluster Vector of Covariance Matrix (Riemannian k-means).
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "geometry/Metrics.hpp"
+#include <Eigen/Dense>
+#include <vector>
+
+namespace Geometry {
+
+/// <summary>	Cluster a vector of covariance matrix with the k-means algorithm on the manifold of the selected \p metric.\n
+/// -# Seed the centroids with k-means++ : the first centroid is drawn uniformly, the next ones are drawn with a probability proportional to the squared distance to the nearest centroid.
+/// -# Lloyd iterations until the labels don't change or after \p maxIter iterations :
+///		- Assign each matrix to the nearest centroid (in parallel, the factors of the matrices and of the centroids are computed once per iteration, see <see cref="DistanceFactorized" />).
+///		- Update each centroid with the mean of its cluster (in parallel, the iterative means start from the previous centroid, see <see cref="MeanWarmStart" />).
+///		  An empty cluster takes the matrix the farthest from its centroid.
+/// </summary>
+/// <param name="matrices">   	Vector of Covariance Matrix. </param>
+/// <param name="nbClusters"> 	The number of clusters (between 1 and the number of matrices). </param>
+/// <param name="centroids">  	The centroid of each cluster. </param>
+/// <param name="labels">     	The cluster of each matrix. </param>
+/// <param name="metric">     	(Optional) The metric (see <see cref="EMetric"/>). </param>
+/// <param name="maxIter">    	(Optional) The maximum number of Lloyd iterations. </param>
+/// <param name="seed">       	(Optional) The seed of the k-means++ initialization (the same seed gives the same clusters). </param>
+/// <param name="nbThreads">  	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool KMeans(const std::vector<Eigen::MatrixXd>& matrices, size_t nbClusters, std::vector<Eigen::MatrixXd>& centroids, std::vector<size_t>& labels,
+			EMetric metric = EMetric::Riemann, size_t maxIter = 100, unsigned int seed = 0, size_t nbThreads = 0);
+
+/// <summary>	Compute several prototypes (means) per class with the k-means algorithm on each class (see <see cref="KMeans" />). </summary>
+/// <param name="datasets">    	Vector of Covariance Matrix of each class. </param>
+/// <param name="nbPrototypes">	The number of prototypes per class (limited to the number of matrices of the class). </param>
+/// <param name="means">       	The prototypes of all classes (ordered by class). </param>
+/// <param name="classes">     	The class of each prototype. </param>
+/// <param name="metric">      	(Optional) The metric (see <see cref="EMetric"/>). </param>
+/// <param name="maxIter">     	(Optional) The maximum number of Lloyd iterations. </param>
+/// <param name="seed">        	(Optional) The seed of the k-means++ initialization. </param>
+/// <param name="nbThreads">   	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	The prototypes can be set directly as the means of a MDM classifier with one "class" per prototype
+/// (<c>CMatrixClassifierMDM(means.size(), metric).setMeans(means)</c>), the predicted prototype is converted to the real class with \p classes. </remarks>
+bool KMeansPrototypes(const std::vector<std::vector<Eigen::MatrixXd>>& datasets, size_t nbPrototypes, std::vector<Eigen::MatrixXd>& means, std::vector<size_t>& classes,
+					  EMetric metric = EMetric::Riemann, size_t maxIter = 100, unsigned int seed = 0, size_t nbThreads = 0);
+
+}  // namespace Geometry
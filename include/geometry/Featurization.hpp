@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "geometry/Basics.hpp"
 #include <Eigen/Dense>
+#include <vector>
 
 namespace Geometry {
 
@@ -106,4 +108,76 @@ bool TangentSpace(const Eigen::MatrixXd& in, Eigen::RowVectorXd& out, const Eige
 /// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 bool UnTangentSpace(const Eigen::RowVectorXd& in, Eigen::MatrixXd& out, const Eigen::MatrixXd& ref = Eigen::MatrixXd());
 
+/// <summary>	Project a covariance matrices in the tangent space (see <see cref="TangentSpace"/>) with the precomputed inverse square root of the reference \f$ M_\text{Ref}^{-1/2} \f$,
+/// without allocation if the output and the buffers have already the good size.
+/// </summary>
+/// <param name="in">		The \f$N \times N\f$ covariance matrix. </param>
+/// <param name="out">		The  \f$\frac{N\left(N+1\right)}{2}\f$ row. </param>
+/// <param name="refIS">	The \f$N \times N\f$ inverse square root of the reference. </param>
+/// <param name="buffers">	The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool TangentSpaceFactorized(const Eigen::MatrixXd& in, Eigen::RowVectorXd& out, const Eigen::MatrixXd& refIS, SSymmetricBuffers& buffers);
+
+/// <summary>	Project a Tangent space vectors in the manifold (see <see cref="UnTangentSpace"/>) with the precomputed square root of the reference \f$ M_\text{Ref}^{1/2} \f$,
+/// without allocation if the output and the buffers have already the good size.
+/// </summary>
+/// <param name="in">		The  \f$\frac{N\left(N+1\right)}{2}\f$ row. </param>
+/// <param name="out">		The \f$N \times N\f$ covariance matrix. </param>
+/// <param name="refS">		The \f$N \times N\f$ square root of the reference. </param>
+/// <param name="buffers">	The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool UnTangentSpaceFactorized(const Eigen::RowVectorXd& in, Eigen::MatrixXd& out, const Eigen::MatrixXd& refS, SSymmetricBuffers& buffers);
+
+/// <summary>	Project a vector of covariance matrices in the tangent space (see <see cref="TangentSpace"/>) at the same reference.
+
+/// The inverse square root of the reference is computed once and the matrices are projected in parallel (see <see cref="TangentSpaceFactorized"/>).
+/// </summary>
+/// <param name="in">			The \f$N \times N\f$ covariance matrices. </param>
+/// <param name="out">			The tangent vectors, one \f$\frac{N\left(N+1\right)}{2}\f$ row by matrix. </param>
+/// <param name="ref">			(Optional) The \f$N \times N\f$ reference (use the identity Matrix if empty). </param>
+/// <param name="nbThreads">	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool TangentSpace(const std::vector<Eigen::MatrixXd>& in, Eigen::MatrixXd& out, const Eigen::MatrixXd& ref = Eigen::MatrixXd(), size_t nbThreads = 0);
+
+/// <summary>	Compute the Gram matrix of the rows of a matrix \f$ G = V V^{\mathsf{T}} \f$.\n
+/// Only the lower triangle is computed by square blocks of rows (one matrix product by block) and the blocks are computed in parallel (see <see cref="ParallelFor" />).
+/// </summary>
+/// <param name="vectors">		The vectors (one by row). </param>
+/// <param name="gram">			The symmetric Gram matrix. </param>
+/// <param name="nbThreads">	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool GramMatrix(const Eigen::MatrixXd& vectors, Eigen::MatrixXd& gram, size_t nbThreads = 0);
+
+/// <summary>	Compute the cross Gram matrix of the rows of two matrices \f$ G = A B^{\mathsf{T}} \f$ by blocks of rows computed in parallel. </summary>
+/// <param name="a">			The first vectors (one by row). </param>
+/// <param name="b">			The second vectors (one by row). </param>
+/// <param name="gram">			The Gram matrix (one row by vector of \p a and one column by vector of \p b). </param>
+/// <param name="nbThreads">	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool GramMatrix(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& gram, size_t nbThreads = 0);
+
+/// <summary>	Compute the Riemannian kernel of a vector of covariance matrices : the inner products of the log maps at the reference.\n
+/// \f[ K_{ij} = \operatorname{tr}\left(\log\left(M_\text{Ref}^{-1/2} M_i M_\text{Ref}^{-1/2}\right) \log\left(M_\text{Ref}^{-1/2} M_j M_\text{Ref}^{-1/2}\right)\right) = \zeta_{M_i} \cdot \zeta_{M_j} \f]
+/// The matrices are projected once in the tangent space (see <see cref="TangentSpace(const std::vector<Eigen::MatrixXd>&, Eigen::MatrixXd&, const Eigen::MatrixXd&, size_t)"/>)
+/// and the kernel is the Gram matrix of the tangent vectors (see <see cref="GramMatrix(const Eigen::MatrixXd&, Eigen::MatrixXd&, size_t)"/>).
+/// </summary>
+/// <param name="matrices">		The \f$N \times N\f$ covariance matrices. </param>
+/// <param name="kernel">		The symmetric kernel matrix. </param>
+/// <param name="ref">			(Optional) The \f$N \times N\f$ reference (use the identity Matrix if empty). </param>
+/// <param name="nbThreads">	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool TangentKernel(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& kernel, const Eigen::MatrixXd& ref = Eigen::MatrixXd(), size_t nbThreads = 0);
+
+/// <summary>	Compute the Riemannian cross kernel between two vectors of covariance matrices at the same reference (for example the trials to classify against the support set).
+/// (see <see cref="TangentKernel(const std::vector<Eigen::MatrixXd>&, Eigen::MatrixXd&, const Eigen::MatrixXd&, size_t)"/>).
+/// </summary>
+/// <param name="a">			The first covariance matrices. </param>
+/// <param name="b">			The second covariance matrices. </param>
+/// <param name="kernel">		The kernel matrix (one row by matrix of \p a and one column by matrix of \p b). </param>
+/// <param name="ref">			(Optional) The \f$N \times N\f$ reference (use the identity Matrix if empty). </param>
+/// <param name="nbThreads">	(Optional) The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool TangentKernel(const std::vector<Eigen::MatrixXd>& a, const std::vector<Eigen::MatrixXd>& b, Eigen::MatrixXd& kernel,
+				   const Eigen::MatrixXd& ref = Eigen::MatrixXd(), size_t nbThreads = 0);
+
 }  // namespace Geometry
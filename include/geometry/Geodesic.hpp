@@ -14,6 +14,7 @@
 #pragma once
 
 #include "geometry/Metrics.hpp"
+#include "geometry/Basics.hpp"
 #include <Eigen/Dense>
 
 namespace Geometry {
@@ -29,6 +30,21 @@ namespace Geometry {
 /// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, EMetric metric = EMetric::Riemann, double alpha = 0.5);
 
+/// <summary>	Compute the matrix at the position alpha on the geodesic between A and B with the selected \p metric without allocation if the buffers have already the good size.\n
+/// - Riemann : with the Cholesky factor \f$ A = L L^{\mathsf{T}} \f$ and \f$ L^{-1} B L^{-\mathsf{T}} = W \operatorname{diag}\left(\mu\right) W^{\mathsf{T}} \f$ (symmetric eigen decomposition),
+/// \f$ \gamma = F F^{\mathsf{T}} \f$ with \f$ F = L W \operatorname{diag}\left(\mu^{\alpha/2}\right) \f$.
+/// - Log-Euclidian : the logarithms and the exponential are computed with symmetric eigen decompositions.
+/// - Other metrics : same as <see cref="Geodesic(const Eigen::MatrixXd&, const Eigen::MatrixXd&, Eigen::MatrixXd&, EMetric, double)" />.
+/// </summary>
+/// <param name="a">		The First Covariance matrix. </param>
+/// <param name="b">		The Second Covariance matrix. </param>
+/// <param name="g">		The Geodesic (it can be A). </param>
+/// <param name="metric">	The metric (see <see cref="EMetric"/>). </param>
+/// <param name="alpha"> 	Position on the Geodesic : \f$ 0\leq \text{alpha} \leq 1\f$. </param>
+/// <param name="buffers">	The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, EMetric metric, double alpha, SSymmetricBuffers& buffers);
+
 /// <summary>	Compute the matrix at the position alpha on the Riemannian geodesic between A and B. \n
 /// \f[ \gamma_\text{R} = A^{1/2} ~ \left( A^{-1/2} ~ B ~ A^{-1/2} \right)^\alpha ~ A^{1/2} \f]
 /// </summary>
@@ -69,4 +85,91 @@ bool GeodesicLogEuclidian(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Ei
 /// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 bool GeodesicIdentity(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, double alpha = 0.5);
 
+/// <summary>	Compute the matrix at the position alpha on the Log-Cholesky geodesic between A and B (with the Cholesky factors \f$ A = LL^{\mathsf{T}} \f$ and \f$ B = KK^{\mathsf{T}} \f$). \n
+/// \f[ \gamma_\text{LogC} = \Gamma\Gamma^{\mathsf{T}} \quad \text{with} \quad \Gamma_{ij} = \left(1 - \alpha \right) \times L_{ij} + \alpha \times K_{ij} \quad (i > j) \quad \text{and} \quad \Gamma_{ii} = L_{ii}^{1 - \alpha} \times K_{ii}^{\alpha} \f]
+/// </summary>
+/// <param name="a">		The First Covariance matrix. </param>
+/// <param name="b">		The Second Covariance matrix. </param>
+/// <param name="g">		The Geodesic (it can be one of the inputs). </param>
+/// <param name="alpha">	Position on the Geodesic : \f$ 0\leq \text{alpha} \leq 1\f$. </param>
+/// <param name="buffers">	The buffers (the Cholesky factors in <c>matrix</c> and <c>product</c>). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	Two Cholesky decompositions without eigen decomposition : an approximation of the Riemann geodesic (same determinant, exact for commuting diagonal matrices) for the running estimations. </remarks>
+bool GeodesicLogCholesky(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, double alpha, SSymmetricBuffers& buffers);
+
+//*************************************************************
+//******************** Compile-time Metric ********************
+//*************************************************************
+/// <summary>	Compute the matrix at the position alpha on the geodesic with the metric \p M known at compilation (same result as <see cref="Geodesic(const Eigen::MatrixXd&, const Eigen::MatrixXd&, Eigen::MatrixXd&, EMetric, double)" /> without dispatch on the metric). </summary>
+/// <typeparam name="M">	The metric (see <see cref="EMetric"/>). </typeparam>
+/// <param name="a">		The First Covariance matrix. </param>
+/// <param name="b">		The Second Covariance matrix. </param>
+/// <param name="g">		The Geodesic. </param>
+/// <param name="alpha">	(Optional) Position on the Geodesic : \f$ 0\leq \text{alpha} \leq 1\f$. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+template <EMetric M>
+bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, double alpha = 0.5)
+{
+	if (!HaveSameSize(a, b)) { return false; }						// Verification same size
+	if (!IsSquare(a)) { return false; }								// Verification square matrix
+	if (!InRange(alpha, 0, 1)) { return false; }					// Verification alpha in [0;1]
+	switch (M)														// Switch metric
+	{
+		case EMetric::Riemann: return GeodesicRiemann(a, b, g, alpha);
+		case EMetric::Euclidian: return GeodesicEuclidian(a, b, g, alpha);
+		case EMetric::LogEuclidian: return GeodesicLogEuclidian(a, b, g, alpha);
+		case EMetric::Identity:
+		default: return GeodesicIdentity(a, b, g, alpha);
+	}
+}
+
+/// <summary>	Compute the matrix at the position alpha on the geodesic with the metric \p M known at compilation and the buffers
+/// (see <see cref="Geodesic(const Eigen::MatrixXd&, const Eigen::MatrixXd&, Eigen::MatrixXd&, EMetric, double, SSymmetricBuffers&)" />).
+/// </summary>
+/// <typeparam name="M">	The metric (see <see cref="EMetric"/>). </typeparam>
+/// <param name="a">		The First Covariance matrix. </param>
+/// <param name="b">		The Second Covariance matrix. </param>
+/// <param name="g">		The Geodesic (it can be A). </param>
+/// <param name="alpha">	Position on the Geodesic : \f$ 0\leq \text{alpha} \leq 1\f$. </param>
+/// <param name="buffers">	The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+template <EMetric M>
+bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, double alpha, SSymmetricBuffers& buffers)
+{
+	if (!HaveSameSize(a, b)) { return false; }						// Verification same size
+	if (!IsSquare(a)) { return false; }								// Verification square matrix
+	if (!InRange(alpha, 0, 1)) { return false; }					// Verification alpha in [0;1]
+	switch (M)														// Switch metric
+	{
+		case EMetric::Riemann:
+		{
+			buffers.matrix = a;										// Cholesky factor A = L L^T
+			if (Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(buffers.matrix) >= 0) { return false; }	// Not a SPD Matrix
+			buffers.product = b;									// L^-1 B L^-T (B is symmetric)
+			buffers.matrix.triangularView<Eigen::Lower>().solveInPlace(buffers.product);
+			buffers.product.transposeInPlace();
+			buffers.matrix.triangularView<Eigen::Lower>().solveInPlace(buffers.product);
+			if (!SelfAdjointEigen(buffers.product, buffers.values, buffers.vectors, buffers.eigen)) { return false; }
+			for (Eigen::Index i = 0; i < buffers.values.size(); ++i) { buffers.values[i] = pow(std::max(buffers.values[i], 0.0), alpha / 2); }
+			buffers.vectors.array().rowwise() *= buffers.values.transpose().array();	// W D^(alpha/2)
+			buffers.product.noalias() = buffers.matrix.triangularView<Eigen::Lower>() * buffers.vectors;
+			g.noalias()               = buffers.product * buffers.product.transpose();
+			return true;
+		}
+		case EMetric::Euclidian: g = (1 - alpha) * a + alpha * b;
+			return true;
+		case EMetric::LogEuclidian:
+		{
+			const auto logarithm = [](const double x) { return log(x); };
+			if (!SelfAdjointFunction(a, buffers.matrix, logarithm, buffers)) { return false; }
+			if (!SelfAdjointFunction(b, g, logarithm, buffers)) { return false; }
+			buffers.matrix = (1 - alpha) * buffers.matrix + alpha * g;
+			return SelfAdjointFunction(buffers.matrix, g, [](const double x) { return exp(x); }, buffers);
+		}
+		case EMetric::Identity:
+		default: g.setIdentity(a.rows(), a.rows());
+			return true;
+	}
+}
+
 }  // namespace Geometry
@@ -17,8 +17,10 @@
 #pragma once
 
 #include "geometry/Metrics.hpp"
+#include "geometry/Basics.hpp"
 #include <Eigen/Dense>
 #include <vector>
+#include <iostream>
 
 namespace Geometry {
 
@@ -29,6 +31,15 @@ namespace Geometry {
 /// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 bool Mean(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean, EMetric metric = EMetric::Riemann);
 
+/// <summary>	Compute the mean of vector of covariance matrix with the selected \p metric, the iterative procedures start from the current \p mean instead of the Euclidian Mean. </summary>
+/// <param name="covs">  	Vector of Covariance Matrix. </param>
+/// <param name="mean">  	The initial mean and the computed mean. </param>
+/// <param name="metric">	(Optional) The metric (see <see cref="EMetric"/>). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>	If the initial mean hasn't the size of the matrices or if the metric has a closed form, it's the same as <see cref="Mean(const std::vector<Eigen::MatrixXd>&, Eigen::MatrixXd&, EMetric)" />.\n
+/// A close initial mean (the previous centroid of a clustering, the previous mean of a class...) reduces the number of iterations. </remarks>
+bool MeanWarmStart(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean, EMetric metric = EMetric::Riemann);
+
 /// <summary>	Approximate Joint Diagonalization based on pham's algorithm.\n 
 /// \f[ C_\text{AJD} = \cdots \f]
 /// </summary>
@@ -160,4 +171,49 @@ bool MeanHarmonic(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mea
 /// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 bool MeanIdentity(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean);
 
+//*************************************************************
+//******************** Compile-time Metric ********************
+//*************************************************************
+/// <summary>	Compute the mean of vector of covariance matrix with the metric \p M known at compilation (same result as <see cref="Mean(const std::vector<Eigen::MatrixXd>&, Eigen::MatrixXd&, EMetric)" /> without dispatch on the metric). </summary>
+/// <typeparam name="M">	The metric (see <see cref="EMetric"/>). </typeparam>
+/// <param name="covs">	Vector of Covariance Matrix. </param>
+/// <param name="mean">	The computed mean. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+template <EMetric M>
+bool Mean(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
+{
+	if (covs.empty()) { return false; }			// If no matrix in vector
+	if (covs.size() == 1)						// If just one matrix in vector
+	{
+		mean = covs[0];
+		return true;
+	}
+	if (!HaveSameSize(covs))
+	{
+		std::cout << "Matrices haven't same size." << std::endl;
+		return false;
+	}
+
+	// Force Square Matrix for non Euclidian and non Identity metric
+	if (!IsSquare(covs[0]) && (M != EMetric::Euclidian && M != EMetric::Identity))
+	{
+		std::cout << "Non Square Matrix is invalid with " << toString(M) << " metric." << std::endl;
+		return false;
+	}
+
+	switch (M)									// Switch method
+	{
+		case EMetric::Riemann: return MeanRiemann(covs, mean);
+		case EMetric::Euclidian: return MeanEuclidian(covs, mean);
+		case EMetric::LogEuclidian: return MeanLogEuclidian(covs, mean);
+		case EMetric::LogDet: return MeanLogDet(covs, mean);
+		case EMetric::Kullback: return MeanKullback(covs, mean);
+		case EMetric::ALE: return MeanALE(covs, mean);
+		case EMetric::Harmonic: return MeanHarmonic(covs, mean);
+		case EMetric::Wasserstein: return MeanWasserstein(covs, mean);
+		case EMetric::Identity:
+		default: return MeanIdentity(covs, mean);
+	}
+}
+
 }  // namespace Geometry
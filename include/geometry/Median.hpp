@@ -14,7 +14,9 @@
 
 #include <Eigen/Dense>
 #include <vector>
+#include <iostream>
 #include "geometry/Metrics.hpp"
+#include "geometry/Basics.hpp"
 
 namespace Geometry {
 
@@ -105,4 +107,50 @@ bool Median(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& media
 			const double epsilon = 0.0001, const size_t maxIter = 50, const EMetric& metric = EMetric::Euclidian);
 //-------------------------------------------------------------------------------------------------
 
+//-------------------------------------------------------------------------------------------------
+/// <summary>	Compute the median of vector of matrix with the metric \p M known at compilation (same result as <see cref="Median(const std::vector<Eigen::MatrixXd>&, Eigen::MatrixXd&, double, size_t, const EMetric&)" /> without dispatch on the metric). </summary>
+/// <typeparam name="M">	The metric (see <see cref="EMetric"/>). </typeparam>
+/// <param name="matrices">	Vector of Matrix. </param>
+/// <param name="median">	The computed median. </param>
+/// <param name="epsilon">	(Optional) The epsilon value to stop algorithm. </param>
+/// <param name="maxIter">	(Optional) The maximum iteration allowed to find best Median. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+template <EMetric M>
+bool Median(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& median, double epsilon = 0.0001, size_t maxIter = 50)
+{
+	if (matrices.empty()) { return false; }						// If no matrix in vector
+	if (matrices.size() == 1)									// If just one matrix in vector
+	{
+		median = matrices[0];
+		return true;
+	}
+	if (!HaveSameSize(matrices))								// If different sizes
+	{
+		std::cout << "Matrices haven't same size." << std::endl;
+		return false;
+	}
+	if (!IsSquare(matrices[0]) && M == EMetric::Riemann)		// If non square for Riemann metric
+	{
+		std::cout << "Non Square Matrix is invalid with " << toString(M) << " metric." << std::endl;
+		return false;
+	}
+
+	switch (M)
+	{
+		case EMetric::Riemann: return MedianRiemann(matrices, median, epsilon, maxIter);
+		case EMetric::Euclidian: return MedianEuclidian(matrices, median, epsilon, maxIter);
+		case EMetric::Identity: return MedianIdentity(matrices, median);
+		case EMetric::LogEuclidian:
+		case EMetric::LogDet:
+		case EMetric::Kullback:
+		case EMetric::ALE:
+		case EMetric::Harmonic:
+		case EMetric::Wasserstein:
+			std::cout << toString(M) << " metric not implemented." << std::endl;
+			return false;
+	}
+	return true;
+}
+//-------------------------------------------------------------------------------------------------
+
 }  // namespace Geometry
@@ -57,7 +57,9 @@ std::vector<size_t> BinHist(const std::vector<double>& dataset, const size_t n);
 //-------------------------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------------------------
-/// <summary> Get a Fit distribution. </summary>
+/// <summary> Get a Fit distribution.\n
+/// The histograms of the subsets are counted with binary searches on the sorted values and the Kullback-Leibler divergences of all the subsets and shapes are computed with one product for each width.
+/// </summary>
 /// <param name="values">		The values. </param>
 /// <param name="mu">			The mu. </param>
 /// <param name="sigma">		The sigma. </param>
@@ -76,6 +78,29 @@ bool FitDistribution(const std::vector<double>& values, double& mu, double& sigm
 					 const double stepBound           = 0.010, const double stepScale  = 0.01);
 //-------------------------------------------------------------------------------------------------
 
+//-------------------------------------------------------------------------------------------------
+/// <summary> Get a Fit distribution of several vectors of values with the same size (see <see cref="FitDistribution" />).\n
+/// The tables independant of the values (bounds of each \f$\beta\f$, probability of each bin...) are computed once and the vectors are fitted in parallel.
+/// </summary>
+/// <param name="values">		The vectors of values (same size). </param>
+/// <param name="mu">			The mu of each vector. </param>
+/// <param name="sigma">		The sigma of each vector. </param>
+/// <param name="betas">		List of wanted \f$\beta\f$ shapes. </param>
+/// <param name="minQuant">		Minimum of wanted quantile. </param>
+/// <param name="maxQuant">		Maximum of wanted quantile. </param>
+/// <param name="minClean">		Minimum of estimated clean datas. </param>
+/// <param name="maxDropout">	Maximum of estimated artifact datas. </param>
+/// <param name="stepBound">	Step used to select beginning of datas subset. </param>
+/// <param name="stepScale">	Step used to select size of datas subset. </param>
+/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+bool FitDistributions(const std::vector<std::vector<double>>& values, std::vector<double>& mu, std::vector<double>& sigma,
+					  const std::vector<double>& betas = doubleRange(1.7, 3.5, 0.15),
+					  const double minQuant            = 0.022, const double maxQuant   = 0.60,
+					  const double minClean            = 0.250, const double maxDropout = 0.10,
+					  const double stepBound           = 0.010, const double stepScale  = 0.01, size_t nbThreads = 0);
+//-------------------------------------------------------------------------------------------------
+
 //-------------------------------------------------------------------------------------
 //------------------------------ Riemannian Eigen Values ------------------------------
 //-------------------------------------------------------------------------------------
@@ -28,6 +28,9 @@ public:
 
 	CASR() = default;	///< Initializes a new instance of the <see cref="CASR"/> class.
 
+	CASR(const CASR& obj) { *this = obj; }	///< Initializes a new instance of the <see cref="CASR"/> class with a copy (the median and threshold are shared until one side is trained again).
+	CASR(CASR&& obj) noexcept = default;	///< Initializes a new instance of the <see cref="CASR"/> class without copy of the matrices.
+
 	/// <summary> Initializes a new instance of the <see cref="CASR"/> class with specified <c>metric</c>. </summary>
 	/// <remarks> Only Euclidian and Riemmann metrics are implemented If other is selected, Euclidian is used. </remarks>
 	explicit CASR(const EMetric& metric) { setMetric(metric); }
@@ -42,17 +45,37 @@ public:
 
 	~CASR() = default;	///< Finalizes an instance of the <see cref="CASR"/> class.
 
-	/// <summary>	Trains the specified dataset. </summary>
+	/// <summary>	Trains the specified dataset (the covariance matrices and the fit distribution of each component are computed in parallel). </summary>
 	/// <param name="dataset">	The dataset. </param>
 	/// <param name="rejectionLimit">	The rejection limit. </param>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
-	bool train(const std::vector<Eigen::MatrixXd>& dataset, const double rejectionLimit = 5);
+	bool train(const std::vector<Eigen::MatrixXd>& dataset, const double rejectionLimit = 5, size_t nbThreads = 0);
 
-	/// <summary>	Apply the ASR algorithm to the input signal. </summary>
+	/// <summary>	Apply the ASR algorithm to the input signal.\n
+	/// The running covariance is the geodesic midpoint between the last covariance and the covariance of the chunk (closed form of the mean of two matrices),
+	/// the eigen decomposition is symmetric and the pseudo inverse of the reconstruction is computed with a Cholesky decomposition of its Gram matrix.
+	/// The previous and the new reconstructions are blended with one product, so there is no allocation when the chunks keep the same size.\n
+	/// The reconstruction matrix only depends on the subspace of the rejected components \f$ Q \f$ :
+	/// \f[ R = I - Q \left(Q^{\mathsf{T}} \Sigma^{-1} Q\right)^{-1} Q^{\mathsf{T}} \Sigma^{-1} \f]
+	/// with \f$ \Sigma \f$ the median matrix. It's reused if the rejected subspace has drifted less than the cache tolerance,
+	/// updated with a rank one correction if only one component is added or removed, and rebuilt otherwise (see <see cref="getCacheHits" />).
+	/// </summary>
 	/// <param name="in">	The input signal. </param>
-	/// <param name="out">	The corrected signal. </param>
+	/// <param name="out">	The corrected signal (it can be the input). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	With the Riemann metric, the exact midpoint costs a second eigen decomposition (about twice the time of the Euclidian metric for 64 channels),
+	/// the Log-Cholesky update keeps one eigen decomposition by chunk (see <see cref="setCholeskyUpdate" />). </remarks>
+	bool process(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) { return process(in, in, out); }
+
+	/// <summary>	Apply the ASR algorithm to the input signal with the statistics of a window (see <see cref="process" /> and <see cref="CASRStream" />).\n
+	/// The running covariance is updated with the covariance of the window, the previous and the new reconstructions are blended over the input signal.
+	/// </summary>
+	/// <param name="window">	The window of signal used for the statistics. </param>
+	/// <param name="in">		The input signal (usually the last samples of the window). </param>
+	/// <param name="out">		The corrected signal (it can be the input or the window, but not a larger matrix which contains the input). </param>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
-	bool process(const Eigen::MatrixXd& in, Eigen::MatrixXd& out);
+	bool process(const Eigen::Ref<const Eigen::MatrixXd>& window, const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out);
 
 	//***************************
 	//***** Getter / Setter *****
@@ -68,6 +91,17 @@ public:
 	/// <remarks>	If value isn't in [0;1], this function does nothing. </remarks>
 	void setMaxChannel(const double max) { if (InRange(max, 0.0, 1.0)) { m_maxChannel = max; } }
 
+	/// <summary> Sets the tolerance of the reconstruction cache, the maximum drift \f$ 1 - \left\| Q_\text{cache}^{\mathsf{T}} q \right\|^2 \f$ (squared sinus of the angle) of a rejected component to reuse the reconstruction. </summary>
+	/// <param name="tolerance">	The tolerance (0 to rebuild the reconstruction for each chunk with rejected components, without comparison with the cache). </param>
+	/// <remarks>	If value isn't in [0;1], this function does nothing. </remarks>
+	void setCacheTolerance(const double tolerance) { if (InRange(tolerance, 0.0, 1.0)) { m_cacheTolerance = tolerance; } }
+
+	/// <summary> Sets the update of the running covariance with the Riemann metric : midpoint of the Log-Cholesky geodesic (two Cholesky decompositions, see <see cref="GeodesicLogCholesky" />)
+	/// instead of the exact midpoint of the Riemann geodesic (one Cholesky and one eigen decomposition). </summary>
+	/// <param name="cholesky">	<c>True</c> to use the Log-Cholesky update. </param>
+	/// <remarks>	The Log-Cholesky midpoint is an approximation of the Riemann midpoint (same determinant), the Euclidian metric isn't affected. </remarks>
+	void setCholeskyUpdate(const bool cholesky) { m_choleskyUpdate = cholesky; }
+
 	/// <summary> Sets the differents matrices : median matrix, trheshold matrix, reconstruction matrix and covariance matrix. </summary>
 	/// <param name="median">		The median matrix. </param>
 	/// <param name="threshold">	The threshold matrix. </param>
@@ -82,8 +116,14 @@ public:
 	EMetric getMetric() const { return m_metric; }						///< Get the metric.
 	size_t getChannelNumber() const { return m_nChannel; }				///< Get the matrices number of channel.
 	double getMaxChannel() const { return m_maxChannel; }				///< Get the number of channel (dimension) to reconstruct in fraction.
-	Eigen::MatrixXd getMedian() const { return m_median; }				///< Get the median matrix.
-	Eigen::MatrixXd getThresholdMatrix() const { return m_threshold; }	///< Get the threshold matrix.
+	Eigen::MatrixXd getMedian() const { return m_median.get(); }				///< Get the median matrix.
+	Eigen::MatrixXd getThresholdMatrix() const { return m_threshold.get(); }	///< Get the threshold matrix.
+	double getCacheTolerance() const { return m_cacheTolerance; }		///< Get the tolerance of the reconstruction cache.
+	bool getCholeskyUpdate() const { return m_choleskyUpdate; }			///< Get if the running covariance is updated with the Log-Cholesky geodesic (Riemann metric).
+	size_t getCacheHits() const { return m_cache.hits; }				///< Get the number of reconstructions reused from the cache.
+	size_t getCacheUpdates() const { return m_cache.updates; }			///< Get the number of reconstructions updated with a rank one correction.
+	size_t getCacheMisses() const { return m_cache.misses; }			///< Get the number of reconstructions rebuilt.
+	void resetCacheStatistics() { m_cache.hits = m_cache.updates = m_cache.misses = 0; }	///< Reset the number of hits, updates and misses of the cache.
 
 	//***********************
 	//***** XML Manager *****
@@ -124,6 +164,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CASR& operator=(CASR&& obj) noexcept = default;
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="CASR"/> are equals. </returns>
@@ -145,6 +190,73 @@ public:
 	}
 
 protected:
+	friend class CASRBank;	///< The bank processes its streams with the state of each stream in a worker ASR.
+
+	/// <summary>	Buffers of the process, kept between the chunks to avoid allocations. </summary>
+	struct SProcessBuffers
+	{
+		Eigen::MatrixXd centered;		///< Centered window (CxW).
+		Eigen::VectorXd mean;			///< Mean of each channel of the chunk (C).
+		Eigen::MatrixXd cov;			///< Covariance matrix of the chunk (CxC).
+		Eigen::VectorXd values;			///< Eigen values of the running covariance (C).
+		Eigen::MatrixXd vectors;		///< Eigen vectors of the running covariance (CxC).
+		Eigen::MatrixXd product;		///< Intermediate product (CxC).
+		Eigen::MatrixXd rejected;		///< Rejected eigen vectors of the chunk by column (CxC, only the first columns are used).
+		Eigen::MatrixXd r;				///< New reconstruction matrix (CxC).
+		Eigen::MatrixXd stacked;		///< New and previous reconstruction matrices side by side (Cx2C).
+		Eigen::MatrixXd blended;		///< Chunk weighted by the blend and by its complement (2CxS).
+		Eigen::VectorXd blend;			///< Blend weights of the samples (S).
+		std::vector<char> keep;			///< Components kept by the reconstruction (C).
+		SSymmetricBuffers symmetric;	///< Buffers of the eigen decompositions.
+
+		/// <summary>	Resize the buffers if the number of channels or samples change. </summary>
+		/// <param name="nChannel">	The number of channels. </param>
+		/// <param name="nWindow">	The number of samples of the window. </param>
+		/// <param name="nSample">	The number of samples of the chunk. </param>
+		void resize(Eigen::Index nChannel, Eigen::Index nWindow, Eigen::Index nSample);
+	};
+
+	/// <summary>	Cache of the reconstruction, the oblique projector on the rejected subspace \f$ P = Q S^{-1} Z^{\mathsf{T}} \f$
+	/// with \f$ Z = \Sigma^{-1} Q \f$ and \f$ S = Q^{\mathsf{T}} Z \f$ (the reconstruction is \f$ I - P \f$).
+	/// The matrices have the size of the maximum number of rejected components, so there is no allocation when this number change.
+	/// </summary>
+	struct SReconstructionCache
+	{
+		bool valid         = false;	///< Define if the inverse of the median is computed.
+		Eigen::Index count = 0;		///< Number of rejected components \f$ r \f$ in the cache.
+		Eigen::MatrixXd inverse;	///< Inverse of the median matrix \f$ \Sigma^{-1} \f$ (CxC).
+		Eigen::MatrixXd q;			///< Rejected components \f$ Q \f$ (Cxr).
+		Eigen::MatrixXd z;			///< Rejected components with the inverse of the median \f$ Z \f$ (Cxr).
+		Eigen::MatrixXd sInv;		///< Inverse of \f$ S \f$ (rxr).
+		Eigen::MatrixXd projector;	///< Projector \f$ P \f$ (CxC).
+		Eigen::VectorXd u, v, w;	///< Vectors of the rank one corrections (C).
+		size_t hits    = 0;			///< Number of reconstructions reused.
+		size_t updates = 0;			///< Number of reconstructions updated with a rank one correction.
+		size_t misses  = 0;			///< Number of reconstructions rebuilt.
+
+		/// <summary>	Resize the matrices if the number of channels change (the cache is invalidated). </summary>
+		/// <param name="nChannel">	The number of channels. </param>
+		void resize(Eigen::Index nChannel);
+	};
+
+	/// <summary>	Compute the new reconstruction matrix in <c>m_buffers.r</c> with the rejected components of the chunk (see <see cref="process" />). </summary>
+	/// <param name="begin">	The first component which can be rejected. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool reconstruction(size_t begin);
+
+	/// <summary>	Rebuild the cache with the first <c>count</c> rejected components of <c>m_buffers.rejected</c>. </summary>
+	/// <param name="count">	The number of rejected components. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool rebuildCache(Eigen::Index count);
+
+	/// <summary>	Add a rejected component to the cache with a rank one correction. </summary>
+	/// <param name="index">	The index of the component in <c>m_buffers.rejected</c>. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> if the component is in the subspace of the cache. </returns>
+	bool addToCache(Eigen::Index index);
+
+	/// <summary>	Remove a rejected component of the cache with a rank one correction. </summary>
+	/// <param name="index">	The index of the component in the cache. </param>
+	void removeFromCache(Eigen::Index index);
 
 	//*********************
 	//***** Variables *****
@@ -153,10 +265,14 @@ protected:
 	size_t m_nChannel   = 0;					///< Number of channel (dimension)
 	double m_maxChannel = 1;					///< Number of channel (dimension) to reconstruct in fraction, 0 for nothing 1 for all
 	bool m_trivial      = true;					///< Define if previous sample was trivial to reconstruct
-	Eigen::MatrixXd m_median;					///< Median computed with train dataset
-	Eigen::MatrixXd m_threshold;				///< Threshold matrix computed with train dataset
+	CCopyOnWrite<Eigen::MatrixXd> m_median;		///< Median computed with train dataset (shared by the copies)
+	CCopyOnWrite<Eigen::MatrixXd> m_threshold;	///< Threshold matrix computed with train dataset (shared by the copies)
 	Eigen::MatrixXd m_r;						///< Last Reconstruction matrix
 	Eigen::MatrixXd m_cov;						///< Last Covariance matrix
+	double m_cacheTolerance = 1e-3;				///< Maximum drift of the rejected components to reuse the reconstruction
+	bool m_choleskyUpdate   = false;			///< Define if the running covariance is updated with the Log-Cholesky geodesic (Riemann metric)
+	SProcessBuffers m_buffers;					///< Buffers of the process (not copied)
+	SReconstructionCache m_cache;				///< Cache of the reconstruction (not copied)
 };
 
 }  // namespace Geometry
@@ -0,0 +1,115 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CASRBank.hpp
+/// \brief Class used to apply Artifact Subspace Reconstruction on several streams with one calibration.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <vector>
+#include <Eigen/Dense>
+
+#include "geometry/artifacts/CASR.hpp"
+
+namespace Geometry {
+
+/// <summary> Class For Artifact Subspace Reconstruction (ASR) on several streams (hyperscanning, multi-user...) with the same calibration.\n
+/// The calibration (median and threshold matrices) is shared with the trained <see cref="CASR" /> and never copied.
+/// The state of each stream (reconstruction matrix, running covariance and trivial flag) is stored in contiguous arrays :
+/// the state of the stream \f$ k \f$ is the block of columns \f$ [kC;(k+1)C[ \f$ of the reconstruction and covariance matrices.
+/// Each stream has also its reconstruction cache (see <see cref="CASR::setCacheTolerance" />, the tolerance of the calibration is used).\n
+/// The bank is a parallel wrapper : each tick processes one chunk of each stream with the persistent threads of the bank (see <see cref="CThreadPool" />).
+/// Each thread has one worker ASR (buffers of the process), the state of the stream is loaded in the worker for its chunk and the cache of the stream is swapped with the cache of the worker.
+/// So the output of each stream is the output of a <see cref="CASR" /> with the same calibration, the computations aren't batched between the streams.\n
+/// The chunks are given in a vector or packed in one matrix (the streams stacked by rows) when they have the same number of samples.
+/// </summary>
+class CASRBank
+{
+public:
+	CASRBank() = default;	///< Initializes a new instance of the <see cref="CASRBank"/> class.
+
+	/// <summary>	Initializes a new instance of the <see cref="CASRBank"/> class with a trained ASR. </summary>
+	/// <param name="calibration">	The trained ASR (the calibration is shared). </param>
+	/// <param name="nStream">		The number of streams. </param>
+	explicit CASRBank(const CASR& calibration, const size_t nStream) { initialize(calibration, nStream); }
+
+	~CASRBank() = default;	///< Finalizes an instance of the <see cref="CASRBank"/> class.
+
+	/// <summary>	Set the calibration and the number of streams, the state of each stream is reset. </summary>
+	/// <param name="calibration">	The trained ASR (the calibration is shared, the state of the ASR is not used). </param>
+	/// <param name="nStream">		The number of streams. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool initialize(const CASR& calibration, size_t nStream);
+
+	/// <summary>	Reset the state of each stream (identity reconstruction, no running covariance and empty cache). </summary>
+	void reset();
+
+	/// <summary>	Apply the ASR algorithm to one chunk of each stream (see <see cref="CASR::process" />). </summary>
+	/// <param name="in">			The chunk of each stream (the number of samples can change between the streams). </param>
+	/// <param name="out">			The corrected chunk of each stream. </param>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <returns>	<c>True</c> if it succeeds for all the streams, <c>False</c> otherwise. </returns>
+	bool process(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out, size_t nbThreads = 0);
+
+	/// <summary>	Apply the ASR algorithm to one chunk of each stream packed in one matrix (see <see cref="CASR::process" />). </summary>
+	/// <param name="in">			The chunks stacked by rows, the rows \f$ [kC;(k+1)C[ \f$ are the stream \f$ k \f$. </param>
+	/// <param name="out">			The corrected chunks stacked by rows (it can be the input). </param>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <returns>	<c>True</c> if it succeeds for all the streams, <c>False</c> otherwise. </returns>
+	bool process(const Eigen::MatrixXd& in, Eigen::MatrixXd& out, size_t nbThreads = 0);
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	size_t getStreamNumber() const { return m_nStream; }								///< Get the number of streams.
+	size_t getChannelNumber() const { return m_calibration.getChannelNumber(); }		///< Get the number of channels of each stream.
+	const CASR& getCalibration() const { return m_calibration; }						///< Get the calibration.
+	bool isTrivial(const size_t stream) const { return m_trivial[stream] != 0; }		///< Check if the last chunk of the stream was trivial.
+
+	/// <summary>	Get the last reconstruction matrix of a stream. </summary>
+	/// <param name="stream">	The index of the stream. </param>
+	/// <returns>	The reconstruction matrix. </returns>
+	Eigen::MatrixXd getReconstruction(const size_t stream) const { return m_r.middleCols(Eigen::Index(stream * getChannelNumber()), Eigen::Index(getChannelNumber())); }
+
+	/// <summary>	Get the last running covariance matrix of a stream. </summary>
+	/// <param name="stream">	The index of the stream. </param>
+	/// <returns>	The covariance matrix (empty if no chunk is processed). </returns>
+	Eigen::MatrixXd getCovariance(const size_t stream) const
+	{
+		if (m_hasCov[stream] == 0) { return Eigen::MatrixXd(); }
+		return m_cov.middleCols(Eigen::Index(stream * getChannelNumber()), Eigen::Index(getChannelNumber()));
+	}
+
+protected:
+	/// <summary>	Process the chunk of one stream with a worker ASR, the state and the cache of the stream are loaded in the worker and saved after the process. </summary>
+	/// <param name="stream">	The index of the stream. </param>
+	/// <param name="in">		The chunk of the stream. </param>
+	/// <param name="out">		The corrected chunk. </param>
+	/// <param name="worker">	The worker ASR of the thread. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool processStream(size_t stream, const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out, CASR& worker);
+
+	/// <summary>	Prepare one worker by thread (copies of the calibration without state). </summary>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+	void prepareWorkers(size_t nbThreads);
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	CASR m_calibration;				///< The calibration (median and threshold shared with the trained ASR)
+	size_t m_nStream = 0;			///< Number of streams
+	Eigen::MatrixXd m_r;			///< Last reconstruction matrix of each stream (C x KC)
+	Eigen::MatrixXd m_cov;			///< Last covariance matrix of each stream (C x KC)
+	std::vector<char> m_trivial;	///< Define if the last chunk of each stream was trivial
+	std::vector<char> m_hasCov;		///< Define if the covariance of each stream is computed
+	std::vector<CASR::SReconstructionCache> m_caches;	///< Reconstruction cache of each stream
+	std::vector<CASR> m_workers;	///< Worker of each thread (buffers of the process)
+	std::vector<Eigen::MatrixXd> m_outputs;	///< Output of each thread for the packed chunks
+	CThreadPool m_pool;				///< Threads of the bank (created at the first tick and kept between the ticks)
+};
+
+}  // namespace Geometry
@@ -0,0 +1,106 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CASRStream.hpp
+/// \brief Class used to apply Artifact Subspace Reconstruction on a stream of packets of any size.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <Eigen/Dense>
+
+#include "geometry/artifacts/CASR.hpp"
+#include "geometry/artifacts/CRingBuffer.hpp"
+
+namespace Geometry {
+
+/// <summary> Class For Artifact Subspace Reconstruction (ASR) on a stream of packets of any size.\n
+/// The packets are buffered in a lock-free ring buffer (see <see cref="CRingBuffer" />) and the stream is cut in steps independent of the packets :
+/// - Each step of \f$ H \f$ samples updates the statistics of the <see cref="CASR" /> with the last window of \f$ W \ge H \f$ samples (overlap of \f$ W - H \f$ samples).
+/// - The reconstruction matrices of the previous and the current steps are blended over the \f$ H \f$ samples of the step,
+///   so the blend is continuous whatever the size of the packets.
+/// - The output is the cleaned input delayed by exactly \f$ H - 1 \f$ samples (see <see cref="getLatency" />), the first output samples are zeros.
+/// - The samples are not cleaned before the first full window (the statistics of a partial window aren't reliable), they are only delayed.
+///
+/// The acquisition and the cleaning can be made in two threads : the producer calls <see cref="push" /> and the consumer calls <see cref="pull" />
+/// (the capacity of the input buffer must be at least the largest packet plus one step, the samples of an incomplete step stay in the buffer).
+/// In one thread, <see cref="process" /> gives an output of the size of the input.
+/// The output buffer receives a step only if it has the room : otherwise the step waits in the input buffer until the output is read (a full input buffer refuses the next packet).
+/// </summary>
+class CASRStream
+{
+public:
+	CASRStream() = default;	///< Initializes a new instance of the <see cref="CASRStream"/> class.
+
+	/// <summary>	Initializes a new instance of the <see cref="CASRStream"/> class with a trained ASR. </summary>
+	/// <param name="asr">		The trained ASR (copied). </param>
+	/// <param name="window">	The number of samples of the window of statistics. </param>
+	/// <param name="step">		The number of samples between two updates of the statistics. </param>
+	/// <param name="capacity">	The capacity of the input buffer in samples (0 for four windows). </param>
+	explicit CASRStream(const CASR& asr, const size_t window, const size_t step, const size_t capacity = 0) { initialize(asr, window, step, capacity); }
+
+	CASRStream(const CASRStream&)            = delete;	///< The input buffer is shared by two threads, the stream can't be copied.
+	CASRStream& operator=(const CASRStream&) = delete;	///< The input buffer is shared by two threads, the stream can't be copied.
+	~CASRStream()                            = default;	///< Finalizes an instance of the <see cref="CASRStream"/> class.
+
+	/// <summary>	Set the ASR, the window and the step, the stream is reset (no thread must use the stream). </summary>
+	/// <param name="asr">		The trained ASR (copied). </param>
+	/// <param name="window">	The number of samples of the window of statistics. </param>
+	/// <param name="step">		The number of samples between two updates of the statistics. </param>
+	/// <param name="capacity">	The capacity of the input buffer in samples (0 for four windows). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	The ASR must be trained, the window must have 2 samples at least and the step must be in [1;window]. </remarks>
+	bool initialize(const CASR& asr, size_t window, size_t step, size_t capacity = 0);
+
+	/// <summary>	Empty the buffers and restart the stream with the trained ASR (no thread must use the stream). </summary>
+	void reset();
+
+	/// <summary>	Write a packet in the input buffer (producer thread, without lock or allocation). </summary>
+	/// <param name="packet">	The packet of samples by column (any number of samples). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> if the number of channels is wrong or if the input buffer is full (the packet is lost). </returns>
+	bool push(const Eigen::Ref<const Eigen::MatrixXd>& packet) { return m_input.push(packet); }
+
+	/// <summary>	Clean all the complete steps of the input buffer and give the available output (consumer thread). </summary>
+	/// <param name="out">	The available cleaned samples (the number of samples varies between two calls). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool pull(Eigen::MatrixXd& out);
+
+	/// <summary>	Write a packet and give the output of the same size, the packet delayed by <see cref="getLatency" /> samples and cleaned (one thread for the acquisition and the cleaning). </summary>
+	/// <param name="in">	The packet of samples by column. </param>
+	/// <param name="out">	The cleaned samples (same size as the input). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool process(const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out);
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	size_t getWindow() const { return m_windowSize; }			///< Get the number of samples of the window of statistics.
+	size_t getStep() const { return m_step; }					///< Get the number of samples between two updates of the statistics.
+	size_t getLatency() const { return m_step - 1; }			///< Get the delay of the output in samples.
+	size_t getCapacity() const { return m_input.getCapacity(); }	///< Get the capacity of the input buffer in samples.
+	size_t getChannelNumber() const { return m_asr.getChannelNumber(); }	///< Get the number of channels.
+	const CASR& getASR() const { return m_asr; }				///< Get the ASR (with the statistics of the stream).
+
+protected:
+	/// <summary>	Clean all the complete steps of the input buffer in the output buffer. </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool update();
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	CASR m_asr;					///< The ASR with the statistics of the stream
+	CASR m_trained;				///< The trained ASR (to reset the stream)
+	size_t m_windowSize = 0;	///< Number of samples of the window of statistics
+	size_t m_step       = 0;	///< Number of samples between two updates of the statistics
+	size_t m_received   = 0;	///< Number of samples in the window (until it's full)
+	CRingBuffer m_input;		///< Input buffer (written by the producer, read by the consumer)
+	CRingBuffer m_output;		///< Output buffer with the delay (only used by the consumer)
+	Eigen::MatrixXd m_window;	///< Last window of samples (Channels x Window)
+	Eigen::MatrixXd m_cleaned;	///< Cleaned samples of the step (Channels x Step)
+};
+
+}  // namespace Geometry
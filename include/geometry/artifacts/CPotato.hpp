@@ -0,0 +1,184 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CPotato.hpp
+/// \brief Class used to use Riemannian Potato Artifact Detection.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+/// \remarks Inspired by the Riemannian Potato of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>).
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "geometry/Basics.hpp"
+#include "geometry/3rd-party/tinyxml2.h"
+#include "geometry/Metrics.hpp"
+
+namespace Geometry {
+
+/// <summary> Class For Riemannian Potato Artifact Detection.\n
+/// Each epoch is accepted or rejected with the z-score of the distance between its covariance matrix and a reference :
+/// \f[ z = \frac{d\left(C, C_\text{ref}\right) - \mu}{\sigma} \f]
+/// The epoch is rejected if \f$ z > \text{threshold} \f$, otherwise the reference and the statistics are updated with the forgetting factor \f$ \lambda \f$ :
+/// \f[ \begin{aligned}
+///		C_\text{ref} &= \gamma\left(C_\text{ref}, C, \lambda\right)\\
+///		\mu &= (1 - \lambda) \mu + \lambda d\\
+///		\sigma^2 &= (1 - \lambda) \left(\sigma^2 + \lambda \left(d - \mu_\text{old}\right)^2\right)
+///	\end{aligned}
+/// \f]
+/// The factor of the reference is kept (see <see cref="DistanceReferenceFactor" />), so each epoch costs one covariance estimation and one distance computation (and one geodesic for a clean epoch).\n
+/// With the Riemann metric, the reference is kept as \f$ C_\text{ref} = F F^{\mathsf{T}} \f$ with the inverse factor \f$ F^{-1} \f$, the distance comes from the eigen decomposition
+/// \f$ F^{-1} C F^{-\mathsf{T}} = W D W^{\mathsf{T}} \f$ and the same decomposition gives the geodesic of a clean epoch :
+/// \f$ C_\text{ref} = G G^{\mathsf{T}} \f$ with \f$ G = F W D^{\lambda/2} \f$ and \f$ G^{-1} = D^{-\lambda/2} W^{\mathsf{T}} F^{-1} \f$,
+/// so an epoch costs one covariance estimation, one symmetric eigen solver and some matrix products.
+/// </summary>
+class CPotato
+{
+public:
+
+	CPotato() = default;	///< Initializes a new instance of the <see cref="CPotato"/> class.
+
+	/// <summary> Initializes a new instance of the <see cref="CPotato"/> class with specified <c>metric</c>. </summary>
+	explicit CPotato(const EMetric& metric) { setMetric(metric); }
+
+	/// <summary> Initializes a new instance of the <see cref="CPotato"/> class with specified <c>metric</c> and train with the specified <c>dataset</c>. </summary>
+	explicit CPotato(const EMetric& metric, const std::vector<Eigen::MatrixXd>& dataset)
+	{
+		setMetric(metric);
+		train(dataset);
+	}
+
+	~CPotato() = default;	///< Finalizes an instance of the <see cref="CPotato"/> class.
+
+	/// <summary>	Trains the reference (mean of the covariance matrices) and the statistics of the distances with the specified dataset. </summary>
+	/// <param name="dataset">	The dataset (epochs of signal). </param>
+	/// <param name="threshold">	The z-score limit of the rejection. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool train(const std::vector<Eigen::MatrixXd>& dataset, const double threshold = 3);
+
+	/// <summary>	Check if the epoch is clean and update the reference if it is. </summary>
+	/// <param name="in">	The epoch of signal. </param>
+	/// <param name="clean">	<c>True</c> if the epoch is accepted, <c>False</c> if it's rejected. </param>
+	/// <param name="zScore">	The z-score of the distance of the epoch. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool process(const Eigen::MatrixXd& in, bool& clean, double& zScore);
+
+	/// <summary>	Check if the covariance matrix of an epoch is clean and update the reference if it is (see <see cref="process" />). </summary>
+	/// <param name="cov">	The covariance matrix of the epoch. </param>
+	/// <param name="clean">	<c>True</c> if the epoch is accepted, <c>False</c> if it's rejected. </param>
+	/// <param name="zScore">	The z-score of the distance of the epoch. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool processCovariance(const Eigen::MatrixXd& cov, bool& clean, double& zScore);
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+
+	/// <summary> Set the metric to use. </summary>
+	/// <param name="metric">The metric. </param>
+	/// <remarks> Only Riemann, Euclidian and Log-Euclidian metrics are implemented, if other is selected, Riemann is used. </remarks>
+	void setMetric(const EMetric& metric)
+	{
+		m_metric = (metric == EMetric::Euclidian || metric == EMetric::LogEuclidian) ? metric : EMetric::Riemann;
+		updateFactor();
+	}
+
+	/// <summary> Sets the z-score limit of the rejection. </summary>
+	/// <param name="threshold">	The threshold. </param>
+	/// <remarks>	If value isn't positive, this function does nothing. </remarks>
+	void setThreshold(const double threshold) { if (threshold > 0) { m_threshold = threshold; } }
+
+	/// <summary> Sets the forgetting factor, weight of a clean epoch in the update of the reference and the statistics (0 for no update). </summary>
+	/// <param name="forgetting">	The forgetting factor. </param>
+	/// <remarks>	If value isn't in [0;1], this function does nothing. </remarks>
+	void setForgetting(const double forgetting) { if (InRange(forgetting, 0.0, 1.0)) { m_forgetting = forgetting; } }
+
+	/// <summary> Sets the reference and the statistics of the distances. </summary>
+	/// <param name="reference">	The reference matrix. </param>
+	/// <param name="mean">			The mean of the distances to the reference. </param>
+	/// <param name="deviation">	The standard deviation of the distances to the reference. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	The reference must be square and the standard deviation positive. </remarks>
+	bool setReference(const Eigen::MatrixXd& reference, double mean, double deviation);
+
+	EMetric getMetric() const { return m_metric; }					///< Get the metric.
+	size_t getChannelNumber() const { return m_nChannel; }			///< Get the matrices number of channel.
+	double getThreshold() const { return m_threshold; }				///< Get the z-score limit of the rejection.
+	double getForgetting() const { return m_forgetting; }			///< Get the forgetting factor.
+	double getMean() const { return m_mean; }						///< Get the mean of the distances.
+	double getStd() const { return m_std; }							///< Get the standard deviation of the distances.
+	const Eigen::MatrixXd& getReference() const { return m_reference; }	///< Get the reference matrix.
+
+	//***********************
+	//***** XML Manager *****
+	//***********************
+	/// <summary>	Saves the Potato information in an XML file. </summary>
+	/// <param name="filename">	Filename. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveXML(const std::string& filename) const;
+
+	/// <summary>	Loads the Potato information from an XML file. </summary>
+	/// <param name="filename">	Filename. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadXML(const std::string& filename);
+
+	//*****************************
+	//***** Override Operator *****
+	//*****************************
+	/// <summary>	Check if object are equals (with a precision tolerance). </summary>
+	/// <param name="obj">			The second object. </param>
+	/// <param name="precision">	Precision for matrix comparison. </param>
+	/// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance), <c>False</c> otherwise. </returns>
+	bool isEqual(const CPotato& obj, const double precision = 1e-6) const;
+
+	/// <summary>	Get the Potato information for output. </summary>
+	/// <returns>	The Potato print in stringstream. </returns>
+	std::stringstream print() const;
+
+	/// <summary>	Override the equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CPotato"/> are equals. </returns>
+	bool operator==(const CPotato& obj) const { return isEqual(obj); }
+
+	/// <summary>	Override the not equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CPotato"/> are diffrents. </returns>
+	bool operator!=(const CPotato& obj) const { return !isEqual(obj); }
+
+	/// <summary>	Override the ostream operator. </summary>
+	/// <param name="os">	The ostream. </param>
+	/// <param name="obj">	The object. </param>
+	/// <returns>	Return the modified ostream. </returns>
+	friend std::ostream& operator <<(std::ostream& os, const CPotato& obj)
+	{
+		os << obj.print().str();
+		return os;
+	}
+
+protected:
+	/// <summary>	Update the factor of the reference used by the distance (see <see cref="DistanceReferenceFactor" />) and its Cholesky factor with the Riemann metric. </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool updateFactor();
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	EMetric m_metric    = EMetric::Riemann;	///< Metric Used for the distance and the update of the reference
+	size_t m_nChannel   = 0;				///< Number of channel (dimension)
+	double m_threshold  = 3;				///< Z-score limit of the rejection
+	double m_forgetting = 0.01;				///< Weight of a clean epoch in the update of the reference and the statistics
+	double m_mean       = 0;				///< Running mean of the distances to the reference
+	double m_std        = 1;				///< Running standard deviation of the distances to the reference
+	Eigen::MatrixXd m_reference;			///< Running reference matrix
+	Eigen::MatrixXd m_factor;				///< Factor of the reference (see <see cref="DistanceReferenceFactor" />), the inverse factor F^-1 with the Riemann metric
+	Eigen::MatrixXd m_root;					///< Factor F of the reference R = F F^T (Riemann metric only)
+	Eigen::MatrixXd m_sampleFactor;			///< Factor of the last sample (see <see cref="DistanceSampleFactor" />)
+	SSymmetricBuffers m_buffers;			///< Buffers of the distance and the geodesic
+};
+
+}  // namespace Geometry
@@ -0,0 +1,93 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CRingBuffer.hpp
+/// \brief Class of lock-free single producer / single consumer ring buffer of multichannel samples.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <Eigen/Dense>
+
+namespace Geometry {
+
+/// <summary> Class of lock-free ring buffer of multichannel samples for one producer thread and one consumer thread. </summary>
+/// <remarks>
+/// The samples are the columns of a matrix of fixed capacity :
+/// - The producer (for example the acquisition) writes the samples with <see cref="push" />.
+/// - The consumer (for example the cleaning) reads the samples with <see cref="pop" />.
+/// - The positions of the producer and of the consumer are atomic counters on separate cache lines, each one is only written by its thread,
+///   so the producer and the consumer never wait each other and there is no allocation after the <see cref="resize" />.
+///
+/// The other functions (<see cref="resize" />, <see cref="clear" />) must be called when no thread uses the buffer.
+/// </remarks>
+class CRingBuffer
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	CRingBuffer() = default;	///< Initializes a new instance of the <see cref="CRingBuffer"/> class without capacity.
+
+	/// <summary>	Initializes a new instance of the <see cref="CRingBuffer"/> class with the specified number of channels and capacity. </summary>
+	/// <param name="nChannel">	The number of channels. </param>
+	/// <param name="capacity">	The maximum number of samples in the buffer. </param>
+	CRingBuffer(const size_t nChannel, const size_t capacity) { resize(nChannel, capacity); }
+
+	CRingBuffer(const CRingBuffer&)            = delete;	///< The positions are shared by two threads, the buffer can't be copied.
+	CRingBuffer& operator=(const CRingBuffer&) = delete;	///< The positions are shared by two threads, the buffer can't be copied.
+	~CRingBuffer()                             = default;	///< Finalizes an instance of the <see cref="CRingBuffer"/> class.
+
+	//**********************
+	//***** Operations *****
+	//**********************
+	/// <summary>	Write samples at the end of the buffer (producer thread). </summary>
+	/// <param name="in">	The samples by column. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> if the number of channels is wrong or if there is not enough free space (nothing is written). </returns>
+	bool push(const Eigen::Ref<const Eigen::MatrixXd>& in);
+
+	/// <summary>	Read and remove samples at the beginning of the buffer (consumer thread). </summary>
+	/// <param name="out">	The samples by column, the number of columns is the number of samples read. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> if the number of channels is wrong or if there is not enough samples (nothing is read). </returns>
+	bool pop(Eigen::Ref<Eigen::MatrixXd> out);
+
+	/// <summary>	Change the number of channels and the capacity, the buffer is emptied (no thread must use the buffer). </summary>
+	/// <param name="nChannel">	The number of channels. </param>
+	/// <param name="capacity">	The maximum number of samples in the buffer. </param>
+	void resize(size_t nChannel, size_t capacity);
+
+	/// <summary>	Remove all the samples (no thread must use the buffer). </summary>
+	void clear() { m_tail.store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	/// <summary>	Get the number of samples in the buffer. </summary>
+	/// <returns>	The number of samples, the other thread can change it concurrently : a lower bound for the consumer (the available samples are underestimated)
+	/// and an upper bound for the producer (the free space is underestimated). </returns>
+	size_t size() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+
+	size_t getChannelNumber() const { return size_t(m_data.rows()); }	///< Get the number of channels.
+	size_t getCapacity() const { return size_t(m_data.cols()); }		///< Get the maximum number of samples in the buffer.
+	bool isLockFree() const { return m_head.is_lock_free() && m_tail.is_lock_free(); }	///< Check if the positions are lock free on this platform.
+
+protected:
+	//*********************
+	//***** Variables *****
+	//*********************
+	/// <summary>	Size of a cache line, the positions are separated to avoid the false sharing between the producer and the consumer. </summary>
+	static constexpr size_t CACHE_LINE = 64;
+
+	Eigen::MatrixXd m_data;								///< The samples by column (Channels x Capacity).
+	char m_padding0[CACHE_LINE];						///< Separation of the data and the position of the producer.
+	std::atomic<size_t> m_head{ 0 };					///< Number of samples written since the last resize (only written by the producer).
+	char m_padding1[CACHE_LINE - sizeof(size_t)];		///< Separation of the positions of the producer and of the consumer.
+	std::atomic<size_t> m_tail{ 0 };					///< Number of samples read since the last resize (only written by the consumer).
+	char m_padding2[CACHE_LINE - sizeof(size_t)];		///< Separation of the position of the consumer and the next object.
+};
+
+}  // namespace Geometry
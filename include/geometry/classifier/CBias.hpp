@@ -13,6 +13,7 @@
 #include <Eigen/Dense>
 #include <vector>
 #include "geometry/Metrics.hpp"
+#include "geometry/Basics.hpp"
 #include "geometry/3rd-party/tinyxml2.h"
 
 namespace Geometry {
@@ -23,6 +24,10 @@ class CBias
 public:
 	/// <summary> Initializes a new instance of the <see cref="CBias"/> class. </summary>
 	CBias() = default;
+	/// <summary> Copy constructor. Initializes a new instance of the <see cref="CBias"/> class. </summary>
+	CBias(const CBias& obj) { *this = obj; }
+	/// <summary> Move constructor. Initializes a new instance of the <see cref="CBias"/> class without copy of the matrices. </summary>
+	CBias(CBias&& obj) noexcept = default;
 	/// <summary> Finalizes an instance of the <see cref="CBias"/> class. </summary>
 	~CBias() = default;
 
@@ -41,24 +46,51 @@ public:
 	/// <summary> Applies the Bias on 2D vector of Matrix. </summary>
 	/// <param name="in">The input 2D vector of matrix. </param>
 	/// <param name="out">The output 2D vector of matrix. </param>
-	void applyBias(const std::vector<std::vector<Eigen::MatrixXd>>& in, std::vector<std::vector<Eigen::MatrixXd>>& out);
+	void applyBias(const std::vector<std::vector<Eigen::MatrixXd>>& in, std::vector<std::vector<Eigen::MatrixXd>>& out) const;
 	/// <summary> Applies the Bias on vector of Matrix. </summary>
 	/// <param name="in">The input vector of matrix. </param>
 	/// <param name="out">The output vector of matrix. </param>
-	void applyBias(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out);
+	void applyBias(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out) const;
 	/// <summary> Applies the Bias on Matrix. </summary>
 	/// <param name="in">The input matrix. </param>
 	/// <param name="out">The output matrix. </param>
+	/// <remarks> If the inverse square root of the bias is deferred (see <see cref="setDeferred"/>), it is computed for this application only (the object is not modified). </remarks>
+	void applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) const;
+	/// <summary> Applies the Bias on Matrix (the deferred inverse square root of the bias is computed and stored before, see <see cref="setDeferred"/>). </summary>
+	/// <param name="in">The input matrix. </param>
+	/// <param name="out">The output matrix. </param>
 	void applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out);
+	/// <summary> Applies the Bias on Matrix without allocation if the output and the buffers have already the good size (see <see cref="applyBias(const Eigen::MatrixXd&, Eigen::MatrixXd&)"/>). </summary>
+	/// <param name="in">The input matrix. </param>
+	/// <param name="out">The output matrix. </param>
+	/// <param name="buffers">The buffers. </param>
+	void applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out, SSymmetricBuffers& buffers);
 
 	/// <summary> Updates the Bias. </summary>
 	/// <param name="sample">The sample. </param>
 	/// <param name="metric">The metric. </param>
+	/// <remarks>
+	/// With the Riemann metric, the geodesic step uses a factor \f$ F \f$ of the bias \f$ B = F F^{\mathsf{T}} \f$ (given by the eigen decomposition of the bias \f$ B = V D V^{\mathsf{T}} \f$, \f$ F = V D^{1/2} \f$) :
+	/// with \f$ F^{-1} S F^{-\mathsf{T}} = W \operatorname{diag}\left(\mu\right) W^{\mathsf{T}} \f$, the new factor is \f$ F W \operatorname{diag}\left(\mu^{\alpha/2}\right) \f$.
+	/// So the geodesic step is one symmetric eigen solver (instead of Schur decompositions for the square roots, the inverse and the power).\n
+	/// The bias is applied with its symmetric inverse square root, which isn't given by the new factor (only up to a rotation) : the eigen decomposition of the new bias gives the inverse square root and the factor of the next step,
+	/// so the step doesn't compute its own factor. If the update is deferred (see <see cref="setDeferred"/>), this eigen decomposition is made at the next application of the bias
+	/// and the steps between two applications use the factor of the previous step (one eigen solver by update).
+	/// </remarks>
 	void updateBias(const Eigen::MatrixXd& sample, const EMetric metric = EMetric::Riemann);
 
+	/// <summary> Updates the Bias without allocation if the buffers have already the good size (see <see cref="updateBias(const Eigen::MatrixXd&, const EMetric)"/>). </summary>
+	/// <param name="sample">The sample. </param>
+	/// <param name="metric">The metric. </param>
+	/// <param name="buffers">The buffers. </param>
+	void updateBias(const Eigen::MatrixXd& sample, EMetric metric, SSymmetricBuffers& buffers);
+
 	const Eigen::MatrixXd& getBias() const { return m_bias; }	///< Get the bias matrix.
 	void setBias(const Eigen::MatrixXd& bias);					///< Set the bias matrix and the inverse square root of biais.
 
+	bool isDeferred() const { return m_deferred; }				///< Check if the inverse square root of the bias is computed at the next application instead of each update.
+	void setDeferred(const bool deferred) { m_deferred = deferred; }	///< Set if the inverse square root of the bias is computed at the next application instead of each update.
+
 	size_t getClassificationNumber() const { return m_n; }		///< Get the Number of classification (used for update).
 	void setClassificationNumber(const size_t& n) { m_n = n; }	///< Set the Number of classification (used for update).
 
@@ -109,6 +141,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CBias& operator=(CBias&& obj) noexcept = default;
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="CBias"/> are equals. </returns>
@@ -130,12 +167,36 @@ public:
 	}
 
 protected:
+	/// <summary>	Compute the inverse square root of the bias and the factors with the eigen decomposition of the bias. </summary>
+	/// <param name="buffers">	The buffers. </param>
+	void refresh(SSymmetricBuffers& buffers);
+
+	/// <summary>	Compute the inverse square root of a bias with its eigen decomposition. </summary>
+	/// <param name="bias">		The bias. </param>
+	/// <param name="biasIS">	The inverse square root. </param>
+	/// <param name="biasS">	The square root. </param>
+	/// <param name="buffers">	The buffers. </param>
+	static void InverseSqrt(const Eigen::MatrixXd& bias, Eigen::MatrixXd& biasIS, Eigen::MatrixXd& biasS, SSymmetricBuffers& buffers);
+
 	//*********************
 	//***** Variables *****
 	//*********************
-	size_t m_n = 0;				///< Number of classification launched (used for update).
-	Eigen::MatrixXd m_bias;		///< Bias Matrix.
-	Eigen::MatrixXd m_biasIS;	///< Inverse squared root bias matrix (stored and pre-computed for application of bias).
+	size_t m_n = 0;					///< Number of classification launched (used for update).
+	Eigen::MatrixXd m_bias;			///< Bias Matrix.
+	Eigen::MatrixXd m_biasIS;		///< Inverse squared root bias matrix (stored and pre-computed for application of bias).
+	Eigen::MatrixXd m_factor;		///< Factor \f$ F \f$ of the bias with \f$ B = F F^{\mathsf{T}} \f$ (used for the Riemannian update, empty if not computed).
+	Eigen::MatrixXd m_factorInv;	///< Inverse of the factor of the bias.
+	bool m_deferred = false;		///< The inverse square root is computed at the next application instead of each update.
+	bool m_outdated = false;		///< The inverse square root doesn't match the bias (deferred update).
 };
 
+/// <summary>	Applies the bias on the sample then updates the bias with the sample (step of the Rebias classifiers with the bias of the classifier or of a session). </summary>
+/// <param name="sample">	The sample. </param>
+/// <param name="bias">		The bias. </param>
+/// <param name="metric">	The metric of the update. </param>
+/// <param name="unbiased">	The sample after the bias. </param>
+/// <param name="buffers">	The buffers. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> if the sample isn't square or hasn't the size of the bias (the bias isn't modified). </returns>
+bool Unbias(const Eigen::MatrixXd& sample, CBias& bias, EMetric metric, Eigen::MatrixXd& unbiased, SSymmetricBuffers& buffers);
+
 }  // namespace Geometry
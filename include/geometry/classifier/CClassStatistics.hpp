@@ -0,0 +1,115 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CClassStatistics.hpp
+/// \brief Class of running sufficient statistics of one class of feature vectors (used for incremental LSQR).
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <Eigen/Dense>
+#include <vector>
+
+namespace Geometry {
+
+/// <summary> Class of running sufficient statistics of one class of feature vectors. </summary>
+/// <remarks>
+/// With \f$ t \f$ the feature vectors, the class stores the number of vectors and the raw moments
+/// \f$ \sum t_i \f$, \f$ \sum t_i t_j \f$, \f$ \sum t_i^2 t_j \f$ and \f$ \sum t_i^2 t_j^2 \f$.\n
+/// It's enough to compute exactly the standardized Ledoit and Wolf covariance used by <see cref="LSQR" /> without the vectors.
+/// Each update is in \f$ \mathcal{O}(F^2) \f$ whatever the number of vectors already added.
+/// </remarks>
+class CClassStatistics
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Initializes a new instance of the <see cref="CClassStatistics"/> class. </summary>
+	CClassStatistics() = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CClassStatistics"/> class with empty statistics. </summary>
+	/// <param name="nbFeatures">	The number of features. </param>
+	explicit CClassStatistics(const size_t nbFeatures) { reset(nbFeatures); }
+
+	/// <summary>	Finalizes an instance of the <see cref="CClassStatistics"/> class. </summary>
+	~CClassStatistics() = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	size_t getCount() const { return m_n; }										///< Get the number of vectors.
+	size_t getFeaturesCount() const { return size_t(m_sum.size()); }			///< Get the number of features.
+	Eigen::RowVectorXd getMean() const { return m_sum / double(m_n); }			///< Get the Euclidean mean of vectors.
+	const Eigen::RowVectorXd& getSum() const { return m_sum; }					///< Get the sum of vectors.
+	const Eigen::MatrixXd& getScatter() const { return m_scatter; }				///< Get the scatter matrix.
+	const Eigen::MatrixXd& getMoment3() const { return m_moment3; }				///< Get the third order moments.
+	const Eigen::MatrixXd& getMoment4() const { return m_moment4; }				///< Get the fourth order moments.
+
+	/// <summary>	Set the statistics (to restore saved statistics). </summary>
+	/// <param name="count">	The number of vectors. </param>
+	/// <param name="sum">		The sum of vectors. </param>
+	/// <param name="scatter">	The scatter matrix. </param>
+	/// <param name="moment3">	The third order moments. </param>
+	/// <param name="moment4">	The fourth order moments. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise (the matrices must be square with the size of the sum). </returns>
+	bool set(size_t count, const Eigen::RowVectorXd& sum, const Eigen::MatrixXd& scatter, const Eigen::MatrixXd& moment3, const Eigen::MatrixXd& moment4);
+
+	//**********************
+	//***** Statistics *****
+	//**********************
+	/// <summary>	Reset the statistics. </summary>
+	/// <param name="nbFeatures">	The number of features. </param>
+	void reset(size_t nbFeatures);
+
+	/// <summary>	Add a vector to the statistics. </summary>
+	/// <param name="sample">	The vector. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool add(const Eigen::RowVectorXd& sample);
+
+	/// <summary>	Add vectors to the statistics. </summary>
+	/// <param name="samples">	The vectors. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool add(const std::vector<Eigen::RowVectorXd>& samples);
+
+	/// <summary>	Compute the covariance matrix of standardized features with the Ledoit and Wolf estimator and rescale it.\n
+	/// It's the same result as the <see cref="MatrixStandardScaler" />, the <see cref="CovarianceMatrix" /> with <see cref="EEstimator::LWF" /> estimator and the rescale on the vectors.
+	/// </summary>
+	/// <param name="cov">	The covariance matrix. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool covarianceLWF(Eigen::MatrixXd& cov) const;
+
+	//*****************************
+	//***** Override Operator *****
+	//*****************************
+	/// <summary>	Check if object are equals (with a precision tolerance). </summary>
+	/// <param name="obj">			The second object. </param>
+	/// <param name="precision">	Precision for matrix comparison. </param>
+	/// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance), <c>False</c> otherwise. </returns>
+	bool isEqual(const CClassStatistics& obj, double precision = 1e-6) const;
+
+	/// <summary>	Override the equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CClassStatistics"/> are equals. </returns>
+	bool operator==(const CClassStatistics& obj) const { return isEqual(obj); }
+
+	/// <summary>	Override the not equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CClassStatistics"/> are diffrents. </returns>
+	bool operator!=(const CClassStatistics& obj) const { return !isEqual(obj); }
+
+protected:
+	//*********************
+	//***** Variables *****
+	//*********************
+	size_t m_n = 0;				///< Number of vectors.
+	Eigen::RowVectorXd m_sum;	///< Sum of vectors \f$ \sum t_i \f$.
+	Eigen::MatrixXd m_scatter;	///< Scatter matrix \f$ \sum t_i t_j \f$.
+	Eigen::MatrixXd m_moment3;	///< Third order moments \f$ \sum t_i^2 t_j \f$.
+	Eigen::MatrixXd m_moment4;	///< Fourth order moments \f$ \sum t_i^2 t_j^2 \f$.
+};
+
+}  // namespace Geometry
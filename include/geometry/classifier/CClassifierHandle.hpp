@@ -0,0 +1,69 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CClassifierHandle.hpp
+/// \brief Class of handle on the active classifier, to replace a trained classifier during the classification (RCU style).
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "geometry/classifier/IMatrixClassifier.hpp"
+#include <memory>
+#include <atomic>
+
+namespace Geometry {
+
+/// <summary> Class of handle on the active classifier, to replace a trained classifier during the classification (RCU style). </summary>
+/// <remarks>
+/// Each published classifier is an immutable version (<c>std::shared_ptr</c> of const classifier) :
+/// - The writer (for example a background training) publishes a new version with <see cref="publish" />, the current readers keep the previous version.
+/// - A reader takes a version with <see cref="acquire" />, the version is reclaimed when its last reader releases it.
+/// - The number of versions is incremented after each publication, so a reader can check if its version is the last one with one atomic load (see <see cref="CClassifierSession" />).
+/// </remarks>
+class CClassifierHandle
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierHandle"/> class without classifier. </summary>
+	CClassifierHandle() = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierHandle"/> class and publish the first version. </summary>
+	/// <param name="model">	The classifier. </param>
+	explicit CClassifierHandle(const std::shared_ptr<const IMatrixClassifier>& model) { publish(model); }
+
+	/// <summary>	Finalizes an instance of the <see cref="CClassifierHandle"/> class. </summary>
+	~CClassifierHandle() = default;
+
+	CClassifierHandle(const CClassifierHandle&)            = delete;	///< The handle is shared by reference.
+	CClassifierHandle& operator=(const CClassifierHandle&) = delete;	///< The handle is shared by reference.
+
+	//*******************
+	//***** Version *****
+	//*******************
+	/// <summary>	Publish a new version of the classifier. </summary>
+	/// <param name="model">	The classifier (it must not be modified after the publication). </param>
+	/// <returns>	The number of the new version. </returns>
+	size_t publish(const std::shared_ptr<const IMatrixClassifier>& model);
+
+	/// <summary>	Take the current version of the classifier. </summary>
+	/// <returns>	The classifier (<c>nullptr</c> if nothing is published). </returns>
+	std::shared_ptr<const IMatrixClassifier> acquire() const { return std::atomic_load(&m_model); }
+
+	/// <summary>	Get the number of the current version (0 if nothing is published). </summary>
+	/// <returns>	The number of the current version. </returns>
+	size_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+
+protected:
+	//*********************
+	//***** Variables *****
+	//*********************
+	std::shared_ptr<const IMatrixClassifier> m_model;	///< The current version of the classifier.
+	std::atomic<size_t> m_version{ 0 };				///< The number of the current version.
+};
+
+}  // namespace Geometry
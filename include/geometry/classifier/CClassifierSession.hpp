@@ -0,0 +1,105 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CClassifierSession.hpp
+/// \brief Class of classification session : adaptation state of one stream of trials on a shared immutable classifier.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "geometry/classifier/IMatrixClassifier.hpp"
+#include "geometry/classifier/CBias.hpp"
+#include "geometry/classifier/CClassifierHandle.hpp"
+#include <memory>
+
+namespace Geometry {
+
+/// <summary> Class of classification session : adaptation state of one stream of trials on a shared immutable classifier. </summary>
+/// <remarks>
+/// The classifier (model) is never modified by the session, so one model can be shared by several sessions in several threads without lock.\n
+/// The session keeps only the state modified by the adaptation (class means and number of trials for MDM classifiers, bias for Rebias classifiers),
+/// initialized with the model (see <see cref="IMatrixClassifier::initSession" />).
+/// A session must be used by only one thread at a time, it has its own workspace (see <see cref="CClassifierWorkspace" />).
+/// With a <see cref="CClassifierHandle" />, the session checks the version of the handle before each classification (one atomic load) and takes the new version when a model is published.
+/// </remarks>
+class CClassifierSession
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierSession"/> class without model. </summary>
+	CClassifierSession() = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierSession"/> class with the model. </summary>
+	/// <param name="model">	The shared model. </param>
+	explicit CClassifierSession(const std::shared_ptr<const IMatrixClassifier>& model) { setModel(model); }
+
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierSession"/> class which follows the versions published in the handle. </summary>
+	/// <param name="handle">		The handle (it must outlive the session). </param>
+	/// <param name="keepState">	Keep the adaptation state when a new compatible version is published (see <see cref="setModel" />). </param>
+	explicit CClassifierSession(const CClassifierHandle& handle, const bool keepState = true) { setHandle(handle, keepState); }
+
+	/// <summary>	Finalizes an instance of the <see cref="CClassifierSession"/> class. </summary>
+	~CClassifierSession() = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	const std::shared_ptr<const IMatrixClassifier>& getModel() const { return m_model; }	///< Get the shared model.
+
+	/// <summary>	Set the model and initialize the adaptation state with it. </summary>
+	/// <param name="model">		The shared model. </param>
+	/// <param name="keepState">	Keep the number of trials of each class if the model is compatible (same type and number of classes) and the bias if it has also the number of channels of the new means, the means are always taken from the new model. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool setModel(const std::shared_ptr<const IMatrixClassifier>& model, bool keepState = false);
+
+	/// <summary>	Follow the versions published in the handle : before each classification, the session takes the new version if there is one (see <see cref="setModel" />). </summary>
+	/// <param name="handle">		The handle (it must outlive the session). </param>
+	/// <param name="keepState">	Keep the adaptation state when a new compatible version is published. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool setHandle(const CClassifierHandle& handle, bool keepState = true);
+
+	size_t getVersion() const { return m_version; }			///< Get the version of the model in the handle (0 without handle).
+
+	/// <summary>	Reset the adaptation state with the model. </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool reset();
+
+	const std::vector<Eigen::MatrixXd>& getMeans() const { return m_means; }		///< Get the adapted means of classes.
+	std::vector<Eigen::MatrixXd>& getMeans() { return m_means; }					///< Get the adapted means of classes.
+	const std::vector<Eigen::MatrixXd>& getFactors() const { return m_factors; }	///< Get the factors of the adapted means.
+	std::vector<Eigen::MatrixXd>& getFactors() { return m_factors; }				///< Get the factors of the adapted means.
+	const std::vector<size_t>& getTrialNumbers() const { return m_nbTrials; }		///< Get the number of trials of each class.
+	std::vector<size_t>& getTrialNumbers() { return m_nbTrials; }					///< Get the number of trials of each class.
+	const CBias& getBias() const { return m_bias; }									///< Get the bias.
+	CBias& getBias() { return m_bias; }												///< Get the bias.
+	CClassifierWorkspace& getWorkspace() { return m_workspace; }					///< Get the workspace of the classification (the session classifies without allocation after the first trial).
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	/// <summary>	Classify the matrix with the model and the adaptation state of the session (only the session evolves with the adaptation). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max());
+
+protected:
+	//*********************
+	//***** Variables *****
+	//*********************
+	std::shared_ptr<const IMatrixClassifier> m_model;	///< The shared model.
+	const CClassifierHandle* m_handle = nullptr;		///< The handle followed by the session.
+	size_t m_version                  = 0;				///< The version of the model in the handle.
+	bool m_keepState                  = true;			///< Keep the adaptation state when a new version is published in the handle.
+	std::vector<Eigen::MatrixXd> m_means;				///< Adapted Mean Matrix of each class.
+	std::vector<Eigen::MatrixXd> m_factors;				///< Factor of the adapted mean of each class for the distances.
+	std::vector<size_t> m_nbTrials;						///< Number of trials of each class.
+	CBias m_bias;										///< Adapted Bias.
+	CClassifierWorkspace m_workspace;					///< Buffers of the classification.
+};
+
+}  // namespace Geometry
@@ -0,0 +1,88 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CClassifierWorkspace.hpp
+/// \brief Class of classification workspace : buffers of the classification to classify without allocation.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "geometry/Basics.hpp"
+#include <Eigen/Dense>
+
+namespace Geometry {
+
+class IMatrixClassifier;
+
+/// <summary> Class of classification workspace : buffers of the classification to classify without allocation. </summary>
+/// <remarks>
+/// The workspace is sized once for a classifier and a number of channels (see <see cref="IMatrixClassifier::initWorkspace" />),
+/// then the classification with the workspace (see <see cref="IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)" />)
+/// doesn't allocate memory if the distance and probability vectors have also the good size (the buffers are resized if needed, so the first classification can allocate).\n
+/// A workspace must be used by only one thread at a time.
+/// </remarks>
+class CClassifierWorkspace
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierWorkspace"/> class without size. </summary>
+	CClassifierWorkspace() = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CClassifierWorkspace"/> class for the classifier. </summary>
+	/// <param name="classifier">	The classifier. </param>
+	/// <param name="nbChannels">	The number of channels (size of the matrices). </param>
+	CClassifierWorkspace(const IMatrixClassifier& classifier, const size_t nbChannels) { init(classifier, nbChannels); }
+
+	/// <summary>	Finalizes an instance of the <see cref="CClassifierWorkspace"/> class. </summary>
+	~CClassifierWorkspace() = default;
+
+	CClassifierWorkspace(const CClassifierWorkspace&)                = default;	///< Copy the buffers.
+	CClassifierWorkspace(CClassifierWorkspace&&) noexcept            = default;	///< Move the buffers.
+	CClassifierWorkspace& operator=(const CClassifierWorkspace&)     = default;	///< Copy the buffers.
+	CClassifierWorkspace& operator=(CClassifierWorkspace&&) noexcept = default;	///< Move the buffers.
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	/// <summary>	Size the buffers for the classifier (see <see cref="IMatrixClassifier::initWorkspace" />). </summary>
+	/// <param name="classifier">	The classifier. </param>
+	/// <param name="nbChannels">	The number of channels (size of the matrices). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool init(const IMatrixClassifier& classifier, size_t nbChannels);
+
+	/// <summary>	Resize the common buffers. </summary>
+	/// <param name="nbChannels">	The number of channels (size of the matrices). </param>
+	/// <param name="nbClass">		The number of classes. </param>
+	void resize(size_t nbChannels, size_t nbClass);
+
+	size_t getChannelCount() const { return m_nbChannels; }	///< Get the number of channels.
+	size_t getClassCount() const { return m_nbClass; }		///< Get the number of classes.
+
+	//*******************
+	//***** Buffers *****
+	//*******************
+	SSymmetricBuffers symmetric;	///< Buffers of the computations on symmetric matrices (distances, geodesics, tangent space...).
+	Eigen::MatrixXd unbiased;		///< Sample after the bias (Rebias classifiers).
+	Eigen::MatrixXd sample;			///< Sample prepared for the distances (filtered for FgMDM classifiers or unbiased).
+	Eigen::MatrixXd factor;			///< Factor of the sample for the distances (see <see cref="DistanceSampleFactor" />).
+	Eigen::RowVectorXd tangent;		///< Sample in the tangent space.
+	Eigen::RowVectorXd reduced;		///< Sample in the reduced space of the FgDA filter.
+	Eigen::RowVectorXd filtered;	///< Sample filtered in the tangent space.
+	Eigen::VectorXd scores;			///< Score of each class (linear classifiers).
+	Eigen::VectorXd bounds;			///< Lower bound of the distance to each class (pruned MDM classifiers).
+	Eigen::VectorXd kernel;			///< Kernel of the sample with each support vector (kernel classifiers).
+
+protected:
+	//*********************
+	//***** Variables *****
+	//*********************
+	size_t m_nbChannels = 0;		///< Number of channels.
+	size_t m_nbClass    = 0;		///< Number of classes.
+};
+
+}  // namespace Geometry
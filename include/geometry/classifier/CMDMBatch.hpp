@@ -0,0 +1,127 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CMDMBatch.hpp
+/// \brief Class of batched inference of many Minimum Distance to Mean (MDM) classifiers with the same geometry.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "geometry/classifier/CMatrixClassifierMDM.hpp"
+#include "geometry/Basics.hpp"
+
+namespace Geometry {
+
+/// <summary> Class of batched inference of many Minimum Distance to Mean (MDM) classifiers with the same geometry (metric and number of channels). </summary>
+/// <remarks>
+/// The class means of all models are packed in one contiguous storage with the factors used by the distances (see <see cref="DistanceReferenceFactor" />),
+/// the models can have different numbers of classes. For each model \f$ u \f$ with \f$ K_u \f$ classes and its sample \f$ S_u \f$ :
+/// - Riemann and Wasserstein metrics : with the Cholesky factor of the sample \f$ S_u = L L^{\mathsf{T}} \f$, the products with the factors of all classes are computed with one matrix product
+/// \f$ [M_1 \dots M_{K_u}] = L^{\mathsf{T}} \times [F_1 \dots F_{K_u}] \f$, then the eigen values of the small symmetric matrices \f$ M_k^{\mathsf{T}} M_k = F_k^{\mathsf{T}} S_u F_k \f$
+/// of the models of a chunk (about 16 classes) are computed together without the eigen vectors (see <see cref="SelfAdjointEigenValues" />), so the groups of interleaved iterations span the models.
+/// - Euclidian and Log-Euclidian metrics : the distances to all classes are the norms of the columns of one expression \f$ [F_1 \dots F_{K_u}] - S_u \f$ (with the logarithm of the sample for Log-Euclidian metric).
+/// - Other metrics : the distances are computed with the packed means (see <see cref="Distance" />).
+///
+/// The models are classified in parallel by contiguous blocks with the threads of the batch (see <see cref="CThreadPool" />), each thread has its own buffers.
+/// The threads are shared by the calls : one batch must not classify in several threads at the same time.
+/// The models are copied in the batch : after an adaptation of a model, the batch must be updated with <see cref="setModel" />.
+/// </remarks>
+class CMDMBatch
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Initializes a new instance of the <see cref="CMDMBatch"/> class without model. </summary>
+	CMDMBatch() = default;
+
+	/// <summary>	Finalizes an instance of the <see cref="CMDMBatch"/> class. </summary>
+	~CMDMBatch() = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	size_t getModelCount() const { return m_offsets.size() - 1; }					///< Get the number of models.
+	size_t getClassCount(const size_t index) const { return m_offsets[index + 1] - m_offsets[index]; }	///< Get the number of classes of the model.
+	size_t getChannelCount() const { return m_nbChannels; }							///< Get the number of channels (size of the matrices).
+	EMetric getMetric() const { return m_metric; }									///< Get the metric used to compute the distances.
+
+	/// <summary>	Add a model in the batch, the first model gives the metric and the number of channels. </summary>
+	/// <param name="model">	The trained MDM classifier (only the base <see cref="CMatrixClassifierMDM" /> classifier, without filter or bias). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise (other metric or number of channels than the batch). </returns>
+	bool addModel(const CMatrixClassifierMDM& model);
+
+	/// <summary>	Update the means of a model in the batch (after an adaptation for example). </summary>
+	/// <param name="index">	The index of the model in the batch. </param>
+	/// <param name="model">	The model (same metric, number of channels and number of classes). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool setModel(size_t index, const CMatrixClassifierMDM& model);
+
+	/// <summary>	Remove all models. </summary>
+	void clear();
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	/// <summary>	Classify one sample by model (same result as <see cref="CMatrixClassifierMDM::predict" /> of each model). </summary>
+	/// <param name="samples">			The sample of each model. </param>
+	/// <param name="classIds">			The predicted class of each model. </param>
+	/// <param name="distances">		The distances of the sample with each class of the model. </param>
+	/// <param name="probabilities">	The probabilities of the sample with each class of the model. </param>
+	/// <param name="nbThreads">		The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, std::vector<std::vector<double>>& distances,
+				  std::vector<std::vector<double>>& probabilities, size_t nbThreads = 0) const;
+
+protected:
+	/// <summary>	Buffers of one thread. </summary>
+	struct SBuffers
+	{
+		Eigen::MatrixXd cholesky;		///< Cholesky factor of the sample (lower part).
+		Eigen::MatrixXd products;		///< Products of the sample with the factors of all classes of one model.
+		Eigen::MatrixXd matrices;		///< Symmetric matrices of all classes of a chunk of models packed by columns.
+		Eigen::MatrixXd values;			///< Eigen values of the symmetric matrices by column.
+		Eigen::MatrixXd eigen;			///< Buffer of the eigen values (see <see cref="SelfAdjointEigenValues" />).
+		Eigen::MatrixXd factor;			///< Factor of the sample (see <see cref="DistanceSampleFactor" />).
+		SSymmetricBuffers symmetric;	///< Buffers of the sample factor.
+		size_t first = 0;				///< Index of the class of the first column of the eigen values.
+	};
+
+	/// <summary>	Compute the factor and the trace of each class of the model in the packed storage. </summary>
+	/// <param name="index">	The index of the model in the batch. </param>
+	/// <param name="model">	The model. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool pack(size_t index, const CMatrixClassifierMDM& model);
+
+	/// <summary>	Compute the eigen values of the symmetric matrices of all classes of a chunk of models (Riemann and Wasserstein metrics). </summary>
+	/// <param name="begin">	The index of the first model of the chunk. </param>
+	/// <param name="end">		The index of the last model of the chunk (excluded). </param>
+	/// <param name="samples">	The sample of each model. </param>
+	/// <param name="buffers">	The buffers of the thread (the eigen values are in <c>values</c> from the class <c>first</c>). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool computeEigenValues(size_t begin, size_t end, const std::vector<Eigen::MatrixXd>& samples, SBuffers& buffers) const;
+
+	/// <summary>	Compute the distances of the sample with each class of the model. </summary>
+	/// <param name="index">	The index of the model in the batch. </param>
+	/// <param name="sample">	The sample. </param>
+	/// <param name="distance">	The distance of the sample with each class. </param>
+	/// <param name="buffers">	The buffers of the thread (with the eigen values of the chunk for Riemann and Wasserstein metrics). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool computeDistances(size_t index, const Eigen::MatrixXd& sample, std::vector<double>& distance, SBuffers& buffers) const;
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	EMetric m_metric    = EMetric::Riemann;			///< Metric of the models.
+	size_t m_nbChannels = 0;						///< Number of channels of the models.
+	std::vector<size_t> m_offsets = { 0 };			///< Index of the first class of each model in the packed storage (and the total number of classes at the end).
+	Eigen::MatrixXd m_means;						///< Means of all classes packed by columns (\f$ N \times (C N) \f$ with \f$ C \f$ the total number of classes).
+	Eigen::MatrixXd m_factors;						///< Factors of all means packed by columns (transposed inverse Cholesky factor for Riemann metric, square root for Wasserstein metric, logarithm for Log-Euclidian metric).
+	Eigen::VectorXd m_traces;						///< Trace of all means (Wasserstein metric).
+	mutable CThreadPool m_pool;						///< Threads of the batch (created at the first classification and kept between the calls).
+};
+
+}  // namespace Geometry
@@ -30,6 +30,10 @@ public:
 	/// <param name="obj">	Initial object. </param>
 	CMatrixClassifierFgMDM(const CMatrixClassifierFgMDM& obj) { *this = obj; }
 
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierFgMDM"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierFgMDM(CMatrixClassifierFgMDM&& obj) noexcept = default;
+
 	/// <summary>	Copy constructor with parent class. Initializes a new instance of the <see cref="CMatrixClassifierFgMDM"/> class. </summary>
 	/// <param name="obj">	Initial object. </param>
 	explicit CMatrixClassifierFgMDM(const CMatrixClassifierFgMDMRT& obj) { copy(obj); }
@@ -40,14 +44,30 @@ public:
 	explicit CMatrixClassifierFgMDM(const size_t nbClass, const EMetric metric) : CMatrixClassifierFgMDMRT(nbClass, metric) { }
 
 	/// <summary>	Finalizes an instance of the <see cref="CMatrixClassifierFgMDM"/> class. </summary>
-	/// <remarks>	clear the <see cref="m_means"/> vector of Matrix and the <see cref="m_datasets"/> member. </remarks>
+	/// <remarks>	clear the <see cref="m_statistics"/> member. </remarks>
 	~CMatrixClassifierFgMDM() override;
 
 	//***************************
 	//***** Getter / Setter *****
 	//***************************
-	void setDatasets(const std::vector<std::vector<Eigen::MatrixXd>>& datasets) { m_datasets = datasets; }	///< Set Datasets.
-	const std::vector<std::vector<Eigen::MatrixXd>>& getDatasets() const { return m_datasets; }				///< Get Datasets.
+	/// <summary>	Set Datasets (the statistics are computed again at the next adaptation). </summary>
+	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
+	void setDatasets(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
+	{
+		m_datasets.set(datasets);
+		m_statistics = CCopyOnWrite<std::vector<CClassStatistics>>();
+	}
+	const std::vector<std::vector<Eigen::MatrixXd>>& getDatasets() const { return m_datasets.get(); }				///< Get Datasets.
+
+	const std::vector<CClassStatistics>& getStatistics() const { return m_statistics.get(); }	///< Get the sufficient statistics of each class in the Tangent Space.
+	const Eigen::MatrixXd& getDrift() const { return m_drift; }									///< Get the running Riemannian mean of all trials (drift of the reference).
+
+	size_t getAnchorPeriod() const { return m_anchorPeriod; }					///< Get the number of adapted trials between two exact re-anchoring (0 for never).
+	void setAnchorPeriod(const size_t period) { m_anchorPeriod = period; }		///< Set the number of adapted trials between two exact re-anchoring (0 for never).
+	size_t getMemoryCap() const { return m_memoryCap; }							///< Get the maximum number of trials kept by class for re-anchoring (0 for no limit).
+	void setMemoryCap(const size_t cap) { m_memoryCap = cap; }					///< Set the maximum number of trials kept by class for re-anchoring (0 for no limit).
+	size_t getFilterPeriod() const { return m_filterPeriod; }					///< Get the number of adapted trials between two computations of the FgDA Weight (0 or 1 for each trial).
+	void setFilterPeriod(const size_t period) { m_filterPeriod = period; }		///< Set the number of adapted trials between two computations of the FgDA Weight (0 or 1 for each trial).
 
 	//**********************
 	//***** Classifier *****
@@ -71,15 +91,53 @@ public:
 	/// -# Return to the original Manifold.\n
 	/// -# Apply the classify function of MDM Classifier (see <see cref="CMatrixClassifierMDM::classify"/>)
 	///	</summary>
-	/// <remarks>	The classifier is train with the new sample. </remarks>
+	/// <remarks>
+	/// The adaptation is incremental, the cost by trial doesn't depend on the number of trials already classified :
+	/// -# The sample (in the Tangent Space of the current reference) is added to the sufficient statistics of its class (<see cref="CClassStatistics" />).
+	/// -# The drift of the reference (Riemannian mean of all trials) is updated with a geodesic step.
+	/// -# Every filter period (see <see cref="setFilterPeriod"/>), the FgDA Weight is computed from the statistics (same result as <see cref="FgDACompute" /> on all the vectors)
+	/// and the class means are the filtered Euclidean means of the vectors in the Tangent Space returned to the original Manifold.
+	/// -# Between two computations of the FgDA Weight, only the mean of the adapted class is filtered again with the current Weight.
+	///
+	/// With \f$ F = N(N+1)/2 \f$ the number of features of the Tangent Space (\f$ N \f$ the number of channels), the statistics are updated in \f$ \mathcal{O}(F^2) \f$
+	/// and the class means in \f$ \mathcal{O}(N^3 + FK) \f$ for each trial. The computation of the FgDA Weight is in \f$ \mathcal{O}(F^3) \f$ :
+	/// the pooled Ledoit and Wolf covariance changes entirely with each trial (standardization and shrinkage), so its QR factorization can't be updated by rank one steps.
+	/// The default period (1) keeps the exact filter of the statistics after each trial.\n
+	/// The class means are an approximation of the training : the training uses the mean of the filtered trials with the metric of the classifier,
+	/// the adaptation the Euclidean mean in the Tangent Space of the reference, and the reference stays fixed until the next re-anchoring (the drift is only used by the re-anchoring).
+	///
+	/// If the anchor period isn't 0, the trials are kept (at most the memory cap by class) and the classifier is retrained exactly every period :
+	/// the reference is the Riemannian mean of the kept trials if there is no memory cap, the drift otherwise.\n
+	/// If the statistics are unavailable, they are computed with an exact retrain on the datasets (see <see cref="setDatasets"/>),
+	/// without datasets (classifier loaded from a file without statistics) only the MDM part evolves (see <see cref="CMatrixClassifierFgMDMRT::classify"/>).
+	/// </remarks>
 	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
 	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
 				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+	using CMatrixClassifierFgMDMRT::classify;
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (see <see cref="classify"/>). </summary>
+	/// <remarks>	Without allocation only if the filter doesn't evolve (no adaptation, or only the MDM part without statistics and datasets), the adaptation of the filter retrains the statistics. </remarks>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Supervised adaptation with a block of labelled trials. </summary>
+	/// <param name="samples">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	The filter evolves with each trial, so the trials are added one by one as with the supervised adaptation of <see cref="classify"/> (incremental cost). </remarks>
+	bool adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels) override;
 
 
 	//*****************************
 	//***** Override Operator *****
 	//*****************************
+	using CMatrixClassifierFgMDMRT::copy;
+
+	/// <summary>	Copy object value. </summary>
+	/// <param name="obj">	The object to copy. </param>
+	void copy(const CMatrixClassifierFgMDM& obj);
 
 	/// <summary>	Get the type of the classifier. </summary>
 	/// <returns>	Minimum Distance to Mean with geodesic filtering (FgMDM). </returns>
@@ -94,6 +152,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierFgMDM& operator=(CMatrixClassifierFgMDM&& obj) noexcept = default;
+
 	/// <summary>	Override the ostream operator. </summary>
 	/// <param name="os">	The ostream. </param>
 	/// <param name="obj">	The object. </param>
@@ -106,12 +169,42 @@ public:
 
 protected:
 	///<summary> train with the actual datasets (<see cref="m_datasets"/>). </summary>
-	bool train() { return CMatrixClassifierFgMDMRT::train(m_datasets); }
+	bool train();
+
+	///<summary> train with the actual datasets (<see cref="m_datasets"/>) and the current reference and update the statistics. </summary>
+	bool trainWithReference();
+
+	///<summary> Update the FgDA Weight and the class means with the statistics (one \f$ F \times F \f$ QR factorization, see <see cref="classify"/>). </summary>
+	bool updateWithStatistics();
+
+	///<summary> Update the mean of one class with its statistics and the current FgDA Weight. </summary>
+	bool updateClassMean(size_t k);
+
+	//***********************
+	//***** XML Manager *****
+	//***********************
+	/// <summary>	Save Additionnal informations (Reference, LDA Weight, statistics and drift). </summary>
+	/// <remarks>	The statistics are saved to continue the incremental adaptation after a reload (four \f$ F \times F \f$ matrices by class). </remarks>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
+
+	/// <summary>	Load Additionnal informations (Reference, LDA Weight, statistics and drift). </summary>
+	/// <remarks>	Without statistics (older files or files of <see cref="CMatrixClassifierFgMDMRT" />), only the MDM part evolves (see <see cref="classify"/>). </remarks>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadAdditional(tinyxml2::XMLElement* data) override;
 
 	//*********************
 	//***** Variables *****
 	//*********************
-	std::vector<std::vector<Eigen::MatrixXd>> m_datasets;	///< Data set for train and adaptation (it can quickly rise).
+	CCopyOnWrite<std::vector<std::vector<Eigen::MatrixXd>>> m_datasets;	///< Data set for train and re-anchoring (limited by the memory cap, shared by the copies).
+	CCopyOnWrite<std::vector<CClassStatistics>> m_statistics;	///< Sufficient statistics of each class in the Tangent Space of the reference (shared by the copies until an adaptation).
+	Eigen::MatrixXd m_drift;								///< Running Riemannian mean of all trials.
+	size_t m_nbDrift       = 0;								///< Number of trials in the running Riemannian mean.
+	size_t m_anchorPeriod  = 0;								///< Number of adapted trials between two exact re-anchoring (0 for never).
+	size_t m_memoryCap     = 0;								///< Maximum number of trials kept by class for re-anchoring (0 for no limit).
+	size_t m_nbSinceAnchor = 0;								///< Number of adapted trials since the last re-anchoring.
+	size_t m_filterPeriod  = 1;								///< Number of adapted trials between two computations of the FgDA Weight.
+	size_t m_nbSinceFilter = 0;								///< Number of adapted trials since the last computation of the FgDA Weight.
 };
 
 }  // namespace Geometry
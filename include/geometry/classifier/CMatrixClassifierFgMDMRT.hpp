@@ -12,6 +12,7 @@
 #pragma once
 
 #include "geometry/classifier/CMatrixClassifierMDM.hpp"
+#include "geometry/Classification.hpp"
 
 namespace Geometry {
 
@@ -30,6 +31,10 @@ public:
 	/// <param name="obj">	Initial object. </param>
 	CMatrixClassifierFgMDMRT(const CMatrixClassifierFgMDMRT& obj) { *this = obj; }
 
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierFgMDMRT"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierFgMDMRT(CMatrixClassifierFgMDMRT&& obj) noexcept = default;
+
 	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierFgMDMRT"/> class and set base members. </summary>
 	/// <param name="nbClass">	The number of classes. </param>
 	/// <param name="metric">	Metric to use to calculate means (see also <see cref="EMetric" />). </param>
@@ -42,11 +47,23 @@ public:
 	//***************************
 	//***** Getter / Setter *****
 	//***************************
-	const Eigen::MatrixXd& getRef() const { return m_ref; }					///< Get reference of tangent space. 	
-	void setRef(const Eigen::MatrixXd& ref) { m_ref = ref; }				///< Set reference of tangent space. 
+	const Eigen::MatrixXd& getRef() const { return m_ref.get(); }					///< Get reference of tangent space. 	
+	void setRef(const Eigen::MatrixXd& ref);								///< Set reference of tangent space. 
+
+	Eigen::MatrixXd getWeight() const { return m_weightU.get() * m_weightV->transpose(); }	///< Get dense weight matrix of geodesic filter (\f$ U \times V^{\mathsf{T}} \f$). 
+	void setWeight(const Eigen::MatrixXd& weight) { FgDAFactorize(weight, m_weightU.replace(), m_weightV.replace()); }	///< Set dense weight matrix of geodesic filter (stored as a factor pair). 
+
+	const Eigen::MatrixXd& getWeightU() const { return m_weightU.get(); }		///< Get left factor of the weight matrix of geodesic filter. 
+	const Eigen::MatrixXd& getWeightV() const { return m_weightV.get(); }		///< Get right factor of the weight matrix of geodesic filter. 
 
-	const Eigen::MatrixXd& getWeight() const { return m_weight; }			 ///< Get weight matrix of geodesic filter. 
-	void setWeight(const Eigen::MatrixXd& weight) { m_weight = weight; }	 ///< Set weight matrix of geodesic filter. 
+	/// <summary>	Set weight matrix of geodesic filter as a factor pair \f$ U \times V^{\mathsf{T}} \f$. </summary>
+	/// <param name="u">	The left factor (\f$ F \times K \f$). </param>
+	/// <param name="v">	The right factor (\f$ F \times K \f$). </param>
+	void setWeight(const Eigen::MatrixXd& u, const Eigen::MatrixXd& v)
+	{
+		m_weightU.set(u);
+		m_weightV.set(v);
+	}
 
 	//**********************
 	//***** Classifier *****
@@ -77,6 +94,31 @@ public:
 	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
 	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
 				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+	using CMatrixClassifierMDM::classify;
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (filtered sample and MDM classification, see <see cref="classify"/>). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Size the buffers of the workspace (with the buffers of the filter). </summary>
+	/// \copydetails IMatrixClassifier::initWorkspace(CClassifierWorkspace&, size_t) const
+	bool initWorkspace(CClassifierWorkspace& workspace, size_t nbChannels) const override;
+
+	/// <summary>	Classify the matrix without adaptation (filtered sample and MDM classification). </summary>
+	/// \copydetails IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	/// <summary>	Classify the matrix with the adaptation state of the session (filtered sample and MDM classification with the means of the session, the filter doesn't evolve). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierSession&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&) const
+	bool classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) const override;
+
+	/// <summary>	Supervised adaptation with a block of labelled trials : the trials are filtered and the MDM part is adapted (see <see cref="CMatrixClassifierMDM::adapt"/>). </summary>
+	/// <param name="samples">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels) override;
 
 
 	//*****************************
@@ -105,6 +147,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierFgMDMRT& operator=(CMatrixClassifierFgMDMRT&& obj) noexcept = default;
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierFgMDMRT"/> are equals. </returns>
@@ -126,14 +173,42 @@ public:
 	}
 
 protected:
+	/// <summary>	Transform the sample to the Tangent Space, apply the FgDA weight and return to the original Manifold. </summary>
+	/// <param name="sample">	The sample. </param>
+	/// <param name="filtered">	The filtered sample. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool filter(const Eigen::MatrixXd& sample, Eigen::MatrixXd& filtered) const;
+
+	/// <summary>	Filter the sample with the buffers of the workspace and the square roots of the reference (see <see cref="updateReference"/>). </summary>
+	/// <param name="sample">		The sample. </param>
+	/// <param name="filtered">		The filtered sample (it can't be the sample). </param>
+	/// <param name="workspace">	The workspace. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool filter(const Eigen::MatrixXd& sample, Eigen::MatrixXd& filtered, CClassifierWorkspace& workspace) const;
+
+	/// <summary>	Compute the square root and the inverse square root of the reference (<see cref="m_refS"/> and <see cref="m_refIS"/>), called when the reference changes. </summary>
+	void updateReference();
+
+	/// <summary>	Transform the samples to the Tangent Space, apply the FgDA weight and return to the original Manifold (in parallel). </summary>
+	/// \copydetails CMatrixClassifierMDM::prepareSamples
+	bool prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, size_t nbThreads) override;
+
+	/// <summary>	Train the classifier with the dataset and the current reference (<see cref="m_ref"/> is not computed). </summary>
+	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
+	/// <param name="tsSample">	The dataset transformed in the Tangent Space (one class by row and trials on colums). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool trainWithReference(const std::vector<std::vector<Eigen::MatrixXd>>& datasets, std::vector<std::vector<Eigen::RowVectorXd>>& tsSample);
+
 	//***********************
 	//***** XML Manager *****
 	//***********************
 	/// <summary>	Save Additionnal informations (Reference and LDA Weight). </summary>
+	/// <remarks>	The LDA Weight is saved as the two factors (<c>Weight-U</c> and <c>Weight-V</c> nodes). </remarks>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
 
 	/// <summary>	Load Additionnal informations (Reference and LDA Weight). </summary>
+	/// <remarks>	A dense LDA Weight (<c>Weight</c> node of older files) is factorized with <see cref="FgDAFactorize" />. </remarks>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 	bool loadAdditional(tinyxml2::XMLElement* data) override;
 
@@ -144,8 +219,11 @@ protected:
 	//*********************
 	//***** Variables *****
 	//*********************
-	Eigen::MatrixXd m_ref;		///< Reference matrix of tanget space.
-	Eigen::MatrixXd m_weight;	///< Weght matrix of Filter Geodesic Discriminant Analysis.
+	CCopyOnWrite<Eigen::MatrixXd> m_ref;		///< Reference matrix of tanget space (shared by the copies).
+	CCopyOnWrite<Eigen::MatrixXd> m_refS;		///< Square root of the reference matrix (empty if the reference isn't SPD).
+	CCopyOnWrite<Eigen::MatrixXd> m_refIS;		///< Inverse square root of the reference matrix (empty if the reference isn't SPD).
+	CCopyOnWrite<Eigen::MatrixXd> m_weightU;	///< Left factor of the Weight matrix of Filter Geodesic Discriminant Analysis (\f$ F \times K \f$).
+	CCopyOnWrite<Eigen::MatrixXd> m_weightV;	///< Right factor of the Weight matrix of Filter Geodesic Discriminant Analysis (\f$ F \times K \f$).
 };
 
 }  // namespace Geometry
@@ -0,0 +1,276 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CMatrixClassifierKNN.hpp
+/// \brief Class of k-Nearest Neighbours (kNN) Classifier with a vantage point tree.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+/// \remarks Inspired by the work of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>) KNearestNeighbor.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "geometry/classifier/IMatrixClassifier.hpp"
+#include "geometry/Basics.hpp"
+
+namespace Geometry {
+
+/// <summary>	Class of k-Nearest Neighbours (kNN) Classifier : the trials of the training are kept and the sample is classified with its nearest trials. </summary>
+/// <remarks>
+/// The trials are indexed in a vantage point tree : each node is a trial (the pivot) and splits the other trials of its subtree
+/// in the trials closer than the median distance to the pivot (inside) and the others (outside).
+/// Each node keeps the range of the distances of each subtree to its pivot, so with the triangle inequality a subtree is skipped
+/// when \f$ \max\left(d_\text{min} - \delta(S, P),\ \delta(S, P) - d_\text{max}\right) \f$ is greater than the distance of the k-th neighbour found.
+/// The search is exact (same neighbours as the exhaustive search), so the metric must be a true metric (see <see cref="isMetricSupported"/>).\n
+/// The factor of each trial is computed once (see <see cref="DistanceReferenceFactor"/>), a query costs one factor of the sample and one factorized distance by visited node.\n
+/// The probabilities are the sum of the weights \f$ \frac{e^{-d_i^2}}{\sum_j e^{-d_j^2}} \f$ of the neighbours of each class, the predicted class has the highest probability.
+/// The distance of a class is the distance of its nearest neighbour (infinity if the class has no neighbour in the k nearest trials).\n
+/// With adaptation, the sample is inserted in the tree with the expected class (supervised) or the predicted class (unsupervised) without rebuild of the tree.
+/// </remarks>
+/// <seealso cref="IMatrixClassifier" />
+class CMatrixClassifierKNN : public IMatrixClassifier
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Default constructor. Initializes a new instance of the <see cref="CMatrixClassifierKNN"/> class. </summary>
+	CMatrixClassifierKNN() = default;
+
+	/// <summary>	Default Copy constructor. Initializes a new instance of the <see cref="CMatrixClassifierKNN"/> class. </summary>
+	/// <param name="obj">	Initial object. </param>
+	CMatrixClassifierKNN(const CMatrixClassifierKNN& obj) { *this = obj; }
+
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierKNN"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierKNN(CMatrixClassifierKNN&& obj) noexcept = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierKNN"/> class and set base members. </summary>
+	/// <param name="nbClass">		The number of classes. </param>
+	/// <param name="metric">		Metric to use to calculate distances (see also <see cref="EMetric" /> and <see cref="isMetricSupported" />). </param>
+	/// <param name="nbNeighbors">	The number of neighbours. </param>
+	explicit CMatrixClassifierKNN(const size_t nbClass, const EMetric metric = EMetric::Riemann, const size_t nbNeighbors = 5)
+		: IMatrixClassifier(nbClass, metric), m_nbNeighbors(nbNeighbors) { }
+
+	/// <summary>	Finalizes an instance of the <see cref="CMatrixClassifierKNN"/> class. </summary>
+	~CMatrixClassifierKNN() override = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	size_t getNeighborCount() const { return m_nbNeighbors; }							///< Get the number of neighbours.
+	void setNeighborCount(const size_t nbNeighbors) { m_nbNeighbors = nbNeighbors; }	///< Set the number of neighbours.
+	size_t getTrialCount() const { return m_index->trials.size(); }					///< Get the number of trials in the tree.
+	const std::vector<Eigen::MatrixXd>& getTrials() const { return m_index->trials; }	///< Get the trials of the tree.
+	const std::vector<size_t>& getLabels() const { return m_index->labels; }			///< Get the class of each trial.
+
+	/// <summary>	Check if the metric is a true metric (triangle inequality), needed by the exact search in the tree. </summary>
+	/// <param name="metric">	The metric. </param>
+	/// <returns>	<c>True</c> for the Riemann, Euclidian, Log-Euclidian, Log-Det and Wasserstein metrics. </returns>
+	static bool isMetricSupported(const EMetric metric)
+	{
+		return metric == EMetric::Riemann || metric == EMetric::Euclidian || metric == EMetric::LogEuclidian || metric == EMetric::LogDet || metric == EMetric::Wasserstein;
+	}
+
+	/// <summary>	Set the trials and build the tree. </summary>
+	/// <param name="trials">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool setTrials(const std::vector<Eigen::MatrixXd>& trials, const std::vector<size_t>& labels);
+
+	/// <summary>	Insert a trial in the tree (without rebuild of the tree). </summary>
+	/// <param name="trial">	The trial. </param>
+	/// <param name="label">	The class of the trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool insert(const Eigen::MatrixXd& trial, size_t label);
+
+	/// <summary>	Find the nearest trials of the sample in the tree (same result as the exhaustive search). </summary>
+	/// <param name="sample">		The sample. </param>
+	/// <param name="nbNeighbors">	The number of neighbours. </param>
+	/// <param name="indexes">		The index of the neighbours in the trials sorted by increasing distance. </param>
+	/// <param name="distances">	The distance of each neighbour. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	This function is thread safe. </remarks>
+	bool findNeighbors(const Eigen::MatrixXd& sample, size_t nbNeighbors, std::vector<size_t>& indexes, std::vector<double>& distances) const;
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	/// <summary>	Train the classifier with the dataset : keep all trials with their class and build the tree. </summary>
+	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise (metric not supported, see <see cref="isMetricSupported"/>). </returns>
+	bool train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets) override;
+
+	/// <summary>	Classify the matrix with its nearest trials and return the class id, the distance and the probability of each class.\n
+	/// With the Supervised or Unsupervised adaptation, the sample is inserted in the tree with the expected or the predicted class.
+	///	</summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+	using IMatrixClassifier::classify;
+
+	/// \copydoc IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	//*****************************
+	//***** Override Operator *****
+	//*****************************
+	/// <summary>	Check if object are equals (with a precision tolerance). </summary>
+	/// <param name="obj">			The second object. </param>
+	/// <param name="precision">	Precision for matrix comparison. </param>
+	/// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance). </returns>
+	bool isEqual(const CMatrixClassifierKNN& obj, double precision = 1e-6) const;
+
+	/// <summary>	Copy object value. </summary>
+	/// <param name="obj">	The object to copy. </param>
+	void copy(const CMatrixClassifierKNN& obj);
+
+	/// <summary>	Get the type of the classifier. </summary>
+	/// <returns>	k-Nearest Neighbours (kNN). </returns>
+	std::string getType() const override { return toString(EMatrixClassifiers::KNN); }
+
+	/// <summary>	Override the affectation operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	The copied object. </returns>
+	CMatrixClassifierKNN& operator=(const CMatrixClassifierKNN& obj)
+	{
+		copy(obj);
+		return *this;
+	}
+
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierKNN& operator=(CMatrixClassifierKNN&& obj) noexcept = default;
+
+	/// <summary>	Override the equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierKNN"/> are equals. </returns>
+	bool operator==(const CMatrixClassifierKNN& obj) const { return isEqual(obj); }
+
+	/// <summary>	Override the not equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierKNN"/> are diffrents. </returns>
+	bool operator!=(const CMatrixClassifierKNN& obj) const { return !isEqual(obj); }
+
+	/// <summary>	Override the ostream operator. </summary>
+	/// <param name="os">	The ostream. </param>
+	/// <param name="obj">	The object. </param>
+	/// <returns>	Return the modified ostream. </returns>
+	friend std::ostream& operator <<(std::ostream& os, const CMatrixClassifierKNN& obj)
+	{
+		os << obj.print().str();
+		return os;
+	}
+
+protected:
+	static const size_t NO_NODE = std::numeric_limits<size_t>::max();	///< Index of a missing subtree.
+
+	/// <summary>	Node of the vantage point tree. </summary>
+	struct SNode
+	{
+		size_t pivot      = 0;			///< Index of the trial used as pivot.
+		double threshold  = 0;			///< The trials closer than the threshold to the pivot are inside, the others outside.
+		size_t inside     = NO_NODE;	///< Index of the inside subtree.
+		size_t outside    = NO_NODE;	///< Index of the outside subtree.
+		double insideMin  = std::numeric_limits<double>::infinity();	///< Minimum distance of the inside subtree to the pivot.
+		double insideMax  = 0;			///< Maximum distance of the inside subtree to the pivot.
+		double outsideMin = std::numeric_limits<double>::infinity();	///< Minimum distance of the outside subtree to the pivot.
+		double outsideMax = 0;			///< Maximum distance of the outside subtree to the pivot.
+	};
+
+	/// <summary>	Trials and tree (shared by the copies until one is modified). </summary>
+	struct SIndex
+	{
+		std::vector<Eigen::MatrixXd> trials;	///< The trials.
+		std::vector<size_t> labels;				///< The class of each trial.
+		std::vector<Eigen::MatrixXd> factors;	///< The reference factor of each trial (see <see cref="DistanceReferenceFactor"/>).
+		std::vector<Eigen::MatrixXd> samples;	///< The sample factor of each trial used to build the tree (see <see cref="DistanceSampleFactor"/>).
+		std::vector<SNode> nodes;				///< The nodes of the tree (the root is the first node).
+	};
+
+	/// <summary>	Check the trials and compute their factors, the tree isn't built (see <see cref="buildTree"/>). </summary>
+	/// <param name="index">	The trials and the tree (the tree is empty). </param>
+	/// <param name="trials">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <param name="buffers">	The buffers of the factors. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool computeFactors(SIndex& index, const std::vector<Eigen::MatrixXd>& trials, const std::vector<size_t>& labels, SSymmetricBuffers& buffers) const;
+
+	/// <summary>	Build the tree with all the trials of the index. </summary>
+	/// <param name="index">	The trials and the tree. </param>
+	/// <param name="buffers">	The buffers of the distances. </param>
+	void buildTree(SIndex& index, SSymmetricBuffers& buffers) const;
+
+	/// <summary>	Check if the nodes are a tree of the trials : each node is reached exactly once from the root and each trial is the pivot of one node. </summary>
+	/// <param name="nodes">		The nodes (the root is the first node). </param>
+	/// <param name="nbTrials">	The number of trials. </param>
+	/// <returns>	<c>True</c> if the nodes are a tree, <c>False</c> otherwise (cycle, shared subtree, unreachable node or index out of range). </returns>
+	static bool isTree(const std::vector<SNode>& nodes, size_t nbTrials);
+
+	/// <summary>	Build the subtree with the trials of the range (the first node of the subtree is added at the end of the nodes). </summary>
+	/// <param name="index">		The trials and the tree. </param>
+	/// <param name="indexes">		The index of the trials (reordered). </param>
+	/// <param name="begin">		The first index of the range. </param>
+	/// <param name="end">			The last index of the range (excluded). </param>
+	/// <param name="distances">	Buffer of the distances of each trial to the pivot. </param>
+	/// <param name="buffers">		The buffers of the distances. </param>
+	/// <returns>	The index of the root of the subtree. </returns>
+	size_t build(SIndex& index, std::vector<size_t>& indexes, size_t begin, size_t end, std::vector<double>& distances, SSymmetricBuffers& buffers) const;
+
+	/// <summary>	Compute the distance of a matrix to the pivot of the node. </summary>
+	/// <param name="index">	The trials and the tree. </param>
+	/// <param name="matrix">	The matrix. </param>
+	/// <param name="factor">	The sample factor of the matrix (see <see cref="DistanceSampleFactor"/>). </param>
+	/// <param name="node">		The node. </param>
+	/// <param name="buffers">	The buffers of the distances. </param>
+	/// <returns>	The distance. </returns>
+	double distance(const SIndex& index, const Eigen::MatrixXd& matrix, const Eigen::MatrixXd& factor, size_t node, SSymmetricBuffers& buffers) const;
+
+	/// <summary>	Find the nearest trials of the sample in the tree with the buffers (see <see cref="findNeighbors"/>). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool findNeighbors(const Eigen::MatrixXd& sample, size_t nbNeighbors, std::vector<size_t>& indexes, std::vector<double>& distances,
+					   Eigen::MatrixXd& factor, SSymmetricBuffers& buffers) const;
+
+	/// <summary>	Compute the class, the distance and the probability of each class with the neighbours. </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool vote(const std::vector<size_t>& indexes, const std::vector<double>& distances, size_t& classId, std::vector<double>& distance,
+			  std::vector<double>& probability) const;
+
+	//***********************
+	//***** XML Manager *****
+	//***********************
+	/// <summary>	Save Additionnal informations (number of neighbours). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
+
+	/// <summary>	Load Additionnal informations (number of neighbours). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadAdditional(tinyxml2::XMLElement* data) override;
+
+	/// <summary>	Save Classes informations (trials with their class and the tree). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveClasses(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
+
+	/// <summary>	Load Classes informations (trials with their class and the tree, the tree is built only if it isn't saved or if it isn't valid, see <see cref="isTree"/>). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadClasses(tinyxml2::XMLElement* data) override;
+
+	/// <summary>	Prints the Additional informations (number of neighbours and trials). </summary>
+	/// <returns>	Additional informations in stringstream. </returns>
+	std::stringstream printAdditional() const override;
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	size_t m_nbNeighbors = 5;				///< Number of neighbours.
+	CCopyOnWrite<SIndex> m_index;			///< Trials and tree.
+	SSymmetricBuffers m_buffers;			///< Buffers of the distances for the classification.
+	Eigen::MatrixXd m_factor;				///< Buffer of the sample factor for the classification.
+	std::vector<size_t> m_neighbors;		///< Buffer of the index of the neighbours for the classification.
+	std::vector<double> m_distances;		///< Buffer of the distances of the neighbours for the classification.
+};
+
+}  // namespace Geometry
@@ -13,6 +13,7 @@
 
 #include "geometry/classifier/IMatrixClassifier.hpp"
 #include "geometry/Metrics.hpp"
+#include <atomic>
 
 namespace Geometry {
 
@@ -31,6 +32,10 @@ public:
 	/// <param name="obj">	Initial object. </param>
 	CMatrixClassifierMDM(const CMatrixClassifierMDM& obj) { *this = obj; }
 
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierMDM"/> class without copy of the means. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierMDM(CMatrixClassifierMDM&& obj) noexcept : IMatrixClassifier(std::move(obj)) { move(obj); }
+
 	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierMDM"/> class and set base members. </summary>
 	/// <param name="nbClass">	The number of classes. </param>
 	/// <param name="metric">	Metric to use to calculate means (see also <see cref="EMetric" />). </param>
@@ -44,11 +49,57 @@ public:
 	//***** Getter / Setter *****
 	//***************************
 	const std::vector<Eigen::MatrixXd>& getMeans() const { return m_means; }				///< Get Means of classes.
-	void setMeans(const std::vector<Eigen::MatrixXd>& means) { m_means = means; }			///< Set Means of classes.
+	void setMeans(const std::vector<Eigen::MatrixXd>& means) { m_means = means; updateFactors(); }	///< Set Means of classes (and update the factors).
+	const std::vector<Eigen::MatrixXd>& getFactors() const { return m_factors; }			///< Get the factors of the means (see <see cref="updateFactors"/>).
 
 	const std::vector<size_t>& getTrialNumbers() const { return m_nbTrials; }				///< Get the number of trial used for train.
 	void setTrialNumbers(const std::vector<size_t>& nbTrials) { m_nbTrials = nbTrials; }	///< Set the number of trial used for train.
 
+	bool getPruning() const { return m_pruning; }											///< Get the state of the class pruning (see <see cref="setPruning"/>).
+	const Eigen::MatrixXd& getClassDistances() const { return m_classDistances; }			///< Get the distances between the means of classes (computed only with the pruning).
+
+	/// <summary>	Enable or disable the pruning of the classes which can't be the closest class (useful with many classes, SSVEP or speller for example).\n
+	/// With the Riemann and Wasserstein metrics, the exact distance is computed only for the classes whose lower bound is lower than the closest distance found :
+	/// - A scalar invariant of the sample \f$ S \f$ and the mean \f$ C_k \f$ gives a first bound :
+	/// \f$ \frac{\left| \log\det S - \log\det C_k \right|}{\sqrt{N}} \f$ (Riemann) and \f$ \left| \sqrt{\operatorname{tr} S} - \sqrt{\operatorname{tr} C_k} \right| \f$ (Wasserstein).
+	/// - The triangle inequality with the distances between the means (computed when the means are trained, set, loaded or adapted) \f$ \left| \delta(S, C_j) - \delta(C_j, C_k) \right| \f$ for each computed class \f$ j \f$.
+	///
+	/// The classes are computed by increasing bound, so the predicted class is the same as the exhaustive search.
+	/// </summary>
+	/// <param name="pruning">	Enable the pruning. </param>
+	/// <remarks>
+	/// The distance of a pruned class is infinity (never evaluated) and its probability is 0, the probabilities are computed only with the exact distances.
+	/// The exact distance can be computed with <see cref="Distance"/> if needed.
+	/// The sessions (see <see cref="CClassifierSession"/>) adapt their own means, so they use only the scalar invariant bound.
+	/// The batch classification isn't pruned (all pairs are computed in parallel).
+	/// The other metrics aren't pruned (their distances cost as much as the bounds).
+	/// </remarks>
+	void setPruning(const bool pruning) { m_pruning = pruning; updateClassDistances(); }
+
+	/// <summary>	Counters of the fast prediction (see <see cref="predictFast"/>). </summary>
+	struct SFastCounters
+	{
+		size_t nbTrials     = 0;	///< Number of classified trials.
+		size_t nbRefined    = 0;	///< Number of trials refined with the exact distances.
+		size_t nbOverBudget = 0;	///< Number of trials classified with the proxy because the time budget was exceeded.
+	};
+
+	bool getFastPrediction() const { return m_fast; }			///< Get the state of the fast prediction mode (see <see cref="setFastPrediction"/>).
+	double getFastMargin() const { return m_fastMargin; }		///< Get the relative margin of the refinement (see <see cref="setFastPrediction"/>).
+	SFastCounters getFastCounters() const;						///< Get the counters of the fast prediction.
+	void resetFastCounters();									///< Reset the counters of the fast prediction.
+
+	/// <summary>	Enable or disable the fast prediction mode of <see cref="predictFast"/> (only with the Riemann metric).\n
+	/// The means are projected once in the tangent space at their Riemannian mean \f$ M \f$ (see <see cref="TangentSpace"/>), updated when the means are trained, set, loaded or adapted.
+	/// The proxy distance to the class \f$ k \f$ is the first order approximation of the Riemannian distance \f$ \left\| T(S) - T(C_k) \right\| \f$
+	/// with \f$ T(X) = \log\left(M^{-1/2} X M^{-1/2}\right) \f$ (one logarithm for the sample and one norm by class instead of one eigen decomposition by class).\n
+	/// Only <see cref="predictFast"/> uses the proxy distances : <see cref="predict"/> and the <c>classify</c> overloads keep the exact distances
+	/// (the proxies follow the means of the classifier, not the means adapted in a session).
+	/// </summary>
+	/// <param name="fast">		Enable the mode. </param>
+	/// <param name="margin">	The classes whose proxy distance is lower than \f$ d_{\text{min}} (1 + \text{margin}) \f$ are refined with the exact distance. </param>
+	void setFastPrediction(bool fast, double margin = 0.1);
+
 	//**********************
 	//***** Classifier *****
 	//**********************
@@ -90,6 +141,72 @@ public:
 	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
 				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
 
+	/// <summary>	Classify the matrix with the buffers of the workspace (as <see cref="classify"/>).\n
+	/// Without allocation with the Riemann, Log-Euclidian, Euclidian and Wasserstein metrics (the distances use the factors of the means, see <see cref="updateFactors"/>).
+	/// </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Classify the matrix without adaptation (distances to the means as <see cref="classify"/>). </summary>
+	/// \copydetails IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	/// <summary>	Classify the matrix without adaptation with the proxy distances of the fast prediction mode (see <see cref="setFastPrediction"/>) :
+	/// -# The proxy distances of all classes are computed.
+	/// -# If the second closest proxy distance is within the margin of the closest one, the exact distances of the classes within the margin are computed and give the predicted class.
+	/// -# If the time budget runs out before the end of the refinement, the proxy decision is kept.
+	///
+	/// The counters of refinement and exceeded budget are updated (see <see cref="getFastCounters"/>).
+	/// </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class : the proxy distances without refinement,
+	/// the exact distances of the candidates and infinity for the other classes after a refinement (the two scales are never mixed). </param>
+	/// <param name="probability">	The probability of the sample with each class (computed with these distances, 0 for the classes which aren't candidates). </param>
+	/// <param name="budget">		The time budget in seconds (0 without limit). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	Without the fast prediction mode (or with another metric than Riemann), it's the same as <see cref="predict"/>. This function is thread safe as <see cref="predict"/>. </remarks>
+	bool predictFast(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability, double budget = 0) const;
+
+	/// <summary>	Initialize the adaptation state of the session with the means and the number of trials of each class. </summary>
+	/// \copydetails IMatrixClassifier::initSession(CClassifierSession&) const
+	bool initSession(CClassifierSession& session) const override;
+
+	/// <summary>	Classify the matrix with the means of the session and adapt them (as <see cref="classify"/>). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierSession&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&) const
+	bool classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) const override;
+
+	/// <summary>	Classify a batch of matrices (see <see cref="IMatrixClassifier::classify(const std::vector<Eigen::MatrixXd>&, std::vector<size_t>&, Eigen::MatrixXd&, Eigen::MatrixXd&, EAdaptations, const std::vector<size_t>&, size_t)"/>).\n
+	/// Without adaptation :
+	/// -# The samples are prepared (see <see cref="prepareSamples"/>).
+	/// -# The distances of all pairs (sample, class) are computed in parallel (so the classes are also split when there are few samples).
+	/// -# The class ids and the probabilities are computed as <see cref="classify"/>, so the result is the same as the loop.
+	///
+	/// With adaptation, the samples are classified one by one in order.
+	///	</summary>
+	/// \copydetails IMatrixClassifier::classify(const std::vector<Eigen::MatrixXd>&, std::vector<size_t>&, Eigen::MatrixXd&, Eigen::MatrixXd&, EAdaptations, const std::vector<size_t>&, size_t)
+	bool classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances, Eigen::MatrixXd& probabilities,
+				  EAdaptations adaptation = EAdaptations::None, const std::vector<size_t>& realClassIds = std::vector<size_t>(), size_t nbThreads = 0) override;
+	using IMatrixClassifier::classify;
+
+	/// <summary>	Supervised adaptation with a block of labelled trials.\n
+	/// With \f$ B_k \f$ the mean (with the metric \f$ m \f$) of the \f$ M_k \f$ trials of the class \f$ k \f$ in the block,
+	/// each prototype is updated with one geodesic step (instead of one by trial) :
+	/// \f[
+	/// \begin{aligned}
+	/// N_k &= N_k + M_k\\
+	/// C_k &= \gamma_m\left( C_k,B_k,\frac{M_k}{N_k}\right)
+	///	\end{aligned}
+	/// \f]
+	///	</summary>
+	/// <param name="samples">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	The result is the same as the sequential supervised adaptation with the Euclidian and Log-Euclidian metrics and an approximation with the other metrics (the block mean replaces the successive geodesic steps). </remarks>
+	virtual bool adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels);
+
 	//*****************************
 	//***** Override Operator *****
 	//*****************************
@@ -117,6 +234,16 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierMDM& operator=(CMatrixClassifierMDM&& obj) noexcept
+	{
+		IMatrixClassifier::operator=(std::move(obj));
+		move(obj);
+		return *this;
+	}
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierMDM"/> are equals. </returns>
@@ -138,6 +265,126 @@ public:
 	}
 
 protected:
+	/// <summary>	Compute the distances between the sample and the means, the predicted class and the probabilities. </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="means">		The means of each class. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class. </param>
+	/// <param name="probability">	The probability of the sample with each class. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <param name="factors">		The factors of the means (see <see cref="updateFactors"/>), <see cref="Distance"/> is used if they are not computed. </param>
+	/// <param name="classDistances">	The distances between the means for the pruning (see <see cref="setPruning"/>), empty if unknown. </param>
+	bool predictWithMeans(const Eigen::MatrixXd& sample, const std::vector<Eigen::MatrixXd>& means, const std::vector<Eigen::MatrixXd>& factors,
+						  const Eigen::MatrixXd& classDistances, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const;
+
+	/// <summary>	Compute the distances between the sample and the means with the buffers of the workspace and the metric \p M known at compilation (see <see cref="predictWithMeans"/>). </summary>
+	/// <typeparam name="M">	The metric of the classifier. </typeparam>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="means">		The means of each class. </param>
+	/// <param name="factors">		The factors of the means. </param>
+	/// <param name="classDistances">	The distances between the means for the pruning, empty if unknown. </param>
+	/// <param name="workspace">	The workspace. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class. </param>
+	/// <param name="probability">	The probability of the sample with each class. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	template <EMetric M>
+	bool predictWithMeans(const Eigen::MatrixXd& sample, const std::vector<Eigen::MatrixXd>& means, const std::vector<Eigen::MatrixXd>& factors, const Eigen::MatrixXd& classDistances,
+						  CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const;
+
+	/// <summary>	Adapt the mean of the class with the sample (expected class if supervised, predicted class if unsupervised). </summary>
+	/// <param name="sample">		The classified sample. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="adaptation">	Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">	The expected class id if supervised adaptation. </param>
+	/// <param name="means">		The means of each class to adapt. </param>
+	/// <param name="factors">		The factors of the means to update (only the factor of the adapted class is computed again). </param>
+	/// <param name="nbTrials">		The number of trials of each class to update. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool adaptMeans(const Eigen::MatrixXd& sample, size_t classId, EAdaptations adaptation, size_t realClassId,
+					std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials) const;
+
+	/// <summary>	Adapt the mean of the class with the sample, the buffers of the workspace and the metric \p M known at compilation (see <see cref="adaptMeans"/>). </summary>
+	/// <typeparam name="M">	The metric of the classifier. </typeparam>
+	/// <param name="sample">		The classified sample. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="adaptation">	Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">	The expected class id if supervised adaptation. </param>
+	/// <param name="means">		The means of each class to adapt. </param>
+	/// <param name="factors">		The factors of the means to update. </param>
+	/// <param name="nbTrials">		The number of trials of each class to update. </param>
+	/// <param name="workspace">	The workspace. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	template <EMetric M>
+	bool adaptMeans(const Eigen::MatrixXd& sample, size_t classId, EAdaptations adaptation, size_t realClassId, std::vector<Eigen::MatrixXd>& means,
+					std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials, CClassifierWorkspace& workspace) const;
+
+	/// <summary>	Classify the sample and adapt the means with the buffers of the workspace and the metric \p M known at compilation
+	/// (the distances, the geodesic and the factor of the adapted class without dispatch on the metric).
+	/// </summary>
+	/// <typeparam name="M">	The metric of the classifier. </typeparam>
+	/// <param name="sample">			The sample to classify. </param>
+	/// <param name="means">			The means of each class. </param>
+	/// <param name="factors">			The factors of the means. </param>
+	/// <param name="nbTrials">			The number of trials of each class. </param>
+	/// <param name="classDistances">	The distances between the means for the pruning, empty if unknown. </param>
+	/// <param name="workspace">		The workspace. </param>
+	/// <param name="classId">			The predicted class. </param>
+	/// <param name="distance">			The distance of the sample with each class. </param>
+	/// <param name="probability">		The probability of the sample with each class. </param>
+	/// <param name="adaptation">		Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">		The expected class id if supervised adaptation. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	template <EMetric M>
+	bool classifyWithMeans(const Eigen::MatrixXd& sample, std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials,
+						   const Eigen::MatrixXd& classDistances, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+						   std::vector<double>& probability, EAdaptations adaptation, size_t realClassId) const;
+
+	/// <summary>	Classify the sample and adapt the means with the metric of the classifier (one dispatch on the metric for the whole trial, see <see cref="classifyWithMeans{M}"/>). </summary>
+	/// \copydetails classifyWithMeans
+	bool classifyWithMeans(const Eigen::MatrixXd& sample, std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials,
+						   const Eigen::MatrixXd& classDistances, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+						   std::vector<double>& probability, EAdaptations adaptation, size_t realClassId) const;
+
+	/// <summary>	Update the distances between the means and the proxy of the adapted class (with the pruning or the fast prediction mode). </summary>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="adaptation">	Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">	The expected class id if supervised adaptation. </param>
+	/// <param name="workspace">	The workspace. </param>
+	void updateAdapted(size_t classId, EAdaptations adaptation, size_t realClassId, CClassifierWorkspace& workspace);
+
+	/// <summary>	Compute the factors of the means used by the distances (see <see cref="DistanceReferenceFactor"/>) :
+	/// inverse Cholesky factor with the Riemann metric, logarithm with the Log-Euclidian metric and square root with the Wasserstein metric.\n
+	/// The factors are computed once when the means are trained, loaded or set, so each distance is only one product and one symmetric eigen solver (see <see cref="DistanceFactorized"/>).
+	/// </summary>
+	/// <remarks>	If a factor can't be computed, the factors are cleared and the distances are computed with <see cref="Distance"/>. </remarks>
+	void updateFactors();
+
+	/// <summary>	Compute the distances between all means for the pruning (see <see cref="setPruning"/>), cleared without pruning or factors. </summary>
+	void updateClassDistances();
+
+	/// <summary>	Compute the distances between the mean of the class and the other means after an adaptation (see <see cref="setPruning"/>). </summary>
+	/// <param name="id">		The adapted class. </param>
+	/// <param name="buffers">	The buffers of the distances. </param>
+	void updateClassDistances(size_t id, SSymmetricBuffers& buffers);
+
+	/// <summary>	Compute the reference and the projections of the means for the fast prediction mode (see <see cref="setFastPrediction"/>), cleared without the mode. </summary>
+	void updateProxy();
+
+	/// <summary>	Project the mean of the class in the tangent space of the fast prediction mode after an adaptation (see <see cref="setFastPrediction"/>). </summary>
+	/// <param name="id">		The adapted class. </param>
+	/// <param name="buffers">	The buffers of the projection. </param>
+	/// <param name="tangent">	The buffer of the projected mean. </param>
+	void updateProxy(size_t id, SSymmetricBuffers& buffers, Eigen::RowVectorXd& tangent);
+
+	/// <summary>	Transform the samples before the computation of the distances in the batch classification (the samples are copied for MDM). </summary>
+	/// <param name="samples">	The samples. </param>
+	/// <param name="prepared">	The transformed samples. </param>
+	/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	This is the only stage of the batch classification where the state of the classifier can evolve, it must process the samples in order in this case. </remarks>
+	virtual bool prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, size_t nbThreads);
+
 	//***********************
 	//***** XML Manager *****
 	//***********************
@@ -154,11 +401,25 @@ protected:
 	//*****************************
 	std::stringstream printClasses() const override;
 
+	/// <summary>	Move the members of this class (the counters of the fast prediction mode are copied). </summary>
+	/// <param name="obj">	The object to move. </param>
+	void move(CMatrixClassifierMDM& obj) noexcept;
+
 	//*********************
 	//***** Variables *****
 	//*********************
 	std::vector<Eigen::MatrixXd> m_means;	///< Mean Matrix of each class.
+	std::vector<Eigen::MatrixXd> m_factors;	///< Factor of the mean of each class for the distances (empty if not computed).
 	std::vector<size_t> m_nbTrials;			///< Number of trials of each class.
+	bool m_pruning = false;					///< Prune the classes which can't be the closest class.
+	Eigen::MatrixXd m_classDistances;		///< Distances between the means of classes (with the pruning).
+	bool m_fast         = false;			///< Fast metric mode.
+	double m_fastMargin = 0.1;				///< Relative margin of the refinement in the fast prediction mode.
+	Eigen::MatrixXd m_proxyRefIS;			///< Inverse square root of the reference of the tangent space (fast prediction mode).
+	Eigen::MatrixXd m_proxyMeans;			///< Means projected in the tangent space, one class by row (fast prediction mode).
+	mutable std::atomic<size_t> m_nbFast{ 0 };			///< Number of trials classified in the fast prediction mode.
+	mutable std::atomic<size_t> m_nbRefined{ 0 };		///< Number of refined trials in the fast prediction mode.
+	mutable std::atomic<size_t> m_nbOverBudget{ 0 };	///< Number of trials over the time budget in the fast prediction mode.
 };
 
 }  // namespace Geometry
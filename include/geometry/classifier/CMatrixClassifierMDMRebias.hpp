@@ -32,6 +32,10 @@ public:
 	/// <param name="obj">	Initial object. </param>
 	CMatrixClassifierMDMRebias(const CMatrixClassifierMDMRebias& obj) { *this = obj; }
 
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierMDMRebias"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierMDMRebias(CMatrixClassifierMDMRebias&& obj) noexcept = default;
+
 	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierMDMRebias"/> class and set base members. </summary>
 	/// <param name="nbClass">	The number of classes. </param>
 	/// <param name="metric">	Metric to use to calculate means (see also <see cref="EMetric" />). </param>
@@ -70,6 +74,34 @@ public:
 	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
 	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
 				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+	using CMatrixClassifierMDM::classify;
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (the bias is applied and updated without allocation, see <see cref="classify"/>). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Classify the matrix without adaptation (the bias is applied but not updated). </summary>
+	/// \copydetails IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	/// <summary>	Initialize the adaptation state of the session with the means, the number of trials of each class and the bias. </summary>
+	/// \copydetails IMatrixClassifier::initSession(CClassifierSession&) const
+	bool initSession(CClassifierSession& session) const override;
+
+	/// <summary>	Classify the matrix with the adaptation state of the session (the bias of the session is applied and updated). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierSession&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&) const
+	bool classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) const override;
+
+	/// <summary>	Supervised adaptation with a block of labelled trials.
+	/// -# Apply the affine transformation and update the reference with each trial (as <see cref="classify"/>).
+	/// -# Apply the adapt function of MDM Classifier with the transformed trials (see <see cref="CMatrixClassifierMDM::adapt"/>).
+	///	</summary>
+	/// <param name="samples">	The trials. </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels) override;
 
 	//*****************************
 	//***** Override Operator *****
@@ -98,6 +130,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierMDMRebias& operator=(CMatrixClassifierMDMRebias&& obj) noexcept = default;
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierMDMRebias"/> are equals. </returns>
@@ -120,6 +157,10 @@ public:
 
 protected:
 
+	/// <summary>	Apply the affine transformation and update the reference with each sample in order (as <see cref="classify"/>). </summary>
+	/// \copydetails CMatrixClassifierMDM::prepareSamples
+	bool prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, size_t nbThreads) override;
+
 	/// <summary>	Save Additionnal informations (reference and number of classification). </summary>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
 	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
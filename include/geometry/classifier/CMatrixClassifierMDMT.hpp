@@ -0,0 +1,74 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CMatrixClassifierMDMT.hpp
+/// \brief Class of Minimum Distance to Mean (MDM) Classifier with the metric known at compilation.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "geometry/classifier/CMatrixClassifierMDM.hpp"
+#include "geometry/classifier/CClassifierSession.hpp"
+
+namespace Geometry {
+
+/// <summary>	Class of Minimum Distance to Mean (MDM) Classifier with the metric known at compilation. </summary>
+/// <typeparam name="M">	The metric of the classifier (see <see cref="EMetric"/>). </typeparam>
+/// <remarks>
+/// The classification with a workspace or a session computes the distances, the geodesic and the factor of the adapted class without dispatch on the metric
+/// (see <see cref="CMatrixClassifierMDM::classifyWithMeans{M}"/>), the results are the same as <see cref="CMatrixClassifierMDM"/> with the metric \p M.
+/// The other functions (train, save, load...) are the functions of <see cref="CMatrixClassifierMDM"/>,
+/// if the metric is changed (load of a classifier with another metric for example), the classification uses the metric of the classifier.
+/// </remarks>
+/// <seealso cref="CMatrixClassifierMDM" />
+template <EMetric M>
+class CMatrixClassifierMDMT final : public CMatrixClassifierMDM
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Default constructor. Initializes a new instance of the <see cref="CMatrixClassifierMDMT"/> class. </summary>
+	CMatrixClassifierMDMT() { m_metric = M; }
+
+	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierMDMT"/> class with the number of classes. </summary>
+	/// <param name="nbClass">	The number of classes. </param>
+	explicit CMatrixClassifierMDMT(const size_t nbClass) : CMatrixClassifierMDM(nbClass, M) { }
+
+	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierMDMT"/> class with a copy of a classifier (the metric must be \p M). </summary>
+	/// <param name="obj">	Initial object. </param>
+	explicit CMatrixClassifierMDMT(const CMatrixClassifierMDM& obj) : CMatrixClassifierMDM(obj) { }
+
+	/// <summary>	Finalizes an instance of the <see cref="CMatrixClassifierMDMT"/> class. </summary>
+	~CMatrixClassifierMDMT() override = default;
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	using CMatrixClassifierMDM::classify;
+
+	/// \copydoc CMatrixClassifierMDM::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  const EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override
+	{
+		if (m_metric != M) { return CMatrixClassifierMDM::classify(sample, workspace, classId, distance, probability, adaptation, realClassId); }
+		if (!classifyWithMeans<M>(sample, m_means, m_factors, m_nbTrials, m_classDistances, workspace, classId, distance, probability, adaptation, realClassId)) { return false; }
+		updateAdapted(classId, adaptation, realClassId, workspace);
+		return true;
+	}
+
+	/// \copydoc CMatrixClassifierMDM::classify(const Eigen::MatrixXd&, CClassifierSession&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&) const
+	bool classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  const EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) const override
+	{
+		if (m_metric != M) { return CMatrixClassifierMDM::classify(sample, session, classId, distance, probability, adaptation, realClassId); }
+		if (session.getMeans().size() != m_nbClass || session.getTrialNumbers().size() != m_nbClass) { return false; }	// Check if session is initialized
+		return classifyWithMeans<M>(sample, session.getMeans(), session.getFactors(), session.getTrialNumbers(), Eigen::MatrixXd(), session.getWorkspace(),
+									classId, distance, probability, adaptation, realClassId);
+	}
+};
+
+}  // namespace Geometry
@@ -0,0 +1,254 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CMatrixClassifierTSKernel.hpp
+/// \brief Class of kernel classifier in the Tangent Space (TS Kernel) : kernel ridge regression on the Riemannian kernel.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+/// \remarks Inspired by the work of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>) kernel functions.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "geometry/classifier/IMatrixClassifier.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Enumeration of kernels on the tangent vectors. </summary>
+enum class ETangentKernel
+{
+	Linear,		///< Riemannian kernel \f$ k(A, B) = \zeta_A \cdot \zeta_B \f$ (see <see cref="TangentKernel" />).
+	Gaussian	///< Gaussian kernel \f$ k(A, B) = \exp\left(-\gamma \left\lVert \zeta_A - \zeta_B \right\rVert^2\right) \f$ (computed from the Riemannian kernel).
+};
+
+/// <summary>	Convert kernel to string. </summary>
+/// <param name="type">	The type of kernel. </param>
+/// <returns>	<c>std::string</c> </returns>
+inline std::string toString(const ETangentKernel type)
+{
+	switch (type)
+	{
+		case ETangentKernel::Linear: return "Linear";
+		case ETangentKernel::Gaussian: return "Gaussian";
+	}
+	return "Invalid";
+}
+
+/// <summary>	Convert string to kernel. </summary>
+/// <param name="type">	The type of kernel. </param>
+/// <returns>	<see cref="ETangentKernel"/> </returns>
+inline ETangentKernel StringToTangentKernel(const std::string& type)
+{
+	if (type == "Gaussian") { return ETangentKernel::Gaussian; }
+	return ETangentKernel::Linear;
+}
+///-------------------------------------------------------------------------------------------------
+
+/// <summary>	Class of kernel classifier in the Tangent Space (TS Kernel). </summary>
+/// <remarks>
+/// The trials are projected once in the Tangent Space at the Riemannian mean of all trials and kept as support vectors \f$ S \f$ (\f$ N \times F \f$).
+/// The training solves the kernel ridge regression of the centered one-hot labels \f$ \left(K + \lambda I\right) A = Y - \bar{Y} \f$ with \f$ K \f$ the kernel of the support vectors
+/// (one symmetric blocked product, see <see cref="GramMatrix" />).\n
+/// The scores are \f$ s = A^{\mathsf{T}} k(S, t) + \bar{Y} \f$ and the probabilities are the softmax of the scores.
+/// One classification costs one symmetric eigen decomposition (the log map) and the \f$ N \times F \f$ product with the support vectors, without allocation after the first call.
+/// </remarks>
+/// <seealso cref="IMatrixClassifier" />
+class CMatrixClassifierTSKernel : public IMatrixClassifier
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Default constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSKernel"/> class. </summary>
+	CMatrixClassifierTSKernel() = default;
+
+	/// <summary>	Default Copy constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSKernel"/> class. </summary>
+	/// <param name="obj">	Initial object. </param>
+	CMatrixClassifierTSKernel(const CMatrixClassifierTSKernel& obj) { *this = obj; }
+
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSKernel"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierTSKernel(CMatrixClassifierTSKernel&& obj) noexcept = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierTSKernel"/> class and set base members. </summary>
+	/// <param name="nbClass">	The number of classes. </param>
+	/// <param name="kernel">	The kernel (see also <see cref="ETangentKernel" />). </param>
+	explicit CMatrixClassifierTSKernel(const size_t nbClass, const ETangentKernel kernel = ETangentKernel::Linear)
+		: IMatrixClassifier(nbClass, EMetric::Riemann), m_kernel(kernel) { }
+
+	/// <summary>	Finalizes an instance of the <see cref="CMatrixClassifierTSKernel"/> class. </summary>
+	~CMatrixClassifierTSKernel() override = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	const Eigen::MatrixXd& getRef() const { return m_ref.get(); }						///< Get reference of tangent space.
+	void setRef(const Eigen::MatrixXd& ref);											///< Set reference of tangent space (and the inverse square root).
+	const Eigen::MatrixXd& getSupport() const { return m_support.get(); }				///< Get the support vectors in the tangent space (\f$ N \times F \f$).
+	const Eigen::MatrixXd& getDual() const { return m_dual.get(); }						///< Get the dual coefficients (\f$ N \times K \f$).
+	const Eigen::VectorXd& getBias() const { return m_bias; }							///< Get bias vector (\f$ K \f$).
+
+	/// <summary>	Set the support vectors and the dual coefficients. </summary>
+	/// <param name="support">	The support vectors in the tangent space (\f$ N \times F \f$). </param>
+	/// <param name="dual">		The dual coefficients (\f$ N \times K \f$). </param>
+	/// <param name="bias">		The bias vector (\f$ K \f$). </param>
+	void setSupport(const Eigen::MatrixXd& support, const Eigen::MatrixXd& dual, const Eigen::VectorXd& bias);
+
+	ETangentKernel getKernel() const { return m_kernel; }								///< Get the kernel.
+	void setKernel(const ETangentKernel kernel) { m_kernel = kernel; }					///< Set the kernel.
+	double getGamma() const { return m_gamma; }											///< Get the width of the gaussian kernel.
+	void setGamma(const double gamma) { m_gamma = gamma; }								///< Set the width of the gaussian kernel (0 for \f$ 1/F \f$ at the training).
+	double getRegularization() const { return m_regularization; }						///< Get the ridge regularization \f$ \lambda \f$.
+	void setRegularization(const double regularization) { m_regularization = regularization; }	///< Set the ridge regularization \f$ \lambda \f$.
+	size_t getThreadCount() const { return m_nbThreads; }								///< Get the maximum number of threads for training (0 for the hardware concurrency).
+	void setThreadCount(const size_t nbThreads) { m_nbThreads = nbThreads; }			///< Set the maximum number of threads for training (0 for the hardware concurrency).
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	/// <summary>	Train the classifier with the dataset.
+	/// -# Compute the Riemannian mean of all trials as reference and store this in <see cref="m_ref"/> member.
+	/// -# Transform all trials to the Tangent Space with the reference (in parallel) and keep them as support vectors.
+	/// -# Compute the kernel matrix of the support vectors and solve the kernel ridge regression.
+	///	</summary>
+	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets) override;
+
+	/// <summary>	Classify the matrix and return the class id, the distance and the probability of each class.\n
+	/// -# Transform the sample to the Tangent Space (one symmetric eigen decomposition).\n
+	/// -# Compute the kernel with the support vectors and the scores \f$ s = A^{\mathsf{T}} k(S, t) + \bar{Y} \f$.\n
+	/// -# The probabilities are the softmax of the scores and the distances are \f$ -\log(\mathcal{P}_i) \f$.
+	///	</summary>
+	/// <remarks>	The classifier doesn't evolve whatever the adaptation method chosen. The internal workspace is reused, so this function isn't reentrant. </remarks>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Classify the matrix without adaptation (same result as <see cref="classify"/> with local buffers). </summary>
+	/// \copydetails IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	/// <summary>	Classify a batch of matrices (the classifier doesn't evolve whatever the adaptation method chosen).\n
+	/// The samples are projected in parallel in the tangent space and the cross kernel with the support vectors is one blocked product (see <see cref="GramMatrix" />).
+	/// </summary>
+	/// \copydetails IMatrixClassifier::classify(const std::vector<Eigen::MatrixXd>&, std::vector<size_t>&, Eigen::MatrixXd&, Eigen::MatrixXd&, EAdaptations, const std::vector<size_t>&, size_t)
+	bool classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances, Eigen::MatrixXd& probabilities,
+				  EAdaptations adaptation = EAdaptations::None, const std::vector<size_t>& realClassIds = std::vector<size_t>(), size_t nbThreads = 0) override;
+	using IMatrixClassifier::classify;
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (see <see cref="classify"/>, the classifier doesn't evolve). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Size the buffers of the workspace (with the kernel of the sample with each support vector). </summary>
+	/// \copydetails IMatrixClassifier::initWorkspace(CClassifierWorkspace&, const size_t) const
+	bool initWorkspace(CClassifierWorkspace& workspace, const size_t nbChannels) const override
+	{
+		workspace.resize(nbChannels, m_nbClass);
+		workspace.kernel.resize(m_support->rows());
+		return true;
+	}
+
+	//*****************************
+	//***** Override Operator *****
+	//*****************************
+	/// <summary>	Check if object are equals (with a precision tolerance). </summary>
+	/// <param name="obj">			The second object. </param>
+	/// <param name="precision">	Precision for matrix comparison. </param>
+	/// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance). </returns>
+	bool isEqual(const CMatrixClassifierTSKernel& obj, double precision = 1e-6) const;
+
+	/// <summary>	Copy object value. </summary>
+	/// <param name="obj">	The object to copy. </param>
+	void copy(const CMatrixClassifierTSKernel& obj);
+
+	/// <summary>	Get the type of the classifier. </summary>
+	/// <returns>	Tangent Space Kernel (TS Kernel). </returns>
+	std::string getType() const override { return toString(EMatrixClassifiers::TSKernel); }
+
+	/// <summary>	Override the affectation operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	The copied object. </returns>
+	CMatrixClassifierTSKernel& operator=(const CMatrixClassifierTSKernel& obj)
+	{
+		copy(obj);
+		return *this;
+	}
+
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierTSKernel& operator=(CMatrixClassifierTSKernel&& obj) noexcept = default;
+
+	/// <summary>	Override the equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierTSKernel"/> are equals. </returns>
+	bool operator==(const CMatrixClassifierTSKernel& obj) const { return isEqual(obj); }
+
+	/// <summary>	Override the not equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierTSKernel"/> are diffrents. </returns>
+	bool operator!=(const CMatrixClassifierTSKernel& obj) const { return !isEqual(obj); }
+
+	/// <summary>	Override the ostream operator. </summary>
+	/// <param name="os">	The ostream. </param>
+	/// <param name="obj">	The object. </param>
+	/// <returns>	Return the modified ostream. </returns>
+	friend std::ostream& operator <<(std::ostream& os, const CMatrixClassifierTSKernel& obj)
+	{
+		os << obj.print().str();
+		return os;
+	}
+
+protected:
+	/// <summary>	Apply the kernel on the inner products of the tangent vectors (nothing for the linear kernel). </summary>
+	/// <param name="products">	The inner products of the tangent vectors, replaced by the kernel. </param>
+	/// <param name="rowNorms">	The squared norms of the tangent vectors of the rows. </param>
+	/// <param name="colNorms">	The squared norms of the tangent vectors of the columns. </param>
+	void applyKernel(Eigen::MatrixXd& products, const Eigen::VectorXd& rowNorms, const Eigen::VectorXd& colNorms) const;
+
+	/// <summary>	Compute the scores of the sample (stored in <c>workspace.scores</c>). </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="workspace">	The workspace (sized if needed, see <see cref="initWorkspace"/>). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool computeScores(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace) const;
+
+	//***********************
+	//***** XML Manager *****
+	//***********************
+	/// <summary>	Save Additionnal informations (Kernel, Reference, Support vectors, Dual coefficients and Bias). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
+
+	/// <summary>	Load Additionnal informations (Kernel, Reference, Support vectors, Dual coefficients and Bias). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadAdditional(tinyxml2::XMLElement* data) override;
+
+	/// <summary>	Prints the Additional informations (Kernel, Reference, Support vectors, Dual coefficients and Bias). </summary>
+	/// <returns>	Additional informations in stringstream. </returns>
+	std::stringstream printAdditional() const override;
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	ETangentKernel m_kernel = ETangentKernel::Linear;	///< Kernel on the tangent vectors.
+	double m_gamma          = 0;		///< Width of the gaussian kernel (0 for \f$ 1/F \f$ at the training).
+	double m_regularization = 1e-2;		///< Ridge regularization \f$ \lambda \f$.
+	size_t m_nbThreads      = 0;		///< Maximum number of threads for training (0 for the hardware concurrency).
+
+	CCopyOnWrite<Eigen::MatrixXd> m_ref;		///< Reference matrix of tangent space (shared by the copies).
+	CCopyOnWrite<Eigen::MatrixXd> m_refIS;		///< Inverse square root of the reference matrix.
+	CCopyOnWrite<Eigen::MatrixXd> m_support;	///< Support vectors in the tangent space (\f$ N \times F \f$).
+	CCopyOnWrite<Eigen::VectorXd> m_norms;		///< Squared norms of the support vectors (gaussian kernel).
+	CCopyOnWrite<Eigen::MatrixXd> m_dual;		///< Dual coefficients (\f$ N \times K \f$).
+	Eigen::VectorXd m_bias;						///< Bias vector (\f$ K \f$).
+
+	CClassifierWorkspace m_workspace;	///< Workspace for classification without allocation.
+};
+
+}  // namespace Geometry
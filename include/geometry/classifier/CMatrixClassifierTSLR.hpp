@@ -0,0 +1,243 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file CMatrixClassifierTSLR.hpp
+/// \brief Class of linear classifier in the Tangent Space (TSLR) : multinomial logistic regression or Linear Discriminant Analysis.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 18/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+/// \remarks Inspired by the work of Alexandre Barachant : <a href="https://github.com/alexandrebarachant/pyRiemann">pyRiemann</a> (<a href="https://github.com/alexandrebarachant/pyRiemann/blob/master/LICENSE">License</a>) TSclassifier.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "geometry/classifier/IMatrixClassifier.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Enumeration of linear solvers for the Tangent Space classifier. </summary>
+enum class ETangentSolver
+{
+	LogisticRegression,	///< Multinomial logistic regression with L2 regularization.
+	LDA					///< Linear Discriminant Analysis (pooled Ledoit and Wolf covariance as <see cref="LSQR" />).
+};
+
+/// <summary>	Convert solver to string. </summary>
+/// <param name="type">	The type of solver. </param>
+/// <returns>	<c>std::string</c> </returns>
+inline std::string toString(const ETangentSolver type)
+{
+	switch (type)
+	{
+		case ETangentSolver::LogisticRegression: return "Logistic Regression";
+		case ETangentSolver::LDA: return "LDA";
+	}
+	return "Invalid";
+}
+
+/// <summary>	Convert string to solver. </summary>
+/// <param name="type">	The type of solver. </param>
+/// <returns>	<see cref="ETangentSolver"/> </returns>
+inline ETangentSolver StringToTangentSolver(const std::string& type)
+{
+	if (type == "LDA") { return ETangentSolver::LDA; }
+	return ETangentSolver::LogisticRegression;
+}
+///-------------------------------------------------------------------------------------------------
+
+/// <summary>	Class of linear classifier in the Tangent Space (TSLR). </summary>
+/// <remarks>
+/// The samples are projected in the Tangent Space at the Riemannian mean of all trials.
+/// The scores are \f$ s = W \times t + b \f$ with \f$ W \f$ a \f$ K \times F \f$ matrix and the probabilities are the softmax of the scores.\n
+/// One classification costs one symmetric eigen decomposition (the log map) and the \f$ K \times F \f$ product, without allocation after the first call.
+/// </remarks>
+/// <seealso cref="IMatrixClassifier" />
+class CMatrixClassifierTSLR : public IMatrixClassifier
+{
+public:
+	//***********************
+	//***** Constructor *****
+	//***********************
+	/// <summary>	Default constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSLR"/> class. </summary>
+	CMatrixClassifierTSLR() = default;
+
+	/// <summary>	Default Copy constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSLR"/> class. </summary>
+	/// <param name="obj">	Initial object. </param>
+	CMatrixClassifierTSLR(const CMatrixClassifierTSLR& obj) { *this = obj; }
+
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="CMatrixClassifierTSLR"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	CMatrixClassifierTSLR(CMatrixClassifierTSLR&& obj) noexcept = default;
+
+	/// <summary>	Initializes a new instance of the <see cref="CMatrixClassifierTSLR"/> class and set base members. </summary>
+	/// <param name="nbClass">	The number of classes. </param>
+	/// <param name="solver">	The linear solver (see also <see cref="ETangentSolver" />). </param>
+	explicit CMatrixClassifierTSLR(const size_t nbClass, const ETangentSolver solver = ETangentSolver::LogisticRegression)
+		: IMatrixClassifier(nbClass, EMetric::Riemann), m_solver(solver) { }
+
+	/// <summary>	Finalizes an instance of the <see cref="CMatrixClassifierTSLR"/> class. </summary>
+	~CMatrixClassifierTSLR() override = default;
+
+	//***************************
+	//***** Getter / Setter *****
+	//***************************
+	const Eigen::MatrixXd& getRef() const { return m_ref.get(); }								///< Get reference of tangent space.
+	void setRef(const Eigen::MatrixXd& ref);											///< Set reference of tangent space (and the inverse square root).
+	const Eigen::MatrixXd& getWeight() const { return m_weight.get(); }						///< Get weight matrix (\f$ K \times F \f$).
+	const Eigen::VectorXd& getBias() const { return m_bias; }							///< Get bias vector (\f$ K \f$).
+
+	/// <summary>	Set the linear classifier. </summary>
+	/// <param name="weight">	The weight matrix (\f$ K \times F \f$). </param>
+	/// <param name="bias">		The bias vector (\f$ K \f$). </param>
+	void setWeight(const Eigen::MatrixXd& weight, const Eigen::VectorXd& bias);
+
+	ETangentSolver getSolver() const { return m_solver; }								///< Get the linear solver.
+	void setSolver(const ETangentSolver solver) { m_solver = solver; }					///< Set the linear solver.
+	double getRegularization() const { return m_regularization; }						///< Get the L2 regularization of the logistic regression.
+	void setRegularization(const double regularization) { m_regularization = regularization; }	///< Set the L2 regularization of the logistic regression.
+	size_t getMaxIterations() const { return m_maxIterations; }							///< Get the maximum number of iterations of the logistic regression.
+	void setMaxIterations(const size_t maxIterations) { m_maxIterations = maxIterations; }	///< Set the maximum number of iterations of the logistic regression.
+	size_t getThreadCount() const { return m_nbThreads; }								///< Get the maximum number of threads for training (0 for the hardware concurrency).
+	void setThreadCount(const size_t nbThreads) { m_nbThreads = nbThreads; }			///< Set the maximum number of threads for training (0 for the hardware concurrency).
+
+	//**********************
+	//***** Classifier *****
+	//**********************
+	/// <summary>	Train the classifier with the dataset.
+	/// -# Compute the Riemannian mean of all trials as reference and store this in <see cref="m_ref"/> member.
+	/// -# Transform data to the Tangent Space with the reference.
+	/// -# Train the linear classifier with the solver (<see cref="ETangentSolver" />).
+	///	</summary>
+	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	The logistic regression is a batch gradient descent with backtracking line search, the loss and the gradient are computed in parallel on blocks of trials. </remarks>
+	bool train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets) override;
+
+	/// <summary>	Classify the matrix and return the class id, the distance and the probability of each class.\n
+	/// -# Transform the sample to the Tangent Space (one symmetric eigen decomposition).\n
+	/// -# Compute the scores \f$ s = W \times t + b \f$.\n
+	/// -# The probabilities are the softmax of the scores and the distances are \f$ -\log(\mathcal{P}_i) \f$.
+	///	</summary>
+	/// <remarks>	The classifier doesn't evolve whatever the adaptation method chosen. The internal workspace is reused, so this function isn't reentrant. </remarks>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, const EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	/// <summary>	Classify the matrix without adaptation (same result as <see cref="classify"/> with local buffers). </summary>
+	/// \copydetails IMatrixClassifier::predict(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&) const
+	bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const override;
+
+	/// <summary>	Classify a batch of matrices in parallel (the classifier doesn't evolve whatever the adaptation method chosen). </summary>
+	/// \copydetails IMatrixClassifier::classify(const std::vector<Eigen::MatrixXd>&, std::vector<size_t>&, Eigen::MatrixXd&, Eigen::MatrixXd&, EAdaptations, const std::vector<size_t>&, size_t)
+	bool classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances, Eigen::MatrixXd& probabilities,
+				  EAdaptations adaptation = EAdaptations::None, const std::vector<size_t>& realClassIds = std::vector<size_t>(), size_t nbThreads = 0) override;
+	using IMatrixClassifier::classify;
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (see <see cref="classify"/>, the classifier doesn't evolve). </summary>
+	/// \copydetails IMatrixClassifier::classify(const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)
+	bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) override;
+
+	//*****************************
+	//***** Override Operator *****
+	//*****************************
+	/// <summary>	Check if object are equals (with a precision tolerance). </summary>
+	/// <param name="obj">			The second object. </param>
+	/// <param name="precision">	Precision for matrix comparison. </param>
+	/// <returns>	<c>True</c> if the two elements are equals (with a precision tolerance). </returns>
+	bool isEqual(const CMatrixClassifierTSLR& obj, double precision = 1e-6) const;
+
+	/// <summary>	Copy object value. </summary>
+	/// <param name="obj">	The object to copy. </param>
+	void copy(const CMatrixClassifierTSLR& obj);
+
+	/// <summary>	Get the type of the classifier. </summary>
+	/// <returns>	Tangent Space Logistic Regression (TSLR). </returns>
+	std::string getType() const override { return toString(EMatrixClassifiers::TSLR); }
+
+	/// <summary>	Override the affectation operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	The copied object. </returns>
+	CMatrixClassifierTSLR& operator=(const CMatrixClassifierTSLR& obj)
+	{
+		copy(obj);
+		return *this;
+	}
+
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	CMatrixClassifierTSLR& operator=(CMatrixClassifierTSLR&& obj) noexcept = default;
+
+	/// <summary>	Override the equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierTSLR"/> are equals. </returns>
+	bool operator==(const CMatrixClassifierTSLR& obj) const { return isEqual(obj); }
+
+	/// <summary>	Override the not equal operator. </summary>
+	/// <param name="obj">	The second object. </param>
+	/// <returns>	<c>True</c> if the two <see cref="CMatrixClassifierTSLR"/> are diffrents. </returns>
+	bool operator!=(const CMatrixClassifierTSLR& obj) const { return !isEqual(obj); }
+
+	/// <summary>	Override the ostream operator. </summary>
+	/// <param name="os">	The ostream. </param>
+	/// <param name="obj">	The object. </param>
+	/// <returns>	Return the modified ostream. </returns>
+	friend std::ostream& operator <<(std::ostream& os, const CMatrixClassifierTSLR& obj)
+	{
+		os << obj.print().str();
+		return os;
+	}
+
+protected:
+	/// <summary>	Train the multinomial logistic regression (minimize the mean cross entropy with L2 regularization of the weight). </summary>
+	/// <param name="features">	The features (one trial by row). </param>
+	/// <param name="labels">	The class of each trial. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool trainLogisticRegression(const Eigen::MatrixXd& features, const std::vector<size_t>& labels);
+
+	/// <summary>	Train the Linear Discriminant Analysis. </summary>
+	/// <param name="datasets">	The features one class by row and trials on colums. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool trainLDA(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets);
+
+	/// <summary>	Compute the scores of the sample (stored in <c>workspace.scores</c>). </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="workspace">	The workspace (sized if needed, see <see cref="initWorkspace"/>). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool computeScores(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace) const;
+
+	//***********************
+	//***** XML Manager *****
+	//***********************
+	/// <summary>	Save Additionnal informations (Solver, Reference, Weight and Bias). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const override;
+
+	/// <summary>	Load Additionnal informations (Solver, Reference, Weight and Bias). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool loadAdditional(tinyxml2::XMLElement* data) override;
+
+	/// <summary>	Prints the Additional informations (Solver, Reference, Weight and Bias). </summary>
+	/// <returns>	Additional informations in stringstream. </returns>
+	std::stringstream printAdditional() const override;
+
+	//*********************
+	//***** Variables *****
+	//*********************
+	ETangentSolver m_solver = ETangentSolver::LogisticRegression;	///< Linear solver.
+	double m_regularization = 1e-3;		///< L2 regularization of the logistic regression.
+	size_t m_maxIterations  = 500;		///< Maximum number of iterations of the logistic regression.
+	size_t m_nbThreads      = 0;		///< Maximum number of threads for training (0 for the hardware concurrency).
+
+	CCopyOnWrite<Eigen::MatrixXd> m_ref;	///< Reference matrix of tangent space (shared by the copies).
+	CCopyOnWrite<Eigen::MatrixXd> m_refIS;	///< Inverse square root of the reference matrix.
+	CCopyOnWrite<Eigen::MatrixXd> m_weight;	///< Weight matrix (\f$ K \times F \f$).
+	Eigen::VectorXd m_bias;				///< Bias vector (\f$ K \f$).
+
+	CClassifierWorkspace m_workspace;	///< Workspace for classification without allocation.
+};
+
+}  // namespace Geometry
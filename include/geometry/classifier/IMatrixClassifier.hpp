@@ -14,11 +14,15 @@
 #include <Eigen/Dense>
 #include <vector>
 #include <limits>
+#include <memory>
 #include "geometry/Metrics.hpp"
 #include "geometry/3rd-party/tinyxml2.h"
+#include "geometry/classifier/CClassifierWorkspace.hpp"
 
 namespace Geometry {
 
+class CClassifierSession;
+
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Enumeration of Adaptation Methods for classifier. </summary>
 enum class EAdaptations
@@ -62,7 +66,10 @@ enum class EMatrixClassifiers
 	FgMDM_RT,			///< Minimum Distance to Mean with geodesic filtering (FgMDM) (Real Time adaptation assumed).
 	FgMDM,				///< Minimum Distance to Mean with geodesic filtering (FgMDM).
 	FgMDM_RT_Rebias,	///< Minimum Distance to Mean with geodesic filtering & Rebias adaptation (FgMDM Rebias) (Real Time adaptation assumed).
-	FgMDM_Rebias		///< Minimum Distance to Mean with geodesic filtering & Rebias adaptation (FgMDM Rebias).
+	FgMDM_Rebias,		///< Minimum Distance to Mean with geodesic filtering & Rebias adaptation (FgMDM Rebias).
+	TSLR,				///< Linear classifier in the Tangent Space (logistic regression or LDA) (TSLR).
+	KNN,				///< k-Nearest Neighbours with a metric tree (kNN).
+	TSKernel			///< Kernel ridge classifier in the Tangent Space (TS Kernel).
 };
 
 
@@ -79,6 +86,9 @@ inline std::string toString(const EMatrixClassifiers type)
 		case EMatrixClassifiers::FgMDM: return "Minimum Distance to Mean with geodesic filtering (FgMDM)";
 		case EMatrixClassifiers::FgMDM_RT_Rebias: return "Minimum Distance to Mean with geodesic filtering Rebias (FgMDM Rebias) (Real Time adaptation assumed)";
 		case EMatrixClassifiers::FgMDM_Rebias: return "Minimum Distance to Mean with geodesic filtering Rebias (FgMDM Rebias)";
+		case EMatrixClassifiers::TSLR: return "Tangent Space Logistic Regression (TSLR)";
+		case EMatrixClassifiers::KNN: return "k-Nearest Neighbours (kNN)";
+		case EMatrixClassifiers::TSKernel: return "Tangent Space Kernel (TS Kernel)";
 	}
 	return "Invalid";
 }
@@ -96,6 +106,9 @@ inline EMatrixClassifiers StringToMatrixClassifier(const std::string& type)
 	{
 		return EMatrixClassifiers::FgMDM_RT_Rebias;
 	}
+	if (type == "Tangent Space Logistic Regression (TSLR)") { return EMatrixClassifiers::TSLR; }
+	if (type == "k-Nearest Neighbours (kNN)") { return EMatrixClassifiers::KNN; }
+	if (type == "Tangent Space Kernel (TS Kernel)") { return EMatrixClassifiers::TSKernel; }
 	return EMatrixClassifiers::FgMDM_Rebias;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -126,6 +139,7 @@ public:
 	static bool convertXMLFormatToMatrix(std::stringstream& in, Eigen::MatrixXd& out, size_t rows, size_t cols);
 
 	/// <summary>	Saves matrix. </summary>
+	/// <remarks>	The number of cols is only saved if the matrix isn't square. </remarks>
 	/// <param name="element">	Matrix Node. </param>
 	/// <param name="matrix">	Matrix to save. </param>
 	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
@@ -147,6 +161,10 @@ public:
 	/// <param name="obj">	Initial object. </param>
 	IMatrixClassifier(const IMatrixClassifier& obj) { *this = obj; }
 
+	/// <summary>	Move constructor. Initializes a new instance of the <see cref="IMatrixClassifier"/> class without copy of the members. </summary>
+	/// <param name="obj">	Initial object (valid but unspecified after the move). </param>
+	IMatrixClassifier(IMatrixClassifier&& obj) noexcept = default;
+
 	/// <summary>	Initializes a new instance of the <see cref="IMatrixClassifier"/> class and set members. </summary>
 	/// <param name="nbClass">	The number of classes. </param>
 	/// <param name="metric">	Metric to use to calculate means (see also <see cref="EMetric" />). </param>
@@ -160,6 +178,7 @@ public:
 	//**********************
 	virtual size_t getClassCount() const { return m_nbClass; }	///< Get the class count.
 	virtual void setClassCount(size_t nbClass);					///< Set the class count.
+	EMetric getMetric() const { return m_metric; }				///< Get the metric used to calculate means and distances.
 
 	/// <summary>	Train the classifier with the dataset. </summary>
 	/// <param name="datasets">	The dataset one class by row and trials on colums. </param>
@@ -187,6 +206,93 @@ public:
 	virtual bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
 						  EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max()) = 0;
 
+	/// <summary>	Classify the matrix and return the class id, the distance and the probability of each class without any modification of the classifier. </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class. </param>
+	/// <param name="probability">	The probability of the sample with each class. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>
+	/// This function is thread safe : one trained classifier can be used by several threads at the same time (if it isn't modified).\n
+	/// By default, a copy of the classifier (see <see cref="clone" />) classifies the sample without adaptation, the classifiers override it to classify without copy.
+	/// </remarks>
+	virtual bool predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+	{
+		std::unique_ptr<IMatrixClassifier> copy = clone();
+		return copy != nullptr && copy->classify(sample, classId, distance, probability, EAdaptations::None);
+	}
+
+	/// <summary>	Copy the classifier (used by the default <see cref="predict" />). </summary>
+	/// <returns>	The copy of the classifier, <c>nullptr</c> by default (the interface can't copy the classifier). </returns>
+	virtual std::unique_ptr<IMatrixClassifier> clone() const { return nullptr; }
+
+	/// <summary>	Size the buffers of the workspace for the classification of matrices with the number of channels (common buffers by default). </summary>
+	/// <param name="workspace">	The workspace. </param>
+	/// <param name="nbChannels">	The number of channels (size of the matrices). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	virtual bool initWorkspace(CClassifierWorkspace& workspace, const size_t nbChannels) const
+	{
+		workspace.resize(nbChannels, m_nbClass);
+		return true;
+	}
+
+	/// <summary>	Classify the matrix with the buffers of the workspace (same result as <see cref="classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)"/>).
+	/// Without allocation if the workspace is initialized (see <see cref="initWorkspace" />) and if the distance and probability vectors have the good size.
+	/// </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="workspace">	The workspace. </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class. </param>
+	/// <param name="probability">	The probability of the sample with each class. </param>
+	/// <param name="adaptation">	Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">	The expected class id if supervised adaptation. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	By default, the workspace isn't used. </remarks>
+	virtual bool classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& /*workspace*/, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+						  const EAdaptations adaptation = EAdaptations::None, const size_t& realClassId = std::numeric_limits<size_t>::max())
+	{
+		return classify(sample, classId, distance, probability, adaptation, realClassId);
+	}
+
+	/// <summary>	Initialize the adaptation state of the session with the classifier (nothing is needed by default). </summary>
+	/// <param name="session">	The session. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	virtual bool initSession(CClassifierSession& /*session*/) const { return true; }
+
+	/// <summary>	Classify the matrix with the adaptation state of the session, only the session evolves with the adaptation (see also <see cref="CClassifierSession" />). </summary>
+	/// <param name="sample">		The sample to classify. </param>
+	/// <param name="session">		The session (initialized with <see cref="initSession" />). </param>
+	/// <param name="classId">		The predicted class. </param>
+	/// <param name="distance">		The distance of the sample with each class. </param>
+	/// <param name="probability">	The probability of the sample with each class. </param>
+	/// <param name="adaptation">	Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassId">	The expected class id if supervised adaptation. </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>	By default, the classifier has no adaptation state and it's the same result as <see cref="predict" />. </remarks>
+	virtual bool classify(const Eigen::MatrixXd& sample, CClassifierSession& /*session*/, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+						  EAdaptations /*adaptation*/ = EAdaptations::None, const size_t& /*realClassId*/ = std::numeric_limits<size_t>::max()) const
+	{
+		return predict(sample, classId, distance, probability);
+	}
+
+	/// <summary>	Classify a batch of matrices and return the class id, the distance and the probability of each class for each matrix. </summary>
+	/// <param name="samples">			The samples to classify. </param>
+	/// <param name="classIds">			The predicted class of each sample. </param>
+	/// <param name="distances">		The distance of each sample (row) with each class (column). </param>
+	/// <param name="probabilities">	The probability of each sample (row) with each class (column). </param>
+	/// <param name="adaptation">		Adaptation method for the classfier <see cref="EAdaptations" />. </param>
+	/// <param name="realClassIds">		The expected class id of each sample if supervised adaptation. </param>
+	/// <param name="nbThreads">		The maximum number of threads (0 for the hardware concurrency). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	/// <remarks>
+	/// The outputs are resized only if they haven't the good size (trials \f$ \times \f$ classes), so they can be preallocated.\n
+	/// This default implementation calls <see cref="classify(const Eigen::MatrixXd&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, const size_t&)"/> in a loop.
+	/// Classifiers override it to compute in parallel without adaptation. With adaptation, the samples are always processed in order
+	/// (each sample is classified with the classifier adapted by the previous samples), so the result is the same as the loop.
+	/// </remarks>
+	virtual bool classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances, Eigen::MatrixXd& probabilities,
+						  EAdaptations adaptation = EAdaptations::None, const std::vector<size_t>& realClassIds = std::vector<size_t>(), size_t nbThreads = 0);
+
 	//***********************
 	//***** XML Manager *****
 	//***********************
@@ -232,6 +338,11 @@ public:
 		return *this;
 	}
 
+	/// <summary>	Override the move affectation operator. </summary>
+	/// <param name="obj">	The second object (valid but unspecified after the move). </param>
+	/// <returns>	The moved object. </returns>
+	IMatrixClassifier& operator=(IMatrixClassifier&& obj) noexcept = default;
+
 	/// <summary>	Override the equal operator. </summary>
 	/// <param name="obj">	The second object. </param>
 	/// <returns>	<c>True</c> if the two <see cref="IMatrixClassifier"/> are equals. </returns>
@@ -253,6 +364,21 @@ public:
 	}
 
 protected:
+	/// <summary>	Check the inputs of the batch classification and resize the outputs if needed. </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool prepareBatch(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances, Eigen::MatrixXd& probabilities,
+					  EAdaptations adaptation, const std::vector<size_t>& realClassIds) const;
+
+	/// <summary>	Initialize the workspace if it isn't sized for the number of channels and the classifier. </summary>
+	/// <param name="workspace">	The workspace. </param>
+	/// <param name="nbChannels">	The number of channels (size of the matrices). </param>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool checkWorkspace(CClassifierWorkspace& workspace, const size_t nbChannels) const
+	{
+		if (workspace.getChannelCount() == nbChannels && workspace.getClassCount() == m_nbClass) { return true; }
+		return initWorkspace(workspace, nbChannels);
+	}
+
 	/// <summary>	Prints the header informations. </summary>
 	/// <returns>	Header informations in stringstream. </returns>
 	virtual std::stringstream printHeader() const;
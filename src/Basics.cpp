@@ -1,5 +1,8 @@
 #include "geometry/Basics.hpp"
 #include <unsupported/Eigen/MatrixFunctions> // SQRT of Matrix
+#include <algorithm>
+#include <thread>
+#include <limits>
 
 namespace Geometry {
 
@@ -117,10 +120,333 @@ bool AreEquals(const Eigen::MatrixXd& matrix1, const Eigen::MatrixXd& matrix2, c
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Maximum number of tridiagonal problems solved together by <see cref="TridiagonalEigenValues" />. </summary>
+static const size_t TRIDIAGONAL_GROUP = 4;
+
+/// <summary>	Eigen values of symmetric tridiagonal matrices with the root free QL iterations of Pal, Walker and Kahan (as <c>dsterf</c> of LAPACK). </summary>
+/// <param name="diags">		The diagonal of each matrix, replaced by the ascending eigen values. </param>
+/// <param name="subdiags">		The sub diagonal of each matrix (size N-1, destroyed). </param>
+/// <param name="nbMatrices">	The number of matrices (at most <see cref="TRIDIAGONAL_GROUP" />). </param>
+/// <param name="n">			The size of the matrices. </param>
+/// <param name="maxIter">		The maximum number of iterations by eigen value. </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+/// <remarks>
+/// The iterations use the squares of the sub diagonal, so the rotations don't need square root (cheaper than the QR iterations of <c>Eigen::SelfAdjointEigenSolver</c> without eigen vectors).\n
+/// The chain of rotations of one matrix is a chain of dependent divisions, the chains of the matrices are interleaved to compute them at the same time.
+/// </remarks>
+static bool TridiagonalEigenValues(double* const* diags, double* const* subdiags, const size_t nbMatrices, const Eigen::Index n, const size_t maxIter = 30)
+{
+	/// <summary>	State of the QL iteration of one matrix. </summary>
+	struct SChain
+	{
+		Eigen::Index l = 0, m = 0;		///< The chain of rotations is from m-1 to l.
+		size_t iter    = 0;				///< Number of iterations for the current eigen value.
+		double sigma = 0, c = 1, s = 0, gamma = 0, p = 0;
+		bool active  = false;			///< A chain of rotations is prepared.
+	} chains[TRIDIAGONAL_GROUP];
+
+	const double eps2 = std::numeric_limits<double>::epsilon() * std::numeric_limits<double>::epsilon();
+	for (size_t k = 0; k < nbMatrices; ++k) { for (Eigen::Index i = 0; i < n - 1; ++i) { subdiags[k][i] *= subdiags[k][i]; } }
+
+	while (true)
+	{
+		// Prepare the next chain of rotations of each matrix
+		Eigen::Index length = 0;
+		for (size_t k = 0; k < nbMatrices; ++k)
+		{
+			SChain& chain = chains[k];
+			double *d     = diags[k], *e = subdiags[k];
+			chain.active  = false;
+			while (chain.l < n)
+			{
+				// Find a small sub diagonal element to split the matrix
+				const Eigen::Index l = chain.l;
+				Eigen::Index m       = l;
+				for (; m < n - 1; ++m)
+				{
+					const double sum = std::abs(d[m]) + std::abs(d[m + 1]);
+					if (e[m] <= eps2 * sum * sum) { break; }
+				}
+				if (m < n - 1) { e[m] = 0; }
+				if (m == l)										// d[l] is an eigen value
+				{
+					chain.l++;
+					chain.iter = 0;
+					continue;
+				}
+				if (m == l + 1)									// 2x2 block
+				{
+					const double mean = 0.5 * (d[l] + d[l + 1]), half = 0.5 * (d[l] - d[l + 1]), r = std::sqrt(half * half + e[l]);
+					d[l]              = mean + r;
+					d[l + 1]          = mean - r;
+					e[l]              = 0;
+					chain.l += 2;
+					chain.iter = 0;
+					continue;
+				}
+				if (chain.iter++ == maxIter) { return false; }
+
+				// Shift with the 2x2 block at the top
+				const double rte = std::sqrt(e[l]);
+				double sigma     = (d[l + 1] - d[l]) / (2 * rte);
+				const double r   = std::sqrt(sigma * sigma + 1);
+				chain.sigma      = d[l] - rte / (sigma + (sigma >= 0 ? r : -r));
+				chain.m          = m;
+				chain.c          = 1;
+				chain.s          = 0;
+				chain.gamma      = d[m] - chain.sigma;
+				chain.p          = chain.gamma * chain.gamma;
+				chain.active     = true;
+				length           = std::max(length, m - l);
+				break;
+			}
+		}
+		if (length == 0) { break; }								// All eigen values are found
+
+		// Interleaved rotations from m-1 to l
+		for (Eigen::Index t = 0; t < length; ++t)
+		{
+			for (size_t k = 0; k < nbMatrices; ++k)
+			{
+				SChain& chain = chains[k];
+				if (!chain.active || t >= chain.m - chain.l) { continue; }
+				double *d       = diags[k], *e = subdiags[k];
+				const Eigen::Index i = chain.m - 1 - t;
+				const double bb = e[i], r = chain.p + bb;
+				if (t != 0) { e[i + 1] = chain.s * r; }
+				const double oldc = chain.c, oldgam = chain.gamma, alpha = d[i];
+				chain.c     = chain.p / r;
+				chain.s     = bb / r;
+				chain.gamma = chain.c * (alpha - chain.sigma) - chain.s * oldgam;
+				d[i + 1]    = oldgam + (alpha - chain.gamma);
+				chain.p     = chain.c != 0 ? (chain.gamma * chain.gamma) / chain.c : oldc * bb;
+			}
+		}
+		for (size_t k = 0; k < nbMatrices; ++k)
+		{
+			const SChain& chain = chains[k];
+			if (!chain.active) { continue; }
+			subdiags[k][chain.l] = chain.s * chain.p;
+			diags[k][chain.l]    = chain.sigma + chain.gamma;
+		}
+	}
+	for (size_t k = 0; k < nbMatrices; ++k) { std::sort(diags[k], diags[k] + n); }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Copy the lower part of the symmetric matrix mapped to [-1:1] to avoid over and underflow (same as Eigen::SelfAdjointEigenSolver). </summary>
+/// <returns>	The scale of the matrix. </returns>
+template <typename TIn, typename TOut>
+static double ScaleLower(const TIn& matrix, TOut& scaled)
+{
+	const Eigen::Index n = matrix.rows();
+	double scale         = 0;
+	for (Eigen::Index j = 0; j < n; ++j) { for (Eigen::Index i = j; i < n; ++i) { scale = std::max(scale, std::abs(matrix(i, j))); } }
+	if (scale == 0) { scale = 1; }
+	scaled.template triangularView<Eigen::Lower>() = matrix / scale;
+	return scale;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool SelfAdjointEigen(const Eigen::MatrixXd& matrix, Eigen::VectorXd& values, Eigen::MatrixXd& vectors, Eigen::VectorXd& buffer, const bool computeVectors)
+{
+	if (!IsSquare(matrix)) { return false; }					// Verification
+	const Eigen::Index n = matrix.rows();
+	values.resize(n);
+	vectors.resize(n, n);
+	buffer.resize(3 * n);
+	if (n == 1)
+	{
+		values[0] = matrix(0, 0);
+		vectors.setOnes();
+		return true;
+	}
+
+	const double scale = ScaleLower(matrix, vectors);		// Map the coefficients to [-1:1]
+
+	// Tridiagonalization and QR iterations in the buffer
+	Eigen::Map<Eigen::VectorXd> subdiag(buffer.data(), n - 1), coeffs(buffer.data() + n - 1, n - 1), workspace(buffer.data() + 2 * n - 2, n);
+	Eigen::internal::tridiagonalization_inplace(vectors, coeffs);
+	values  = vectors.diagonal();
+	subdiag = vectors.diagonal<-1>();
+	if (computeVectors)
+	{
+		Eigen::HouseholderSequence<Eigen::MatrixXd, Eigen::Map<Eigen::VectorXd>> householder(vectors, coeffs);
+		householder.setLength(n - 1).setShift(1);
+		householder.evalTo(vectors, workspace);				// In place
+	}
+	const Eigen::ComputationInfo info = Eigen::internal::computeFromTridiagonal_impl(values, subdiag, 30, computeVectors, vectors);
+	values *= scale;
+	return info == Eigen::Success;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool SelfAdjointEigenValues(Eigen::MatrixXd& matrices, Eigen::MatrixXd& values, Eigen::MatrixXd& buffer)
+{
+	const Eigen::Index n = matrices.rows();
+	if (n == 0 || matrices.cols() % n != 0) { return false; }	// Verification
+	const Eigen::Index nbMatrices = matrices.cols() / n;
+	values.resize(n, nbMatrices);
+	buffer.resize(n, 2 * nbMatrices);						// Sub diagonal and householder coefficients (and scale at the end)
+	if (n == 1)
+	{
+		values = matrices;
+		return true;
+	}
+
+	// Tridiagonalization of each matrix in place
+	for (Eigen::Index k = 0; k < nbMatrices; ++k)
+	{
+		auto matrix = matrices.middleCols(k * n, n);
+		buffer(n - 1, nbMatrices + k) = ScaleLower(matrix, matrix);	// Map the coefficients to [-1:1]
+		Eigen::Map<Eigen::VectorXd> coeffs(buffer.col(nbMatrices + k).data(), n - 1);
+		Eigen::internal::tridiagonalization_inplace(matrix, coeffs);
+		values.col(k)             = matrix.diagonal();
+		buffer.col(k).head(n - 1) = matrix.diagonal<-1>();
+	}
+
+	// QL iterations by group of matrices
+	for (Eigen::Index first = 0; first < nbMatrices; first += Eigen::Index(TRIDIAGONAL_GROUP))
+	{
+		const size_t nb = size_t(std::min(nbMatrices - first, Eigen::Index(TRIDIAGONAL_GROUP)));
+		double *diags[TRIDIAGONAL_GROUP], *subdiags[TRIDIAGONAL_GROUP];
+		for (size_t k = 0; k < nb; ++k)
+		{
+			diags[k]    = values.col(first + Eigen::Index(k)).data();
+			subdiags[k] = buffer.col(first + Eigen::Index(k)).data();
+		}
+		if (!TridiagonalEigenValues(diags, subdiags, nb, n)) { return false; }
+	}
+	for (Eigen::Index k = 0; k < nbMatrices; ++k) { values.col(k) *= buffer(n - 1, nbMatrices + k); }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
 //************************************************
 //************************************************
 //************************************************
 
+//**************************************************
+//******************** Parallel ********************
+//**************************************************
+//---------------------------------------------------------------------------------------------------
+size_t ParallelThreadCount(const size_t n, const size_t nbThreads)
+{
+	size_t res = nbThreads == 0 ? size_t(std::thread::hardware_concurrency()) : nbThreads;
+	if (res == 0) { res = 1; }
+	return std::max<size_t>(1, std::min(res, n));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+void ParallelFor(const size_t n, const std::function<void(size_t, size_t, size_t)>& function, const size_t nbThreads)
+{
+	if (n == 0) { return; }
+	const size_t nbBlock = ParallelThreadCount(n, nbThreads), size = n / nbBlock, rest = n % nbBlock;
+	std::vector<std::thread> threads;
+	threads.reserve(nbBlock - 1);
+	size_t begin = size + (rest > 0 ? 1 : 0);			// The first block is for the calling thread
+	for (size_t t = 1; t < nbBlock; ++t)
+	{
+		const size_t end = begin + size + (t < rest ? 1 : 0);
+		threads.emplace_back(function, begin, end, t);
+		begin = end;
+	}
+	function(0, size + (rest > 0 ? 1 : 0), 0);
+	for (auto& t : threads) { t.join(); }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Get the block of a job with the split of <see cref="ParallelFor" /> (the first blocks have one more index). </summary>
+/// <param name="n">		The size of the range. </param>
+/// <param name="nbBlock">	The number of blocks. </param>
+/// <param name="job">		The index of the block. </param>
+/// <param name="begin">	The first index of the block. </param>
+/// <param name="end">		The last index of the block (excluded). </param>
+static void ParallelBlock(const size_t n, const size_t nbBlock, const size_t job, size_t& begin, size_t& end)
+{
+	const size_t size = n / nbBlock, rest = n % nbBlock;
+	begin             = job * size + std::min(job, rest);
+	end               = begin + size + (job < rest ? 1 : 0);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+CThreadPool::~CThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_start.notify_all();
+	for (auto& t : m_threads) { t.join(); }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+void CThreadPool::run(const size_t n, const std::function<void(size_t, size_t, size_t)>& function, const size_t nbThreads)
+{
+	if (n == 0) { return; }
+	const size_t nbBlock = ParallelThreadCount(n, nbThreads);
+	if (nbBlock == 1)
+	{
+		function(0, n, 0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// The new threads start from the current loop, so they can't miss the next one
+		while (m_threads.size() + 1 < nbBlock) { m_threads.emplace_back(&CThreadPool::work, this, m_threads.size() + 1, m_generation); }
+		m_function = &function;
+		m_n        = n;
+		m_nbBlock  = nbBlock;
+		m_pending  = nbBlock - 1;
+		++m_generation;
+	}
+	m_start.notify_all();
+
+	size_t begin, end;
+	ParallelBlock(n, nbBlock, 0, begin, end);
+	function(begin, end, 0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]() { return m_pending == 0; });
+	m_function = nullptr;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+void CThreadPool::work(const size_t job, size_t generation)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+		if (m_stop) { return; }
+		generation = m_generation;
+		if (job >= m_nbBlock) { continue; }						// No block for this thread in this loop
+
+		size_t begin, end;
+		ParallelBlock(m_n, m_nbBlock, job, begin, end);
+		const auto& function = *m_function;
+		lock.unlock();
+		function(begin, end, job);
+		lock.lock();
+		if (--m_pending == 0) { m_done.notify_one(); }
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//**************************************************
+//**************************************************
+//**************************************************
+
 //*************************************************************
 //******************** Index Manipulations ********************
 //*************************************************************
@@ -1,9 +1,41 @@
 #include "geometry/Classification.hpp"
 #include "geometry/Covariance.hpp"
 #include "geometry/Basics.hpp"
+#include <limits>
 
 namespace Geometry {
 
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Solve the LSQR system with the class means and the pooled covariance. </summary>
+static bool LSQRSolve(const Eigen::MatrixXd& mean, const Eigen::MatrixXd& cov, Eigen::MatrixXd& weight)
+{
+	// linear least squares systems solver
+	// Chosen solver with the performance table of this page : https://eigen.tuxfamily.org/dox/group__TutorialLinearAlgebra.html
+	weight = cov.colPivHouseholderQr().solve(mean.transpose()).transpose();
+	//weight = cov.completeOrthogonalDecomposition().solve(mean.transpose()).transpose();
+	//weight = cov.bdcSvd(ComputeThinU | ComputeThinV).solve(mean.transpose()).transpose();
+
+	// Treat binary case as a special case
+	if (mean.rows() == 2)
+	{
+		const Eigen::MatrixXd tmp = weight.row(1) - weight.row(0);	// Need to use a tmp variable otherwise sometimes error
+		weight                    = tmp;
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Transform the LSQR Weight to FgDA Weight factors. </summary>
+static bool FgDAFactors(const Eigen::MatrixXd& w, Eigen::MatrixXd& u, Eigen::MatrixXd& v)
+{
+	const size_t nbClass = w.rows();
+	v                    = w.transpose();
+	u                    = v * (w * v).colPivHouseholderQr().solve(Eigen::MatrixXd::Identity(nbClass, nbClass));
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
 ///-------------------------------------------------------------------------------------------------
 bool LSQR(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& weight)
 {
@@ -50,33 +82,77 @@ bool LSQR(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::M
 		cov += (double(nbSample[k]) / double(totalSample)) * classCov;
 	}
 
-	// linear least squares systems solver
-	// Chosen solver with the performance table of this page : https://eigen.tuxfamily.org/dox/group__TutorialLinearAlgebra.html
-	weight = cov.colPivHouseholderQr().solve(mean.transpose()).transpose();
-	//weight = cov.completeOrthogonalDecomposition().solve(mean.transpose()).transpose();
-	//weight = cov.bdcSvd(ComputeThinU | ComputeThinV).solve(mean.transpose()).transpose();
+	return LSQRSolve(mean, cov, weight);
+}
+///-------------------------------------------------------------------------------------------------
 
-	// Treat binary case as a special case
-	if (nbClass == 2)
+///-------------------------------------------------------------------------------------------------
+bool LSQR(const std::vector<CClassStatistics>& statistics, Eigen::MatrixXd& weight)
+{
+	// Precomputation
+	if (statistics.empty()) { return false; }
+	const size_t nbClass = statistics.size(), nbFeatures = statistics[0].getFeaturesCount();
+	size_t totalSample   = 0;
+	for (const auto& s : statistics)
 	{
-		const Eigen::MatrixXd tmp = weight.row(1) - weight.row(0);	// Need to use a tmp variable otherwise sometimes error
-		weight                    = tmp;
+		if (s.getCount() == 0 || s.getFeaturesCount() != nbFeatures) { return false; }
+		totalSample += s.getCount();
 	}
-	return true;
+
+	// Compute Class Euclidian mean and pooled Covariance
+	Eigen::MatrixXd mean(nbClass, nbFeatures), cov = Eigen::MatrixXd::Zero(nbFeatures, nbFeatures), classCov;
+	for (size_t k = 0; k < nbClass; ++k)
+	{
+		mean.row(k) = statistics[k].getMean();
+		if (!statistics[k].covarianceLWF(classCov)) { return false; }
+		cov += (double(statistics[k].getCount()) / double(totalSample)) * classCov;
+	}
+
+	return LSQRSolve(mean, cov, weight);
 }
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
 bool FgDACompute(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& weight)
+{
+	Eigen::MatrixXd u, v;
+	if (!FgDACompute(datasets, u, v)) { return false; }
+	weight = u * v.transpose();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool FgDACompute(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets, Eigen::MatrixXd& u, Eigen::MatrixXd& v)
 {
 	// Compute LSQR Weight
 	Eigen::MatrixXd w;
 	if (!LSQR(datasets, w)) { return false; }
-	const size_t nbClass = w.rows();
+	return FgDAFactors(w, u, v);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool FgDACompute(const std::vector<CClassStatistics>& statistics, Eigen::MatrixXd& u, Eigen::MatrixXd& v)
+{
+	// Compute LSQR Weight
+	Eigen::MatrixXd w;
+	if (!LSQR(statistics, w)) { return false; }
+	return FgDAFactors(w, u, v);
+}
+///-------------------------------------------------------------------------------------------------
 
-	// Transform to FgDA Weight
-	const Eigen::MatrixXd wT = w.transpose();
-	weight                   = (wT * (w * wT).colPivHouseholderQr().solve(Eigen::MatrixXd::Identity(nbClass, nbClass))) * w;
+///-------------------------------------------------------------------------------------------------
+bool FgDAFactorize(const Eigen::MatrixXd& weight, Eigen::MatrixXd& u, Eigen::MatrixXd& v, const double tolerance)
+{
+	if (weight.rows() != weight.cols() || weight.size() == 0) { return false; }
+	const Eigen::BDCSVD<Eigen::MatrixXd> svd(weight, Eigen::ComputeThinU | Eigen::ComputeThinV);
+	const Eigen::VectorXd& s = svd.singularValues();
+	Eigen::Index rank        = 0;
+	while (rank < s.size() && s[rank] > tolerance * s[0]) { rank++; }
+	if (rank == 0) { rank = 1; }	// Keep at least one component (null weight)
+	u = svd.matrixU().leftCols(rank) * s.head(rank).asDiagonal();
+	v = svd.matrixV().leftCols(rank);
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -90,4 +166,38 @@ bool FgDAApply(const Eigen::RowVectorXd& in, Eigen::RowVectorXd& out, const Eige
 }
 ///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+bool FgDAApply(const Eigen::RowVectorXd& in, Eigen::RowVectorXd& out, const Eigen::MatrixXd& u, const Eigen::MatrixXd& v)
+{
+	if (in.cols() != u.rows() || u.cols() != v.cols()) { return false; }
+	out.noalias() = (in * u) * v.transpose();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void DistancesToProbabilities(const std::vector<double>& distance, size_t& classId, std::vector<double>& probability)
+{
+	double distMin = std::numeric_limits<double>::max();	// Init of distance min
+	for (size_t k = 0; k < distance.size(); ++k)
+	{
+		if (distMin > distance[k])
+		{
+			classId = k;
+			distMin = distance[k];
+		}
+	}
+
+	probability.resize(distance.size());
+	double sumProbability = 0.0;
+	for (size_t k = 0; k < distance.size(); ++k)
+	{
+		probability[k] = distMin / distance[k];
+		sumProbability += probability[k];
+	}
+
+	for (auto& p : probability) { p /= sumProbability; }
+}
+///-------------------------------------------------------------------------------------------------
+
 }  // namespace Geometry
@@ -0,0 +1,205 @@
+#include "geometry/Clustering.hpp"
+#include "geometry/Basics.hpp"
+#include "geometry/Distance.hpp"
+#include "geometry/Mean.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Geometry {
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Distance between a matrix and a centroid with the precomputed factors (the rounding error of the distance of a matrix with itself can give NaN with some metrics, it's 0). </summary>
+static double ClusterDistance(const Eigen::MatrixXd& a, const Eigen::MatrixXd& aFactor, const Eigen::MatrixXd& b, const Eigen::MatrixXd& bFactor,
+							  const EMetric metric, SSymmetricBuffers& buffers)
+{
+	const double d = DistanceFactorized(a, aFactor, b, bFactor, metric, buffers);
+	return std::isnan(d) ? 0.0 : d;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Compute in parallel the sample factor of each matrix (see <see cref="DistanceSampleFactor" />), computed once for all iterations. </summary>
+static bool SampleFactors(const std::vector<Eigen::MatrixXd>& matrices, std::vector<Eigen::MatrixXd>& factors, const EMetric metric, const size_t nbThreads)
+{
+	const size_t n = matrices.size();
+	factors.resize(n);
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(n, nbThreads));
+	std::vector<char> valid(n, 0);
+	ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t i = begin; i < end; ++i) { valid[i] = char(DistanceSampleFactor(matrices[i], factors[i], metric, buffers[job])); }
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Seed the centroids with k-means++ (the next centroid is drawn with a probability proportional to the squared distance to the nearest centroid). </summary>
+static bool SeedCentroids(const std::vector<Eigen::MatrixXd>& matrices, const std::vector<Eigen::MatrixXd>& samples, const size_t nbClusters,
+						  std::vector<Eigen::MatrixXd>& centroids, const EMetric metric, const unsigned int seed, const size_t nbThreads)
+{
+	const size_t n = matrices.size();
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<double> nearest(n, std::numeric_limits<double>::max());		// Squared distance to the nearest centroid
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(n, nbThreads));
+
+	centroids.clear();
+	centroids.reserve(nbClusters);
+	centroids.push_back(matrices[std::min(n - 1, size_t(uniform(generator) * double(n)))]);
+	while (centroids.size() < nbClusters)
+	{
+		Eigen::MatrixXd factor;
+		if (!DistanceReferenceFactor(centroids.back(), factor, metric)) { return false; }
+		ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const double d = ClusterDistance(matrices[i], samples[i], centroids.back(), factor, metric, buffers[job]);
+				nearest[i]     = std::min(nearest[i], d * d);
+			}
+		}, nbThreads);
+
+		double sum = 0;
+		for (const auto& d : nearest) { sum += d; }
+		size_t next = n - 1;
+		if (sum > 0)												// Draw with the squared distances
+		{
+			double r = uniform(generator) * sum;
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (nearest[i] <= 0) { continue; }
+				next = i;										// Last candidate if the rounding error keeps r positive
+				r -= nearest[i];
+				if (r < 0) { break; }
+			}
+		}
+		else { next = std::min(n - 1, size_t(uniform(generator) * double(n))); }	// All matrices are on a centroid
+		centroids.push_back(matrices[next]);
+	}
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Assign in parallel each matrix to the nearest centroid (the factor of each centroid is computed once). </summary>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise, \p changed is set if one label is modified. </returns>
+static bool AssignClusters(const std::vector<Eigen::MatrixXd>& matrices, const std::vector<Eigen::MatrixXd>& samples, const std::vector<Eigen::MatrixXd>& centroids,
+						   std::vector<size_t>& labels, std::vector<double>& distances, const EMetric metric, const size_t nbThreads, bool& changed)
+{
+	const size_t n = matrices.size(), k = centroids.size();
+	std::vector<Eigen::MatrixXd> factors(k);
+	for (size_t c = 0; c < k; ++c) { if (!DistanceReferenceFactor(centroids[c], factors[c], metric)) { return false; } }
+
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(n, nbThreads));
+	std::vector<char> modified(n, 0);
+	ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t label = 0;
+			double best  = std::numeric_limits<double>::max();
+			for (size_t c = 0; c < k; ++c)
+			{
+				const double d = ClusterDistance(matrices[i], samples[i], centroids[c], factors[c], metric, buffers[job]);
+				if (d < best)
+				{
+					best  = d;
+					label = c;
+				}
+			}
+			modified[i]  = char(labels[i] != label);
+			labels[i]    = label;
+			distances[i] = best;
+		}
+	}, nbThreads);
+
+	changed = false;
+	for (const auto& m : modified) { if (m != 0) { changed = true; } }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Update in parallel each centroid with the mean of its cluster started from the previous centroid, an empty cluster takes the farthest matrix. </summary>
+static bool UpdateCentroids(const std::vector<Eigen::MatrixXd>& matrices, std::vector<Eigen::MatrixXd>& centroids, std::vector<size_t>& labels,
+							std::vector<double>& distances, const EMetric metric, const size_t nbThreads)
+{
+	const size_t n = matrices.size(), k = centroids.size();
+	std::vector<size_t> sizes(k, 0);
+	for (const auto& l : labels) { sizes[l]++; }
+	for (size_t c = 0; c < k; ++c)
+	{
+		if (sizes[c] != 0) { continue; }
+		size_t farthest = n;										// Farthest matrix which isn't alone in its cluster
+		for (size_t i = 0; i < n; ++i) { if (sizes[labels[i]] > 1 && (farthest == n || distances[i] > distances[farthest])) { farthest = i; } }
+		if (farthest == n) { return false; }
+		sizes[labels[farthest]]--;
+		sizes[c]            = 1;
+		centroids[c]        = matrices[farthest];
+		labels[farthest]    = c;
+		distances[farthest] = 0;
+	}
+
+	std::vector<std::vector<Eigen::MatrixXd>> clusters(k);
+	for (size_t i = 0; i < n; ++i) { clusters[labels[i]].push_back(matrices[i]); }
+
+	std::vector<char> valid(k, 0);
+	ParallelFor(k, [&](const size_t begin, const size_t end, const size_t /*job*/)
+	{
+		for (size_t c = begin; c < end; ++c) { valid[c] = char(MeanWarmStart(clusters[c], centroids[c], metric)); }
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool KMeans(const std::vector<Eigen::MatrixXd>& matrices, const size_t nbClusters, std::vector<Eigen::MatrixXd>& centroids, std::vector<size_t>& labels,
+			const EMetric metric, const size_t maxIter, const unsigned int seed, const size_t nbThreads)
+{
+	if (!AreNotEmpty(matrices) || !AreSquare(matrices) || !HaveSameSize(matrices)) { return false; }	// Verification of the set
+	if (nbClusters == 0 || nbClusters > matrices.size()) { return false; }
+
+	std::vector<Eigen::MatrixXd> samples;
+	if (!SampleFactors(matrices, samples, metric, nbThreads)) { return false; }
+	if (!SeedCentroids(matrices, samples, nbClusters, centroids, metric, seed, nbThreads)) { return false; }
+
+	labels.assign(matrices.size(), nbClusters);
+	std::vector<double> distances(matrices.size(), 0);
+	for (size_t iter = 0; ; ++iter)
+	{
+		bool changed = false;
+		if (!AssignClusters(matrices, samples, centroids, labels, distances, metric, nbThreads, changed)) { return false; }
+		if (!changed || iter >= maxIter) { break; }				// Stopping criterion
+		if (!UpdateCentroids(matrices, centroids, labels, distances, metric, nbThreads)) { return false; }
+	}
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool KMeansPrototypes(const std::vector<std::vector<Eigen::MatrixXd>>& datasets, const size_t nbPrototypes, std::vector<Eigen::MatrixXd>& means,
+					  std::vector<size_t>& classes, const EMetric metric, const size_t maxIter, const unsigned int seed, const size_t nbThreads)
+{
+	if (datasets.empty() || nbPrototypes == 0) { return false; }
+	means.clear();
+	classes.clear();
+	for (size_t k = 0; k < datasets.size(); ++k)
+	{
+		std::vector<Eigen::MatrixXd> centroids;
+		std::vector<size_t> labels;
+		if (!KMeans(datasets[k], std::min(nbPrototypes, datasets[k].size()), centroids, labels, metric, maxIter, seed, nbThreads)) { return false; }
+		for (auto& c : centroids)
+		{
+			means.push_back(std::move(c));
+			classes.push_back(k);
+		}
+	}
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
@@ -7,17 +7,18 @@ namespace Geometry {
 //---------------------------------------------------------------------------------------------------
 double Distance(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, const EMetric metric)
 {
-	if (!HaveSameSize(a, b)) { return 0; }
 	switch (metric)
 	{
-		case EMetric::Riemann: return DistanceRiemann(a, b);
-		case EMetric::Euclidian: return DistanceEuclidian(a, b);
-		case EMetric::LogEuclidian: return DistanceLogEuclidian(a, b);
-		case EMetric::LogDet: return DistanceLogDet(a, b);
-		case EMetric::Kullback: return DistanceKullbackSym(a, b);
-		case EMetric::Wasserstein: return DistanceWasserstein(a, b);
+		case EMetric::Riemann: return Distance<EMetric::Riemann>(a, b);
+		case EMetric::Euclidian: return Distance<EMetric::Euclidian>(a, b);
+		case EMetric::LogEuclidian: return Distance<EMetric::LogEuclidian>(a, b);
+		case EMetric::LogDet: return Distance<EMetric::LogDet>(a, b);
+		case EMetric::Kullback: return Distance<EMetric::Kullback>(a, b);
+		case EMetric::ALE: return Distance<EMetric::ALE>(a, b);
+		case EMetric::Harmonic: return Distance<EMetric::Harmonic>(a, b);
+		case EMetric::Wasserstein: return Distance<EMetric::Wasserstein>(a, b);
 		case EMetric::Identity:
-		default: return 1.0;
+		default: return Distance<EMetric::Identity>(a, b);
 	}
 }
 //---------------------------------------------------------------------------------------------------
@@ -65,4 +66,225 @@ double DistanceWasserstein(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b)
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+bool DistanceReferenceFactor(const Eigen::MatrixXd& b, Eigen::MatrixXd& factor, const EMetric metric)
+{
+	if (!IsSquare(b)) { return false; }
+	switch (metric)
+	{
+		case EMetric::Riemann:
+		{
+			const Eigen::LLT<Eigen::MatrixXd> llt(b);
+			if (llt.info() != Eigen::Success) { return false; }	// Not a SPD Matrix
+			factor = llt.matrixL().solve(Eigen::MatrixXd::Identity(b.rows(), b.cols()));
+			return true;
+		}
+		case EMetric::LogEuclidian: factor = b.log();
+			return true;
+		case EMetric::Wasserstein: factor = b.sqrt();
+			return true;
+		default: factor.resize(0, 0);
+			return true;
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool DistanceSampleFactor(const Eigen::MatrixXd& a, Eigen::MatrixXd& factor, const EMetric metric)
+{
+	if (!IsSquare(a)) { return false; }
+	if (metric == EMetric::LogEuclidian) { factor = a.log(); }
+	else { factor.resize(0, 0); }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+double DistanceFactorized(const Eigen::MatrixXd& a, const Eigen::MatrixXd& aFactor, const Eigen::MatrixXd& b, const Eigen::MatrixXd& bFactor, const EMetric metric)
+{
+	if (!HaveSameSize(a, b)) { return 0; }
+	switch (metric)
+	{
+		case EMetric::Riemann:
+		{
+			const Eigen::MatrixXd tmp = bFactor.triangularView<Eigen::Lower>() * a,
+								  m   = tmp * bFactor.transpose();
+			const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(m, Eigen::EigenvaluesOnly);
+			return sqrt(es.eigenvalues().array().log().square().sum());
+		}
+		case EMetric::LogEuclidian: return (bFactor - aFactor).norm();
+		case EMetric::Wasserstein:
+		{
+			const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(bFactor * a * bFactor, Eigen::EigenvaluesOnly);
+			return sqrt(a.trace() + b.trace() - 2 * es.eigenvalues().array().max(0).sqrt().sum());
+		}
+		default: return Distance(a, b, metric);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool DistanceReferenceFactor(const Eigen::MatrixXd& b, Eigen::MatrixXd& factor, const EMetric metric, SSymmetricBuffers& buffers)
+{
+	switch (metric)
+	{
+		case EMetric::Riemann: return DistanceReferenceFactor<EMetric::Riemann>(b, factor, buffers);
+		case EMetric::Euclidian: return DistanceReferenceFactor<EMetric::Euclidian>(b, factor, buffers);
+		case EMetric::LogEuclidian: return DistanceReferenceFactor<EMetric::LogEuclidian>(b, factor, buffers);
+		case EMetric::LogDet: return DistanceReferenceFactor<EMetric::LogDet>(b, factor, buffers);
+		case EMetric::Kullback: return DistanceReferenceFactor<EMetric::Kullback>(b, factor, buffers);
+		case EMetric::ALE: return DistanceReferenceFactor<EMetric::ALE>(b, factor, buffers);
+		case EMetric::Harmonic: return DistanceReferenceFactor<EMetric::Harmonic>(b, factor, buffers);
+		case EMetric::Wasserstein: return DistanceReferenceFactor<EMetric::Wasserstein>(b, factor, buffers);
+		case EMetric::Identity:
+		default: return DistanceReferenceFactor<EMetric::Identity>(b, factor, buffers);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool DistanceSampleFactor(const Eigen::MatrixXd& a, Eigen::MatrixXd& factor, const EMetric metric, SSymmetricBuffers& buffers)
+{
+	switch (metric)
+	{
+		case EMetric::Riemann: return DistanceSampleFactor<EMetric::Riemann>(a, factor, buffers);
+		case EMetric::Euclidian: return DistanceSampleFactor<EMetric::Euclidian>(a, factor, buffers);
+		case EMetric::LogEuclidian: return DistanceSampleFactor<EMetric::LogEuclidian>(a, factor, buffers);
+		case EMetric::LogDet: return DistanceSampleFactor<EMetric::LogDet>(a, factor, buffers);
+		case EMetric::Kullback: return DistanceSampleFactor<EMetric::Kullback>(a, factor, buffers);
+		case EMetric::ALE: return DistanceSampleFactor<EMetric::ALE>(a, factor, buffers);
+		case EMetric::Harmonic: return DistanceSampleFactor<EMetric::Harmonic>(a, factor, buffers);
+		case EMetric::Wasserstein: return DistanceSampleFactor<EMetric::Wasserstein>(a, factor, buffers);
+		case EMetric::Identity:
+		default: return DistanceSampleFactor<EMetric::Identity>(a, factor, buffers);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+double DistanceFactorized(const Eigen::MatrixXd& a, const Eigen::MatrixXd& aFactor, const Eigen::MatrixXd& b, const Eigen::MatrixXd& bFactor,
+						  const EMetric metric, SSymmetricBuffers& buffers)
+{
+	switch (metric)
+	{
+		case EMetric::Riemann: return DistanceFactorized<EMetric::Riemann>(a, aFactor, b, bFactor, buffers);
+		case EMetric::Euclidian: return DistanceFactorized<EMetric::Euclidian>(a, aFactor, b, bFactor, buffers);
+		case EMetric::LogEuclidian: return DistanceFactorized<EMetric::LogEuclidian>(a, aFactor, b, bFactor, buffers);
+		case EMetric::LogDet: return DistanceFactorized<EMetric::LogDet>(a, aFactor, b, bFactor, buffers);
+		case EMetric::Kullback: return DistanceFactorized<EMetric::Kullback>(a, aFactor, b, bFactor, buffers);
+		case EMetric::ALE: return DistanceFactorized<EMetric::ALE>(a, aFactor, b, bFactor, buffers);
+		case EMetric::Harmonic: return DistanceFactorized<EMetric::Harmonic>(a, aFactor, b, bFactor, buffers);
+		case EMetric::Wasserstein: return DistanceFactorized<EMetric::Wasserstein>(a, aFactor, b, bFactor, buffers);
+		case EMetric::Identity:
+		default: return DistanceFactorized<EMetric::Identity>(a, aFactor, b, bFactor, buffers);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//*********************************************************
+//******************** Distance Matrix ********************
+//*********************************************************
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Size of the square tiles of pairs computed by <see cref="DistanceMatrix" /> (the factors of one tile are reused in cache). </summary>
+static const size_t DISTANCE_TILE = 32;
+
+/// <summary>	Compute in parallel the factor of each matrix used by <see cref="DistanceFactorized" />. </summary>
+/// <param name="matrices">		The matrices. </param>
+/// <param name="factors">		The factor of each matrix. </param>
+/// <param name="metric">		The metric (see <see cref="EMetric"/>). </param>
+/// <param name="reference">	Compute the reference factors (see <see cref="DistanceReferenceFactor" />) or the sample factors (see <see cref="DistanceSampleFactor" />). </param>
+/// <param name="nbThreads">	The maximum number of threads (0 for the hardware concurrency). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+static bool DistanceFactors(const std::vector<Eigen::MatrixXd>& matrices, std::vector<Eigen::MatrixXd>& factors, const EMetric metric, const bool reference,
+							const size_t nbThreads)
+{
+	const size_t n = matrices.size();
+	factors.resize(n);
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(n, nbThreads));
+	std::vector<char> valid(n, 0);
+	ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			valid[i] = char(reference ? DistanceReferenceFactor(matrices[i], factors[i], metric, buffers[job])
+									  : DistanceSampleFactor(matrices[i], factors[i], metric, buffers[job]));
+		}
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool DistanceMatrix(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& distances, const EMetric metric, const size_t nbThreads)
+{
+	if (!AreNotEmpty(matrices) || !AreSquare(matrices) || !HaveSameSize(matrices)) { return false; }	// Verification of the set
+	const size_t n = matrices.size(), nbTiles = (n + DISTANCE_TILE - 1) / DISTANCE_TILE;
+	std::vector<Eigen::MatrixXd> references, samples;
+	if (!DistanceFactors(matrices, references, metric, true, nbThreads) || !DistanceFactors(matrices, samples, metric, false, nbThreads)) { return false; }
+
+	// Tiles of the upper triangle
+	std::vector<std::pair<size_t, size_t>> tiles;
+	tiles.reserve(nbTiles * (nbTiles + 1) / 2);
+	for (size_t r = 0; r < nbTiles; ++r) { for (size_t c = r; c < nbTiles; ++c) { tiles.emplace_back(r, c); } }
+
+	distances.resize(Eigen::Index(n), Eigen::Index(n));
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(tiles.size(), nbThreads));
+	ParallelFor(tiles.size(), [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t t = begin; t < end; ++t)
+		{
+			const size_t rBegin = tiles[t].first * DISTANCE_TILE, rEnd = std::min(n, rBegin + DISTANCE_TILE),
+						 cBegin = tiles[t].second * DISTANCE_TILE, cEnd = std::min(n, cBegin + DISTANCE_TILE);
+			for (size_t i = rBegin; i < rEnd; ++i)
+			{
+				distances(Eigen::Index(i), Eigen::Index(i)) = 0;
+				for (size_t j = std::max(cBegin, i + 1); j < cEnd; ++j)
+				{
+					const double d = DistanceFactorized(matrices[j], samples[j], matrices[i], references[i], metric, buffers[job]);
+					distances(Eigen::Index(i), Eigen::Index(j)) = d;
+					distances(Eigen::Index(j), Eigen::Index(i)) = d;
+				}
+			}
+		}
+	}, nbThreads);
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool DistanceMatrix(const std::vector<Eigen::MatrixXd>& a, const std::vector<Eigen::MatrixXd>& b, Eigen::MatrixXd& distances, const EMetric metric,
+					const size_t nbThreads)
+{
+	if (!AreNotEmpty(a) || !AreNotEmpty(b) || !AreSquare(a) || !HaveSameSize(a) || !HaveSameSize(b) || !HaveSameSize(a[0], b[0])) { return false; }
+	const size_t n = a.size(), m = b.size(), nbRowTiles = (n + DISTANCE_TILE - 1) / DISTANCE_TILE, nbColTiles = (m + DISTANCE_TILE - 1) / DISTANCE_TILE;
+	std::vector<Eigen::MatrixXd> samples, references;
+	if (!DistanceFactors(a, samples, metric, false, nbThreads) || !DistanceFactors(b, references, metric, true, nbThreads)) { return false; }
+
+	distances.resize(Eigen::Index(n), Eigen::Index(m));
+	const size_t nbTiles = nbRowTiles * nbColTiles;
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(nbTiles, nbThreads));
+	ParallelFor(nbTiles, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t t = begin; t < end; ++t)
+		{
+			const size_t rBegin = (t / nbColTiles) * DISTANCE_TILE, rEnd = std::min(n, rBegin + DISTANCE_TILE),
+						 cBegin = (t % nbColTiles) * DISTANCE_TILE, cEnd = std::min(m, cBegin + DISTANCE_TILE);
+			for (size_t j = cBegin; j < cEnd; ++j)
+			{
+				for (size_t i = rBegin; i < rEnd; ++i)
+				{
+					distances(Eigen::Index(i), Eigen::Index(j)) = DistanceFactorized(a[i], samples[i], b[j], references[j], metric, buffers[job]);
+				}
+			}
+		}
+	}, nbThreads);
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//*********************************************************
+//*********************************************************
+//*********************************************************
+
 }  // namespace Geometry
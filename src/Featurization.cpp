@@ -89,4 +89,143 @@ bool UnTangentSpace(const Eigen::RowVectorXd& in, Eigen::MatrixXd& out, const Ei
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+bool TangentSpaceFactorized(const Eigen::MatrixXd& in, Eigen::RowVectorXd& out, const Eigen::MatrixXd& refIS, SSymmetricBuffers& buffers)
+{
+	if (!IsSquare(in) || !HaveSameSize(in, refIS)) { return false; }	// Verification
+	const Eigen::Index n = in.rows();							// Number of Features			=> N
+
+	buffers.product.noalias() = refIS * in;						// Transformation Matrix		=> J
+	buffers.matrix.noalias()  = buffers.product * refIS;
+	if (!SelfAdjointFunction(buffers.matrix, buffers.matrix, [](const double x) { return log(x); }, buffers)) { return false; }
+
+	out.resize(n * (n + 1) / 2);								// Upper triangle of J with the coefficients
+	Eigen::Index idx = 0;
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		out[idx++] = buffers.matrix(i, i);
+		for (Eigen::Index j = i + 1; j < n; ++j) { out[idx++] = M_SQRT2 * buffers.matrix(i, j); }
+	}
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool UnTangentSpaceFactorized(const Eigen::RowVectorXd& in, Eigen::MatrixXd& out, const Eigen::MatrixXd& refS, SSymmetricBuffers& buffers)
+{
+	const Eigen::Index n = refS.rows();							// Number of Features			=> N
+	if (!IsSquare(refS) || in.size() != n * (n + 1) / 2) { return false; }	// Verification
+
+	buffers.matrix.resize(n, n);								// Symmetric matrix with the coefficients
+	Eigen::Index idx = 0;
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		buffers.matrix(i, i) = in[idx++];
+		for (Eigen::Index j = i + 1; j < n; ++j) { buffers.matrix(i, j) = buffers.matrix(j, i) = in[idx++] / M_SQRT2; }
+	}
+	if (!SelfAdjointFunction(buffers.matrix, buffers.matrix, [](const double x) { return exp(x); }, buffers)) { return false; }
+	buffers.product.noalias() = refS * buffers.matrix;
+	out.noalias()             = buffers.product * refS;
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//*********************************************************
+//******************** Tangent Kernel *********************
+//*********************************************************
+/// <summary>	Number of rows of the square blocks computed by <see cref="GramMatrix" /> (the rows of one block are reused in cache). </summary>
+static const size_t GRAM_BLOCK = 64;
+
+//---------------------------------------------------------------------------------------------------
+bool TangentSpace(const std::vector<Eigen::MatrixXd>& in, Eigen::MatrixXd& out, const Eigen::MatrixXd& ref, const size_t nbThreads)
+{
+	if (!AreNotEmpty(in) || !AreSquare(in) || !HaveSameSize(in)) { return false; }	// Verification of the set
+	if (ref.size() != 0 && !HaveSameSize(in[0], ref)) { return false; }
+	const Eigen::Index n = in[0].rows();
+	const Eigen::MatrixXd refIS = (ref.size() == 0) ? Eigen::MatrixXd(Eigen::MatrixXd::Identity(n, n)) : Eigen::MatrixXd(Eigen::MatrixXd(ref.sqrt()).inverse());
+
+	out.resize(Eigen::Index(in.size()), n * (n + 1) / 2);
+	std::vector<SSymmetricBuffers> buffers(ParallelThreadCount(in.size(), nbThreads));
+	std::vector<char> valid(in.size(), 0);
+	ParallelFor(in.size(), [&](const size_t begin, const size_t end, const size_t job)
+	{
+		Eigen::RowVectorXd row;
+		for (size_t i = begin; i < end; ++i)
+		{
+			valid[i] = char(TangentSpaceFactorized(in[i], row, refIS, buffers[job]) && row.allFinite());
+			out.row(Eigen::Index(i)) = row;
+		}
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool GramMatrix(const Eigen::MatrixXd& vectors, Eigen::MatrixXd& gram, const size_t nbThreads)
+{
+	if (vectors.size() == 0) { return false; }
+	const size_t n = vectors.rows(), nbBlocks = (n + GRAM_BLOCK - 1) / GRAM_BLOCK;
+
+	// Blocks of the lower triangle
+	std::vector<std::pair<size_t, size_t>> blocks;
+	blocks.reserve(nbBlocks * (nbBlocks + 1) / 2);
+	for (size_t r = 0; r < nbBlocks; ++r) { for (size_t c = 0; c <= r; ++c) { blocks.emplace_back(r, c); } }
+
+	gram.resize(Eigen::Index(n), Eigen::Index(n));
+	ParallelFor(blocks.size(), [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t b = begin; b < end; ++b)
+		{
+			const Eigen::Index r = Eigen::Index(blocks[b].first * GRAM_BLOCK), c = Eigen::Index(blocks[b].second * GRAM_BLOCK),
+							   nR = std::min(Eigen::Index(GRAM_BLOCK), Eigen::Index(n) - r), nC = std::min(Eigen::Index(GRAM_BLOCK), Eigen::Index(n) - c);
+			gram.block(r, c, nR, nC).noalias() = vectors.middleRows(r, nR) * vectors.middleRows(c, nC).transpose();
+		}
+	}, nbThreads);
+	gram.triangularView<Eigen::StrictlyUpper>() = gram.transpose();	// Symmetric copy of the lower triangle
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool GramMatrix(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& gram, const size_t nbThreads)
+{
+	if (a.size() == 0 || b.size() == 0 || a.cols() != b.cols()) { return false; }
+	const size_t n = a.rows(), nbBlocks = (n + GRAM_BLOCK - 1) / GRAM_BLOCK;
+	gram.resize(a.rows(), b.rows());
+	ParallelFor(nbBlocks, [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t blk = begin; blk < end; ++blk)
+		{
+			const Eigen::Index r = Eigen::Index(blk * GRAM_BLOCK), nR = std::min(Eigen::Index(GRAM_BLOCK), Eigen::Index(n) - r);
+			gram.middleRows(r, nR).noalias() = a.middleRows(r, nR) * b.transpose();
+		}
+	}, nbThreads);
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool TangentKernel(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& kernel, const Eigen::MatrixXd& ref, const size_t nbThreads)
+{
+	Eigen::MatrixXd vectors;
+	if (!TangentSpace(matrices, vectors, ref, nbThreads)) { return false; }
+	return GramMatrix(vectors, kernel, nbThreads);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool TangentKernel(const std::vector<Eigen::MatrixXd>& a, const std::vector<Eigen::MatrixXd>& b, Eigen::MatrixXd& kernel, const Eigen::MatrixXd& ref,
+				   const size_t nbThreads)
+{
+	Eigen::MatrixXd vA, vB;
+	if (!TangentSpace(a, vA, ref, nbThreads) || !TangentSpace(b, vB, ref, nbThreads)) { return false; }
+	return GramMatrix(vA, vB, kernel, nbThreads);
+}
+//---------------------------------------------------------------------------------------------------
+
+//*********************************************************
+//*********************************************************
+//*********************************************************
+
 }  // namespace Geometry
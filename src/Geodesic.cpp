@@ -7,16 +7,37 @@ namespace Geometry {
 //---------------------------------------------------------------------------------------------------
 bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, const EMetric metric, const double alpha)
 {
-	if (!HaveSameSize(a, b)) { return false; }						// Verification same size
-	if (!IsSquare(a)) { return false; }								// Verification square matrix
-	if (!InRange(alpha, 0, 1)) { return false; }					// Verification alpha in [0;1]
-	switch (metric)													// Switch metric
+	switch (metric)
+	{
+		case EMetric::Riemann: return Geodesic<EMetric::Riemann>(a, b, g, alpha);
+		case EMetric::Euclidian: return Geodesic<EMetric::Euclidian>(a, b, g, alpha);
+		case EMetric::LogEuclidian: return Geodesic<EMetric::LogEuclidian>(a, b, g, alpha);
+		case EMetric::LogDet: return Geodesic<EMetric::LogDet>(a, b, g, alpha);
+		case EMetric::Kullback: return Geodesic<EMetric::Kullback>(a, b, g, alpha);
+		case EMetric::ALE: return Geodesic<EMetric::ALE>(a, b, g, alpha);
+		case EMetric::Harmonic: return Geodesic<EMetric::Harmonic>(a, b, g, alpha);
+		case EMetric::Wasserstein: return Geodesic<EMetric::Wasserstein>(a, b, g, alpha);
+		case EMetric::Identity:
+		default: return Geodesic<EMetric::Identity>(a, b, g, alpha);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool Geodesic(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, const EMetric metric, const double alpha, SSymmetricBuffers& buffers)
+{
+	switch (metric)
 	{
-		case EMetric::Riemann: return GeodesicRiemann(a, b, g, alpha);
-		case EMetric::Euclidian: return GeodesicEuclidian(a, b, g, alpha);
-		case EMetric::LogEuclidian: return GeodesicLogEuclidian(a, b, g, alpha);
+		case EMetric::Riemann: return Geodesic<EMetric::Riemann>(a, b, g, alpha, buffers);
+		case EMetric::Euclidian: return Geodesic<EMetric::Euclidian>(a, b, g, alpha, buffers);
+		case EMetric::LogEuclidian: return Geodesic<EMetric::LogEuclidian>(a, b, g, alpha, buffers);
+		case EMetric::LogDet: return Geodesic<EMetric::LogDet>(a, b, g, alpha, buffers);
+		case EMetric::Kullback: return Geodesic<EMetric::Kullback>(a, b, g, alpha, buffers);
+		case EMetric::ALE: return Geodesic<EMetric::ALE>(a, b, g, alpha, buffers);
+		case EMetric::Harmonic: return Geodesic<EMetric::Harmonic>(a, b, g, alpha, buffers);
+		case EMetric::Wasserstein: return Geodesic<EMetric::Wasserstein>(a, b, g, alpha, buffers);
 		case EMetric::Identity:
-		default: return GeodesicIdentity(a, b, g, alpha);
+		default: return Geodesic<EMetric::Identity>(a, b, g, alpha, buffers);
 	}
 }
 //---------------------------------------------------------------------------------------------------
@@ -54,4 +75,24 @@ bool GeodesicIdentity(const Eigen::MatrixXd& a, const Eigen::MatrixXd& /*b*/, Ei
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+bool GeodesicLogCholesky(const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, Eigen::MatrixXd& g, const double alpha, SSymmetricBuffers& buffers)
+{
+	if (!HaveSameSize(a, b)) { return false; }						// Verification same size
+	if (!IsSquare(a)) { return false; }								// Verification square matrix
+	if (!InRange(alpha, 0, 1)) { return false; }					// Verification alpha in [0;1]
+	buffers.matrix  = a;
+	buffers.product = b;
+	if (Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(buffers.matrix) >= 0) { return false; }		// Not a SPD Matrix
+	if (Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(buffers.product) >= 0) { return false; }	// Not a SPD Matrix
+
+	// Straight line on the strictly lower part and on the log of the diagonal of the Cholesky factors
+	buffers.matrix.triangularView<Eigen::StrictlyLower>() = (1 - alpha) * buffers.matrix + alpha * buffers.product;
+	for (Eigen::Index i = 0; i < buffers.matrix.rows(); ++i) { buffers.matrix(i, i) = std::pow(buffers.matrix(i, i), 1 - alpha) * std::pow(buffers.product(i, i), alpha); }
+	buffers.matrix.triangularView<Eigen::StrictlyUpper>().setZero();
+	g.noalias() = buffers.matrix * buffers.matrix.transpose();
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
 }  // namespace Geometry
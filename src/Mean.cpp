@@ -13,39 +13,114 @@ static const double EPSILON  = 0.0001;			// 10^{-4}
 static const size_t ITER_MAX = 50;
 
 //---------------------------------------------------------------------------------------------------
-bool Mean(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean, const EMetric metric)
+/// <summary>	Iterative procedure of the Riemannian mean from the initial mean (see <see cref="MeanRiemann"/>). </summary>
+static bool MeanRiemannIterations(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
 {
-	if (covs.empty()) { return false; }			// If no matrix in vector
-	if (covs.size() == 1)						// If just one matrix in vector
+	const size_t k = covs.size(), n = covs[0].rows();			// Number of Matrix & Features		=> K & N
+	size_t i       = 0;											// Index of Covariance Matrix		=> i
+	double nu      = 1.0,										// Coefficient change				=> nu
+		   tau     = std::numeric_limits<double>::max(),		// Coefficient change criterion		=> tau
+		   crit    = std::numeric_limits<double>::max();		// Current change					=> crit
+
+	while (i < ITER_MAX && EPSILON < crit && EPSILON < nu)		// Stopping criterion
 	{
-		mean = covs[0];
-		return true;
+		i++;													// Iteration Criterion
+		const Eigen::MatrixXd sC = mean.sqrt(), isC = sC.inverse();	// Square root & Inverse Square root of Mean	=> sC & isC
+		Eigen::MatrixXd mJ       = Eigen::MatrixXd::Zero(n, n);	// Change							=> J
+		for (const auto& cov : covs) { mJ += (isC * cov * isC).log(); }	// Sum of log(isC*Ci*isC)
+		mJ /= double(k);										// Normalization
+		crit = mJ.norm();										// Current change criterion
+		mean = sC * (nu * mJ).exp() * sC;						// Update Mean		=> M = sC * exp(nu*J) * sC
+
+		const double h = nu * crit;								// Update Coefficient change
+		if (h < tau)
+		{
+			nu *= 0.95;
+			tau = h;
+		}
+		else { nu *= 0.5; }
 	}
-	if (!HaveSameSize(covs))
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Iterative procedure of the Log Determinant mean from the initial mean (see <see cref="MeanLogDet"/>). </summary>
+static bool MeanLogDetIterations(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
+{
+	const size_t k = covs.size(), n = covs[0].rows();		// Number of Matrix & Features	=> K & N
+	size_t i       = 0;										// Index of Covariance Matrix	=> i
+	double crit    = std::numeric_limits<double>::max();	// Current change				=> crit
+	while (i < ITER_MAX && EPSILON < crit)					// Stopping criterion
 	{
-		std::cout << "Matrices haven't same size." << std::endl;
-		return false;
+		i++;												// Iteration Criterion
+		Eigen::MatrixXd mJ = Eigen::MatrixXd::Zero(n, n);	// Change						=> J
+
+		for (const auto& cov : covs) { mJ += (0.5 * (cov + mean)).inverse(); }	// Sum of ((Ci+M)/2)^{-1}
+		mJ   = (mJ / double(k)).inverse();					// Normalization
+		crit = (mJ - mean).norm();							// Current change criterion
+		mean = mJ;											// Update mean
 	}
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Iterative procedure of the Wasserstein mean from the initial mean (see <see cref="MeanWasserstein"/>). </summary>
+static bool MeanWassersteinIterations(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
+{
+	const size_t k = covs.size(), n = covs[0].rows();		// Number of Matrix & Features	=> K & N
+	size_t i       = 0;										// Index of Covariance Matrix	=> i
+	double crit    = std::numeric_limits<double>::max();	// Current change				=> crit
+
+	Eigen::MatrixXd sC = mean.sqrt();						// Square root of Mean			=> sC
 
-	// Force Square Matrix for non Euclidian and non Identity metric
-	if (!IsSquare(covs[0]) && (metric != EMetric::Euclidian && metric != EMetric::Identity))
+	while (i < ITER_MAX && EPSILON < crit)					// Stopping criterion
 	{
-		std::cout << "Non Square Matrix is invalid with " << toString(metric) << " metric." << std::endl;
-		return false;
+		i++;												// Iteration Criterion
+		Eigen::MatrixXd mJ = Eigen::MatrixXd::Zero(n, n);	// Change						=> J
+
+		for (const auto& cov : covs) { mJ += (sC * cov * sC).sqrt(); }	// Sum of sqrt(sC*Ci*sC)
+		mJ /= double(k);									// Normalization
+
+		const Eigen::MatrixXd sJ = mJ.sqrt();				// Square root of change		=> sJ
+		crit                     = (sJ - sC).norm();		// Current change criterion
+		sC                       = sJ;						// Update sC
 	}
+	mean = sC * sC;											// Un-square root 
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
 
-	switch (metric)								// Switch method
+//---------------------------------------------------------------------------------------------------
+bool Mean(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean, const EMetric metric)
+{
+	switch (metric)
 	{
-		case EMetric::Riemann: return MeanRiemann(covs, mean);
-		case EMetric::Euclidian: return MeanEuclidian(covs, mean);
-		case EMetric::LogEuclidian: return MeanLogEuclidian(covs, mean);
-		case EMetric::LogDet: return MeanLogDet(covs, mean);
-		case EMetric::Kullback: return MeanKullback(covs, mean);
-		case EMetric::ALE: return MeanALE(covs, mean);
-		case EMetric::Harmonic: return MeanHarmonic(covs, mean);
-		case EMetric::Wasserstein: return MeanWasserstein(covs, mean);
+		case EMetric::Riemann: return Mean<EMetric::Riemann>(covs, mean);
+		case EMetric::Euclidian: return Mean<EMetric::Euclidian>(covs, mean);
+		case EMetric::LogEuclidian: return Mean<EMetric::LogEuclidian>(covs, mean);
+		case EMetric::LogDet: return Mean<EMetric::LogDet>(covs, mean);
+		case EMetric::Kullback: return Mean<EMetric::Kullback>(covs, mean);
+		case EMetric::ALE: return Mean<EMetric::ALE>(covs, mean);
+		case EMetric::Harmonic: return Mean<EMetric::Harmonic>(covs, mean);
+		case EMetric::Wasserstein: return Mean<EMetric::Wasserstein>(covs, mean);
 		case EMetric::Identity:
-		default: return MeanIdentity(covs, mean);
+		default: return Mean<EMetric::Identity>(covs, mean);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool MeanWarmStart(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean, const EMetric metric)
+{
+	if (covs.size() < 2 || !AreSquare(covs) || !HaveSameSize(covs) || !HaveSameSize(mean, covs[0])) { return Mean(covs, mean, metric); }	// No valid initial mean
+	switch (metric)
+	{
+		case EMetric::Riemann: return MeanRiemannIterations(covs, mean);
+		case EMetric::LogDet: return MeanLogDetIterations(covs, mean);
+		case EMetric::Wasserstein: return MeanWassersteinIterations(covs, mean);
+		default: return Mean(covs, mean, metric);		// Closed form
 	}
 }
 //---------------------------------------------------------------------------------------------------
@@ -61,32 +136,8 @@ bool AJDPham(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& ajd, dou
 //---------------------------------------------------------------------------------------------------
 bool MeanRiemann(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
 {
-	const size_t k = covs.size(), n = covs[0].rows();			// Number of Matrix & Features		=> K & N
-	size_t i       = 0;											// Index of Covariance Matrix		=> i
-	double nu      = 1.0,										// Coefficient change				=> nu
-		   tau     = std::numeric_limits<double>::max(),		// Coefficient change criterion		=> tau
-		   crit    = std::numeric_limits<double>::max();		// Current change					=> crit
 	if (!MeanEuclidian(covs, mean)) { return false; }			// Initial Mean
-
-	while (i < ITER_MAX && EPSILON < crit && EPSILON < nu)		// Stopping criterion
-	{
-		i++;													// Iteration Criterion
-		const Eigen::MatrixXd sC = mean.sqrt(), isC = sC.inverse();	// Square root & Inverse Square root of Mean	=> sC & isC
-		Eigen::MatrixXd mJ       = Eigen::MatrixXd::Zero(n, n);	// Change							=> J
-		for (const auto& cov : covs) { mJ += (isC * cov * isC).log(); }	// Sum of log(isC*Ci*isC)
-		mJ /= double(k);										// Normalization
-		crit = mJ.norm();										// Current change criterion
-		mean = sC * (nu * mJ).exp() * sC;						// Update Mean		=> M = sC * exp(nu*J) * sC
-
-		const double h = nu * crit;								// Update Coefficient change
-		if (h < tau)
-		{
-			nu *= 0.95;
-			tau = h;
-		}
-		else { nu *= 0.5; }
-	}
-	return true;
+	return MeanRiemannIterations(covs, mean);
 }
 //---------------------------------------------------------------------------------------------------
 
@@ -115,22 +166,8 @@ bool MeanLogEuclidian(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd&
 //---------------------------------------------------------------------------------------------------
 bool MeanLogDet(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
 {
-	const size_t k = covs.size(), n = covs[0].rows();		// Number of Matrix & Features	=> K & N
-	size_t i       = 0;										// Index of Covariance Matrix	=> i
-	double crit    = std::numeric_limits<double>::max();	// Current change				=> crit
 	if (!MeanEuclidian(covs, mean)) { return false; }		// Initial Mean
-
-	while (i < ITER_MAX && EPSILON < crit)					// Stopping criterion
-	{
-		i++;												// Iteration Criterion
-		Eigen::MatrixXd mJ = Eigen::MatrixXd::Zero(n, n);	// Change						=> J
-
-		for (const auto& cov : covs) { mJ += (0.5 * (cov + mean)).inverse(); }	// Sum of ((Ci+M)/2)^{-1}
-		mJ   = (mJ / double(k)).inverse();					// Normalization
-		crit = (mJ - mean).norm();							// Current change criterion
-		mean = mJ;											// Update mean
-	}
-	return true;
+	return MeanLogDetIterations(covs, mean);
 }
 //---------------------------------------------------------------------------------------------------
 
@@ -148,27 +185,8 @@ bool MeanKullback(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mea
 //---------------------------------------------------------------------------------------------------
 bool MeanWasserstein(const std::vector<Eigen::MatrixXd>& covs, Eigen::MatrixXd& mean)
 {
-	const size_t k = covs.size(), n = covs[0].rows();		// Number of Matrix & Features	=> K & N
-	size_t i       = 0;										// Index of Covariance Matrix	=> i
-	double crit    = std::numeric_limits<double>::max();	// Current change				=> crit
-
 	if (!MeanEuclidian(covs, mean)) { return false; }		// Initial Mean
-	Eigen::MatrixXd sC = mean.sqrt();						// Square root of Mean			=> sC
-
-	while (i < ITER_MAX && EPSILON < crit)					// Stopping criterion
-	{
-		i++;												// Iteration Criterion
-		Eigen::MatrixXd mJ = Eigen::MatrixXd::Zero(n, n);	// Change						=> J
-
-		for (const auto& cov : covs) { mJ += (sC * cov * sC).sqrt(); }	// Sum of sqrt(sC*Ci*sC)
-		mJ /= double(k);									// Normalization
-
-		const Eigen::MatrixXd sJ = mJ.sqrt();				// Square root of change		=> sJ
-		crit                     = (sJ - sC).norm();		// Current change criterion
-		sC                       = sJ;						// Update sC
-	}
-	mean = sC * sC;											// Un-square root 
-	return true;
+	return MeanWassersteinIterations(covs, mean);
 }
 //---------------------------------------------------------------------------------------------------
 
@@ -19,38 +19,19 @@ double Median(const Eigen::MatrixXd& m)
 //---------------------------------------------------------------------------------------------------
 bool Median(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixXd& median, const double epsilon, const size_t maxIter, const EMetric& metric)
 {
-	if (matrices.empty()) { return false; }						// If no matrix in vector
-	if (matrices.size() == 1)									// If just one matrix in vector
-	{
-		median = matrices[0];
-		return true;
-	}
-	if (!HaveSameSize(matrices))								// If different sizes
-	{
-		std::cout << "Matrices haven't same size." << std::endl;
-		return false;
-	}
-	if (!IsSquare(matrices[0]) && metric == EMetric::Riemann)	// If non square for Riemann metric
-	{
-		std::cout << "Non Square Matrix is invalid with " << toString(metric) << " metric." << std::endl;
-		return false;
-	}
-
 	switch (metric)
 	{
-		case EMetric::Riemann: return MedianRiemann(matrices, median, epsilon, maxIter);
-		case EMetric::Euclidian: return MedianEuclidian(matrices, median, epsilon, maxIter);
-		case EMetric::Identity: return MedianIdentity(matrices, median);
-		case EMetric::LogEuclidian:
-		case EMetric::LogDet:
-		case EMetric::Kullback:
-		case EMetric::ALE:
-		case EMetric::Harmonic:
-		case EMetric::Wasserstein:
-			std::cout << toString(metric) << " metric not implemented." << std::endl;
-			return false;
+		case EMetric::Riemann: return Median<EMetric::Riemann>(matrices, median, epsilon, maxIter);
+		case EMetric::Euclidian: return Median<EMetric::Euclidian>(matrices, median, epsilon, maxIter);
+		case EMetric::LogEuclidian: return Median<EMetric::LogEuclidian>(matrices, median, epsilon, maxIter);
+		case EMetric::LogDet: return Median<EMetric::LogDet>(matrices, median, epsilon, maxIter);
+		case EMetric::Kullback: return Median<EMetric::Kullback>(matrices, median, epsilon, maxIter);
+		case EMetric::ALE: return Median<EMetric::ALE>(matrices, median, epsilon, maxIter);
+		case EMetric::Harmonic: return Median<EMetric::Harmonic>(matrices, median, epsilon, maxIter);
+		case EMetric::Wasserstein: return Median<EMetric::Wasserstein>(matrices, median, epsilon, maxIter);
+		case EMetric::Identity:
+		default: return Median<EMetric::Identity>(matrices, median, epsilon, maxIter);
 	}
-	return true;
 }
 //---------------------------------------------------------------------------------------------------
 
@@ -147,5 +128,4 @@ bool MedianIdentity(const std::vector<Eigen::MatrixXd>& matrices, Eigen::MatrixX
 }
 //---------------------------------------------------------------------------------------------------
 
-
 }  // namespace Geometry
@@ -1,7 +1,9 @@
 #include "geometry/Misc.hpp"
+#include "geometry/Basics.hpp"
 #include "geometry/Featurization.hpp"
 
 #include <boost/math/special_functions/gamma.hpp>
+#include <algorithm>	// std::partition_point
 #include <numeric>	// std::iota
 
 namespace Geometry {
@@ -100,124 +102,214 @@ std::vector<size_t> BinHist(const std::vector<double>& dataset, const size_t n)
 //---------------------------------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------------------------------
-bool FitDistribution(const std::vector<double>& values, double& mu, double& sigma, const std::vector<double>& betas, const double minQuant,
-					 const double maxQuant, const double minClean, const double maxDropout, const double stepBound, const double stepScale)
+/// <summary>	Tables of the fit distribution for a number of values, independant of the values (shared by all the channels of <see cref="FitDistributions" />). </summary>
+struct SFitTables
 {
-	if (values.empty() || betas.empty() || minQuant < 0 || minQuant > 1 || maxQuant < 0 || maxQuant > 1 || minClean < 0 || maxDropout < 0
-		|| stepBound < 0.0001 || stepBound > 0.1 || stepScale < 0.0001 || stepScale > 0.1) { return false; }
-
-	//========== Scales ==========
-	const size_t nBeta = betas.size();
-	// Scales is a vector for each beta as :
-	// scale = beta/(2*gamma(1/beta)) with gamma the function as gamma(n) = (n-1)! for all integer greater than 0
-	std::vector<double> scales;
-	scales.reserve(nBeta);
-	std::transform(betas.begin(), betas.end(), std::back_inserter(scales), [](const double beta) -> double { return beta / (2 * tgamma(1 / beta)); });
-
-	//========== zBounds ==========
-	// zBounds is a vector of lower and upper bounds for each beta as : sign(quants-1/2) * gammaincinv(sign(quants-1/2) * (2*quants-1), 1/beta)^(1/beta);
-	// with gammaincinv the Inverse incomplete gamma function, here quants are the quantiles limit (by default [0.022 0.6])
-	std::vector<std::vector<double>> zBounds(nBeta);
-	const int signMin    = sgn(minQuant - 0.5), signMax          = sgn(maxQuant - 0.5);
-	const double coefMin = signMin * (2 * minQuant - 1), coefMax = signMax * (2 * maxQuant - 1);
-
-	for (size_t i = 0; i < nBeta; ++i)
+	std::vector<double> betas;					///< The \f$\beta\f$ shapes.
+	std::vector<double> zMin, zMax;				///< Lower and upper bounds of each \f$\beta\f$.
+	std::vector<size_t> widths;					///< Widths of the subsets (descending order).
+	std::vector<size_t> bounds;					///< Beginnings of the subsets.
+	std::vector<size_t> profileIds;				///< Index of the profile of each width.
+	std::vector<Eigen::MatrixXd> profiles;		///< Normalized probability of each bin for each \f$\beta\f$ (nbins x nBeta), one by number of bins.
+	std::vector<Eigen::RowVectorXd> entropies;	///< Sum of \f$ p \log(p) \f$ of each profile for each \f$\beta\f$.
+	std::vector<double> logCounts;				///< \f$ \log(c + 0.01) \f$ for each count \f$ c \f$ of a bin.
+	size_t n = 0;								///< The number of values.
+
+	/// <summary>	Build the tables (see <see cref="FitDistribution" /> for the parameters). </summary>
+	/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+	bool build(const size_t nValue, const std::vector<double>& shapes, const double minQuant, const double maxQuant, const double minClean, const double maxDropout,
+			   const double stepBound, const double stepScale)
 	{
-		if (betas[i] == 0) { zBounds[i] = { 0, 0 }; }
-		else
+		if (nValue == 0 || shapes.empty() || minQuant < 0 || minQuant > 1 || maxQuant < 0 || maxQuant > 1 || minClean < 0 || maxDropout < 0
+			|| stepBound < 0.0001 || stepBound > 0.1 || stepScale < 0.0001 || stepScale > 0.1) { return false; }
+		n     = nValue;
+		betas = shapes;
+
+		//========== zBounds ==========
+		// zBounds is a vector of lower and upper bounds for each beta as : sign(quants-1/2) * gammaincinv(sign(quants-1/2) * (2*quants-1), 1/beta)^(1/beta);
+		// with gammaincinv the Inverse incomplete gamma function, here quants are the quantiles limit (by default [0.022 0.6])
+		const size_t nBeta   = betas.size();
+		const int signMin    = sgn(minQuant - 0.5), signMax          = sgn(maxQuant - 0.5);
+		const double coefMin = signMin * (2 * minQuant - 1), coefMax = signMax * (2 * maxQuant - 1);
+		zMin.assign(nBeta, 0);
+		zMax.assign(nBeta, 0);
+		for (size_t b = 0; b < nBeta; ++b)
+		{
+			if (betas[b] == 0) { continue; }
+			const double beta = 1 / betas[b];
+			zMin[b]           = signMin * pow(boost::math::gamma_p_inv(beta, coefMin), beta);
+			zMax[b]           = signMax * pow(boost::math::gamma_p_inv(beta, coefMax), beta);
+		}
+
+		//========== Compute Index range ==========
+		// Width are the limit if all data is clean or artifacted. It's usefull for the for loop limit and step for each width possible
+		// Bounds are the range of begining value used to compute mu and sigma. It's usefull for the for loop limit and step for first index of value to take
+		widths = RoundIndexRange(n * (maxQuant - minQuant) * minClean, n * (maxQuant - minQuant), n * stepScale, true, false);
+		std::reverse(widths.begin(), widths.end());
+		bounds = RoundIndexRange(n * minQuant, n * (minQuant + maxDropout), n * stepBound, true, false);
+		if (widths.empty() || bounds.empty()) { return false; }
+		const size_t maxWidth = widths.front();	// Widths are in descending order
+		if (widths.back() == 0 || bounds.back() + maxWidth > n) { return false; }
+
+		//========== Profiles ==========
+		// The probability of each bin only depends on the number of bins and beta : prob = exp(-|z|^beta) * beta/(2*gamma(1/beta)), normalized
+		profileIds.resize(widths.size());
+		profiles.clear();
+		entropies.clear();
+		std::vector<size_t> nbins;
+		for (size_t k = 0; k < widths.size(); ++k)
 		{
-			const double beta = 1 / betas[i];
-			zBounds[i]        = {
-				signMin * pow(boost::math::gamma_p_inv(beta, coefMin), beta),
-				signMax * pow(boost::math::gamma_p_inv(beta, coefMax), beta)
-			};
+			const size_t nbin = size_t(std::round(3 * log2(1 + (double(widths[k]) / 2))));
+			const auto it     = std::find(nbins.begin(), nbins.end(), nbin);
+			profileIds[k]     = size_t(it - nbins.begin());
+			if (it != nbins.end()) { continue; }
+			nbins.push_back(nbin);
+
+			Eigen::MatrixXd prob(nbin, nBeta);
+			Eigen::RowVectorXd entropy(nBeta);
+			for (size_t b = 0; b < nBeta; ++b)
+			{
+				const double scale = betas[b] / (2 * tgamma(1 / betas[b]));
+				double sumprob     = 0.0;
+				for (size_t i = 0; i < nbin; ++i)
+				{
+					prob(i, b) = std::exp(-std::pow(std::abs(zMin[b] + (((i + 0.5) / nbin) * (zMax[b] - zMin[b]))), betas[b])) * scale;
+					sumprob += prob(i, b);
+				}
+				if (sumprob != 0) { prob.col(b) /= sumprob; }
+				entropy[b] = 0;
+				for (size_t i = 0; i < nbin; ++i) { entropy[b] += prob(i, b) * log(prob(i, b)); }
+			}
+			profiles.push_back(std::move(prob));
+			entropies.push_back(std::move(entropy));
 		}
+
+		//========== Logarithm of the counts ==========
+		logCounts.resize(maxWidth + 1);
+		for (size_t c = 0; c <= maxWidth; ++c) { logCounts[c] = log(c + 0.01); }
+		return true;
 	}
+};
+//---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Fit the distribution of the values with the precomputed tables (see <see cref="FitDistribution" />). </summary>
+/// <param name="values">	The values. </param>
+/// <param name="tables">	The tables for the number of values. </param>
+/// <param name="mu">		The mu. </param>
+/// <param name="sigma">	The sigma. </param>
+/// <param name="sorted">	Buffer of the sorted values. </param>
+/// <param name="hist">		Buffer of the logarithm of the histograms (nBound x nbins). </param>
+/// <param name="kl">		Buffer of the Kullback-Leibler divergences (nBound x nBeta). </param>
+static void FitDistributionTables(const std::vector<double>& values, const SFitTables& tables, double& mu, double& sigma,
+								  std::vector<double>& sorted, Eigen::MatrixXd& hist, Eigen::MatrixXd& kl)
+{
 	//========== Sort Values ==========
 	// We sort values to access quantiles directly
-	const size_t n                = values.size();
-	std::vector<double> newValues = values;
-	std::sort(newValues.begin(), newValues.end());
-
-	//========== Compute Index range ==========
-	// Width are the limit if all data is clean or artifacted. It's usefull for the for loop limit and step for each width possible
-	// Bounds are the range of begining value used to compute mu and sigma. It's usefull for the for loop limit and step for first index of value to take
-	// We create Vector for widths and bounds to precompute all round and avoid duplicate indexes in widths or bounds
-	std::vector<size_t> widths = RoundIndexRange(n * (maxQuant - minQuant) * minClean, n * (maxQuant - minQuant), n * stepScale, true, false);
-	std::reverse(widths.begin(), widths.end());
-	const std::vector<size_t> bounds = RoundIndexRange(n * minQuant, n * (minQuant + maxDropout), n * stepBound, true, false);
-	const size_t maxWidth            = std::max(widths.front(), widths.back());	// to prevent if widths is in descending or ascending order
-	const size_t nBound              = bounds.size();
-
-	//========== Compute Grid (with index range) ==========
-	// Create the Biggest table of data with width in column and bound in row
-	std::vector<std::vector<double>> grid(nBound);
-	std::vector<double> firsts(nBound);
-	for (size_t i = 0; i < nBound; ++i)
-	{
-		grid[i].reserve(maxWidth);
-		const auto first = newValues.begin() + bounds[i];
-		std::copy_n(first, maxWidth, std::back_inserter(grid[i]));
-		firsts[i] = grid[i][0];
-		for (auto& e : grid[i]) { e -= firsts[i]; }	// Substract first value on all element
-	}
+	sorted = values;
+	std::sort(sorted.begin(), sorted.end());
 
 	//==========  Width Loop ==========
-	double bestKl   = std::numeric_limits<double>::max();
-	size_t bestBeta = 0, bestId = 0, bestWidth = 0;
+	const size_t nBound = tables.bounds.size(), nBeta = tables.betas.size();
+	double bestKl       = std::numeric_limits<double>::max();
+	size_t bestBeta     = 0, bestId = 0, bestWidth = 0;
 	// for each interval width...
-	for (const auto& w : widths)
+	for (size_t k = 0; k < tables.widths.size(); ++k)
 	{
-		const size_t nbins = size_t(std::round(3 * log2(1 + (double(w) / 2))));
+		const size_t w           = tables.widths[k];
+		const Eigen::MatrixXd& p = tables.profiles[tables.profileIds[k]];
+		const Eigen::Index nbins = p.rows();
 
 		//==========  Compute Histogramm ==========
-		std::vector<std::vector<double>> hist(nBound);
+		// The subset [first;first+w[ minus its first value is sorted, so the bin of each value (see BinHist) is ascending :
+		// the count of each bin is the difference of the positions of the first value of the bin and of the next one (binary search)
+		hist.resize(Eigen::Index(nBound), nbins);
 		for (size_t i = 0; i < nBound; ++i)
 		{
-			hist[i].reserve(nbins);
-			std::vector<size_t> tmp = BinHist(std::vector<double>(grid[i].begin(), grid[i].begin() + w), nbins);
-			std::transform(tmp.begin(), tmp.end(), std::back_inserter(hist[i]), [](const size_t e) -> double { return log(e + 0.01); });
-		}
-
-		//==========  Beta Loop ==========
-		for (size_t b = 0; b < nBeta; ++b)
-		{
-			//==========  Compute Probability ==========
-			std::vector<double> prob(nbins);
-			double sumprob = 0.0;
-			for (size_t i = 0; i < nbins; ++i)
+			const auto first   = sorted.begin() + Eigen::Index(tables.bounds[i]);
+			const double start = *first, max = first[Eigen::Index(w) - 1] - start;
+			if (max == 0)
 			{
-				prob[i] = std::exp(-std::pow(std::abs(zBounds[b][0] + (((i + 0.5) / nbins) * (zBounds[b][1] - zBounds[b][0]))), betas[b])) * scales[b];
-				sumprob += prob[i];
+				hist.row(Eigen::Index(i)).setConstant(tables.logCounts[0]);	// if max is 0, coef can't be compute
+				continue;
 			}
-			if (sumprob != 0) { for (auto& p : prob) { p /= sumprob; } }
+			const double coef = double(nbins) / max;
+			auto begin        = first;
+			for (Eigen::Index j = 0; j + 1 < nbins; ++j)
+			{
+				const auto end = std::partition_point(begin, first + Eigen::Index(w), [&](const double v) { return size_t(std::floor((v - start) * coef)) <= size_t(j); });
+				hist(Eigen::Index(i), j) = tables.logCounts[size_t(end - begin)];
+				begin = end;
+			}
+			hist(Eigen::Index(i), nbins - 1) = tables.logCounts[size_t(first + Eigen::Index(w) - begin)];	// The last bin has the max
+		}
 
-			//========== Compute the Kullback-Leibler divergences ==========
-			//kl = sum(prob * (log(prob) - hist)) + log(w));
-			std::vector<double> kl(nBound, log(w));
-			for (size_t i = 0; i < nBound; ++i) { for (size_t j = 0; j < nbins; ++j) { kl[i] += prob[j] * (log(prob[j]) - hist[i][j]); } }
+		//========== Compute the Kullback-Leibler divergences ==========
+		// kl = sum(prob * (log(prob) - hist)) + log(w) for all bounds and betas in one product
+		kl.noalias() = -hist * p;
+		kl.rowwise() += tables.entropies[tables.profileIds[k]];
+		kl.array() += log(w);
 
-			// Update Parameters
-			auto minIt = std::min_element(kl.begin(), kl.end());
-			if (*minIt < bestKl)
+		// Update Parameters (first minimum of each beta)
+		for (size_t b = 0; b < nBeta; ++b)
+		{
+			Eigen::Index minId;
+			const double minKl = kl.col(Eigen::Index(b)).minCoeff(&minId);
+			if (minKl < bestKl)
 			{
-				bestKl    = *minIt;
+				bestKl    = minKl;
 				bestBeta  = b;
-				bestId    = minIt - kl.begin();
+				bestId    = size_t(minId);
 				bestWidth = w - 1;
 			}
 		}
 	}
 
-	double alpha = grid[bestId][bestWidth] / (zBounds[bestBeta][1] - zBounds[bestBeta][0]);
-	double beta  = betas[bestBeta];
+	const double first = sorted[tables.bounds[bestId]];
+	const double alpha = (sorted[tables.bounds[bestId] + bestWidth] - first) / (tables.zMax[bestBeta] - tables.zMin[bestBeta]);
+	const double beta  = tables.betas[bestBeta];
 
-	mu    = firsts[bestId] - zBounds[bestBeta][0] * alpha;
+	mu    = first - tables.zMin[bestBeta] * alpha;
 	sigma = sqrt(alpha * alpha * std::tgamma(3 / beta) / std::tgamma(1 / beta));
+}
+//---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+bool FitDistribution(const std::vector<double>& values, double& mu, double& sigma, const std::vector<double>& betas, const double minQuant,
+					 const double maxQuant, const double minClean, const double maxDropout, const double stepBound, const double stepScale)
+{
+	SFitTables tables;
+	if (!tables.build(values.size(), betas, minQuant, maxQuant, minClean, maxDropout, stepBound, stepScale)) { return false; }
+	std::vector<double> sorted;
+	Eigen::MatrixXd hist, kl;
+	FitDistributionTables(values, tables, mu, sigma, sorted, hist, kl);
 	return true;
 }
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+bool FitDistributions(const std::vector<std::vector<double>>& values, std::vector<double>& mu, std::vector<double>& sigma, const std::vector<double>& betas,
+					  const double minQuant, const double maxQuant, const double minClean, const double maxDropout, const double stepBound,
+					  const double stepScale, const size_t nbThreads)
+{
+	if (values.empty()) { return false; }
+	for (const auto& v : values) { if (v.size() != values[0].size()) { return false; } }
+	SFitTables tables;
+	if (!tables.build(values[0].size(), betas, minQuant, maxQuant, minClean, maxDropout, stepBound, stepScale)) { return false; }
+
+	const size_t n = values.size(), nbJobs = ParallelThreadCount(n, nbThreads);
+	mu.resize(n);
+	sigma.resize(n);
+	std::vector<std::vector<double>> sorted(nbJobs);
+	std::vector<Eigen::MatrixXd> hist(nbJobs), kl(nbJobs);
+	ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t i = begin; i < end; ++i) { FitDistributionTables(values[i], tables, mu[i], sigma[i], sorted[job], hist[job], kl[job]); }
+	}, nbThreads);
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 void sortedEigenVector(const Eigen::MatrixXd& matrix, Eigen::MatrixXd& vectors, std::vector<double>& values, const EMetric /*metric*/)
 {
@@ -3,19 +3,56 @@
 #include "geometry/Misc.hpp"
 #include "geometry/Median.hpp"
 #include "geometry/Covariance.hpp"
-#include "geometry/Mean.hpp"
+#include "geometry/Geodesic.hpp"
 #include "geometry/classifier/IMatrixClassifier.hpp"
 
 #include <boost/math/special_functions/detail/igamma_inverse.hpp>
 #include <unsupported/Eigen/MatrixFunctions>
 
+#include <algorithm>
 #include <cmath>
-#include <numeric>
 
 namespace Geometry {
 
 ///-------------------------------------------------------------------------------------------------
-bool CASR::train(const std::vector<Eigen::MatrixXd>& dataset, const double rejectionLimit)
+/// <summary>	Ledoit and Wolf covariance matrix of the centered chunk, same as <see cref="CovarianceMatrix" /> with <c>EEstimator::LWF</c> and <c>EStandardization::Center</c>,
+/// without allocation if the buffers have already the good size.
+/// </summary>
+/// <param name="in">		The window (CxW). </param>
+/// <param name="cov">		The covariance matrix (CxC). </param>
+/// <param name="centered">	The buffer of the centered window (CxW). </param>
+/// <param name="mean">		The buffer of the mean of each channel (C). </param>
+/// <returns>	<c>True</c> if it succeeds, <c>False</c> otherwise. </returns>
+static bool CovarianceMatrixLWF(const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& cov, Eigen::MatrixXd& centered, Eigen::VectorXd& mean)
+{
+	const double n = double(in.rows()), S = double(in.cols());	// Number of Features & Samples		=> N & S
+	mean.noalias() = in.rowwise().mean();
+	centered       = in;
+	centered.colwise() -= mean;
+	cov.noalias() = centered * centered.transpose();
+	cov /= S;
+
+	// Sum of X^2 * X^2^T is the sum of the squared norms of the samples squared
+	double x4 = 0;
+	for (Eigen::Index i = 0; i < centered.cols(); ++i)
+	{
+		const double norm = centered.col(i).squaredNorm();
+		x4 += norm * norm;
+	}
+	const double mu        = cov.trace() / n,
+				 delta     = (cov.squaredNorm() - n * mu * mu) / n,
+				 beta      = 1. / (n * S) * (x4 / S - cov.squaredNorm()),
+				 shrinkage = std::min(beta, delta) / delta;	// Assure shrinkage <= 1
+	if (!InRange(shrinkage, 0, 1)) { return false; }
+
+	cov *= 1 - shrinkage;									// Shrinkage of the matrix
+	cov.diagonal().array() += shrinkage * mu;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASR::train(const std::vector<Eigen::MatrixXd>& dataset, const double rejectionLimit, const size_t nbThreads)
 {
 	if (dataset.empty() || dataset[0].size() == 0) { return false; }
 	const size_t n = dataset.size();	// Number of samples
@@ -23,105 +60,306 @@ bool CASR::train(const std::vector<Eigen::MatrixXd>& dataset, const double rejec
 
 	//========== Compute the covariance matrix ==========
 	std::vector<Eigen::MatrixXd> covs(n);
-	//for (size_t i = 0; i < n; ++i) { if (!CovarianceMatrixLWF(dataset[i], covs[i])) { return false; } }	// We assume data is centered
-	for (size_t i = 0; i < n; ++i) { if (!CovarianceMatrix(dataset[i], covs[i], EEstimator::LWF, EStandardization::Center)) { return false; } }
+	std::vector<char> valid(n, 0);
+	ParallelFor(n, [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t i = begin; i < end; ++i) { valid[i] = char(CovarianceMatrix(dataset[i], covs[i], EEstimator::LWF, EStandardization::Center)); }
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
 
 	//========== Compute Square Root of Median ==========
-	if (!Median(covs, m_median)) { return false; }											// Geometric median independant of metric
-	m_median = m_median.sqrt();
+	Eigen::MatrixXd median;
+	if (!Median(covs, median)) { return false; }											// Geometric median independant of metric
+	m_median.set(median.sqrt());
 
 	//========== Compute Eigen vectors ==========
 	Eigen::MatrixXd eigVector;
 	std::vector<double> eigValues;
-	sortedEigenVector(m_median, eigVector, eigValues, m_metric);							//Actually only Euclidian metric is implemented
+	sortedEigenVector(m_median.get(), eigVector, eigValues, m_metric);							//Actually only Euclidian metric is implemented
 
-	//========== Compute the ponderate dataset ==========
-	std::vector<Eigen::MatrixXd> newDataset;
-	newDataset.reserve(n);
-	for (const auto& m : dataset) { newDataset.push_back((m.transpose() * eigVector)); }	// Multiply by eigen vector (we transpose to have channels in column
-	for (auto& m : newDataset) { m = m.cwiseProduct(m); }									// Square new signal
-
-	//========== Compute the "fit" distribution ==========
-	// Compute the RMS of each channel for each sample
+	//========== Compute the RMS of each channel for each sample ==========
+	// The samples are multiplied by the eigen vectors (we transpose to have channels in column) and the RMS is the root of the mean of the squares
 	std::vector<std::vector<double>> rms(m_nChannel, std::vector<double>(n));
-	for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < m_nChannel; ++j) { rms[j][i] = sqrt(newDataset[i].col(j).mean()); } }
+	ParallelFor(n, [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		Eigen::MatrixXd projected;
+		for (size_t i = begin; i < end; ++i)
+		{
+			projected.noalias() = dataset[i].transpose() * eigVector;
+			for (size_t j = 0; j < m_nChannel; ++j) { rms[j][i] = sqrt(projected.col(Eigen::Index(j)).squaredNorm() / double(projected.rows())); }
+		}
+	}, nbThreads);
 
-	// Compute the "fit" distribution
-	std::vector<double> mu(m_nChannel, 0.0), sigma(m_nChannel, 0.0);
-	for (size_t i = 0; i < m_nChannel; ++i) { FitDistribution(rms[i], mu[i], sigma[i]); }
+	//========== Compute the "fit" distribution ==========
+	std::vector<double> mu, sigma;
+	if (!FitDistributions(rms, mu, sigma, doubleRange(1.7, 3.5, 0.15), 0.022, 0.60, 0.250, 0.10, 0.010, 0.01, nbThreads)) { return false; }
 
 	// Compute the threshold Matrix
-	m_threshold = Eigen::MatrixXd::Zero(m_nChannel, m_nChannel);
-	for (size_t i = 0; i < m_nChannel; ++i) { m_threshold(i, i) = mu[i] + rejectionLimit * sigma[i]; }
-	m_threshold *= eigVector.transpose();
-
-	// Initialize Reconstruction matrix and trivial
-	m_r       = Eigen::MatrixXd::Identity(m_nChannel, m_nChannel);
-	m_trivial = true;
+	Eigen::MatrixXd& threshold = m_threshold.replace();	// New threshold, the copies keep the previous one
+	threshold.setZero(m_nChannel, m_nChannel);
+	for (size_t i = 0; i < m_nChannel; ++i) { threshold(i, i) = mu[i] + rejectionLimit * sigma[i]; }
+	threshold *= eigVector.transpose();
+
+	// Initialize Reconstruction matrix, trivial and the cache
+	m_r           = Eigen::MatrixXd::Identity(m_nChannel, m_nChannel);
+	m_trivial     = true;
+	m_cache.valid = false;
 	return true;
 }
+///-------------------------------------------------------------------------------------------------
 
-bool CASR::process(const Eigen::MatrixXd& in, Eigen::MatrixXd& out)
+///-------------------------------------------------------------------------------------------------
+bool CASR::process(const Eigen::Ref<const Eigen::MatrixXd>& window, const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out)
 {
 	// Check if input data is compatible with train data and if we don't limit so mutch the reconstruction
-	out = in;
-	if (size_t(out.rows()) != m_nChannel) { return false; }
+	const bool valid   = size_t(in.rows()) == m_nChannel && in.cols() != 0 && window.rows() == in.rows() && window.cols() != 0;
 	const size_t begin = size_t((1.0 - m_maxChannel) * double(m_nChannel));	// We define the number of channels to non reconstruct
-	if (begin == m_nChannel) { return true; }
-	if (m_r.size() == 0) { m_r = Eigen::MatrixXd::Identity(m_nChannel, m_nChannel); }
-
-	// Compute Covariance matrix
-	Eigen::MatrixXd cov;
-	if (!CovarianceMatrix(in, cov, EEstimator::LWF, EStandardization::Center)) { return false; }
-	if (m_cov.size() == 0) { m_cov = cov; }									// if first time
-	else { if (!Mean({ m_cov, cov }, m_cov, m_metric)) { return false; } }	// else mean of the both
+	if (!valid || begin == m_nChannel)
+	{
+		out = in;
+		return valid;
+	}
+	const Eigen::Index nChannel = Eigen::Index(m_nChannel);
+	if (m_r.size() == 0) { m_r = Eigen::MatrixXd::Identity(nChannel, nChannel); }
+	m_buffers.resize(nChannel, window.cols(), in.cols());
+	m_cache.resize(nChannel);
+	SProcessBuffers& b = m_buffers;
+
+	// Compute Covariance matrix of the window (the mean of two matrices is the midpoint of the geodesic)
+	const bool covariance = CovarianceMatrixLWF(window, b.cov, b.centered, b.mean);
+	out                   = in;		// The window isn't used after its covariance, so the output can be the window or the input
+	if (!covariance) { return false; }
+	if (m_cov.size() == 0) { m_cov = b.cov; }													// if first time
+	else if (m_choleskyUpdate && m_metric == EMetric::Riemann)									// else mean of the both
+	{
+		if (!GeodesicLogCholesky(m_cov, b.cov, m_cov, 0.5, b.symmetric)) { return false; }
+	}
+	else if (!Geodesic(m_cov, b.cov, m_cov, m_metric, 0.5, b.symmetric)) { return false; }
 
-	// Compute Eigen vector & values
-	Eigen::MatrixXd eigVector;
-	std::vector<double> eigValues;
-	sortedEigenVector(m_cov, eigVector, eigValues, m_metric);
+	// Compute Eigen vector & values (ascending order)
+	if (!SelfAdjointEigen(m_cov, b.values, b.vectors, b.symmetric.eigen)) { return false; }
 
 	// Check if eigen values is over threshold computes during train (ponderate by eigen vector)
-	Eigen::MatrixXd threshold = (m_threshold * eigVector).cwiseAbs2();
-	bool trivial              = true;
-	std::vector<bool> keep(m_nChannel, true);
-	for (size_t i = begin; i < m_nChannel; ++i)
+	b.product.noalias() = m_threshold.get() * b.vectors;
+	bool trivial        = true;
+	for (size_t i = 0; i < m_nChannel; ++i)
 	{
-		if (eigValues[i] >= threshold.col(i).sum())
-		{
-			keep[i] = false;
-			trivial = false;
-		}
+		b.keep[i] = i < begin || b.values[i] < b.product.col(i).squaredNorm();
+		if (!b.keep[i]) { trivial = false; }
 	}
 
 	// Check if All channels are clean
-	if (trivial) { m_r = Eigen::MatrixXd::Identity(m_nChannel, m_nChannel); }
+	if (trivial) { m_r.setIdentity(); }
 	else	// if not...
 	{
-		// Compute the reconstruction matrix with bad channels 
-		Eigen::MatrixXd tmp = eigVector.transpose() * m_median;
-		for (size_t i = begin; i < m_nChannel; ++i) { if (!keep[i]) { tmp.row(i).setZero(); } }
-		const Eigen::MatrixXd newR = m_median * tmp.completeOrthogonalDecomposition().pseudoInverse() * eigVector.transpose();
+		if (!reconstruction(begin)) { return false; }	// Compute the reconstruction matrix with bad channels
 
 		if (!m_trivial)
 		{
-			// Compute blend values for the samples
-			const size_t nSample = in.cols();
-			std::vector<double> blend(nSample);
-			std::iota(blend.begin(), blend.end(), 1);	// Range 1 to nSample (inclued)
-			for (auto& b : blend) { b = (1 - cos(M_PI * (b / double(nSample)))) / 2.0; }
-
 			// Apply reconstruction ponderate by the blend (we considere the old reconstruction matrix for the second part)
-			Eigen::MatrixXd t1 = newR * in;
-			Eigen::MatrixXd t2 = m_r * in;
-			for (size_t i = 0; i < nSample; ++i) { out.col(i) = (blend[i] * t1.col(i)) + ((1 - blend[i]) * t2.col(i)); }
+			// out = [R_new, R_old] * [in * diag(blend) ; in * diag(1 - blend)] in one product
+			b.stacked.leftCols(nChannel)           = b.r;
+			b.stacked.rightCols(nChannel)          = m_r;
+			b.blended.topRows(nChannel).noalias()  = in * b.blend.asDiagonal();
+			b.blended.bottomRows(nChannel)         = in - b.blended.topRows(nChannel);
+			out.noalias()                          = b.stacked * b.blended;
 		}
-		m_r = newR;	// Update the reconstruction matrix
+		m_r.swap(b.r);	// Update the reconstruction matrix
 	}
 	m_trivial = trivial;
 	return true;
 }
+///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+void CASR::SProcessBuffers::resize(const Eigen::Index nChannel, const Eigen::Index nWindow, const Eigen::Index nSample)
+{
+	if (vectors.rows() != nChannel)
+	{
+		mean.resize(nChannel);
+		cov.resize(nChannel, nChannel);
+		values.resize(nChannel);
+		vectors.resize(nChannel, nChannel);
+		product.resize(nChannel, nChannel);
+		rejected.resize(nChannel, nChannel);
+		r.resize(nChannel, nChannel);
+		stacked.resize(nChannel, 2 * nChannel);
+		keep.resize(size_t(nChannel));
+		symmetric.resize(nChannel);
+	}
+	if (centered.rows() != nChannel || centered.cols() != nWindow) { centered.resize(nChannel, nWindow); }
+	if (blended.rows() != 2 * nChannel || blended.cols() != nSample) { blended.resize(2 * nChannel, nSample); }
+	if (blend.size() != nSample)
+	{
+		// Blend values for the samples : Range 1 to nSample (inclued) on a raised cosine
+		blend.resize(nSample);
+		for (Eigen::Index i = 0; i < nSample; ++i) { blend[i] = (1 - cos(M_PI * (double(i + 1) / double(nSample)))) / 2.0; }
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CASR::SReconstructionCache::resize(const Eigen::Index nChannel)
+{
+	if (inverse.rows() == nChannel) { return; }
+	inverse.resize(nChannel, nChannel);
+	q.resize(nChannel, nChannel);
+	z.resize(nChannel, nChannel);
+	sInv.resize(nChannel, nChannel);
+	projector.resize(nChannel, nChannel);
+	u.resize(nChannel);
+	v.resize(nChannel);
+	w.resize(nChannel);
+	valid = false;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASR::reconstruction(const size_t begin)
+{
+	SProcessBuffers& b = m_buffers;
+
+	// Inverse of the median (the model keeps its square root) and buffers of the cache
+	if (!m_cache.valid)
+	{
+		b.product.noalias() = m_median.get() * m_median.get();
+		const Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>> llt(b.product);
+		if (llt.info() != Eigen::Success) { return false; }
+		m_cache.inverse.setIdentity();
+		llt.solveInPlace(m_cache.inverse);
+		m_cache.count = 0;
+		m_cache.valid = true;
+	}
+
+	// Rejected components of the chunk
+	Eigen::Index count = 0;
+	for (size_t i = begin; i < m_nChannel; ++i) { if (!b.keep[i]) { b.rejected.col(count++) = b.vectors.col(Eigen::Index(i)); } }
+
+	// Compare with the cache : squared norm of the projection of each new component on the cached subspace (columns) and of each cached component on the new subspace (rows)
+	// Without tolerance the reconstruction is always rebuilt (the rounding errors of the projections can't pass the comparison)
+	const Eigen::Index cached = m_cache.count;
+	bool done                 = false;
+	if (m_cacheTolerance > 0 && cached > 0 && std::abs(count - cached) <= 1)
+	{
+		auto overlap = b.product.topLeftCorner(cached, count);
+		overlap.noalias() = m_cache.q.leftCols(cached).transpose() * b.rejected.leftCols(count);
+		const double limit = 1.0 - m_cacheTolerance;
+		Eigen::Index newest = 0, oldest = 0;
+		const double minCol = overlap.colwise().squaredNorm().minCoeff(&newest), minRow = overlap.rowwise().squaredNorm().minCoeff(&oldest);
+
+		if (count == cached && minCol >= limit)		// Same subspace : the reconstruction is reused
+		{
+			m_cache.hits++;
+			done = true;
+		}
+		else if (count == cached + 1 && minRow >= limit)	// One more component : the cached subspace is in the new one, the farthest new component completes it
+		{
+			if (addToCache(newest))
+			{
+				m_cache.updates++;
+				done = true;
+			}
+		}
+		else if (count + 1 == cached && minCol >= limit && minRow <= m_cacheTolerance)	// One less component : the new subspace is the cached one without the farthest cached component
+		{
+			removeFromCache(oldest);
+			m_cache.updates++;
+			done = true;
+		}
+	}
+	if (!done)
+	{
+		if (!rebuildCache(count)) { return false; }
+		m_cache.misses++;
+	}
+
+	// Reconstruction R = I - P
+	b.r = -m_cache.projector;
+	b.r.diagonal().array() += 1;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASR::rebuildCache(const Eigen::Index count)
+{
+	SReconstructionCache& c = m_cache;
+	const auto q = c.q.leftCols(count), z = c.z.leftCols(count);
+	c.q.leftCols(count)           = m_buffers.rejected.leftCols(count);
+	c.z.leftCols(count).noalias() = c.inverse * q;
+
+	// S^-1 with a Cholesky decomposition (S is SPD), then P = Q S^-1 Z^T
+	auto s = m_buffers.product.topLeftCorner(count, count);
+	s.noalias() = q.transpose() * z;
+	const Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>> llt(s);
+	if (llt.info() != Eigen::Success) { return false; }
+	c.sInv.topLeftCorner(count, count).setIdentity();
+	llt.solveInPlace(c.sInv.topLeftCorner(count, count));
+	auto product = m_buffers.product.topRows(count);
+	product.noalias()     = c.sInv.topLeftCorner(count, count) * z.transpose();
+	c.projector.noalias() = q * product;
+	c.count               = count;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASR::addToCache(const Eigen::Index index)
+{
+	// Bordering of S^-1 with the new component q : z = Sigma^-1 q, u = S^-1 Q^T z and s = q^T z - z^T Q u (Schur complement)
+	SReconstructionCache& c = m_cache;
+	const Eigen::Index r    = c.count;
+	const auto q            = m_buffers.rejected.col(index);
+	c.w.noalias()           = c.inverse * q;
+	c.v.head(r).noalias()   = c.q.leftCols(r).transpose() * c.w;
+	c.u.head(r).noalias()   = c.sInv.topLeftCorner(r, r) * c.v.head(r);
+	const double s          = q.dot(c.w) - c.v.head(r).dot(c.u.head(r));
+	if (!(s > 1e-12 * q.dot(c.w))) { return false; }
+
+	// P' = P + (Q u - q) (Z u - z)^T / s (the free column of Z is used as buffer)
+	c.v.noalias() = c.q.leftCols(r) * c.u.head(r);
+	c.v           = (c.v - q) / s;
+	c.z.col(r).noalias() = c.z.leftCols(r) * c.u.head(r);
+	c.z.col(r) -= c.w;
+	c.projector.noalias() += c.v * c.z.col(r).transpose();
+
+	// New S^-1 and new component in the cache
+	c.v.head(r)           = c.u.head(r) / s;
+	c.sInv.topLeftCorner(r, r).noalias() += c.v.head(r) * c.u.head(r).transpose();
+	c.sInv.row(r).head(r) = -c.v.head(r).transpose();
+	c.sInv.col(r).head(r) = -c.v.head(r);
+	c.sInv(r, r)          = 1.0 / s;
+	c.q.col(r)            = q;
+	c.z.col(r)            = c.w;
+	c.count++;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CASR::removeFromCache(const Eigen::Index index)
+{
+	// P' = P - (Q S^-1 e_j) (Z S^-1 e_j)^T / S^-1_jj and S'^-1 = S^-1 - S^-1 e_j e_j^T S^-1 / S^-1_jj without the row and the column j
+	SReconstructionCache& c = m_cache;
+	const Eigen::Index r    = c.count;
+	const double d          = c.sInv(index, index);
+	c.u.head(r)             = c.sInv.col(index).head(r);
+	c.v.noalias()           = c.q.leftCols(r) * c.u.head(r);
+	c.w.noalias()           = c.z.leftCols(r) * c.u.head(r);
+	c.v /= d;
+	c.projector.noalias() -= c.v * c.w.transpose();
+	c.v.head(r) = c.u.head(r) / d;
+	c.sInv.topLeftCorner(r, r).noalias() -= c.v.head(r) * c.u.head(r).transpose();
+
+	for (Eigen::Index k = index; k + 1 < r; ++k)
+	{
+		c.q.col(k)            = c.q.col(k + 1);
+		c.z.col(k)            = c.z.col(k + 1);
+		c.sInv.col(k).head(r) = c.sInv.col(k + 1).head(r);
+	}
+	for (Eigen::Index k = index; k + 1 < r; ++k) { c.sInv.row(k).head(r - 1) = c.sInv.row(k + 1).head(r - 1); }
+	c.count--;
+}
 ///-------------------------------------------------------------------------------------------------
 
 bool CASR::setMatrices(const Eigen::MatrixXd& median, const Eigen::MatrixXd& threshold, const Eigen::MatrixXd& reconstruct,
@@ -134,12 +372,13 @@ bool CASR::setMatrices(const Eigen::MatrixXd& median, const Eigen::MatrixXd& thr
 		std::cout << "All matrices must be square with same size (or empty for reconstruct and covariance matrix" << std::endl;
 		return false;
 	}
-	m_nChannel  = median.rows();
-	m_median    = median;
-	m_threshold = threshold;
-	m_r         = reconstruct.size() != 0 ? reconstruct : Eigen::MatrixXd::Identity(m_nChannel, m_nChannel);
-	m_cov       = covariance;
-	m_trivial   = true;
+	m_nChannel    = median.rows();
+	m_median.set(median);
+	m_threshold.set(threshold);
+	m_r           = reconstruct.size() != 0 ? reconstruct : Eigen::MatrixXd::Identity(m_nChannel, m_nChannel);
+	m_cov         = covariance;
+	m_trivial     = true;
+	m_cache.valid = false;
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -163,11 +402,11 @@ bool CASR::saveXML(const std::string& filename) const
 	data->SetAttribute("trivial", m_trivial);					// Set attribute nCHannel
 
 	tinyxml2::XMLElement* median = doc.NewElement("Median");	// Create Median node
-	if (!IMatrixClassifier::saveMatrix(median, m_median)) { return false; }	// Save Median Matrix
+	if (!IMatrixClassifier::saveMatrix(median, m_median.get())) { return false; }	// Save Median Matrix
 	data->InsertEndChild(median);								// Add Median node to data node
 
 	tinyxml2::XMLElement* threshold = doc.NewElement("Threshold");	// Create Median node
-	if (!IMatrixClassifier::saveMatrix(threshold, m_threshold)) { return false; }	// Save Median Matrix
+	if (!IMatrixClassifier::saveMatrix(threshold, m_threshold.get())) { return false; }	// Save Median Matrix
 	data->InsertEndChild(threshold);							// Add Median node to data node
 
 	tinyxml2::XMLElement* r = doc.NewElement("R");				// Create Median node
@@ -204,11 +443,11 @@ bool CASR::loadXML(const std::string& filename)
 
 	tinyxml2::XMLElement* element = data->FirstChildElement("Median");	// Get Median Node
 	if (element == nullptr) { return false; }					// Check if Node Exist
-	if (!IMatrixClassifier::loadMatrix(element, m_median)) { return false; }	// Load Median Matrix
+	if (!IMatrixClassifier::loadMatrix(element, m_median.replace())) { return false; }	// Load Median Matrix
 
 	element = data->FirstChildElement("Threshold");				// Get Threshold Node
 	if (element == nullptr) { return false; }					// Check if Node Exist
-	if (!IMatrixClassifier::loadMatrix(element, m_threshold)) { return false; }	// Load Threshold Matrix
+	if (!IMatrixClassifier::loadMatrix(element, m_threshold.replace())) { return false; }	// Load Threshold Matrix
 
 	element = data->FirstChildElement("R");						// Get R Node
 	if (element == nullptr) { return false; }					// Check if Node Exist
@@ -218,6 +457,7 @@ bool CASR::loadXML(const std::string& filename)
 	if (element == nullptr) { return false; }					// Check if Node Exist
 	if (!IMatrixClassifier::loadMatrix(element, m_cov)) { return false; }	// Load Cov Matrix
 
+	m_cache.valid = false;
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -231,7 +471,7 @@ bool CASR::isEqual(const CASR& obj, const double precision) const
 {
 	return m_metric == obj.m_metric && m_nChannel == obj.m_nChannel
 		   && abs(m_maxChannel - obj.m_maxChannel) < precision && m_trivial == obj.m_trivial
-		   && AreEquals(m_median, obj.m_median, precision) && AreEquals(m_threshold, obj.m_threshold, precision)
+		   && AreEquals(m_median.get(), obj.m_median.get(), precision) && AreEquals(m_threshold.get(), obj.m_threshold.get(), precision)
 		   && AreEquals(m_r, obj.m_r, precision) && AreEquals(m_cov, obj.m_cov, precision);
 }
 ///-------------------------------------------------------------------------------------------------
@@ -239,14 +479,17 @@ bool CASR::isEqual(const CASR& obj, const double precision) const
 ///-------------------------------------------------------------------------------------------------
 void CASR::copy(const CASR& obj)
 {
-	m_metric     = obj.m_metric;
-	m_nChannel   = obj.m_nChannel;
-	m_maxChannel = obj.m_maxChannel;
-	m_trivial    = obj.m_trivial;
-	m_median     = obj.m_median;
-	m_threshold  = obj.m_threshold;
-	m_r          = obj.m_r;
-	m_cov        = obj.m_cov;
+	m_metric         = obj.m_metric;
+	m_nChannel       = obj.m_nChannel;
+	m_maxChannel     = obj.m_maxChannel;
+	m_trivial        = obj.m_trivial;
+	m_median         = obj.m_median;
+	m_threshold      = obj.m_threshold;
+	m_r              = obj.m_r;
+	m_cov            = obj.m_cov;
+	m_cacheTolerance = obj.m_cacheTolerance;
+	m_choleskyUpdate = obj.m_choleskyUpdate;
+	m_cache.valid    = false;
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -260,8 +503,8 @@ std::stringstream CASR::print() const
 	{
 		ss << "Train done." << std::endl;
 		ss << size_t(m_maxChannel * double(m_nChannel)) << "/" << m_nChannel << " channels can be reconstruted." << std::endl;
-		ss << "Median matrix is : " << std::endl << m_median << std::endl;
-		ss << "Threshold matrix is : " << std::endl << m_threshold << std::endl;
+		ss << "Median matrix is : " << std::endl << m_median.get() << std::endl;
+		ss << "Threshold matrix is : " << std::endl << m_threshold.get() << std::endl;
 		if (m_cov.size() == 0) { ss << "No process launched yet." << std::endl; }
 		else
 		{
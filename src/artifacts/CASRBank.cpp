@@ -0,0 +1,111 @@
+#include "geometry/artifacts/CASRBank.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CASRBank::initialize(const CASR& calibration, const size_t nStream)
+{
+	if (calibration.getChannelNumber() == 0 || nStream == 0)
+	{
+		std::cout << "The ASR must be trained and the bank must have one stream at least." << std::endl;
+		return false;
+	}
+	m_calibration = calibration;			// The median and the threshold are shared
+	m_nStream     = nStream;
+	m_workers.clear();						// The workers of the previous calibration
+	reset();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CASRBank::reset()
+{
+	const Eigen::Index n = Eigen::Index(getChannelNumber());
+	m_r.resize(n, Eigen::Index(m_nStream) * n);
+	for (size_t k = 0; k < m_nStream; ++k) { m_r.middleCols(Eigen::Index(k) * n, n).setIdentity(); }
+	m_cov.setZero(n, Eigen::Index(m_nStream) * n);
+	m_trivial.assign(m_nStream, 1);
+	m_hasCov.assign(m_nStream, 0);
+	m_caches.assign(m_nStream, CASR::SReconstructionCache());	// Sized at the first chunk
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRBank::process(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out, const size_t nbThreads)
+{
+	if (m_nStream == 0 || in.size() != m_nStream) { return false; }
+	out.resize(m_nStream);
+	prepareWorkers(nbThreads);
+	std::vector<char> valid(m_nStream, 0);
+	m_pool.run(m_nStream, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t k = begin; k < end; ++k) { valid[k] = char(processStream(k, in[k], out[k], m_workers[job])); }
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRBank::process(const Eigen::MatrixXd& in, Eigen::MatrixXd& out, const size_t nbThreads)
+{
+	const Eigen::Index n = Eigen::Index(getChannelNumber());
+	out                  = in;
+	if (m_nStream == 0 || in.rows() != Eigen::Index(m_nStream) * n || in.cols() == 0) { return false; }
+	prepareWorkers(nbThreads);
+	m_outputs.resize(m_workers.size());
+	std::vector<char> valid(m_nStream, 0);
+	m_pool.run(m_nStream, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t k = begin; k < end; ++k)
+		{
+			// The rows of the stream are a block of the packed chunks (no copy of the input)
+			valid[k]                               = char(processStream(k, in.middleRows(Eigen::Index(k) * n, n), m_outputs[job], m_workers[job]));
+			out.middleRows(Eigen::Index(k) * n, n) = m_outputs[job];
+		}
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRBank::processStream(const size_t stream, const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out, CASR& worker)
+{
+	const Eigen::Index n = Eigen::Index(getChannelNumber()), col = Eigen::Index(stream) * n;
+
+	// Load the state of the stream in the worker (no allocation after the first chunk)
+	worker.m_r = m_r.middleCols(col, n);
+	if (m_hasCov[stream] != 0) { worker.m_cov = m_cov.middleCols(col, n); }
+	else { worker.m_cov.resize(0, 0); }
+	worker.m_trivial = m_trivial[stream] != 0;
+	std::swap(worker.m_cache, m_caches[stream]);
+
+	const bool res = worker.process(in, in, out);
+
+	// Save the state of the stream
+	m_r.middleCols(col, n) = worker.m_r;
+	if (worker.m_cov.size() != 0)
+	{
+		m_cov.middleCols(col, n) = worker.m_cov;
+		m_hasCov[stream]         = 1;
+	}
+	m_trivial[stream] = char(worker.m_trivial);
+	std::swap(worker.m_cache, m_caches[stream]);
+	return res;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CASRBank::prepareWorkers(const size_t nbThreads)
+{
+	const size_t nbJobs = ParallelThreadCount(m_nStream, nbThreads);
+	while (m_workers.size() < nbJobs) { m_workers.push_back(m_calibration); }	// The workers keep their buffers between the ticks
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
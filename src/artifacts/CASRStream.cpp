@@ -0,0 +1,84 @@
+#include "geometry/artifacts/CASRStream.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CASRStream::initialize(const CASR& asr, const size_t window, const size_t step, const size_t capacity)
+{
+	const size_t size = capacity == 0 ? 4 * window : capacity;
+	if (asr.getChannelNumber() == 0 || window < 2 || step == 0 || step > window || size < step)
+	{
+		std::cout << "The ASR must be trained, the window must have 2 samples at least, the step must be in [1;window] and the capacity at least one step." << std::endl;
+		return false;
+	}
+	m_trained    = asr;
+	m_windowSize = window;
+	m_step       = step;
+	m_input.resize(asr.getChannelNumber(), size);
+	m_output.resize(asr.getChannelNumber(), size + step);	// The delay and the cleaned samples of a full input buffer
+	reset();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CASRStream::reset()
+{
+	const Eigen::Index nChannel = Eigen::Index(m_trained.getChannelNumber());
+	m_asr      = m_trained;
+	m_received = 0;
+	m_input.clear();
+	m_output.clear();
+	m_window.setZero(nChannel, Eigen::Index(m_windowSize));
+	m_cleaned.setZero(nChannel, Eigen::Index(m_step));
+	if (m_step > 1) { m_output.push(Eigen::MatrixXd::Zero(nChannel, Eigen::Index(getLatency()))); }	// The delay of the output
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRStream::pull(Eigen::MatrixXd& out)
+{
+	const bool res = update();
+	out.resize(Eigen::Index(getChannelNumber()), Eigen::Index(m_output.size()));
+	return m_output.pop(out) && res;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRStream::process(const Eigen::Ref<const Eigen::MatrixXd>& in, Eigen::MatrixXd& out)
+{
+	if (!push(in)) { return false; }
+	const bool res = update();
+	// The output buffer has at least the size of the input with the delay of one step
+	out.resize(Eigen::Index(getChannelNumber()), in.cols());
+	return m_output.pop(out) && res;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CASRStream::update()
+{
+	if (m_step == 0) { return false; }
+	const Eigen::Index window = Eigen::Index(m_windowSize), step = Eigen::Index(m_step);
+	bool res                  = true;
+	// The steps stay in the input buffer while the output can't receive them (push and process mixed on one stream), so no cleaned sample is lost
+	while (m_input.size() >= m_step && m_output.size() + m_step <= m_output.getCapacity())
+	{
+		// Slide the window of one step (overlap of window - step samples) and read the new samples at the end
+		for (Eigen::Index i = 0; i + step < window; ++i) { m_window.col(i) = m_window.col(i + step); }
+		m_input.pop(m_window.rightCols(step));
+		m_received = std::min(m_received + m_step, m_windowSize);
+
+		// Clean the new samples with the statistics of the window (a failed step gives the samples without cleaning to keep the delay)
+		if (m_received < m_windowSize) { m_cleaned = m_window.rightCols(step); }
+		else if (!m_asr.process(m_window, m_window.rightCols(step), m_cleaned)) { res = false; }
+		m_output.push(m_cleaned);
+	}
+	return res;
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
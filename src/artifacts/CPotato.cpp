@@ -0,0 +1,220 @@
+#include "geometry/artifacts/CPotato.hpp"
+
+#include "geometry/Covariance.hpp"
+#include "geometry/Distance.hpp"
+#include "geometry/Geodesic.hpp"
+#include "geometry/Mean.hpp"
+#include "geometry/classifier/IMatrixClassifier.hpp"
+
+#include <cmath>
+#include <iostream>
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::train(const std::vector<Eigen::MatrixXd>& dataset, const double threshold)
+{
+	if (dataset.size() < 2 || dataset[0].size() == 0) { return false; }
+	const size_t n = dataset.size();	// Number of samples
+
+	//========== Compute the covariance matrix ==========
+	std::vector<Eigen::MatrixXd> covs(n);
+	for (size_t i = 0; i < n; ++i) { if (!CovarianceMatrix(dataset[i], covs[i], EEstimator::LWF, EStandardization::Center)) { return false; } }
+
+	//========== Compute the reference ==========
+	Eigen::MatrixXd reference;
+	if (!Mean(covs, reference, m_metric)) { return false; }
+
+	//========== Compute the statistics of the distances ==========
+	std::vector<double> distances(n);
+	for (size_t i = 0; i < n; ++i) { distances[i] = Distance(covs[i], reference, m_metric); }
+	double mean = 0, variance = 0;
+	for (const auto& d : distances) { mean += d; }
+	mean /= double(n);
+	for (const auto& d : distances) { variance += (d - mean) * (d - mean); }
+	variance /= double(n);
+
+	setThreshold(threshold);
+	return setReference(reference, mean, std::sqrt(variance));
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::process(const Eigen::MatrixXd& in, bool& clean, double& zScore)
+{
+	clean  = false;
+	zScore = 0;
+	if (size_t(in.rows()) != m_nChannel) { return false; }
+	Eigen::MatrixXd cov;
+	if (!CovarianceMatrix(in, cov, EEstimator::LWF, EStandardization::Center)) { return false; }
+	return processCovariance(cov, clean, zScore);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::processCovariance(const Eigen::MatrixXd& cov, bool& clean, double& zScore)
+{
+	clean  = false;
+	zScore = 0;
+	if (m_nChannel == 0 || !HaveSameSize(cov, m_reference)) { return false; }
+
+	// Distance to the reference (the factor of the reference is kept between the epochs)
+	double d;
+	if (m_metric == EMetric::Riemann)
+	{
+		// Eigen decomposition F^-1 C F^-T = W D W^T (the eigen vectors are kept for the update of the reference)
+		m_buffers.product.noalias() = m_factor * cov;
+		m_buffers.matrix.noalias()  = m_buffers.product * m_factor.transpose();
+		if (!SelfAdjointEigen(m_buffers.matrix, m_buffers.values, m_buffers.vectors, m_buffers.eigen, m_forgetting != 0)) { return false; }
+		d = std::sqrt(m_buffers.values.array().log().square().sum());
+	}
+	else
+	{
+		if (!DistanceSampleFactor(cov, m_sampleFactor, m_metric, m_buffers)) { return false; }
+		d = DistanceFactorized(cov, m_sampleFactor, m_reference, m_factor, m_metric, m_buffers);
+	}
+	if (!std::isfinite(d)) { return false; }
+	zScore = (d - m_mean) / m_std;
+	clean  = zScore <= m_threshold;
+	if (!clean || m_forgetting == 0) { return true; }			// The rejected epochs doesn't change the reference
+
+	// Update the statistics and the reference with the clean epoch
+	const double delta = d - m_mean;
+	m_mean += m_forgetting * delta;
+	m_std = std::sqrt((1 - m_forgetting) * (m_std * m_std + m_forgetting * delta * delta));
+	if (m_metric != EMetric::Riemann)
+	{
+		if (!Geodesic(m_reference, cov, m_reference, m_metric, m_forgetting, m_buffers)) { return false; }
+		return updateFactor();
+	}
+
+	// Geodesic with the decomposition of the distance : R = F (F^-1 C F^-T)^a F^T = G G^T with G = F W D^(a/2) and G^-1 = D^(-a/2) W^T F^-1
+	for (Eigen::Index i = 0; i < m_buffers.values.size(); ++i) { m_buffers.values[i] = std::pow(m_buffers.values[i], 0.5 * m_forgetting); }
+	m_buffers.product.noalias() = m_root * m_buffers.vectors;
+	m_buffers.product.array().rowwise() *= m_buffers.values.transpose().array();
+	m_reference.noalias() = m_buffers.product * m_buffers.product.transpose();
+	m_root                = m_buffers.product;
+	m_buffers.product.noalias() = m_buffers.vectors.transpose() * m_factor;
+	m_buffers.product.array().colwise() /= m_buffers.values.array();
+	m_factor = m_buffers.product;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::setReference(const Eigen::MatrixXd& reference, const double mean, const double deviation)
+{
+	if (!IsSquare(reference) || reference.size() == 0 || !(deviation > 0))
+	{
+		std::cout << "The reference must be square and the standard deviation positive." << std::endl;
+		return false;
+	}
+	m_nChannel  = reference.rows();
+	m_reference = reference;
+	m_mean      = mean;
+	m_std       = deviation;
+	return updateFactor();
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::updateFactor()
+{
+	if (m_reference.size() == 0) { return true; }
+	if (!DistanceReferenceFactor(m_reference, m_factor, m_metric, m_buffers)) { return false; }
+	if (m_metric == EMetric::Riemann) { m_root = m_buffers.matrix.triangularView<Eigen::Lower>(); }	// Cholesky factor L of the reference
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//***********************
+//***** XML Manager *****
+//***********************
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::saveXML(const std::string& filename) const
+{
+	tinyxml2::XMLDocument doc;
+	// Create Root
+	tinyxml2::XMLNode* root = doc.NewElement("Potato");			// Create root node
+	doc.InsertFirstChild(root);									// Add root to XML
+
+	tinyxml2::XMLElement* data = doc.NewElement("Potato-data");	// Create data node
+	data->SetAttribute("metric", toString(m_metric).c_str());	// Set attribute metric
+	data->SetAttribute("nChannel", int(m_nChannel));			// Set attribute nChannel
+	data->SetAttribute("threshold", m_threshold);				// Set attribute threshold
+	data->SetAttribute("forgetting", m_forgetting);				// Set attribute forgetting
+	data->SetAttribute("mean", m_mean);							// Set attribute mean
+	data->SetAttribute("std", m_std);							// Set attribute std
+
+	tinyxml2::XMLElement* reference = doc.NewElement("Reference");	// Create Reference node
+	if (!IMatrixClassifier::saveMatrix(reference, m_reference)) { return false; }	// Save Reference Matrix
+	data->InsertEndChild(reference);							// Add Reference node to data node
+
+	root->InsertEndChild(data);									// Add data to root
+	return doc.SaveFile(filename.c_str()) == 0;					// save XML (if != 0 it means error)
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::loadXML(const std::string& filename)
+{
+	// Load File
+	tinyxml2::XMLDocument xmlDoc;
+	if (xmlDoc.LoadFile(filename.c_str()) != 0) { return false; }	// Check File Exist and Loading
+
+	// Load Root
+	tinyxml2::XMLNode* root = xmlDoc.FirstChild();				// Get Root Node
+	if (root == nullptr) { return false; }						// Check Root Node Exist
+
+	// Load Data
+	tinyxml2::XMLElement* data = root->FirstChildElement("Potato-data");	// Get Data Node
+	if (data == nullptr) { return false; }						// Check Data Node Exist
+	m_metric     = StringToMetric(std::string(data->Attribute("metric")));
+	m_nChannel   = data->IntAttribute("nChannel");
+	m_threshold  = data->DoubleAttribute("threshold");
+	m_forgetting = data->DoubleAttribute("forgetting");
+	m_mean       = data->DoubleAttribute("mean");
+	m_std        = data->DoubleAttribute("std");
+
+	tinyxml2::XMLElement* element = data->FirstChildElement("Reference");	// Get Reference Node
+	if (element == nullptr) { return false; }					// Check if Node Exist
+	if (!IMatrixClassifier::loadMatrix(element, m_reference)) { return false; }	// Load Reference Matrix
+	if (size_t(m_reference.rows()) != m_nChannel) { return false; }
+
+	return updateFactor();
+}
+///-------------------------------------------------------------------------------------------------
+
+//*****************************
+//***** Override Operator *****
+//*****************************
+
+///-------------------------------------------------------------------------------------------------
+bool CPotato::isEqual(const CPotato& obj, const double precision) const
+{
+	return m_metric == obj.m_metric && m_nChannel == obj.m_nChannel
+		   && std::abs(m_threshold - obj.m_threshold) < precision && std::abs(m_forgetting - obj.m_forgetting) < precision
+		   && std::abs(m_mean - obj.m_mean) < precision && std::abs(m_std - obj.m_std) < precision
+		   && AreEquals(m_reference, obj.m_reference, precision);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+std::stringstream CPotato::print() const
+{
+	std::stringstream ss;
+	ss << "Metric : " << toString(m_metric) << std::endl;
+	if (m_nChannel == 0) { ss << "Train not done" << std::endl; }
+	else
+	{
+		ss << "Train done." << std::endl;
+		ss << "Z-score threshold : " << m_threshold << ", forgetting factor : " << m_forgetting << std::endl;
+		ss << "Distances : mean " << m_mean << ", standard deviation " << m_std << std::endl;
+		ss << "Reference matrix is : " << std::endl << m_reference << std::endl;
+	}
+	return ss;
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
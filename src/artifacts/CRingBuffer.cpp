@@ -0,0 +1,52 @@
+#include "geometry/artifacts/CRingBuffer.hpp"
+
+#include <algorithm>
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CRingBuffer::push(const Eigen::Ref<const Eigen::MatrixXd>& in)
+{
+	const size_t capacity = getCapacity(), n = size_t(in.cols());
+	const size_t head     = m_head.load(std::memory_order_relaxed),	// Only this thread writes the head
+				 tail     = m_tail.load(std::memory_order_acquire);	// The samples before the tail are read by the consumer
+	if (in.rows() != m_data.rows() || n > capacity - (head - tail)) { return false; }
+	if (n == 0) { return true; }
+
+	// Copy in two parts if the samples go round the end of the buffer
+	const size_t begin = head % capacity, first = std::min(n, capacity - begin);
+	m_data.middleCols(Eigen::Index(begin), Eigen::Index(first)) = in.leftCols(Eigen::Index(first));
+	m_data.leftCols(Eigen::Index(n - first))                    = in.rightCols(Eigen::Index(n - first));
+	m_head.store(head + n, std::memory_order_release);				// Publish the samples to the consumer
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CRingBuffer::pop(Eigen::Ref<Eigen::MatrixXd> out)
+{
+	const size_t capacity = getCapacity(), n = size_t(out.cols());
+	const size_t tail     = m_tail.load(std::memory_order_relaxed),	// Only this thread writes the tail
+				 head     = m_head.load(std::memory_order_acquire);	// The samples before the head are written by the producer
+	if (out.rows() != m_data.rows() || n > head - tail) { return false; }
+	if (n == 0) { return true; }
+
+	// Copy in two parts if the samples go round the end of the buffer
+	const size_t begin = tail % capacity, first = std::min(n, capacity - begin);
+	out.leftCols(Eigen::Index(first))      = m_data.middleCols(Eigen::Index(begin), Eigen::Index(first));
+	out.rightCols(Eigen::Index(n - first)) = m_data.leftCols(Eigen::Index(n - first));
+	m_tail.store(tail + n, std::memory_order_release);				// Give the space back to the producer
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CRingBuffer::resize(const size_t nChannel, const size_t capacity)
+{
+	m_data.setZero(Eigen::Index(nChannel), Eigen::Index(capacity));
+	m_head.store(0, std::memory_order_relaxed);
+	m_tail.store(0, std::memory_order_relaxed);
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
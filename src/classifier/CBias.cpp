@@ -16,14 +16,15 @@ bool CBias::computeBias(const std::vector<std::vector<Eigen::MatrixXd>>& dataset
 bool CBias::computeBias(const std::vector<Eigen::MatrixXd>& datasets, const EMetric metric)
 {
 	if (!Mean(datasets, m_bias, metric)) { return false; }	// Compute Bias reference
-	m_biasIS = m_bias.sqrt().inverse();						// Inverse Square root of Bias matrix => isR
-	m_n      = 0;
+	SSymmetricBuffers buffers;
+	refresh(buffers);										// Inverse Square root of Bias matrix => isR
+	m_n = 0;
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
-void CBias::applyBias(const std::vector<std::vector<Eigen::MatrixXd>>& in, std::vector<std::vector<Eigen::MatrixXd>>& out)
+void CBias::applyBias(const std::vector<std::vector<Eigen::MatrixXd>>& in, std::vector<std::vector<Eigen::MatrixXd>>& out) const
 {
 	const size_t n = in.size();
 	out.resize(n);
@@ -32,7 +33,7 @@ void CBias::applyBias(const std::vector<std::vector<Eigen::MatrixXd>>& in, std::
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
-void CBias::applyBias(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out)
+void CBias::applyBias(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen::MatrixXd>& out) const
 {
 	const size_t n = in.size();
 	out.resize(n);
@@ -41,24 +42,123 @@ void CBias::applyBias(const std::vector<Eigen::MatrixXd>& in, std::vector<Eigen:
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
-void CBias::applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) { out = m_biasIS * in * m_biasIS.transpose(); }
+void CBias::applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) const
+{
+	if (!m_outdated) { out = m_biasIS * in * m_biasIS.transpose(); }
+	else													// Deferred update, the object isn't modified (shared classifier)
+	{
+		Eigen::MatrixXd biasIS, biasS;
+		SSymmetricBuffers buffers;
+		InverseSqrt(m_bias, biasIS, biasS, buffers);
+		out = biasIS * in * biasIS.transpose();
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CBias::applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out)
+{
+	SSymmetricBuffers buffers;
+	applyBias(in, out, buffers);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CBias::applyBias(const Eigen::MatrixXd& in, Eigen::MatrixXd& out, SSymmetricBuffers& buffers)
+{
+	if (m_outdated) { refresh(buffers); }					// Deferred update
+	buffers.product.noalias() = m_biasIS * in;
+	out.noalias()             = buffers.product * m_biasIS.transpose();
+}
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
 void CBias::updateBias(const Eigen::MatrixXd& sample, const EMetric metric)
+{
+	SSymmetricBuffers buffers;
+	updateBias(sample, metric, buffers);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CBias::updateBias(const Eigen::MatrixXd& sample, const EMetric metric, SSymmetricBuffers& buffers)
 {
 	m_n++;													// Update number of classify
-	if (m_n == 1) { m_bias = sample; }						// At the first pass we reinitialize the Bias
-	else { Geodesic(m_bias, sample, m_bias, metric, 1.0 / m_n); }
-	m_biasIS = m_bias.sqrt().inverse();						// Inverse Square root of Bias matrix => isR
+	if (m_n == 1)											// At the first pass we reinitialize the Bias
+	{
+		m_bias = sample;
+		m_factor.resize(0, 0);
+	}
+	else if (metric == EMetric::Riemann && HaveSameSize(m_bias, sample))
+	{
+		if (m_factor.size() == 0) { refresh(buffers); }		// Factor of the bias B = F F^T
+		// Geodesic with the factor : G = F (F^-1 S F^-T)^(1/n) F^T = (F W D^(1/2n)) (F W D^(1/2n))^T
+		buffers.product.noalias() = m_factorInv * sample;
+		buffers.matrix.noalias()  = buffers.product * m_factorInv.transpose();
+		SelfAdjointEigen(buffers.matrix, buffers.values, buffers.vectors, buffers.eigen);
+		for (Eigen::Index i = 0; i < buffers.values.size(); ++i) { buffers.values[i] = pow(std::max(buffers.values[i], 0.0), 0.5 / double(m_n)); }
+		buffers.product.noalias() = m_factor * buffers.vectors;
+		buffers.product.array().rowwise() *= buffers.values.transpose().array();
+		m_bias.noalias()          = buffers.product * buffers.product.transpose();
+		if (m_deferred)										// The next step uses this factor, without the eigen decomposition of the bias
+		{
+			m_factor                  = buffers.product;
+			buffers.product.noalias() = buffers.vectors.transpose() * m_factorInv;
+			buffers.product.array().colwise() /= buffers.values.array();
+			m_factorInv = buffers.product;
+		}
+	}
+	else
+	{
+		Geodesic(m_bias, sample, m_bias, metric, 1.0 / m_n, buffers);
+		m_factor.resize(0, 0);
+	}
+	m_outdated = true;
+	if (!m_deferred) { refresh(buffers); }					// Inverse Square root of Bias matrix => isR and factor of the next step
 }
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
 void CBias::setBias(const Eigen::MatrixXd& bias)
 {
-	m_bias   = bias;
-	m_biasIS = m_bias.sqrt().inverse();
+	m_bias = bias;
+	SSymmetricBuffers buffers;
+	refresh(buffers);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CBias::refresh(SSymmetricBuffers& buffers)
+{
+	// B = V D V^T : inverse square root V D^(-1/2) V^T, factor V D^(1/2) and its inverse D^(-1/2) V^T
+	SelfAdjointEigen(m_bias, buffers.values, buffers.vectors, buffers.eigen);
+	buffers.values        = buffers.values.array().max(0).sqrt();
+	m_factor.noalias()    = buffers.vectors * buffers.values.asDiagonal();
+	m_factorInv.noalias() = buffers.values.asDiagonal().inverse() * buffers.vectors.transpose();
+	m_biasIS.noalias()    = buffers.vectors * m_factorInv;
+	m_outdated            = false;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CBias::InverseSqrt(const Eigen::MatrixXd& bias, Eigen::MatrixXd& biasIS, Eigen::MatrixXd& biasS, SSymmetricBuffers& buffers)
+{
+	SelfAdjointEigen(bias, buffers.values, buffers.vectors, buffers.eigen);
+	buffers.values = buffers.values.array().max(0).sqrt();
+	buffers.product.noalias() = buffers.vectors * buffers.values.asDiagonal();
+	biasS.noalias()           = buffers.product * buffers.vectors.transpose();
+	buffers.product.noalias() = buffers.vectors * buffers.values.asDiagonal().inverse();
+	biasIS.noalias()          = buffers.product * buffers.vectors.transpose();
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool Unbias(const Eigen::MatrixXd& sample, CBias& bias, const EMetric metric, Eigen::MatrixXd& unbiased, SSymmetricBuffers& buffers)
+{
+	if (!IsSquare(sample) || sample.rows() != bias.getBias().rows()) { return false; }	// The bias must have the size of the sample
+	bias.applyBias(sample, unbiased, buffers);
+	bias.updateBias(sample, metric, buffers);
+	return true;
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -113,7 +213,8 @@ bool CBias::loadAdditional(tinyxml2::XMLElement* data)
 	tinyxml2::XMLElement* bias = data->FirstChildElement("Bias");	// Get LDA Weight Node
 	m_n                        = bias->IntAttribute("n");			// Get the number of Trials for this class
 	if (!IMatrixClassifier::loadMatrix(bias, m_bias)) { return false; }	// Load Reference Matrix
-	m_biasIS = m_bias.sqrt().inverse();
+	SSymmetricBuffers buffers;
+	refresh(buffers);
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -125,9 +226,13 @@ bool CBias::isEqual(const CBias& obj, const double precision) const { return Are
 ///-------------------------------------------------------------------------------------------------
 void CBias::copy(const CBias& obj)
 {
-	m_bias   = obj.m_bias;
-	m_biasIS = obj.m_biasIS;
-	m_n      = obj.m_n;
+	m_bias      = obj.m_bias;
+	m_biasIS    = obj.m_biasIS;
+	m_factor    = obj.m_factor;
+	m_factorInv = obj.m_factorInv;
+	m_deferred  = obj.m_deferred;
+	m_outdated  = obj.m_outdated;
+	m_n         = obj.m_n;
 }
 ///-------------------------------------------------------------------------------------------------
 
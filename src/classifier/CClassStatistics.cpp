@@ -0,0 +1,111 @@
+#include "geometry/classifier/CClassStatistics.hpp"
+#include "geometry/Covariance.hpp"
+#include "geometry/Basics.hpp"
+#include <algorithm>
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+void CClassStatistics::reset(const size_t nbFeatures)
+{
+	m_n       = 0;
+	m_sum     = Eigen::RowVectorXd::Zero(nbFeatures);
+	m_scatter = Eigen::MatrixXd::Zero(nbFeatures, nbFeatures);
+	m_moment3 = Eigen::MatrixXd::Zero(nbFeatures, nbFeatures);
+	m_moment4 = Eigen::MatrixXd::Zero(nbFeatures, nbFeatures);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassStatistics::set(const size_t count, const Eigen::RowVectorXd& sum, const Eigen::MatrixXd& scatter, const Eigen::MatrixXd& moment3, const Eigen::MatrixXd& moment4)
+{
+	const Eigen::Index nF = sum.size();
+	for (const auto* m : { &scatter, &moment3, &moment4 }) { if (m->rows() != nF || m->cols() != nF) { return false; } }
+	m_n       = count;
+	m_sum     = sum;
+	m_scatter = scatter;
+	m_moment3 = moment3;
+	m_moment4 = moment4;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassStatistics::add(const Eigen::RowVectorXd& sample)
+{
+	if (m_sum.size() == 0) { reset(sample.size()); }
+	if (sample.size() != m_sum.size()) { return false; }
+	const Eigen::RowVectorXd squared = sample.cwiseProduct(sample);
+	m_n++;
+	m_sum += sample;
+	m_scatter.noalias() += sample.transpose() * sample;
+	m_moment3.noalias() += squared.transpose() * sample;
+	m_moment4.noalias() += squared.transpose() * squared;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassStatistics::add(const std::vector<Eigen::RowVectorXd>& samples)
+{
+	for (const auto& s : samples) { if (!add(s)) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassStatistics::covarianceLWF(Eigen::MatrixXd& cov) const
+{
+	if (m_n == 0) { return false; }
+	const size_t nF = m_sum.size();
+	const double n  = double(m_n);
+
+	// Standard Scaler (mean and standard deviation of each feature)
+	const Eigen::RowVectorXd mu = m_sum / n;
+	Eigen::RowVectorXd scale(nF);
+	for (size_t i = 0; i < nF; ++i)
+	{
+		const double variance = m_scatter(i, i) / n - mu[i] * mu[i];
+		scale[i]              = variance <= 0 ? 1 : sqrt(variance);
+	}
+
+	// Covariance of standardized features and sum of squared products of squared standardized features (centered moments from raw moments)
+	cov.resize(nF, nF);
+	double sumX2 = 0;
+	for (size_t i = 0; i < nF; ++i)
+	{
+		for (size_t j = 0; j < nF; ++j)
+		{
+			const double mi = mu[i], mj = mu[j], si2 = scale[i] * scale[i], sj2 = scale[j] * scale[j];
+			cov(i, j)       = (m_scatter(i, j) / n - mi * mj) / (scale[i] * scale[j]);
+			const double x2 = m_moment4(i, j) - 2 * mj * m_moment3(i, j) - 2 * mi * m_moment3(j, i)
+							  + mj * mj * m_scatter(i, i) + mi * mi * m_scatter(j, j) + 4 * mi * mj * m_scatter(i, j)
+							  - 2 * mi * mj * mj * m_sum[i] - 2 * mi * mi * mj * m_sum[j] + n * mi * mi * mj * mj;
+			sumX2 += x2 / (si2 * sj2);
+		}
+	}
+
+	// Ledoit and Wolf shrinkage (same formula as CovarianceMatrixLWF)
+	const double trace     = cov.trace() / nF;
+	Eigen::MatrixXd mDelta = cov;
+	for (size_t i = 0; i < nF; ++i) { mDelta(i, i) -= trace; }
+	const double delta     = mDelta.cwiseProduct(mDelta).sum() / nF,
+				 beta      = 1. / (double(nF) * n) * (sumX2 / n - cov.cwiseProduct(cov).sum()),
+				 shrinkage = std::min(beta, delta) / delta;
+	if (!ShrunkCovariance(cov, shrinkage)) { return false; }
+
+	// Rescale
+	for (size_t i = 0; i < nF; ++i) { for (size_t j = 0; j < nF; ++j) { cov(i, j) *= scale[i] * scale[j]; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassStatistics::isEqual(const CClassStatistics& obj, const double precision) const
+{
+	return m_n == obj.m_n && AreEquals(m_sum, obj.m_sum, precision) && AreEquals(m_scatter, obj.m_scatter, precision)
+		   && AreEquals(m_moment3, obj.m_moment3, precision) && AreEquals(m_moment4, obj.m_moment4, precision);
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
@@ -0,0 +1,13 @@
+#include "geometry/classifier/CClassifierHandle.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+size_t CClassifierHandle::publish(const std::shared_ptr<const IMatrixClassifier>& model)
+{
+	std::atomic_store(&m_model, model);								// The readers take the new version from now
+	return m_version.fetch_add(1, std::memory_order_acq_rel) + 1;	// The sessions see the new version after the store
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
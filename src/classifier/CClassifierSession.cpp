@@ -0,0 +1,61 @@
+#include "geometry/classifier/CClassifierSession.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CClassifierSession::setModel(const std::shared_ptr<const IMatrixClassifier>& model, const bool keepState)
+{
+	const bool compatible = keepState && m_model != nullptr && model != nullptr
+							&& model->getType() == m_model->getType() && model->getClassCount() == m_model->getClassCount();
+	const std::vector<size_t> nbTrials = m_nbTrials;
+	const CBias bias                   = m_bias;
+	m_model                            = model;
+	if (!reset()) { return false; }
+	if (compatible)
+	{
+		// The bias is kept only if the means of the new model have the same number of channels
+		const Eigen::Index nbChannel = m_means.empty() ? 0 : m_means[0].rows();
+		if (m_nbTrials.size() == nbTrials.size()) { m_nbTrials = nbTrials; }
+		if (bias.getBias().size() != 0 && bias.getBias().rows() == nbChannel) { m_bias = bias; }
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassifierSession::setHandle(const CClassifierHandle& handle, const bool keepState)
+{
+	m_handle    = &handle;
+	m_keepState = keepState;
+	m_version   = handle.getVersion();
+	return setModel(handle.acquire(), false);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassifierSession::reset()
+{
+	m_means.clear();
+	m_factors.clear();
+	m_nbTrials.clear();
+	m_bias = CBias();
+	if (m_model == nullptr) { return false; }
+	return m_model->initSession(*this);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CClassifierSession::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+								  const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (m_handle != nullptr && m_handle->getVersion() != m_version)	// New version published
+	{
+		m_version = m_handle->getVersion();
+		if (!setModel(m_handle->acquire(), m_keepState)) { return false; }
+	}
+	if (m_model == nullptr) { return false; }
+	return m_model->classify(sample, *this, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
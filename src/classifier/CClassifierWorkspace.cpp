@@ -0,0 +1,25 @@
+#include "geometry/classifier/CClassifierWorkspace.hpp"
+#include "geometry/classifier/IMatrixClassifier.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+bool CClassifierWorkspace::init(const IMatrixClassifier& classifier, const size_t nbChannels) { return classifier.initWorkspace(*this, nbChannels); }
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CClassifierWorkspace::resize(const size_t nbChannels, const size_t nbClass)
+{
+	const Eigen::Index n = Eigen::Index(nbChannels);
+	m_nbChannels         = nbChannels;
+	m_nbClass            = nbClass;
+	symmetric.resize(n);
+	unbiased.resize(n, n);
+	sample.resize(n, n);
+	tangent.resize(n * (n + 1) / 2);
+	scores.resize(nbClass);
+	bounds.resize(nbClass);
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
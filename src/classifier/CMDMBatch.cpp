@@ -0,0 +1,219 @@
+#include "geometry/classifier/CMDMBatch.hpp"
+#include "geometry/Classification.hpp"
+#include "geometry/Distance.hpp"
+#include "geometry/Basics.hpp"
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Check if the distances of the metric use the packed factors. </summary>
+static bool HasFactors(const EMetric metric) { return metric == EMetric::Riemann || metric == EMetric::LogEuclidian || metric == EMetric::Wasserstein; }
+
+/// <summary>	Minimal number of classes of the chunks of models with the eigen values computed together. </summary>
+static const size_t EIGEN_CHUNK = 16;
+///-------------------------------------------------------------------------------------------------
+
+//***************************
+//***** Getter / Setter *****
+//***************************
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::addModel(const CMatrixClassifierMDM& model)
+{
+	if (model.getType() != toString(EMatrixClassifiers::MDM)) { return false; }	// Only the base classifier (without filter or bias)
+	const std::vector<Eigen::MatrixXd>& means = model.getMeans();
+	const size_t nbClass                      = model.getClassCount();
+	if (nbClass == 0 || means.size() != nbClass || !IsSquare(means[0])) { return false; }	// Verification if classifier is trained
+	if (getModelCount() == 0)									// The first model gives the geometry
+	{
+		m_metric     = model.getMetric();
+		m_nbChannels = size_t(means[0].rows());
+	}
+	else if (model.getMetric() != m_metric || size_t(means[0].rows()) != m_nbChannels) { return false; }
+
+	// Resize the packed storage
+	const size_t index = getModelCount(), first = m_offsets.back();
+	const Eigen::Index n = Eigen::Index(m_nbChannels);
+	m_offsets.push_back(first + nbClass);
+	m_means.conservativeResize(n, Eigen::Index(m_offsets.back()) * n);
+	m_traces.conservativeResize(Eigen::Index(m_offsets.back()));
+	if (HasFactors(m_metric)) { m_factors.conservativeResize(n, Eigen::Index(m_offsets.back()) * n); }
+	if (pack(index, model)) { return true; }
+
+	// Remove the model
+	m_offsets.pop_back();
+	m_means.conservativeResize(n, Eigen::Index(first) * n);
+	m_traces.conservativeResize(Eigen::Index(first));
+	if (HasFactors(m_metric)) { m_factors.conservativeResize(n, Eigen::Index(first) * n); }
+	return false;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::setModel(const size_t index, const CMatrixClassifierMDM& model)
+{
+	if (index >= getModelCount() || model.getType() != toString(EMatrixClassifiers::MDM)) { return false; }
+	if (model.getMetric() != m_metric || model.getClassCount() != getClassCount(index) || model.getMeans().size() != getClassCount(index)) { return false; }
+	return pack(index, model);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMDMBatch::clear()
+{
+	m_nbChannels = 0;
+	m_offsets    = { 0 };
+	m_means.resize(0, 0);
+	m_factors.resize(0, 0);
+	m_traces.resize(0);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::pack(const size_t index, const CMatrixClassifierMDM& model)
+{
+	const std::vector<Eigen::MatrixXd>& means = model.getMeans();
+	const Eigen::Index n                      = Eigen::Index(m_nbChannels);
+	const size_t first                        = m_offsets[index];
+	SSymmetricBuffers buffers;
+	Eigen::MatrixXd factor;
+	for (size_t k = 0; k < means.size(); ++k)
+	{
+		if (means[k].rows() != n || means[k].cols() != n) { return false; }
+		const Eigen::Index col = Eigen::Index(first + k) * n;
+		m_means.middleCols(col, n) = means[k];
+		m_traces[Eigen::Index(first + k)] = means[k].trace();
+		if (!HasFactors(m_metric)) { continue; }
+		if (!DistanceReferenceFactor(means[k], factor, m_metric, buffers)) { return false; }
+		// The transposed Cholesky factor gives the whitened sample with the products by column (S x F^T)
+		if (m_metric == EMetric::Riemann) { m_factors.middleCols(col, n) = factor.transpose(); }
+		else { m_factors.middleCols(col, n) = factor; }
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//**********************
+//***** Classifier *****
+//**********************
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, std::vector<std::vector<double>>& distances,
+						 std::vector<std::vector<double>>& probabilities, const size_t nbThreads) const
+{
+	const size_t nbModels = getModelCount();
+	if (samples.size() != nbModels) { return false; }
+	classIds.resize(nbModels);
+	distances.resize(nbModels);
+	probabilities.resize(nbModels);
+	if (nbModels == 0) { return true; }
+
+	std::vector<SBuffers> buffers(ParallelThreadCount(nbModels, nbThreads));
+	std::vector<char> valid(nbModels, 0);
+	const bool eigen = m_metric == EMetric::Riemann || m_metric == EMetric::Wasserstein;
+	m_pool.run(nbModels, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		buffers[job].symmetric.resize(Eigen::Index(m_nbChannels));
+		for (size_t first = begin, last = begin; first < end; first = last)
+		{
+			// Chunk of models with enough classes to fill the groups of the eigen values, small enough to stay in cache
+			last = first + 1;
+			while (last < end && m_offsets[last] - m_offsets[first] < EIGEN_CHUNK) { ++last; }
+			if (eigen && !computeEigenValues(first, last, samples, buffers[job])) { continue; }
+			for (size_t i = first; i < last; ++i)
+			{
+				if (!computeDistances(i, samples[i], distances[i], buffers[job])) { continue; }
+				DistancesToProbabilities(distances[i], classIds[i], probabilities[i]);
+				valid[i] = 1;
+			}
+		}
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::computeEigenValues(const size_t begin, const size_t end, const std::vector<Eigen::MatrixXd>& samples, SBuffers& buffers) const
+{
+	const Eigen::Index n = Eigen::Index(m_nbChannels);
+	buffers.first        = m_offsets[begin];
+	buffers.matrices.resize(n, Eigen::Index(m_offsets[end] - buffers.first) * n);
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const Eigen::MatrixXd& sample = samples[i];
+		const size_t first            = m_offsets[i], nbClass = m_offsets[i + 1] - first;
+		const Eigen::Index col        = Eigen::Index(first) * n, width = Eigen::Index(nbClass) * n;
+		auto matrices                 = buffers.matrices.middleCols(Eigen::Index(first - buffers.first) * n, width);
+		if (!IsSquare(sample) || sample.rows() != n)				// Rejected by computeDistances, identity matrices to keep the other models of the chunk
+		{
+			for (size_t k = 0; k < nbClass; ++k) { matrices.middleCols(Eigen::Index(k) * n, n).setIdentity(); }
+			continue;
+		}
+
+		// With the Cholesky factor of the sample S = L L^T : F_k^T S F_k = M_k^T M_k with one product for all classes [M_1 ... M_K] = L^T [F_1 ... F_K]
+		buffers.cholesky    = sample;
+		const bool cholesky = Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(buffers.cholesky) < 0;
+		if (cholesky) { buffers.products.noalias() = buffers.cholesky.triangularView<Eigen::Lower>().transpose() * m_factors.middleCols(col, width); }
+		else { buffers.products.noalias() = sample * m_factors.middleCols(col, width); }	// Singular sample : S [F_1 ... F_K]
+		for (size_t k = 0; k < nbClass; ++k)
+		{
+			const Eigen::Index c = Eigen::Index(k) * n;
+			auto matrix          = matrices.middleCols(c, n);
+			if (cholesky)										// Only the lower part is used by the eigen decomposition
+			{
+				matrix.setZero();
+				matrix.selfadjointView<Eigen::Lower>().rankUpdate(buffers.products.middleCols(c, n).transpose());
+			}
+			else { matrix.noalias() = m_factors.middleCols(col + c, n).transpose() * buffers.products.middleCols(c, n); }
+		}
+	}
+	// Eigen values of all classes of the chunk at once (the groups of interleaved iterations span the models)
+	return SelfAdjointEigenValues(buffers.matrices, buffers.values, buffers.eigen);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMDMBatch::computeDistances(const size_t index, const Eigen::MatrixXd& sample, std::vector<double>& distance, SBuffers& buffers) const
+{
+	const Eigen::Index n = Eigen::Index(m_nbChannels);
+	if (!IsSquare(sample) || sample.rows() != n) { return false; }	// Verification if it's a square matrix of the good size
+	const size_t first = m_offsets[index], nbClass = m_offsets[index + 1] - first;
+	const Eigen::Index col = Eigen::Index(first) * n;
+	distance.resize(nbClass);
+
+	switch (m_metric)
+	{
+		case EMetric::Riemann:
+		case EMetric::Wasserstein:
+		{
+			// The eigen values of all classes of the chunk are already computed (see computeEigenValues)
+			const Eigen::Index offset = Eigen::Index(first - buffers.first);
+			const double trace        = sample.trace();
+			for (size_t k = 0; k < nbClass; ++k)
+			{
+				const auto values = buffers.values.col(offset + Eigen::Index(k));
+				if (m_metric == EMetric::Riemann) { distance[k] = sqrt(values.array().log().square().sum()); }
+				else { distance[k] = sqrt(trace + m_traces[Eigen::Index(first + k)] - 2 * values.array().max(0).sqrt().sum()); }
+			}
+			return true;
+		}
+		case EMetric::Euclidian:
+		case EMetric::LogEuclidian:
+		{
+			// The classes of the model are contiguous : one column of N x N coefficients by class
+			const bool euclidian = m_metric == EMetric::Euclidian;
+			if (!euclidian && !DistanceSampleFactor(sample, buffers.factor, m_metric, buffers.symmetric)) { return false; }
+			const Eigen::MatrixXd& packed = euclidian ? m_means : m_factors;
+			const Eigen::Map<const Eigen::MatrixXd> classes(packed.data() + col * n, n * n, Eigen::Index(nbClass));
+			const Eigen::Map<const Eigen::VectorXd> vector((euclidian ? sample : buffers.factor).data(), n * n);
+			for (size_t k = 0; k < nbClass; ++k) { distance[k] = (classes.col(Eigen::Index(k)) - vector).norm(); }
+			return true;
+		}
+		default:
+			for (size_t k = 0; k < nbClass; ++k) { distance[k] = Distance(sample, m_means.middleCols(col + Eigen::Index(k) * n, n), m_metric); }
+			return true;
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
@@ -1,20 +1,22 @@
 #include "geometry/classifier/CMatrixClassifierFgMDM.hpp"
 #include "geometry/Mean.hpp"
+#include "geometry/Basics.hpp"
+#include "geometry/Geodesic.hpp"
+#include "geometry/Featurization.hpp"
 
 namespace Geometry {
 
 ///-------------------------------------------------------------------------------------------------
 CMatrixClassifierFgMDM::~CMatrixClassifierFgMDM()
 {
-	for (auto& v : m_datasets) { v.clear(); }
-	m_datasets.clear();
+	m_statistics = CCopyOnWrite<std::vector<CClassStatistics>>();
 }
 ///-------------------------------------------------------------------------------------------------
 
 ///-------------------------------------------------------------------------------------------------
 bool CMatrixClassifierFgMDM::train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
 {
-	m_datasets = datasets;
+	m_datasets.set(datasets);
 	return train();
 }
 ///-------------------------------------------------------------------------------------------------
@@ -23,18 +25,225 @@ bool CMatrixClassifierFgMDM::train(const std::vector<std::vector<Eigen::MatrixXd
 bool CMatrixClassifierFgMDM::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
 									  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
 {
-	if (!CMatrixClassifierFgMDMRT::classify(sample, classId, distance, probability, EAdaptations::None)) { return false; }
+	if (adaptation == EAdaptations::None) { return CMatrixClassifierFgMDMRT::classify(sample, classId, distance, probability, adaptation); }
+
+	// Without statistics and datasets only the MDM part can evolve
+	const bool hasStatistics = m_statistics->size() == m_nbClass;
+	bool hasDatasets         = m_datasets->size() == m_nbClass;
+	for (const auto& trials : m_datasets.get()) { hasDatasets = hasDatasets && !trials.empty(); }
+	if (!hasStatistics && !hasDatasets) { return CMatrixClassifierFgMDMRT::classify(sample, classId, distance, probability, adaptation, realClassId); }
+
+	Eigen::RowVectorXd tsSample, filtered;
+	Eigen::MatrixXd newSample;
+	if (!TangentSpace(sample, tsSample, m_ref.get())) { return false; }					// Transform to the Tangent Space
+	if (!FgDAApply(tsSample, filtered, m_weightU.get(), m_weightV.get())) { return false; }		// Apply Filter
+	if (!UnTangentSpace(filtered, newSample, m_ref.get())) { return false; }				// Return to Matrix Space
+	if (!CMatrixClassifierMDM::classify(newSample, classId, distance, probability, EAdaptations::None)) { return false; }
 
 	// Adaptation
-	if (adaptation == EAdaptations::None) { return true; }
 	// Get class id for adaptation and increase number of trials, expected if supervised, predicted if unsupervised
 	const size_t id = adaptation == EAdaptations::Supervised ? realClassId : classId;
 	if (id >= m_nbClass) { return false; }					// Check id (if supervised and bad input)
+	if (!hasStatistics)										// Statistics initialization with an exact retrain
+	{
+		m_datasets.write()[id].push_back(sample);
+		return train();
+	}
 	m_nbTrials[id]++;										// Update number of trials for the class id
-	m_datasets[id].push_back(sample);						// Update the dataset
+	if (!m_statistics.write()[id].add(tsSample)) { return false; }	// Update the statistics (copied if shared)
 
-	// Retrain 
-	return train();
+	// Update the drift of the reference
+	m_nbDrift++;
+	if (m_nbDrift == 1) { m_drift = sample; }
+	else if (!Geodesic(m_drift, sample, m_drift, EMetric::Riemann, 1.0 / double(m_nbDrift))) { return false; }
+
+	// Exact re-anchoring
+	if (m_anchorPeriod != 0)
+	{
+		std::vector<std::vector<Eigen::MatrixXd>>& datasets = m_datasets.write();	// Detach the datasets shared with the copies
+		if (datasets.size() != m_nbClass) { datasets.resize(m_nbClass); }
+		auto& trials = datasets[id];
+		trials.push_back(sample);							// Update the dataset
+		if (m_memoryCap != 0 && trials.size() > m_memoryCap) { trials.erase(trials.begin(), trials.begin() + (trials.size() - m_memoryCap)); }
+		if (++m_nbSinceAnchor >= m_anchorPeriod)
+		{
+			if (m_memoryCap == 0) { return train(); }		// All trials are kept, so exact retrain
+			m_ref.set(m_drift);								// Drift is the reference of all trials
+			return trainWithReference();
+		}
+	}
+
+	// FgDA Weight computed every filter period, otherwise only the mean of the class is filtered again with the current Weight
+	if (++m_nbSinceFilter >= m_filterPeriod) { return updateWithStatistics(); }
+	if (!updateClassMean(id)) { return false; }
+	updateFactors();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+									  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	bool hasDatasets = m_datasets->size() == m_nbClass;
+	for (const auto& trials : m_datasets.get()) { hasDatasets = hasDatasets && !trials.empty(); }
+	if (adaptation == EAdaptations::None || (m_statistics->size() != m_nbClass && !hasDatasets))
+	{
+		return CMatrixClassifierFgMDMRT::classify(sample, workspace, classId, distance, probability, adaptation, realClassId);
+	}
+	return classify(sample, classId, distance, probability, adaptation, realClassId);	// The filter evolves
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels)
+{
+	if (samples.size() != labels.size()) { return false; }
+	size_t classId;
+	std::vector<double> distance, probability;
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		if (!classify(samples[i], classId, distance, probability, EAdaptations::Supervised, labels[i])) { return false; }
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::train()
+{
+	if (m_datasets->empty()) { return false; }
+	const std::vector<Eigen::MatrixXd> trials = Vector2DTo1D(m_datasets.get());
+	if (!Mean(trials, m_ref.replace(), EMetric::Riemann)) { return false; }	// Compute Reference matrix
+	m_drift   = m_ref.get();
+	m_nbDrift = trials.size();
+	return trainWithReference();
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::trainWithReference()
+{
+	std::vector<std::vector<Eigen::RowVectorXd>> tsSample;
+	if (!CMatrixClassifierFgMDMRT::trainWithReference(m_datasets.get(), tsSample)) { return false; }
+
+	// Compute statistics
+	std::vector<CClassStatistics>& statistics = m_statistics.replace();
+	statistics.resize(tsSample.size());
+	for (size_t k = 0; k < tsSample.size(); ++k)
+	{
+		statistics[k].reset(m_weightU->rows());
+		if (!statistics[k].add(tsSample[k])) { return false; }
+	}
+	m_nbSinceAnchor = 0;
+	m_nbSinceFilter = 0;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::updateWithStatistics()
+{
+	if (!FgDACompute(m_statistics.get(), m_weightU.replace(), m_weightV.replace())) { return false; }		// Compute FgDA Weight
+	m_nbSinceFilter = 0;
+
+	// Class means
+	for (size_t k = 0; k < m_nbClass; ++k) { if (!updateClassMean(k)) { return false; } }
+	updateFactors();
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::updateClassMean(const size_t k)
+{
+	Eigen::RowVectorXd filtered;
+	if (!FgDAApply(m_statistics.get()[k].getMean(), filtered, m_weightU.get(), m_weightV.get())) { return false; }	// Apply Filter
+	return UnTangentSpace(filtered, m_means[k], m_ref.get());												// Return to Matrix Space
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const
+{
+	if (!CMatrixClassifierFgMDMRT::saveAdditional(doc, data)) { return false; }	// Save Reference and Weight
+	if (m_statistics->empty()) { return true; }
+
+	// Save the drift of the reference
+	tinyxml2::XMLElement* drift = doc.NewElement("Drift");			// Create Drift node
+	drift->SetAttribute("count", int(m_nbDrift));						// Set number of trials of the drift
+	if (!saveMatrix(drift, m_drift)) { return false; }					// Save Drift
+	data->InsertEndChild(drift);										// Add drift node to data node
+
+	// Save the statistics of each class
+	for (const auto& s : m_statistics.get())
+	{
+		tinyxml2::XMLElement* element = doc.NewElement("Statistics");	// Create statistics node
+		element->SetAttribute("count", int(s.getCount()));				// Set number of vectors
+		const auto saveMoment = [&](const char* name, const Eigen::MatrixXd& matrix)
+		{
+			tinyxml2::XMLElement* moment = doc.NewElement(name);		// Create moment node
+			element->InsertEndChild(moment);							// Add moment node to statistics node
+			return saveMatrix(moment, matrix);							// Save moment
+		};
+		if (!saveMoment("Sum", s.getSum()) || !saveMoment("Scatter", s.getScatter())
+			|| !saveMoment("Moment-3", s.getMoment3()) || !saveMoment("Moment-4", s.getMoment4())) { return false; }
+		data->InsertEndChild(element);									// Add statistics node to data node
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDM::loadAdditional(tinyxml2::XMLElement* data)
+{
+	if (!CMatrixClassifierFgMDMRT::loadAdditional(data)) { return false; }	// Load Reference and Weight
+	m_statistics = CCopyOnWrite<std::vector<CClassStatistics>>();
+	m_drift      = m_ref.get();
+	m_nbDrift    = 0;
+
+	// Load the drift of the reference
+	tinyxml2::XMLElement* drift = data->FirstChildElement("Drift");		// Get Drift Node
+	if (drift != nullptr)
+	{
+		m_nbDrift = size_t(drift->IntAttribute("count"));				// Get number of trials of the drift
+		if (!loadMatrix(drift, m_drift)) { return false; }				// Load Drift
+	}
+
+	// Load the statistics of each class
+	std::vector<CClassStatistics> statistics;
+	tinyxml2::XMLElement* element = data->FirstChildElement("Statistics");	// Get First Statistics Node
+	while (element != nullptr)
+	{
+		Eigen::MatrixXd sum, scatter, moment3, moment4;
+		tinyxml2::XMLElement* nodes[4] = { element->FirstChildElement("Sum"), element->FirstChildElement("Scatter"),
+										   element->FirstChildElement("Moment-3"), element->FirstChildElement("Moment-4") };
+		for (const auto* n : nodes) { if (n == nullptr) { return false; } }
+		if (!loadMatrix(nodes[0], sum) || !loadMatrix(nodes[1], scatter) || !loadMatrix(nodes[2], moment3) || !loadMatrix(nodes[3], moment4)) { return false; }
+		if (sum.rows() != 1) { return false; }
+		statistics.emplace_back();
+		if (!statistics.back().set(size_t(element->IntAttribute("count")), sum, scatter, moment3, moment4)) { return false; }
+		element = element->NextSiblingElement("Statistics");				// Next Statistics
+	}
+	if (!statistics.empty() && statistics.size() != m_nbClass) { return false; }
+	if (!statistics.empty()) { m_statistics.set(std::move(statistics)); }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierFgMDM::copy(const CMatrixClassifierFgMDM& obj)
+{
+	CMatrixClassifierFgMDMRT::copy(obj);
+	m_datasets      = obj.m_datasets;
+	m_statistics    = obj.m_statistics;
+	m_drift         = obj.m_drift;
+	m_nbDrift       = obj.m_nbDrift;
+	m_anchorPeriod  = obj.m_anchorPeriod;
+	m_memoryCap     = obj.m_memoryCap;
+	m_nbSinceAnchor = obj.m_nbSinceAnchor;
+	m_filterPeriod  = obj.m_filterPeriod;
+	m_nbSinceFilter = obj.m_nbSinceFilter;
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -1,30 +1,64 @@
 #include "geometry/classifier/CMatrixClassifierFgMDMRT.hpp"
+#include "geometry/classifier/CClassifierSession.hpp"
 #include "geometry/Mean.hpp"
 #include "geometry/Basics.hpp"
 #include "geometry/Featurization.hpp"
-#include "geometry/Classification.hpp"
 #include <iostream>
+#include <algorithm>
 
 namespace Geometry {
 
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Check if two low-rank products \f$ U_1 V_1^{\mathsf{T}} \f$ and \f$ U_2 V_2^{\mathsf{T}} \f$ are equals without forming them (same criterion as <see cref="AreEquals" />). </summary>
+static bool AreEqualsLowRank(const Eigen::MatrixXd& u1, const Eigen::MatrixXd& v1, const Eigen::MatrixXd& u2, const Eigen::MatrixXd& v2, const double precision)
+{
+	if (u1.size() == 0 || u2.size() == 0) { return u1.size() == u2.size(); }
+	if (u1.rows() != u2.rows() || v1.rows() != v2.rows()) { return false; }
+	// Frobenius norms with traces of small K x K products
+	const double n11  = ((v1.transpose() * v1) * (u1.transpose() * u1)).trace(),
+				 n22  = ((v2.transpose() * v2) * (u2.transpose() * u2)).trace(),
+				 n12  = ((v2.transpose() * v1) * (u1.transpose() * u2)).trace(),
+				 diff = std::max(0.0, n11 + n22 - 2 * n12);
+	return diff <= precision * precision * std::min(n11, n22);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierFgMDMRT::setRef(const Eigen::MatrixXd& ref)
+{
+	m_ref.set(ref);
+	updateReference();
+}
+///-------------------------------------------------------------------------------------------------
+
 ///-------------------------------------------------------------------------------------------------
 bool CMatrixClassifierFgMDMRT::train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
 {
 	if (datasets.empty()) { return false; }
-	if (!Mean(Vector2DTo1D(datasets), m_ref, EMetric::Riemann)) { return false; }	// Compute Reference matrix
+	if (!Mean(Vector2DTo1D(datasets), m_ref.replace(), EMetric::Riemann)) { return false; }	// Compute Reference matrix
+	std::vector<std::vector<Eigen::RowVectorXd>> tsSample;
+	return trainWithReference(datasets, tsSample);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::trainWithReference(const std::vector<std::vector<Eigen::MatrixXd>>& datasets, std::vector<std::vector<Eigen::RowVectorXd>>& tsSample)
+{
+	if (datasets.empty()) { return false; }
+	updateReference();
 
 	// Transform to the Tangent Space
 	const size_t nbClass = datasets.size();
-	std::vector<std::vector<Eigen::RowVectorXd>> tsSample(nbClass);
+	tsSample.resize(nbClass);
 	for (size_t k = 0; k < nbClass; ++k)
 	{
 		const size_t nbTrials = datasets[k].size();
 		tsSample[k].resize(nbTrials);
-		for (size_t i = 0; i < nbTrials; ++i) { if (!TangentSpace(datasets[k][i], tsSample[k][i], m_ref)) { return false; } }
+		for (size_t i = 0; i < nbTrials; ++i) { if (!TangentSpace(datasets[k][i], tsSample[k][i], m_ref.get())) { return false; } }
 	}
 
 	// Compute FgDA Weight
-	if (!FgDACompute(tsSample, m_weight)) { return false; }
+	if (!FgDACompute(tsSample, m_weightU.replace(), m_weightV.replace())) { return false; }
 
 	// Convert Datasets
 	std::vector<std::vector<Eigen::MatrixXd>> newDatasets(nbClass);
@@ -36,8 +70,8 @@ bool CMatrixClassifierFgMDMRT::train(const std::vector<std::vector<Eigen::Matrix
 		filtered[k].resize(nbTrials);
 		for (size_t i = 0; i < nbTrials; ++i)
 		{
-			if (!FgDAApply(tsSample[k][i], filtered[k][i], m_weight)) { return false; }			// Apply Filter
-			if (!UnTangentSpace(filtered[k][i], newDatasets[k][i], m_ref)) { return false; }	// Return to Matrix Space
+			if (!FgDAApply(tsSample[k][i], filtered[k][i], m_weightU.get(), m_weightV.get())) { return false; }			// Apply Filter
+			if (!UnTangentSpace(filtered[k][i], newDatasets[k][i], m_ref.get())) { return false; }	// Return to Matrix Space
 		}
 	}
 
@@ -49,22 +83,131 @@ bool CMatrixClassifierFgMDMRT::train(const std::vector<std::vector<Eigen::Matrix
 bool CMatrixClassifierFgMDMRT::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
 										std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
 {
-	Eigen::RowVectorXd tsSample, filtered;
 	Eigen::MatrixXd newSample;
-
-	if (!TangentSpace(sample, tsSample, m_ref)) { return false; }		// Transform to the Tangent Space
-	if (!FgDAApply(tsSample, filtered, m_weight)) { return false; }		// Apply Filter
-	if (!UnTangentSpace(filtered, newSample, m_ref)) { return false; }	// Return to Matrix Space
+	if (!filter(sample, newSample)) { return false; }
 	return CMatrixClassifierMDM::classify(newSample, classId, distance, probability, adaptation, realClassId);
 }
 ///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+										std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!filter(sample, workspace.sample, workspace)) { return false; }
+	return CMatrixClassifierMDM::classify(workspace.sample, workspace, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::initWorkspace(CClassifierWorkspace& workspace, const size_t nbChannels) const
+{
+	if (!CMatrixClassifierMDM::initWorkspace(workspace, nbChannels)) { return false; }
+	workspace.sample.resize(nbChannels, nbChannels);
+	workspace.reduced.resize(m_weightU->cols());
+	workspace.filtered.resize(m_weightV->rows());
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	Eigen::MatrixXd newSample;
+	if (!filter(sample, newSample)) { return false; }
+	return CMatrixClassifierMDM::predict(newSample, classId, distance, probability);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance,
+										std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId) const
+{
+	CClassifierWorkspace& workspace = session.getWorkspace();
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!filter(sample, workspace.sample, workspace)) { return false; }
+	return CMatrixClassifierMDM::classify(workspace.sample, session, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::filter(const Eigen::MatrixXd& sample, Eigen::MatrixXd& filtered) const
+{
+	Eigen::RowVectorXd tsSample, tsFiltered;
+	if (!TangentSpace(sample, tsSample, m_ref.get())) { return false; }				// Transform to the Tangent Space
+	if (!FgDAApply(tsSample, tsFiltered, m_weightU.get(), m_weightV.get())) { return false; }	// Apply Filter
+	return UnTangentSpace(tsFiltered, filtered, m_ref.get());							// Return to Matrix Space
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::filter(const Eigen::MatrixXd& sample, Eigen::MatrixXd& filtered, CClassifierWorkspace& workspace) const
+{
+	// Without the square roots of the reference (reference set directly in the member), use the filter with allocations
+	if (m_refIS->rows() != sample.rows() || m_refIS->cols() != sample.cols()) { return filter(sample, filtered); }
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!TangentSpaceFactorized(sample, workspace.tangent, m_refIS.get(), workspace.symmetric)) { return false; }	// Transform to the Tangent Space
+
+	// Apply Filter (same checks as FgDAApply)
+	if (m_weightU->size() == 0 || m_weightV->size() == 0 || m_weightU->cols() != m_weightV->cols()
+		|| workspace.tangent.cols() != m_weightU->rows() || m_weightV->rows() != m_weightU->rows()) { return false; }
+	workspace.reduced.noalias()  = workspace.tangent * m_weightU.get();
+	workspace.filtered.noalias() = workspace.reduced * m_weightV->transpose();
+
+	return UnTangentSpaceFactorized(workspace.filtered, filtered, m_refS.get(), workspace.symmetric);				// Return to Matrix Space
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierFgMDMRT::updateReference()
+{
+	if (m_ref->size() == 0 || !IsSquare(m_ref.get()))
+	{
+		m_refS.set(Eigen::MatrixXd());
+		m_refIS.set(Eigen::MatrixXd());
+		return;
+	}
+	const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(m_ref.get());
+	const Eigen::VectorXd values = solver.eigenvalues();
+	if (solver.info() != Eigen::Success || values.minCoeff() <= 0)
+	{
+		m_refS.set(Eigen::MatrixXd());
+		m_refIS.set(Eigen::MatrixXd());
+		return;
+	}
+	m_refS.set(solver.eigenvectors() * values.cwiseSqrt().asDiagonal() * solver.eigenvectors().transpose());
+	m_refIS.set(solver.eigenvectors() * values.cwiseSqrt().cwiseInverse().asDiagonal() * solver.eigenvectors().transpose());
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, const size_t nbThreads)
+{
+	prepared.resize(samples.size());
+	std::vector<char> valid(samples.size(), 0);
+	ParallelFor(samples.size(), [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t i = begin; i < end; ++i) { valid[i] = filter(samples[i], prepared[i]) ? 1 : 0; }
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRT::adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels)
+{
+	std::vector<Eigen::MatrixXd> filtered(samples.size());
+	for (size_t i = 0; i < samples.size(); ++i) { if (!filter(samples[i], filtered[i])) { return false; } }
+	return CMatrixClassifierMDM::adapt(filtered, labels);
+}
+///-------------------------------------------------------------------------------------------------
+
 ///-------------------------------------------------------------------------------------------------
 bool CMatrixClassifierFgMDMRT::isEqual(const CMatrixClassifierFgMDMRT& obj, const double precision) const
 {
 	if (!CMatrixClassifierMDM::isEqual(obj, precision)) { return false; }	// Compare base members
-	if (!AreEquals(m_ref, obj.m_ref, precision)) { return false; }			// Compare Reference
-	if (!AreEquals(m_weight, obj.m_weight, precision)) { return false; }	// Compare Weight
+	if (!AreEquals(m_ref.get(), obj.m_ref.get(), precision)) { return false; }			// Compare Reference
+	if (!AreEqualsLowRank(m_weightU.get(), m_weightV.get(), obj.m_weightU.get(), obj.m_weightV.get(), precision)) { return false; }	// Compare Weight
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -73,8 +216,11 @@ bool CMatrixClassifierFgMDMRT::isEqual(const CMatrixClassifierFgMDMRT& obj, cons
 void CMatrixClassifierFgMDMRT::copy(const CMatrixClassifierFgMDMRT& obj)
 {
 	CMatrixClassifierMDM::copy(obj);
-	m_ref    = obj.m_ref;
-	m_weight = obj.m_weight;
+	m_ref     = obj.m_ref;
+	m_refS    = obj.m_refS;
+	m_refIS   = obj.m_refIS;
+	m_weightU = obj.m_weightU;
+	m_weightV = obj.m_weightV;
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -83,13 +229,16 @@ bool CMatrixClassifierFgMDMRT::saveAdditional(tinyxml2::XMLDocument& doc, tinyxm
 {
 	// Save Reference
 	tinyxml2::XMLElement* reference = doc.NewElement("Reference");	// Create Reference node
-	if (!saveMatrix(reference, m_ref)) { return false; }		// Save class
+	if (!saveMatrix(reference, m_ref.get())) { return false; }		// Save class
 	data->InsertEndChild(reference);							// Add class node to data node
 
-	// Save Weight
-	tinyxml2::XMLElement* weight = doc.NewElement("Weight");				// Create LDA Weight node
-	if (!saveMatrix(weight, m_weight)) { return false; }		// Save class
-	data->InsertEndChild(weight);								// Add class node to data node
+	// Save Weight factors
+	tinyxml2::XMLElement* weightU = doc.NewElement("Weight-U");	// Create LDA Weight left factor node
+	if (!saveMatrix(weightU, m_weightU.get())) { return false; }		// Save factor
+	data->InsertEndChild(weightU);								// Add factor node to data node
+	tinyxml2::XMLElement* weightV = doc.NewElement("Weight-V");	// Create LDA Weight right factor node
+	if (!saveMatrix(weightV, m_weightV.get())) { return false; }		// Save factor
+	data->InsertEndChild(weightV);								// Add factor node to data node
 
 	return true;
 }
@@ -100,11 +249,26 @@ bool CMatrixClassifierFgMDMRT::loadAdditional(tinyxml2::XMLElement* data)
 {
 	// Load Reference
 	tinyxml2::XMLElement* ref = data->FirstChildElement("Reference");		// Get Reference Node
-	if (!loadMatrix(ref, m_ref)) { return false; }				// Load Reference Matrix
+	if (!loadMatrix(ref, m_ref.replace())) { return false; }				// Load Reference Matrix
+	updateReference();
+
+	// Load Weight factors
+	tinyxml2::XMLElement* weightU = data->FirstChildElement("Weight-U");	// Get LDA Weight left factor Node
+	tinyxml2::XMLElement* weightV = data->FirstChildElement("Weight-V");	// Get LDA Weight right factor Node
+	if (weightU != nullptr && weightV != nullptr) { return loadMatrix(weightU, m_weightU.replace()) && loadMatrix(weightV, m_weightV.replace()); }
 
-	// Load Weight
+	// Load dense Weight (older format)
 	tinyxml2::XMLElement* weight = data->FirstChildElement("Weight");		// Get LDA Weight Node
-	return loadMatrix(weight, m_weight);						// Load LDA Weight Matrix
+	if (weight == nullptr) { return false; }
+	Eigen::MatrixXd dense;
+	if (!loadMatrix(weight, dense)) { return false; }			// Load LDA Weight Matrix
+	if (dense.size() == 0)
+	{
+		m_weightU.set(Eigen::MatrixXd());
+		m_weightV.set(Eigen::MatrixXd());
+		return true;
+	}
+	return FgDAFactorize(dense, m_weightU.replace(), m_weightV.replace());			// Factorize LDA Weight Matrix
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -112,8 +276,9 @@ bool CMatrixClassifierFgMDMRT::loadAdditional(tinyxml2::XMLElement* data)
 std::stringstream CMatrixClassifierFgMDMRT::printAdditional() const
 {
 	std::stringstream ss;
-	ss << "Reference matrix : " << std::endl << m_ref.format(MATRIX_FORMAT) << std::endl;		// Reference 
-	ss << "Weight matrix : " << std::endl << m_weight.format(MATRIX_FORMAT) << std::endl;		// Print Weight
+	ss << "Reference matrix : " << std::endl << m_ref->format(MATRIX_FORMAT) << std::endl;		// Reference 
+	ss << "Weight left factor : " << std::endl << m_weightU->format(MATRIX_FORMAT) << std::endl;	// Print Weight left factor
+	ss << "Weight right factor : " << std::endl << m_weightV->format(MATRIX_FORMAT) << std::endl;	// Print Weight right factor
 	return ss;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 #include "geometry/classifier/CMatrixClassifierFgMDMRTRebias.hpp"
+#include "geometry/classifier/CClassifierSession.hpp"
 
 #include "geometry/Mean.hpp"
 #include "geometry/Covariance.hpp"
@@ -16,8 +17,8 @@ bool CMatrixClassifierFgMDMRTRebias::train(const std::vector<std::vector<Eigen::
 	std::vector<std::vector<Eigen::MatrixXd>> newDatasets;
 	m_bias.applyBias(datasets, newDatasets);
 	if (!CMatrixClassifierFgMDMRT::train(newDatasets)) { return false; }	// Train FgMDM
-	const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(m_ref.rows(), m_ref.cols());	// Identity matrix
-	if (AreEquals(m_ref, identity)) { m_ref = identity; }	// Normally it's always the case with Identity matrix we simplify future operation
+	const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(m_ref->rows(), m_ref->cols());	// Identity matrix
+	if (AreEquals(m_ref.get(), identity)) { setRef(identity); }	// Normally it's always the case with Identity matrix we simplify future operation
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -26,14 +27,80 @@ bool CMatrixClassifierFgMDMRTRebias::train(const std::vector<std::vector<Eigen::
 bool CMatrixClassifierFgMDMRTRebias::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
 											  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
 {
-	if (!IsSquare(sample)) { return false; }				// Verification if it's a square matrix
 	Eigen::MatrixXd newSample;
-	m_bias.applyBias(sample, newSample);
-	m_bias.updateBias(sample, m_metric);
+	SSymmetricBuffers buffers;
+	if (!Unbias(sample, m_bias, m_metric, newSample, buffers)) { return false; }
 	return CMatrixClassifierFgMDMRT::classify(newSample, classId, distance, probability, adaptation, realClassId);
 }
 ///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+											  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!Unbias(sample, m_bias, m_metric, workspace.unbiased, workspace.symmetric)) { return false; }
+	return CMatrixClassifierFgMDMRT::classify(workspace.unbiased, workspace, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	if (!IsSquare(sample) || sample.rows() != m_bias.getBias().rows()) { return false; }	// The bias must have the size of the sample
+	Eigen::MatrixXd newSample;
+	m_bias.applyBias(sample, newSample);
+	return CMatrixClassifierFgMDMRT::predict(newSample, classId, distance, probability);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::initSession(CClassifierSession& session) const
+{
+	if (!CMatrixClassifierFgMDMRT::initSession(session)) { return false; }
+	session.getBias() = m_bias;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance,
+											std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId) const
+{
+	CClassifierWorkspace& workspace = session.getWorkspace();
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!Unbias(sample, session.getBias(), m_metric, workspace.unbiased, workspace.symmetric)) { return false; }
+	return CMatrixClassifierFgMDMRT::classify(workspace.unbiased, session, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, const size_t nbThreads)
+{
+	std::vector<Eigen::MatrixXd> unbiased(samples.size());
+	SSymmetricBuffers buffers;
+	for (size_t i = 0; i < samples.size(); ++i) { if (!Unbias(samples[i], m_bias, m_metric, unbiased[i], buffers)) { return false; } }
+	return CMatrixClassifierFgMDMRT::prepareSamples(unbiased, prepared, nbThreads);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierFgMDMRTRebias::adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels)
+{
+	// Verification of the whole block before the update of the bias (a rejected block doesn't modify the classifier)
+	if (samples.size() != labels.size()) { return false; }
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		if (labels[i] >= m_nbClass || !IsSquare(samples[i]) || samples[i].rows() != m_bias.getBias().rows()) { return false; }	// Check id and sample
+	}
+
+	std::vector<Eigen::MatrixXd> newSamples(samples.size());
+	SSymmetricBuffers buffers;
+	for (size_t i = 0; i < samples.size(); ++i) { Unbias(samples[i], m_bias, m_metric, newSamples[i], buffers); }	// The block is already checked
+	return CMatrixClassifierFgMDMRT::adapt(newSamples, labels);
+}
+///-------------------------------------------------------------------------------------------------
+
 //***********************
 //***** XML Manager *****
 //***********************
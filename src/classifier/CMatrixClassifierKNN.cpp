@@ -0,0 +1,437 @@
+#include "geometry/classifier/CMatrixClassifierKNN.hpp"
+#include "geometry/Distance.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace Geometry {
+
+//***************************
+//***** Getter / Setter *****
+//***************************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::setTrials(const std::vector<Eigen::MatrixXd>& trials, const std::vector<size_t>& labels)
+{
+	SIndex index;
+	SSymmetricBuffers buffers;
+	if (!computeFactors(index, trials, labels, buffers)) { return false; }
+	buildTree(index, buffers);
+	m_index.set(std::move(index));
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::insert(const Eigen::MatrixXd& trial, const size_t label)
+{
+	if (!isMetricSupported(m_metric) || label >= m_nbClass || !IsSquare(trial)) { return false; }
+	if (!m_index->trials.empty() && !HaveSameSize(trial, m_index->trials[0])) { return false; }
+	Eigen::MatrixXd factor, sample;
+	if (!DistanceReferenceFactor(trial, factor, m_metric, m_buffers) || !DistanceSampleFactor(trial, sample, m_metric, m_buffers)) { return false; }
+
+	SIndex& index = m_index.write();
+	const size_t id = index.trials.size();
+	SNode leaf;
+	leaf.pivot = id;
+
+	// Descent to a free subtree, the ranges of the subtrees are updated on the path
+	size_t node = index.nodes.empty() ? NO_NODE : 0;
+	while (node != NO_NODE)
+	{
+		const double d = distance(index, trial, sample, node, m_buffers);
+		SNode& n       = index.nodes[node];
+		if (n.inside == NO_NODE && n.outside == NO_NODE) { n.threshold = d; }	// First trial under a leaf
+		size_t& child = d < n.threshold ? n.inside : n.outside;
+		double& min   = d < n.threshold ? n.insideMin : n.outsideMin;
+		double& max   = d < n.threshold ? n.insideMax : n.outsideMax;
+		min           = std::min(min, d);
+		max           = std::max(max, d);
+		if (child == NO_NODE)
+		{
+			child = index.nodes.size();
+			break;
+		}
+		node = child;
+	}
+
+	index.nodes.push_back(leaf);
+	index.trials.push_back(trial);
+	index.labels.push_back(label);
+	index.factors.push_back(std::move(factor));
+	index.samples.push_back(std::move(sample));
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::findNeighbors(const Eigen::MatrixXd& sample, const size_t nbNeighbors, std::vector<size_t>& indexes, std::vector<double>& distances) const
+{
+	Eigen::MatrixXd factor;
+	SSymmetricBuffers buffers;
+	return findNeighbors(sample, nbNeighbors, indexes, distances, factor, buffers);
+}
+///-------------------------------------------------------------------------------------------------
+
+//**********************
+//***** Classifier *****
+//**********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
+{
+	if (datasets.empty()) { return false; }
+	setClassCount(datasets.size());
+	std::vector<Eigen::MatrixXd> trials;
+	std::vector<size_t> labels;
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		trials.insert(trials.end(), datasets[k].begin(), datasets[k].end());
+		labels.insert(labels.end(), datasets[k].size(), k);
+	}
+	return setTrials(trials, labels);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+									const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!findNeighbors(sample, m_nbNeighbors, m_neighbors, m_distances, m_factor, m_buffers)) { return false; }
+	if (!vote(m_neighbors, m_distances, classId, distance, probability)) { return false; }
+
+	if (adaptation == EAdaptations::None) { return true; }
+	if (adaptation == EAdaptations::Supervised && realClassId >= m_nbClass) { return false; }	// Expected class needed
+	return insert(sample, adaptation == EAdaptations::Supervised ? realClassId : classId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	std::vector<size_t> indexes;
+	std::vector<double> distances;
+	if (!findNeighbors(sample, m_nbNeighbors, indexes, distances)) { return false; }
+	return vote(indexes, distances, classId, distance, probability);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::computeFactors(SIndex& index, const std::vector<Eigen::MatrixXd>& trials, const std::vector<size_t>& labels,
+										  SSymmetricBuffers& buffers) const
+{
+	if (!isMetricSupported(m_metric)) { return false; }											// The search needs the triangle inequality
+	if (trials.size() != labels.size() || !AreSquare(trials) || !HaveSameSize(trials)) { return false; }	// Verification of the trials
+	for (const auto& l : labels) { if (l >= m_nbClass) { return false; } }
+
+	index.trials = trials;
+	index.labels = labels;
+	index.factors.resize(trials.size());
+	index.samples.resize(trials.size());
+	index.nodes.clear();
+	for (size_t i = 0; i < trials.size(); ++i)
+	{
+		if (!DistanceReferenceFactor(trials[i], index.factors[i], m_metric, buffers)) { return false; }
+		if (!DistanceSampleFactor(trials[i], index.samples[i], m_metric, buffers)) { return false; }
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierKNN::buildTree(SIndex& index, SSymmetricBuffers& buffers) const
+{
+	std::vector<size_t> indexes(index.trials.size());
+	for (size_t i = 0; i < indexes.size(); ++i) { indexes[i] = i; }
+	std::vector<double> distances(index.trials.size());
+	index.nodes.clear();
+	index.nodes.reserve(index.trials.size());
+	build(index, indexes, 0, indexes.size(), distances, buffers);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::isTree(const std::vector<SNode>& nodes, const size_t nbTrials)
+{
+	if (nodes.size() != nbTrials || nodes.empty()) { return false; }
+
+	// Depth first traversal from the root, a node or a pivot seen twice is a cycle or a shared subtree
+	const size_t n = nodes.size();
+	std::vector<char> reached(n, 0), pivots(n, 0);
+	std::vector<size_t> stack(1, 0);
+	size_t count = 0;
+	while (!stack.empty())
+	{
+		const size_t node = stack.back();
+		stack.pop_back();
+		if (node >= n || reached[node] != 0) { return false; }
+		const SNode& current = nodes[node];
+		if (current.pivot >= n || pivots[current.pivot] != 0) { return false; }
+		reached[node]         = 1;
+		pivots[current.pivot] = 1;
+		count++;
+		if (current.inside != NO_NODE) { stack.push_back(current.inside); }
+		if (current.outside != NO_NODE) { stack.push_back(current.outside); }
+	}
+	return count == n;		// All the nodes are reached
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+size_t CMatrixClassifierKNN::build(SIndex& index, std::vector<size_t>& indexes, const size_t begin, const size_t end, std::vector<double>& distances,
+								   SSymmetricBuffers& buffers) const
+{
+	if (begin == end) { return NO_NODE; }
+	const size_t node = index.nodes.size();
+	SNode n;
+	n.pivot = indexes[begin];
+	index.nodes.push_back(n);
+	if (end - begin == 1) { return node; }
+
+	// Split the other trials at the median distance to the pivot
+	for (size_t i = begin + 1; i < end; ++i) { distances[indexes[i]] = distance(index, index.trials[indexes[i]], index.samples[indexes[i]], node, buffers); }
+	const size_t mid = begin + 1 + (end - begin - 1) / 2;
+	std::nth_element(indexes.begin() + long(begin + 1), indexes.begin() + long(mid), indexes.begin() + long(end),
+					 [&](const size_t a, const size_t b) { return distances[a] < distances[b]; });
+	n.threshold = distances[indexes[mid]];
+	for (size_t i = begin + 1; i < mid; ++i)
+	{
+		n.insideMin = std::min(n.insideMin, distances[indexes[i]]);
+		n.insideMax = std::max(n.insideMax, distances[indexes[i]]);
+	}
+	for (size_t i = mid; i < end; ++i)
+	{
+		n.outsideMin = std::min(n.outsideMin, distances[indexes[i]]);
+		n.outsideMax = std::max(n.outsideMax, distances[indexes[i]]);
+	}
+
+	n.inside          = build(index, indexes, begin + 1, mid, distances, buffers);
+	n.outside         = build(index, indexes, mid, end, distances, buffers);
+	index.nodes[node] = n;
+	return node;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+double CMatrixClassifierKNN::distance(const SIndex& index, const Eigen::MatrixXd& matrix, const Eigen::MatrixXd& factor, const size_t node,
+									  SSymmetricBuffers& buffers) const
+{
+	const size_t pivot = index.nodes[node].pivot;
+	const double d     = DistanceFactorized(matrix, factor, index.trials[pivot], index.factors[pivot], m_metric, buffers);
+	return std::isnan(d) ? 0.0 : d;		// Square root of a negative rounding error for identical matrices (Wasserstein and Log-Det metrics)
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::findNeighbors(const Eigen::MatrixXd& sample, const size_t nbNeighbors, std::vector<size_t>& indexes, std::vector<double>& distances,
+										 Eigen::MatrixXd& factor, SSymmetricBuffers& buffers) const
+{
+	const SIndex& index = m_index.get();
+	if (index.nodes.empty() || nbNeighbors == 0) { return false; }									// Verification if classifier is trained
+	if (!IsSquare(sample) || !HaveSameSize(sample, index.trials[0])) { return false; }				// Verification if it's a square matrix of the good size
+	if (!DistanceSampleFactor(sample, factor, m_metric, buffers)) { return false; }
+
+	// Depth first search, the closest subtree first, with the k best neighbours in a max heap
+	std::priority_queue<std::pair<double, size_t>> best;
+	std::vector<std::pair<size_t, double>> stack;			// Node and lower bound of its distances to the sample
+	stack.emplace_back(0, 0.0);
+	while (!stack.empty())
+	{
+		const size_t node  = stack.back().first;
+		const double bound = stack.back().second;
+		stack.pop_back();
+		if (best.size() == nbNeighbors && bound >= best.top().first) { continue; }	// The subtree can't contain a closer trial
+
+		const SNode& n = index.nodes[node];
+		const double d = distance(index, sample, factor, node, buffers);
+		if (!std::isfinite(d)) { return false; }					// Not a SPD Matrix
+		if (best.size() < nbNeighbors) { best.emplace(d, n.pivot); }
+		else if (d < best.top().first)
+		{
+			best.pop();
+			best.emplace(d, n.pivot);
+		}
+
+		// Lower bounds of the subtrees with the triangle inequality
+		const double inside  = std::max(0.0, std::max(n.insideMin - d, d - n.insideMax)),
+					 outside = std::max(0.0, std::max(n.outsideMin - d, d - n.outsideMax));
+		const bool insideFirst = inside <= outside;
+		if (insideFirst && n.outside != NO_NODE) { stack.emplace_back(n.outside, outside); }	// The farthest is pushed first
+		if (n.inside != NO_NODE) { stack.emplace_back(n.inside, inside); }
+		if (!insideFirst && n.outside != NO_NODE) { stack.emplace_back(n.outside, outside); }
+	}
+
+	indexes.resize(best.size());
+	distances.resize(best.size());
+	for (size_t i = best.size(); i > 0; --i)
+	{
+		distances[i - 1] = best.top().first;
+		indexes[i - 1]   = best.top().second;
+		best.pop();
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::vote(const std::vector<size_t>& indexes, const std::vector<double>& distances, size_t& classId, std::vector<double>& distance,
+								std::vector<double>& probability) const
+{
+	if (indexes.empty()) { return false; }
+	distance.assign(m_nbClass, std::numeric_limits<double>::infinity());
+	probability.assign(m_nbClass, 0.0);
+
+	// Softmax of the opposite of the squared distances (relative to the nearest neighbour without underflow)
+	const double ref = distances[0] * distances[0];
+	double sum       = 0.0;
+	for (size_t i = 0; i < indexes.size(); ++i)
+	{
+		const size_t k = m_index->labels[indexes[i]];
+		const double w = exp(ref - distances[i] * distances[i]);
+		probability[k] += w;
+		sum += w;
+		distance[k] = std::min(distance[k], distances[i]);
+	}
+	for (auto& p : probability) { p /= sum; }
+	classId = size_t(std::max_element(probability.begin(), probability.end()) - probability.begin());
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//***********************
+//***** XML Manager *****
+//***********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::saveAdditional(tinyxml2::XMLDocument& /*doc*/, tinyxml2::XMLElement* data) const
+{
+	data->SetAttribute("neighbors", int(m_nbNeighbors));		// Set attribute number of neighbours
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::loadAdditional(tinyxml2::XMLElement* data)
+{
+	m_nbNeighbors = size_t(data->IntAttribute("neighbors", 5));	// Get the number of neighbours
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::saveClasses(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const
+{
+	const SIndex& index = m_index.get();
+	for (size_t i = 0; i < index.trials.size(); ++i)				// for each trial
+	{
+		tinyxml2::XMLElement* element = doc.NewElement("Trial");	// Create trial node
+		element->SetAttribute("class-id", int(index.labels[i]));	// Set attribute class id (0 to K)
+		if (!saveMatrix(element, index.trials[i])) { return false; }	// Save trial Matrix
+		data->InsertEndChild(element);								// Add trial node to data node
+	}
+
+	// Save the tree : one node by row (pivot, threshold, inside, outside and the ranges of the subtrees, -1 for a missing subtree)
+	Eigen::MatrixXd tree(index.nodes.size(), 8);
+	for (size_t i = 0; i < index.nodes.size(); ++i)
+	{
+		const SNode& n = index.nodes[i];
+		const bool in = n.inside != NO_NODE, out = n.outside != NO_NODE;	// The ranges of a missing subtree are empty (infinite minimum)
+		tree.row(Eigen::Index(i)) << double(n.pivot), n.threshold, in ? double(n.inside) : -1.0, out ? double(n.outside) : -1.0,
+				in ? n.insideMin : 0.0, n.insideMax, out ? n.outsideMin : 0.0, n.outsideMax;
+	}
+	tinyxml2::XMLElement* element = doc.NewElement("Tree");			// Create tree node
+	if (!saveMatrix(element, tree)) { return false; }				// Save tree Matrix
+	data->InsertEndChild(element);									// Add tree node to data node
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::loadClasses(tinyxml2::XMLElement* data)
+{
+	std::vector<Eigen::MatrixXd> trials;
+	std::vector<size_t> labels;
+	for (tinyxml2::XMLElement* element = data->FirstChildElement("Trial"); element != nullptr; element = element->NextSiblingElement("Trial"))
+	{
+		trials.emplace_back();
+		labels.push_back(size_t(element->IntAttribute("class-id")));	// Get the class of the trial
+		if (!loadMatrix(element, trials.back())) { return false; }	// Load trial Matrix
+	}
+	if (trials.empty())												// Classifier not trained
+	{
+		m_index = CCopyOnWrite<SIndex>();
+		return true;
+	}
+	SIndex index;
+	SSymmetricBuffers buffers;
+	if (!computeFactors(index, trials, labels, buffers)) { return false; }
+
+	// Saved tree (the tree is built only if the saved tree is missing or isn't valid)
+	tinyxml2::XMLElement* element = data->FirstChildElement("Tree");
+	Eigen::MatrixXd tree;
+	if (element != nullptr && loadMatrix(element, tree) && size_t(tree.rows()) == trials.size() && tree.cols() == 8 && tree.allFinite())
+	{
+		// An index out of range is replaced by the number of trials (rejected by the check of the tree)
+		const double size  = double(trials.size());
+		const auto toIndex = [&](const double x) { return x < 0 ? NO_NODE : x < size ? size_t(x) : trials.size(); };
+		index.nodes.resize(trials.size());
+		for (size_t i = 0; i < index.nodes.size(); ++i)
+		{
+			SNode& n                     = index.nodes[i];
+			const Eigen::RowVectorXd row = tree.row(Eigen::Index(i));
+			n.pivot                      = row[0] < 0 ? trials.size() : toIndex(row[0]);
+			n.threshold                  = row[1];
+			n.inside                     = toIndex(row[2]);
+			n.outside                    = toIndex(row[3]);
+			if (n.inside != NO_NODE)
+			{
+				n.insideMin = row[4];
+				n.insideMax = row[5];
+			}
+			if (n.outside != NO_NODE)
+			{
+				n.outsideMin = row[6];
+				n.outsideMax = row[7];
+			}
+		}
+	}
+	if (!isTree(index.nodes, trials.size())) { buildTree(index, buffers); }
+	m_index.set(std::move(index));
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//*****************************
+//***** Override Operator *****
+//*****************************
+///-------------------------------------------------------------------------------------------------
+std::stringstream CMatrixClassifierKNN::printAdditional() const
+{
+	std::stringstream ss;
+	ss << "Number of neighbours : " << m_nbNeighbors << std::endl;
+	ss << "Number of trials : " << m_index->trials.size() << std::endl;
+	return ss;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierKNN::isEqual(const CMatrixClassifierKNN& obj, const double precision) const
+{
+	if (!IMatrixClassifier::isEqual(obj, precision)) { return false; }		// Compare base members
+	if (m_nbNeighbors != obj.m_nbNeighbors) { return false; }				// Compare number of neighbours
+	const SIndex &index = m_index.get(), &other = obj.m_index.get();
+	if (index.labels != other.labels) { return false; }						// Compare classes of trials
+	for (size_t i = 0; i < index.trials.size(); ++i)
+	{
+		if (!AreEquals(index.trials[i], other.trials[i], precision)) { return false; }	// Compare trials
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierKNN::copy(const CMatrixClassifierKNN& obj)
+{
+	IMatrixClassifier::copy(obj);
+	m_nbNeighbors = obj.m_nbNeighbors;
+	m_index       = obj.m_index;
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
@@ -1,12 +1,75 @@
 #include "geometry/classifier/CMatrixClassifierMDM.hpp"
+#include "geometry/classifier/CClassifierSession.hpp"
 #include "geometry/Mean.hpp"
 #include "geometry/Distance.hpp"
 #include "geometry/Basics.hpp"
 #include "geometry/Geodesic.hpp"
+#include "geometry/Classification.hpp"
+#include "geometry/Featurization.hpp"
 #include <unsupported/Eigen/MatrixFunctions> // SQRT of Matrix
+#include <chrono>
 
 namespace Geometry {
 
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Check if the classes can be pruned with the metric (expensive distance with a cheap lower bound, the Euclidian and Log-Euclidian distances cost as much as their bounds). </summary>
+static bool CanPrune(const EMetric metric) { return metric == EMetric::Riemann || metric == EMetric::Wasserstein; }
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Scalar invariant \f$ \tau \f$ of the matrix for the lower bound \f$ \delta(A, B) \geq w \left| \tau(A) - \tau(B) \right| \f$ (see <see cref="CMatrixClassifierMDM::setPruning"/>). </summary>
+/// <param name="matrix">	The matrix. </param>
+/// <param name="factor">	The factor of the mean (see <see cref="DistanceReferenceFactor"/>), empty for a sample. </param>
+/// <param name="metric">	The metric. </param>
+/// <param name="buffers">	The buffers (Cholesky factor of a sample). </param>
+/// <returns>	The invariant (NaN if it can't be computed). </returns>
+static double PruningInvariant(const Eigen::MatrixXd& matrix, const Eigen::MatrixXd& factor, const EMetric metric, SSymmetricBuffers& buffers)
+{
+	switch (metric)
+	{
+		case EMetric::Riemann:							// log(det(A)) / sqrt(N), the factor of a mean is its inverse Cholesky factor
+			if (factor.size() != 0) { return -2 * factor.diagonal().array().abs().log().sum() / sqrt(double(matrix.rows())); }
+			buffers.matrix = matrix;
+			if (Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(buffers.matrix) >= 0) { return std::numeric_limits<double>::quiet_NaN(); }
+			return 2 * buffers.matrix.diagonal().array().log().sum() / sqrt(double(matrix.rows()));
+		case EMetric::Wasserstein: return sqrt(std::max(matrix.trace(), 0.0));
+		default: return std::numeric_limits<double>::quiet_NaN();
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Compute the exact distance only for the classes which can be the closest class (see <see cref="CMatrixClassifierMDM::setPruning"/>). </summary>
+/// <param name="bounds">			The lower bound of the distance to each class (updated with the triangle inequality). </param>
+/// <param name="classDistances">	The distances between the means (empty if unknown). </param>
+/// <param name="distance">			The distance of the sample with each class (infinity for the pruned classes, never evaluated). </param>
+/// <param name="distanceTo">		The function to compute the exact distance to a class. </param>
+template <typename TDistance>
+static void PrunedDistances(Eigen::VectorXd& bounds, const Eigen::MatrixXd& classDistances, std::vector<double>& distance, TDistance distanceTo)
+{
+	const Eigen::Index nbClass = bounds.size();
+	const bool triangle        = classDistances.rows() == nbClass && classDistances.cols() == nbClass;
+	const double margin        = 1e-9;			// Relative margin for the rounding errors of the bounds
+	for (auto& d : distance) { d = -1; }		// Not computed
+	double best = std::numeric_limits<double>::infinity();
+	while (true)
+	{
+		// Next class with the lowest bound
+		Eigen::Index next = -1;
+		for (Eigen::Index k = 0; k < nbClass; ++k) { if (distance[k] < 0 && (next < 0 || bounds[k] < bounds[next])) { next = k; } }
+		if (next < 0) { return; }
+		if (bounds[next] > best * (1 + margin))	// No remaining class can be the closest class
+		{
+			for (Eigen::Index k = 0; k < nbClass; ++k) { if (distance[k] < 0) { distance[k] = std::numeric_limits<double>::infinity(); } }
+			return;
+		}
+		distance[next] = distanceTo(size_t(next));
+		best           = std::min(best, distance[next]);
+		if (triangle) { for (Eigen::Index k = 0; k < nbClass; ++k) { bounds[k] = std::max(bounds[k], std::abs(distance[next] - classDistances(next, k))); } }
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
 //***********************	
 //***** Constructor *****	
 //***********************
@@ -22,6 +85,7 @@ CMatrixClassifierMDM::CMatrixClassifierMDM(const size_t nbClass, const EMetric m
 CMatrixClassifierMDM::~CMatrixClassifierMDM()
 {
 	m_means.clear();
+	m_factors.clear();
 	m_nbTrials.clear();
 }
 ///-------------------------------------------------------------------------------------------------
@@ -37,6 +101,9 @@ void CMatrixClassifierMDM::setClassCount(const size_t nbClass)
 		IMatrixClassifier::setClassCount(nbClass);
 		m_means.resize(m_nbClass);
 		m_nbTrials.resize(nbClass);
+		m_factors.clear();
+		m_classDistances.resize(0, 0);
+		m_proxyMeans.resize(0, 0);
 	}
 }
 ///-------------------------------------------------------------------------------------------------
@@ -51,6 +118,7 @@ bool CMatrixClassifierMDM::train(const std::vector<std::vector<Eigen::MatrixXd>>
 		if (!Mean(datasets[k], m_means[k], m_metric)) { return false; }	// Compute the mean of each class
 		m_nbTrials[k] = datasets[k].size();
 	}
+	updateFactors();
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -58,40 +126,432 @@ bool CMatrixClassifierMDM::train(const std::vector<std::vector<Eigen::MatrixXd>>
 ///-------------------------------------------------------------------------------------------------
 bool CMatrixClassifierMDM::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
 									std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!predictWithMeans(sample, m_means, m_factors, m_classDistances, classId, distance, probability)) { return false; }
+	if (!adaptMeans(sample, classId, adaptation, realClassId, m_means, m_factors, m_nbTrials)) { return false; }
+	if ((m_pruning || m_fast) && adaptation != EAdaptations::None)
+	{
+		const size_t id = adaptation == EAdaptations::Supervised ? realClassId : classId;
+		SSymmetricBuffers buffers;
+		Eigen::RowVectorXd tangent;
+		updateClassDistances(id, buffers);
+		updateProxy(id, buffers, tangent);
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+									std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!classifyWithMeans(sample, m_means, m_factors, m_nbTrials, m_classDistances, workspace, classId, distance, probability, adaptation, realClassId)) { return false; }
+	updateAdapted(classId, adaptation, realClassId, workspace);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateAdapted(const size_t classId, const EAdaptations adaptation, const size_t realClassId, CClassifierWorkspace& workspace)
+{
+	if ((!m_pruning && !m_fast) || adaptation == EAdaptations::None) { return; }
+	const size_t id = adaptation == EAdaptations::Supervised ? realClassId : classId;
+	updateClassDistances(id, workspace.symmetric);
+	updateProxy(id, workspace.symmetric, workspace.tangent);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	return predictWithMeans(sample, m_means, m_factors, m_classDistances, classId, distance, probability);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::predictFast(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+									   const double budget) const
+{
+	if (m_proxyMeans.rows() != Eigen::Index(m_nbClass)) { return predict(sample, classId, distance, probability); }	// Without the fast prediction mode
+	const auto start = std::chrono::steady_clock::now();
+	const auto over  = [&]() { return budget > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > budget; };
+	m_nbFast++;
+
+	// Proxy distances in the tangent space
+	SSymmetricBuffers buffers;
+	Eigen::RowVectorXd tangent;
+	if (!TangentSpaceFactorized(sample, tangent, m_proxyRefIS, buffers)) { return false; }
+	distance.resize(m_nbClass);
+	for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = (m_proxyMeans.row(Eigen::Index(k)) - tangent).norm(); }
+	DistancesToProbabilities(distance, classId, probability);
+
+	// Refinement of the classes within the margin
+	const double limit = distance[classId] * (1 + m_fastMargin);
+	size_t nbCandidates = 0;
+	for (const auto& d : distance) { if (d <= limit) { nbCandidates++; } }
+	if (nbCandidates < 2) { return true; }					// The proxy decision is clear
+	m_nbRefined++;
+	std::vector<double> refined(m_nbClass, std::numeric_limits<double>::infinity());	// The other classes aren't candidates
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		if (distance[k] > limit) { continue; }
+		if (over())											// Keep the proxy decision
+		{
+			m_nbOverBudget++;
+			return true;
+		}
+		refined[k] = m_factors.size() == m_nbClass ? DistanceFactorized(sample, Eigen::MatrixXd(), m_means[k], m_factors[k], m_metric, buffers)
+												   : Distance(sample, m_means[k], m_metric);
+	}
+	// The exact decision and the probabilities are only between the candidates
+	distance.swap(refined);
+	DistancesToProbabilities(distance, classId, probability);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+CMatrixClassifierMDM::SFastCounters CMatrixClassifierMDM::getFastCounters() const
+{
+	SFastCounters counters;
+	counters.nbTrials     = m_nbFast.load();
+	counters.nbRefined    = m_nbRefined.load();
+	counters.nbOverBudget = m_nbOverBudget.load();
+	return counters;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::resetFastCounters()
+{
+	m_nbFast       = 0;
+	m_nbRefined    = 0;
+	m_nbOverBudget = 0;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::setFastPrediction(const bool fast, const double margin)
+{
+	m_fast       = fast;
+	m_fastMargin = margin;
+	updateProxy();
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::initSession(CClassifierSession& session) const
+{
+	session.getMeans()        = m_means;
+	session.getFactors()      = m_factors;
+	session.getTrialNumbers() = m_nbTrials;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance,
+									std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId) const
+{
+	if (session.getMeans().size() != m_nbClass || session.getTrialNumbers().size() != m_nbClass) { return false; }	// Check if session is initialized
+	return classifyWithMeans(sample, session.getMeans(), session.getFactors(), session.getTrialNumbers(), Eigen::MatrixXd(), session.getWorkspace(),
+							 classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::predictWithMeans(const Eigen::MatrixXd& sample, const std::vector<Eigen::MatrixXd>& means, const std::vector<Eigen::MatrixXd>& factors,
+											const Eigen::MatrixXd& classDistances, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
 {
 	if (!IsSquare(sample)) { return false; }				// Verification if it's a square matrix 
-	double distMin = std::numeric_limits<double>::max();	// Init of distance min
 
 	// Compute Distances
 	distance.resize(m_nbClass);
-	for (size_t k = 0; k < m_nbClass; ++k)
+	if (factors.size() == m_nbClass)						// With the factors of the means
 	{
-		distance[k] = Distance(sample, m_means[k], m_metric);
-		if (distMin > distance[k])
+		Eigen::MatrixXd sampleFactor;						// Computed once for all classes
+		if (!DistanceSampleFactor(sample, sampleFactor, m_metric)) { return false; }
+		const auto distanceTo = [&](const size_t k) { return DistanceFactorized(sample, sampleFactor, means[k], factors[k], m_metric); };
+		if (m_pruning && CanPrune(m_metric))				// Only the classes which can be the closest class
 		{
-			classId = k;
-			distMin = distance[k];
+			SSymmetricBuffers buffers;
+			Eigen::VectorXd bounds(m_nbClass);
+			const double invariant = PruningInvariant(sample, Eigen::MatrixXd(), m_metric, buffers);
+			for (size_t k = 0; k < m_nbClass; ++k)
+			{
+				const double bound = std::abs(invariant - PruningInvariant(means[k], factors[k], m_metric, buffers));
+				bounds[k]          = std::isfinite(bound) ? bound : 0;
+			}
+			PrunedDistances(bounds, classDistances, distance, distanceTo);
 		}
+		else { for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = distanceTo(k); } }
 	}
+	else { for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = Distance(sample, means[k], m_metric); } }
 
-	// Compute Probabilities (personnal method)
-	probability.resize(m_nbClass);
-	double sumProbability = 0.0;
-	for (size_t k = 0; k < m_nbClass; ++k)
+	// Compute Probabilities
+	DistancesToProbabilities(distance, classId, probability);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+template <EMetric M>
+bool CMatrixClassifierMDM::predictWithMeans(const Eigen::MatrixXd& sample, const std::vector<Eigen::MatrixXd>& means, const std::vector<Eigen::MatrixXd>& factors,
+											const Eigen::MatrixXd& classDistances, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+											std::vector<double>& probability) const
+{
+	if (!IsSquare(sample)) { return false; }				// Verification if it's a square matrix 
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+
+	// Compute Distances
+	distance.resize(m_nbClass);
+	if (factors.size() == m_nbClass)						// With the factors of the means
 	{
-		probability[k] = distMin / distance[k];
-		sumProbability += probability[k];
+		if (!DistanceSampleFactor<M>(sample, workspace.factor, workspace.symmetric)) { return false; }
+		const auto distanceTo = [&](const size_t k) { return DistanceFactorized<M>(sample, workspace.factor, means[k], factors[k], workspace.symmetric); };
+		if (m_pruning && CanPrune(M))						// Only the classes which can be the closest class
+		{
+			const double invariant = PruningInvariant(sample, workspace.factor, M, workspace.symmetric);
+			for (size_t k = 0; k < m_nbClass; ++k)
+			{
+				const double bound                = std::abs(invariant - PruningInvariant(means[k], factors[k], M, workspace.symmetric));
+				workspace.bounds[Eigen::Index(k)] = std::isfinite(bound) ? bound : 0;
+			}
+			PrunedDistances(workspace.bounds, classDistances, distance, distanceTo);
+		}
+		else { for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = distanceTo(k); } }
 	}
+	else { for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = Distance<M>(sample, means[k]); } }
+
+	// Compute Probabilities
+	DistancesToProbabilities(distance, classId, probability);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
 
-	for (auto& p : probability) { p /= sumProbability; }
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::adaptMeans(const Eigen::MatrixXd& sample, const size_t classId, const EAdaptations adaptation, const size_t realClassId,
+									  std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials) const
+{
+	if (adaptation == EAdaptations::None) { return true; }
+	// Get class id for adaptation and increase number of trials, expected if supervised, predicted if unsupervised
+	const size_t id = adaptation == EAdaptations::Supervised ? realClassId : classId;
+	if (id >= m_nbClass) { return false; }					// Check id (if supervised and bad input)
+	nbTrials[id]++;											// Update number of trials for the class id
+	if (!Geodesic(means[id], sample, means[id], m_metric, 1.0 / nbTrials[id])) { return false; }
+	// Update only the factor of the adapted class
+	if (factors.size() == m_nbClass && !DistanceReferenceFactor(means[id], factors[id], m_metric)) { factors.clear(); }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
 
-	// Adaptation
+///-------------------------------------------------------------------------------------------------
+template <EMetric M>
+bool CMatrixClassifierMDM::adaptMeans(const Eigen::MatrixXd& sample, const size_t classId, const EAdaptations adaptation, const size_t realClassId,
+									  std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors, std::vector<size_t>& nbTrials,
+									  CClassifierWorkspace& workspace) const
+{
 	if (adaptation == EAdaptations::None) { return true; }
 	// Get class id for adaptation and increase number of trials, expected if supervised, predicted if unsupervised
 	const size_t id = adaptation == EAdaptations::Supervised ? realClassId : classId;
 	if (id >= m_nbClass) { return false; }					// Check id (if supervised and bad input)
-	m_nbTrials[id]++;										// Update number of trials for the class id
-	return Geodesic(m_means[id], sample, m_means[id], m_metric, 1.0 / m_nbTrials[id]);
+	nbTrials[id]++;											// Update number of trials for the class id
+	if (!Geodesic<M>(means[id], sample, means[id], 1.0 / nbTrials[id], workspace.symmetric)) { return false; }
+	// Update only the factor of the adapted class
+	if (factors.size() == m_nbClass && !DistanceReferenceFactor<M>(means[id], factors[id], workspace.symmetric)) { factors.clear(); }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+template <EMetric M>
+bool CMatrixClassifierMDM::classifyWithMeans(const Eigen::MatrixXd& sample, std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors,
+											 std::vector<size_t>& nbTrials, const Eigen::MatrixXd& classDistances, CClassifierWorkspace& workspace, size_t& classId,
+											 std::vector<double>& distance, std::vector<double>& probability, const EAdaptations adaptation, const size_t realClassId) const
+{
+	if (!predictWithMeans<M>(sample, means, factors, classDistances, workspace, classId, distance, probability)) { return false; }
+	return adaptMeans<M>(sample, classId, adaptation, realClassId, means, factors, nbTrials, workspace);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::classifyWithMeans(const Eigen::MatrixXd& sample, std::vector<Eigen::MatrixXd>& means, std::vector<Eigen::MatrixXd>& factors,
+											 std::vector<size_t>& nbTrials, const Eigen::MatrixXd& classDistances, CClassifierWorkspace& workspace, size_t& classId,
+											 std::vector<double>& distance, std::vector<double>& probability, const EAdaptations adaptation, const size_t realClassId) const
+{
+	switch (m_metric)
+	{
+		case EMetric::Riemann: return classifyWithMeans<EMetric::Riemann>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::Euclidian: return classifyWithMeans<EMetric::Euclidian>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::LogEuclidian: return classifyWithMeans<EMetric::LogEuclidian>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::LogDet: return classifyWithMeans<EMetric::LogDet>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::Kullback: return classifyWithMeans<EMetric::Kullback>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::ALE: return classifyWithMeans<EMetric::ALE>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::Harmonic: return classifyWithMeans<EMetric::Harmonic>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::Wasserstein: return classifyWithMeans<EMetric::Wasserstein>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+		case EMetric::Identity:
+		default: return classifyWithMeans<EMetric::Identity>(sample, means, factors, nbTrials, classDistances, workspace, classId, distance, probability, adaptation, realClassId);
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateFactors()
+{
+	m_factors.resize(m_means.size());
+	for (size_t k = 0; k < m_means.size(); ++k)
+	{
+		if (m_means[k].size() == 0 || !DistanceReferenceFactor(m_means[k], m_factors[k], m_metric))
+		{
+			m_factors.clear();								// Distances without factors
+			break;
+		}
+	}
+	updateClassDistances();
+	updateProxy();
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateClassDistances()
+{
+	m_classDistances.resize(0, 0);
+	if (!m_pruning || !CanPrune(m_metric) || m_factors.size() != m_nbClass) { return; }
+	m_classDistances.setZero(Eigen::Index(m_nbClass), Eigen::Index(m_nbClass));
+	SSymmetricBuffers buffers;
+	for (size_t k = 0; k < m_nbClass; ++k) { updateClassDistances(k, buffers); }
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateClassDistances(const size_t id, SSymmetricBuffers& buffers)
+{
+	const Eigen::Index n = Eigen::Index(m_nbClass);
+	if (m_classDistances.rows() != n || m_classDistances.cols() != n || id >= m_nbClass) { return; }
+	if (m_factors.size() != m_nbClass)						// The factors are cleared if the adapted mean isn't valid
+	{
+		m_classDistances.resize(0, 0);
+		return;
+	}
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		const double d = k == id ? 0 : DistanceFactorized(m_means[id], m_factors[id], m_means[k], m_factors[k], m_metric, buffers);
+		m_classDistances(Eigen::Index(id), Eigen::Index(k)) = m_classDistances(Eigen::Index(k), Eigen::Index(id)) = d;
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateProxy()
+{
+	m_proxyRefIS.resize(0, 0);
+	m_proxyMeans.resize(0, 0);
+	if (!m_fast || m_metric != EMetric::Riemann || m_nbClass == 0 || !AreNotEmpty(m_means)) { return; }
+	Eigen::MatrixXd ref;
+	SSymmetricBuffers buffers;
+	if (!Mean(m_means, ref, EMetric::Riemann)) { return; }	// Tangent space at the mean of the classes
+	if (!SelfAdjointFunction(ref, m_proxyRefIS, [](const double x) { return 1.0 / sqrt(x); }, buffers))
+	{
+		m_proxyRefIS.resize(0, 0);
+		return;
+	}
+	m_proxyMeans.resize(Eigen::Index(m_nbClass), Eigen::Index(m_means[0].rows() * (m_means[0].rows() + 1) / 2));
+	Eigen::RowVectorXd tangent;
+	for (size_t k = 0; k < m_nbClass; ++k) { updateProxy(k, buffers, tangent); }
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::updateProxy(const size_t id, SSymmetricBuffers& buffers, Eigen::RowVectorXd& tangent)
+{
+	if (m_proxyMeans.rows() != Eigen::Index(m_nbClass) || id >= m_nbClass) { return; }
+	if (TangentSpaceFactorized(m_means[id], tangent, m_proxyRefIS, buffers)) { m_proxyMeans.row(Eigen::Index(id)) = tangent; }
+	else { m_proxyMeans.resize(0, 0); }						// Without the fast prediction mode
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances,
+									Eigen::MatrixXd& probabilities, const EAdaptations adaptation, const std::vector<size_t>& realClassIds, const size_t nbThreads)
+{
+	// Sequential pipeline with adaptation
+	if (adaptation != EAdaptations::None) { return IMatrixClassifier::classify(samples, classIds, distances, probabilities, adaptation, realClassIds, nbThreads); }
+
+	if (!prepareBatch(samples, classIds, distances, probabilities, adaptation, realClassIds)) { return false; }
+	for (const auto& sample : samples) { if (!IsSquare(sample)) { return false; } }	// Verification if it's square matrices
+	std::vector<Eigen::MatrixXd> prepared;
+	if (!prepareSamples(samples, prepared, nbThreads)) { return false; }
+	const size_t n       = samples.size();
+	const bool factorize = m_factors.size() == m_nbClass;
+
+	// Compute the factors of the samples in parallel
+	std::vector<Eigen::MatrixXd> factors(factorize ? n : 0);
+	bool valid = true;
+	if (factorize)
+	{
+		std::vector<char> success(n, 1);
+		ParallelFor(n, [&](const size_t begin, const size_t end, size_t /*job*/)
+		{
+			for (size_t i = begin; i < end; ++i) { success[i] = DistanceSampleFactor(prepared[i], factors[i], m_metric) ? 1 : 0; }
+		}, nbThreads);
+		for (const auto& s : success) { valid = valid && s == 1; }
+	}
+	if (!valid) { return false; }
+
+	// Compute Distances of each pair (sample, class) in parallel
+	ParallelFor(n * m_nbClass, [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t p = begin; p < end; ++p)
+		{
+			const size_t i = p / m_nbClass, k = p % m_nbClass;
+			distances(i, k) = factorize ? DistanceFactorized(prepared[i], factors[i], m_means[k], m_factors[k], m_metric)
+										: Distance(prepared[i], m_means[k], m_metric);
+		}
+	}, nbThreads);
+
+	// Compute Probabilities
+	std::vector<double> distance(m_nbClass), probability;
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t k = 0; k < m_nbClass; ++k) { distance[k] = distances(i, k); }
+		DistancesToProbabilities(distance, classIds[i], probability);
+		for (size_t k = 0; k < m_nbClass; ++k) { probabilities(i, k) = probability[k]; }
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, size_t /*nbThreads*/)
+{
+	prepared = samples;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDM::adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels)
+{
+	if (samples.size() != labels.size()) { return false; }
+	// Split the block by class
+	std::vector<std::vector<Eigen::MatrixXd>> blocks(m_nbClass);
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		if (labels[i] >= m_nbClass || !IsSquare(samples[i])) { return false; }	// Check id and sample
+		blocks[labels[i]].push_back(samples[i]);
+	}
+
+	// One geodesic step to the mean of the block for each class
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		if (blocks[k].empty()) { continue; }
+		Eigen::MatrixXd blockMean;
+		if (!Mean(blocks[k], blockMean, m_metric)) { return false; }
+		m_nbTrials[k] += blocks[k].size();
+		if (!Geodesic(m_means[k], blockMean, m_means[k], m_metric, double(blocks[k].size()) / double(m_nbTrials[k]))) { return false; }
+	}
+	updateFactors();
+	return true;
 }
 ///-------------------------------------------------------------------------------------------------
 
@@ -126,6 +586,7 @@ bool CMatrixClassifierMDM::loadClasses(tinyxml2::XMLElement* data)
 		if (!loadMatrix(element, m_means[k])) { return false; }			// Load Class Matrix
 		element = element->NextSiblingElement("Class");					// Next Class
 	}
+	updateFactors();													// Factors of the loaded means
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -171,7 +632,55 @@ void CMatrixClassifierMDM::copy(const CMatrixClassifierMDM& obj)
 		m_means[i]    = obj.m_means[i];
 		m_nbTrials[i] = obj.m_nbTrials[i];
 	}
+	m_factors        = obj.m_factors;
+	m_pruning        = obj.m_pruning;
+	m_classDistances = obj.m_classDistances;
+	m_fast           = obj.m_fast;
+	m_fastMargin     = obj.m_fastMargin;
+	m_proxyRefIS     = obj.m_proxyRefIS;
+	m_proxyMeans     = obj.m_proxyMeans;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierMDM::move(CMatrixClassifierMDM& obj) noexcept
+{
+	m_means          = std::move(obj.m_means);
+	m_factors        = std::move(obj.m_factors);
+	m_nbTrials       = std::move(obj.m_nbTrials);
+	m_pruning        = obj.m_pruning;
+	m_classDistances = std::move(obj.m_classDistances);
+	m_fast           = obj.m_fast;
+	m_fastMargin     = obj.m_fastMargin;
+	m_proxyRefIS     = std::move(obj.m_proxyRefIS);
+	m_proxyMeans     = std::move(obj.m_proxyMeans);
+	m_nbFast         = obj.m_nbFast.load();
+	m_nbRefined      = obj.m_nbRefined.load();
+	m_nbOverBudget   = obj.m_nbOverBudget.load();
 }
 ///-------------------------------------------------------------------------------------------------
 
+
+//*************************************************************
+//******************** Compile-time Metric ********************
+//*************************************************************
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Riemann>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Euclidian>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::LogEuclidian>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::LogDet>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Kullback>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::ALE>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Harmonic>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Wasserstein>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+template bool CMatrixClassifierMDM::classifyWithMeans<EMetric::Identity>(const Eigen::MatrixXd&, std::vector<Eigen::MatrixXd>&, std::vector<Eigen::MatrixXd>&, std::vector<size_t>&,
+																		  const Eigen::MatrixXd&, CClassifierWorkspace&, size_t&, std::vector<double>&, std::vector<double>&, EAdaptations, size_t) const;
+
 }  // namespace Geometry
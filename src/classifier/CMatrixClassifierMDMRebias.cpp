@@ -1,4 +1,5 @@
 #include "geometry/classifier/CMatrixClassifierMDMRebias.hpp"
+#include "geometry/classifier/CClassifierSession.hpp"
 #include "geometry/Mean.hpp"
 #include "geometry/Basics.hpp"
 #include <unsupported/Eigen/MatrixFunctions> // SQRT of Matrix
@@ -22,14 +23,80 @@ bool CMatrixClassifierMDMRebias::train(const std::vector<std::vector<Eigen::Matr
 bool CMatrixClassifierMDMRebias::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
 										  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
 {
-	if (!IsSquare(sample)) { return false; }					// Verification if it's a square matrix 
 	Eigen::MatrixXd newSample;
-	m_bias.applyBias(sample, newSample);
-	m_bias.updateBias(sample, m_metric);
+	SSymmetricBuffers buffers;
+	if (!Unbias(sample, m_bias, m_metric, newSample, buffers)) { return false; }
 	return CMatrixClassifierMDM::classify(newSample, classId, distance, probability, adaptation, realClassId);
 }
 ///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+										  std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!Unbias(sample, m_bias, m_metric, workspace.unbiased, workspace.symmetric)) { return false; }
+	return CMatrixClassifierMDM::classify(workspace.unbiased, workspace, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	if (!IsSquare(sample) || sample.rows() != m_bias.getBias().rows()) { return false; }	// The bias must have the size of the sample
+	Eigen::MatrixXd newSample;
+	m_bias.applyBias(sample, newSample);
+	return CMatrixClassifierMDM::predict(newSample, classId, distance, probability);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::initSession(CClassifierSession& session) const
+{
+	if (!CMatrixClassifierMDM::initSession(session)) { return false; }
+	session.getBias() = m_bias;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::classify(const Eigen::MatrixXd& sample, CClassifierSession& session, size_t& classId, std::vector<double>& distance,
+										std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId) const
+{
+	CClassifierWorkspace& workspace = session.getWorkspace();
+	if (!checkWorkspace(workspace, sample.rows())) { return false; }
+	if (!Unbias(sample, session.getBias(), m_metric, workspace.unbiased, workspace.symmetric)) { return false; }
+	return CMatrixClassifierMDM::classify(workspace.unbiased, session, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::prepareSamples(const std::vector<Eigen::MatrixXd>& samples, std::vector<Eigen::MatrixXd>& prepared, size_t /*nbThreads*/)
+{
+	prepared.resize(samples.size());
+	SSymmetricBuffers buffers;
+	for (size_t i = 0; i < samples.size(); ++i) { if (!Unbias(samples[i], m_bias, m_metric, prepared[i], buffers)) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierMDMRebias::adapt(const std::vector<Eigen::MatrixXd>& samples, const std::vector<size_t>& labels)
+{
+	// Verification of the whole block before the update of the bias (a rejected block doesn't modify the classifier)
+	if (samples.size() != labels.size()) { return false; }
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		if (labels[i] >= m_nbClass || !IsSquare(samples[i]) || samples[i].rows() != m_bias.getBias().rows()) { return false; }	// Check id and sample
+	}
+
+	std::vector<Eigen::MatrixXd> newSamples(samples.size());
+	SSymmetricBuffers buffers;
+	for (size_t i = 0; i < samples.size(); ++i) { Unbias(samples[i], m_bias, m_metric, newSamples[i], buffers); }	// The block is already checked
+	return CMatrixClassifierMDM::adapt(newSamples, labels);
+}
+///-------------------------------------------------------------------------------------------------
+
 //***********************
 //***** XML Manager *****
 //***********************
@@ -0,0 +1,292 @@
+#include "geometry/classifier/CMatrixClassifierTSKernel.hpp"
+#include "geometry/Mean.hpp"
+#include "geometry/Basics.hpp"
+#include "geometry/Featurization.hpp"
+#include <unsupported/Eigen/MatrixFunctions> // SQRT of Matrix
+
+namespace Geometry {
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Softmax of the scores, the distances are \f$ -\log(\mathcal{P}_i) \f$. </summary>
+template <typename TScores, typename TDistance, typename TProbability>
+static void Softmax(const TScores& scores, size_t& classId, TDistance&& distance, TProbability&& probability)
+{
+	Eigen::Index best     = 0;
+	const double maxScore = scores.maxCoeff(&best);
+	classId               = size_t(best);
+	double sum            = 0;
+	for (Eigen::Index k = 0; k < scores.size(); ++k) { sum += exp(scores[k] - maxScore); }
+	for (Eigen::Index k = 0; k < scores.size(); ++k)
+	{
+		distance(k)    = log(sum) - (scores[k] - maxScore);	// -log(p_k) without underflow
+		probability(k) = exp(-distance(k));
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+//***************************
+//***** Getter / Setter *****
+//***************************
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSKernel::setRef(const Eigen::MatrixXd& ref)
+{
+	m_ref.set(ref);
+	m_refIS.set(ref.size() == 0 ? Eigen::MatrixXd() : Eigen::MatrixXd(Eigen::MatrixXd(ref.sqrt()).inverse()));
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSKernel::setSupport(const Eigen::MatrixXd& support, const Eigen::MatrixXd& dual, const Eigen::VectorXd& bias)
+{
+	m_support.set(support);
+	m_norms.set(support.rowwise().squaredNorm());
+	m_dual.set(dual);
+	m_bias = bias;
+}
+///-------------------------------------------------------------------------------------------------
+
+//**********************
+//***** Classifier *****
+//**********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
+{
+	if (datasets.empty()) { return false; }
+	setClassCount(datasets.size());							// Change the number of classes if needed
+	for (const auto& d : datasets) { if (d.empty()) { return false; } }
+
+	// Compute Reference matrix
+	const std::vector<Eigen::MatrixXd> trials = Vector2DTo1D(datasets);
+	Eigen::MatrixXd ref;
+	if (!Mean(trials, ref, EMetric::Riemann)) { return false; }
+	setRef(ref);
+
+	// Transform to the Tangent Space once (in parallel) and compute the kernel of the support vectors
+	Eigen::MatrixXd support, kernel;
+	if (!TangentSpace(trials, support, ref, m_nbThreads)) { return false; }
+	if (!GramMatrix(support, kernel, m_nbThreads)) { return false; }
+	if (m_gamma <= 0) { m_gamma = 1.0 / double(support.cols()); }
+	const Eigen::VectorXd norms = support.rowwise().squaredNorm();
+	applyKernel(kernel, norms, norms);
+
+	// Kernel ridge regression of the centered one-hot labels
+	const Eigen::Index n = Eigen::Index(trials.size());
+	Eigen::MatrixXd targets = Eigen::MatrixXd::Zero(n, Eigen::Index(m_nbClass));
+	Eigen::Index idx        = 0;
+	for (size_t k = 0; k < m_nbClass; ++k) { for (size_t i = 0; i < datasets[k].size(); ++i) { targets(idx++, Eigen::Index(k)) = 1.0; } }
+	const Eigen::VectorXd bias = targets.colwise().mean().transpose();
+	targets.rowwise() -= bias.transpose();
+	kernel.diagonal().array() += m_regularization;
+	const Eigen::LDLT<Eigen::MatrixXd> solver(kernel);
+	if (solver.info() != Eigen::Success) { return false; }
+	const Eigen::MatrixXd dual = solver.solve(targets);
+	if (!dual.allFinite()) { return false; }
+
+	setSupport(support, dual, bias);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSKernel::applyKernel(Eigen::MatrixXd& products, const Eigen::VectorXd& rowNorms, const Eigen::VectorXd& colNorms) const
+{
+	if (m_kernel != ETangentKernel::Gaussian) { return; }
+	// ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a.b
+	for (Eigen::Index j = 0; j < products.cols(); ++j)
+	{
+		products.col(j) = (-m_gamma * ((rowNorms.array() + colNorms[j]) - 2.0 * products.col(j).array()).max(0.0)).exp();
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::computeScores(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace) const
+{
+	if (!IsSquare(sample) || sample.rows() != m_refIS->rows()) { return false; }	// Verification if it's a square matrix of the good size
+	const Eigen::Index n = sample.rows();
+	if (m_support->cols() != n * (n + 1) / 2 || m_dual->rows() != m_support->rows() || m_dual->cols() != Eigen::Index(m_nbClass)) { return false; }	// Verification if classifier is trained
+	if (!checkWorkspace(workspace, size_t(n))) { return false; }
+
+	// Log map : log(refIS * sample * refIS) with a symmetric eigen decomposition
+	if (!TangentSpaceFactorized(sample, workspace.tangent, m_refIS.get(), workspace.symmetric)) { return false; }
+	if (!workspace.tangent.allFinite()) { return false; }	// Not a SPD Matrix
+
+	// Kernel with the support vectors
+	workspace.kernel.resize(m_support->rows());
+	workspace.kernel.noalias() = m_support.get() * workspace.tangent.transpose();
+	if (m_kernel == ETangentKernel::Gaussian)				// Same as applyKernel for one sample
+	{
+		const double norm = workspace.tangent.squaredNorm();
+		workspace.kernel  = (-m_gamma * ((m_norms->array() + norm) - 2.0 * workspace.kernel.array()).max(0.0)).exp();
+	}
+
+	// Scores
+	workspace.scores.noalias() = m_dual->transpose() * workspace.kernel;
+	workspace.scores += m_bias;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
+										 std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	return classify(sample, m_workspace, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+										 std::vector<double>& probability, const EAdaptations /*adaptation*/, const size_t& /*realClassId*/)
+{
+	if (!computeScores(sample, workspace)) { return false; }
+	distance.resize(m_nbClass);
+	probability.resize(m_nbClass);
+	Softmax(workspace.scores, classId, [&](const Eigen::Index k) -> double& { return distance[k]; },
+			[&](const Eigen::Index k) -> double& { return probability[k]; });
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	CClassifierWorkspace workspace;
+	if (!computeScores(sample, workspace)) { return false; }
+	distance.resize(m_nbClass);
+	probability.resize(m_nbClass);
+	Softmax(workspace.scores, classId, [&](const Eigen::Index k) -> double& { return distance[k]; },
+			[&](const Eigen::Index k) -> double& { return probability[k]; });
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances,
+										 Eigen::MatrixXd& probabilities, const EAdaptations adaptation, const std::vector<size_t>& realClassIds, const size_t nbThreads)
+{
+	if (!prepareBatch(samples, classIds, distances, probabilities, adaptation, realClassIds)) { return false; }
+	if (m_dual->rows() != m_support->rows() || m_dual->cols() != Eigen::Index(m_nbClass) || m_support->rows() == 0) { return false; }	// Verification if classifier is trained
+
+	// Tangent vectors of the samples and cross kernel with the support vectors
+	Eigen::MatrixXd vectors, kernel;
+	if (!TangentSpace(samples, vectors, m_ref.get(), nbThreads)) { return false; }
+	if (vectors.cols() != m_support->cols() || !GramMatrix(vectors, m_support.get(), kernel, nbThreads)) { return false; }
+	applyKernel(kernel, vectors.rowwise().squaredNorm(), m_norms.get());
+
+	Eigen::MatrixXd scores = kernel * m_dual.get();
+	scores.rowwise() += m_bias.transpose();
+	for (Eigen::Index i = 0; i < scores.rows(); ++i)
+	{
+		Softmax(scores.row(i), classIds[i], [&](const Eigen::Index k) -> double& { return distances(i, k); },
+				[&](const Eigen::Index k) -> double& { return probabilities(i, k); });
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//***********************
+//***** XML Manager *****
+//***********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const
+{
+	data->SetAttribute("kernel", toString(m_kernel).c_str());	// Set attribute kernel
+	data->SetAttribute("gamma", m_gamma);						// Set attribute gamma
+
+	// Save Reference
+	tinyxml2::XMLElement* reference = doc.NewElement("Reference");	// Create Reference node
+	if (!saveMatrix(reference, m_ref.get())) { return false; }		// Save Reference
+	data->InsertEndChild(reference);							// Add Reference node to data node
+
+	// Save Kernel classifier
+	tinyxml2::XMLElement* support = doc.NewElement("Support");	// Create Support node
+	if (!saveMatrix(support, m_support.get())) { return false; }	// Save Support vectors
+	data->InsertEndChild(support);								// Add Support node to data node
+	tinyxml2::XMLElement* dual = doc.NewElement("Dual");		// Create Dual node
+	if (!saveMatrix(dual, m_dual.get())) { return false; }		// Save Dual coefficients
+	data->InsertEndChild(dual);									// Add Dual node to data node
+	tinyxml2::XMLElement* bias = doc.NewElement("Bias");		// Create Bias node
+	if (!saveMatrix(bias, m_bias)) { return false; }			// Save Bias
+	data->InsertEndChild(bias);									// Add Bias node to data node
+
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::loadAdditional(tinyxml2::XMLElement* data)
+{
+	const char* kernel = data->Attribute("kernel");				// Get the kernel
+	m_kernel           = StringToTangentKernel(kernel == nullptr ? "" : kernel);
+	m_gamma            = data->DoubleAttribute("gamma");
+
+	// Load Reference
+	tinyxml2::XMLElement* ref = data->FirstChildElement("Reference");	// Get Reference Node
+	Eigen::MatrixXd reference;
+	if (!loadMatrix(ref, reference)) { return false; }			// Load Reference Matrix
+
+	// Load Kernel classifier
+	tinyxml2::XMLElement* support = data->FirstChildElement("Support");	// Get Support Node
+	tinyxml2::XMLElement* dual    = data->FirstChildElement("Dual");	// Get Dual Node
+	tinyxml2::XMLElement* bias    = data->FirstChildElement("Bias");	// Get Bias Node
+	if (support == nullptr || dual == nullptr || bias == nullptr) { return false; }
+	Eigen::MatrixXd s, d, b;
+	if (!loadMatrix(support, s) || !loadMatrix(dual, d) || !loadMatrix(bias, b)) { return false; }	// Load Support, Dual and Bias Matrix
+	if (b.cols() > 1 || s.rows() != d.rows()) { return false; }
+
+	setSupport(s, d, b.size() == 0 ? Eigen::VectorXd() : Eigen::VectorXd(b.col(0)));
+	setRef(reference);											// Set the reference and the inverse square root
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//*****************************
+//***** Override Operator *****
+//*****************************
+///-------------------------------------------------------------------------------------------------
+std::stringstream CMatrixClassifierTSKernel::printAdditional() const
+{
+	std::stringstream ss;
+	ss << "Kernel : " << toString(m_kernel);													// Kernel
+	if (m_kernel == ETangentKernel::Gaussian) { ss << " (gamma : " << m_gamma << ")"; }
+	ss << std::endl;
+	ss << "Reference matrix : " << std::endl << m_ref->format(MATRIX_FORMAT) << std::endl;		// Reference
+	ss << "Number of support vectors : " << m_support->rows() << std::endl;					// Support vectors
+	ss << "Bias : " << std::endl << m_bias.transpose().format(MATRIX_FORMAT) << std::endl;		// Print Bias
+	return ss;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSKernel::isEqual(const CMatrixClassifierTSKernel& obj, const double precision) const
+{
+	if (!IMatrixClassifier::isEqual(obj, precision)) { return false; }	// Compare base members
+	if (m_kernel != obj.m_kernel) { return false; }						// Compare Kernel
+	if (std::abs(m_gamma - obj.m_gamma) > precision) { return false; }	// Compare Gamma
+	if (!AreEquals(m_ref.get(), obj.m_ref.get(), precision)) { return false; }			// Compare Reference
+	if (!AreEquals(m_support.get(), obj.m_support.get(), precision)) { return false; }	// Compare Support vectors
+	if (!AreEquals(m_dual.get(), obj.m_dual.get(), precision)) { return false; }		// Compare Dual coefficients
+	if (!AreEquals(m_bias, obj.m_bias, precision)) { return false; }	// Compare Bias
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSKernel::copy(const CMatrixClassifierTSKernel& obj)
+{
+	IMatrixClassifier::copy(obj);
+	m_kernel         = obj.m_kernel;
+	m_gamma          = obj.m_gamma;
+	m_regularization = obj.m_regularization;
+	m_nbThreads      = obj.m_nbThreads;
+	m_ref            = obj.m_ref;
+	m_refIS          = obj.m_refIS;
+	m_support        = obj.m_support;
+	m_norms          = obj.m_norms;
+	m_dual           = obj.m_dual;
+	m_bias           = obj.m_bias;
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
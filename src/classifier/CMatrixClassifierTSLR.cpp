@@ -0,0 +1,375 @@
+#include "geometry/classifier/CMatrixClassifierTSLR.hpp"
+#include "geometry/classifier/CClassStatistics.hpp"
+#include "geometry/Mean.hpp"
+#include "geometry/Basics.hpp"
+#include "geometry/Featurization.hpp"
+#include <unsupported/Eigen/MatrixFunctions> // SQRT of Matrix
+
+namespace Geometry {
+
+#ifndef M_SQRT2
+#define M_SQRT2 1.4142135623730950488016887242097
+#endif
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Compute the mean cross entropy of the multinomial logistic regression with L2 regularization and its gradient (blocks of trials in parallel). </summary>
+static double LogisticLoss(const Eigen::MatrixXd& features, const std::vector<size_t>& labels, const Eigen::MatrixXd& weight, const Eigen::VectorXd& bias,
+						   const double regularization, Eigen::MatrixXd* gradW, Eigen::VectorXd* gradB, const size_t nbThreads)
+{
+	const size_t n = features.rows(), nbClass = weight.rows(), nbJobs = ParallelThreadCount(n, nbThreads);
+	const bool gradient = gradW != nullptr && gradB != nullptr;
+	std::vector<double> losses(nbJobs, 0.0);
+	std::vector<Eigen::MatrixXd> gWs(gradient ? nbJobs : 0, Eigen::MatrixXd::Zero(weight.rows(), weight.cols()));
+	std::vector<Eigen::VectorXd> gBs(gradient ? nbJobs : 0, Eigen::VectorXd::Zero(nbClass));
+
+	ParallelFor(n, [&](const size_t begin, const size_t end, const size_t job)
+	{
+		Eigen::VectorXd scores(nbClass);
+		for (size_t i = begin; i < end; ++i)
+		{
+			scores.noalias() = weight * features.row(i).transpose();
+			scores += bias;
+			const double maxScore = scores.maxCoeff();
+			scores                = (scores.array() - maxScore).exp();
+			const double sum      = scores.sum();
+			losses[job] -= log(scores[labels[i]] / sum);
+			if (gradient)
+			{
+				scores /= sum;						// Probabilities
+				scores[labels[i]] -= 1.0;			// Residual
+				gWs[job].noalias() += scores * features.row(i);
+				gBs[job] += scores;
+			}
+		}
+	}, nbThreads);
+
+	double loss = 0;
+	for (const auto& l : losses) { loss += l; }
+	loss = loss / double(n) + 0.5 * regularization * weight.squaredNorm();
+	if (gradient)
+	{
+		gradW->noalias() = regularization * weight;
+		gradB->setZero(nbClass);
+		for (size_t j = 0; j < nbJobs; ++j)
+		{
+			*gradW += gWs[j] / double(n);
+			*gradB += gBs[j] / double(n);
+		}
+	}
+	return loss;
+}
+///-------------------------------------------------------------------------------------------------
+
+//***************************
+//***** Getter / Setter *****
+//***************************
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSLR::setRef(const Eigen::MatrixXd& ref)
+{
+	m_ref.set(ref);
+	m_refIS.set(ref.size() == 0 ? Eigen::MatrixXd() : Eigen::MatrixXd(Eigen::MatrixXd(ref.sqrt()).inverse()));
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSLR::setWeight(const Eigen::MatrixXd& weight, const Eigen::VectorXd& bias)
+{
+	m_weight.set(weight);
+	m_bias = bias;
+}
+///-------------------------------------------------------------------------------------------------
+
+//**********************
+//***** Classifier *****
+//**********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets)
+{
+	if (datasets.empty()) { return false; }
+	setClassCount(datasets.size());							// Change the number of classes if needed
+	for (const auto& d : datasets) { if (d.empty()) { return false; } }
+
+	// Compute Reference matrix
+	Eigen::MatrixXd ref;
+	if (!Mean(Vector2DTo1D(datasets), ref, EMetric::Riemann)) { return false; }
+	setRef(ref);
+
+	// Transform to the Tangent Space (in parallel)
+	std::vector<size_t> labels;
+	std::vector<const Eigen::MatrixXd*> trials;
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		for (const auto& trial : datasets[k])
+		{
+			labels.push_back(k);
+			trials.push_back(&trial);
+		}
+	}
+	std::vector<Eigen::RowVectorXd> tsSample(trials.size());
+	std::vector<char> valid(trials.size(), 1);
+	ParallelFor(trials.size(), [&](const size_t begin, const size_t end, size_t /*job*/)
+	{
+		for (size_t i = begin; i < end; ++i) { valid[i] = TangentSpace(*trials[i], tsSample[i], m_ref.get()) ? 1 : 0; }
+	}, m_nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+
+	// Train the linear classifier
+	if (m_solver == ETangentSolver::LDA)
+	{
+		std::vector<std::vector<Eigen::RowVectorXd>> tsDatasets(m_nbClass);
+		for (size_t i = 0; i < tsSample.size(); ++i) { tsDatasets[labels[i]].push_back(tsSample[i]); }
+		return trainLDA(tsDatasets);
+	}
+	Eigen::MatrixXd features(tsSample.size(), tsSample[0].size());
+	for (size_t i = 0; i < tsSample.size(); ++i) { features.row(i) = tsSample[i]; }
+	return trainLogisticRegression(features, labels);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::trainLogisticRegression(const Eigen::MatrixXd& features, const std::vector<size_t>& labels)
+{
+	const size_t nbFeatures = features.cols();
+	Eigen::MatrixXd weight = Eigen::MatrixXd::Zero(m_nbClass, nbFeatures), gradW, newWeight;
+	Eigen::VectorXd bias   = Eigen::VectorXd::Zero(m_nbClass), gradB, newBias;
+
+	// Gradient descent with backtracking line search (Armijo rule)
+	double loss = LogisticLoss(features, labels, weight, bias, m_regularization, &gradW, &gradB, m_nbThreads), step = 1.0;
+	for (size_t it = 0; it < m_maxIterations; ++it)
+	{
+		const double gradNorm = gradW.squaredNorm() + gradB.squaredNorm();
+		if (gradNorm < 1e-16) { break; }					// Converged
+		double newLoss = loss;
+		while (step > 1e-12)
+		{
+			newWeight = weight - step * gradW;
+			newBias   = bias - step * gradB;
+			newLoss   = LogisticLoss(features, labels, newWeight, newBias, m_regularization, nullptr, nullptr, m_nbThreads);
+			if (newLoss <= loss - 0.5 * step * gradNorm) { break; }
+			step *= 0.5;
+		}
+		if (step <= 1e-12) { break; }						// No more decrease possible
+		weight.swap(newWeight);
+		bias.swap(newBias);
+		loss = LogisticLoss(features, labels, weight, bias, m_regularization, &gradW, &gradB, m_nbThreads);
+		step *= 2.0;										// Try a longer step at the next iteration
+	}
+	setWeight(weight, bias);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::trainLDA(const std::vector<std::vector<Eigen::RowVectorXd>>& datasets)
+{
+	// Compute Class Euclidian mean and pooled Covariance (same estimator as LSQR)
+	const size_t nbFeatures = datasets[0][0].size();
+	size_t totalSample      = 0;
+	for (const auto& d : datasets) { totalSample += d.size(); }
+	Eigen::MatrixXd mean(m_nbClass, nbFeatures), cov = Eigen::MatrixXd::Zero(nbFeatures, nbFeatures), classCov;
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		CClassStatistics statistics(nbFeatures);
+		if (!statistics.add(datasets[k])) { return false; }
+		mean.row(k) = statistics.getMean();
+		if (!statistics.covarianceLWF(classCov)) { return false; }
+		cov += (double(datasets[k].size()) / double(totalSample)) * classCov;
+	}
+
+	// Linear discriminant : s_k = w_k t - 1/2 w_k mu_k + log(prior_k)
+	const Eigen::MatrixXd weight = cov.colPivHouseholderQr().solve(mean.transpose()).transpose();
+	Eigen::VectorXd bias(m_nbClass);
+	for (size_t k = 0; k < m_nbClass; ++k)
+	{
+		bias[k] = -0.5 * weight.row(k).dot(mean.row(k)) + log(double(datasets[k].size()) / double(totalSample));
+	}
+	setWeight(weight, bias);
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Softmax of the scores, the distances are \f$ -\log(\mathcal{P}_i) \f$. </summary>
+template <typename TDistance, typename TProbability>
+static void Softmax(const Eigen::VectorXd& scores, size_t& classId, TDistance&& distance, TProbability&& probability)
+{
+	const double maxScore = scores.maxCoeff(&classId);
+	double sum            = 0;
+	for (Eigen::Index k = 0; k < scores.size(); ++k) { sum += exp(scores[k] - maxScore); }
+	for (Eigen::Index k = 0; k < scores.size(); ++k)
+	{
+		distance(k)    = log(sum) - (scores[k] - maxScore);	// -log(p_k) without underflow
+		probability(k) = exp(-distance(k));
+	}
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::computeScores(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace) const
+{
+	if (!IsSquare(sample) || sample.rows() != m_refIS->rows()) { return false; }	// Verification if it's a square matrix of the good size
+	const Eigen::Index n = sample.rows();
+	if (m_weight->rows() != Eigen::Index(m_nbClass) || m_weight->cols() != n * (n + 1) / 2) { return false; }	// Verification if classifier is trained
+	if (!checkWorkspace(workspace, size_t(n))) { return false; }
+
+	// Log map : log(refIS * sample * refIS) with a symmetric eigen decomposition
+	if (!TangentSpaceFactorized(sample, workspace.tangent, m_refIS.get(), workspace.symmetric)) { return false; }
+	if (!workspace.tangent.allFinite()) { return false; }	// Not a SPD Matrix
+
+	// Scores
+	workspace.scores.noalias() = m_weight.get() * workspace.tangent.transpose();
+	workspace.scores += m_bias;
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance,
+									 std::vector<double>& probability, const EAdaptations adaptation, const size_t& realClassId)
+{
+	return classify(sample, m_workspace, classId, distance, probability, adaptation, realClassId);
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::classify(const Eigen::MatrixXd& sample, CClassifierWorkspace& workspace, size_t& classId, std::vector<double>& distance,
+									 std::vector<double>& probability, const EAdaptations /*adaptation*/, const size_t& /*realClassId*/)
+{
+	if (!computeScores(sample, workspace)) { return false; }
+	distance.resize(m_nbClass);
+	probability.resize(m_nbClass);
+	Softmax(workspace.scores, classId, [&](const Eigen::Index k) -> double& { return distance[k]; },
+			[&](const Eigen::Index k) -> double& { return probability[k]; });
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::predict(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability) const
+{
+	CClassifierWorkspace workspace;
+	if (!computeScores(sample, workspace)) { return false; }
+	distance.resize(m_nbClass);
+	probability.resize(m_nbClass);
+	Softmax(workspace.scores, classId, [&](const Eigen::Index k) -> double& { return distance[k]; },
+			[&](const Eigen::Index k) -> double& { return probability[k]; });
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances,
+									 Eigen::MatrixXd& probabilities, const EAdaptations adaptation, const std::vector<size_t>& realClassIds, const size_t nbThreads)
+{
+	if (!prepareBatch(samples, classIds, distances, probabilities, adaptation, realClassIds)) { return false; }
+	std::vector<CClassifierWorkspace> workspaces(ParallelThreadCount(samples.size(), nbThreads));
+	std::vector<char> valid(samples.size(), 0);
+	ParallelFor(samples.size(), [&](const size_t begin, const size_t end, const size_t job)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (!computeScores(samples[i], workspaces[job])) { continue; }
+			Softmax(workspaces[job].scores, classIds[i], [&](const Eigen::Index k) -> double& { return distances(i, k); },
+					[&](const Eigen::Index k) -> double& { return probabilities(i, k); });
+			valid[i] = 1;
+		}
+	}, nbThreads);
+	for (const auto& v : valid) { if (v == 0) { return false; } }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//***********************
+//***** XML Manager *****
+//***********************
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::saveAdditional(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* data) const
+{
+	data->SetAttribute("solver", toString(m_solver).c_str());	// Set attribute solver
+
+	// Save Reference
+	tinyxml2::XMLElement* reference = doc.NewElement("Reference");	// Create Reference node
+	if (!saveMatrix(reference, m_ref.get())) { return false; }		// Save Reference
+	data->InsertEndChild(reference);							// Add Reference node to data node
+
+	// Save Linear classifier
+	tinyxml2::XMLElement* weight = doc.NewElement("Weight");	// Create Weight node
+	if (!saveMatrix(weight, m_weight.get())) { return false; }		// Save Weight
+	data->InsertEndChild(weight);								// Add Weight node to data node
+	tinyxml2::XMLElement* bias = doc.NewElement("Bias");		// Create Bias node
+	if (!saveMatrix(bias, m_bias)) { return false; }			// Save Bias
+	data->InsertEndChild(bias);									// Add Bias node to data node
+
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::loadAdditional(tinyxml2::XMLElement* data)
+{
+	const char* solver = data->Attribute("solver");				// Get the solver
+	m_solver           = StringToTangentSolver(solver == nullptr ? "" : solver);
+
+	// Load Reference
+	tinyxml2::XMLElement* ref = data->FirstChildElement("Reference");	// Get Reference Node
+	Eigen::MatrixXd reference;
+	if (!loadMatrix(ref, reference)) { return false; }			// Load Reference Matrix
+
+	// Load Linear classifier
+	tinyxml2::XMLElement* weight = data->FirstChildElement("Weight");	// Get Weight Node
+	tinyxml2::XMLElement* bias   = data->FirstChildElement("Bias");		// Get Bias Node
+	if (weight == nullptr || bias == nullptr) { return false; }
+	Eigen::MatrixXd w, b;
+	if (!loadMatrix(weight, w) || !loadMatrix(bias, b)) { return false; }	// Load Weight and Bias Matrix
+	if (b.cols() > 1) { return false; }
+
+	m_weight.set(std::move(w));
+	m_bias = b.size() == 0 ? Eigen::VectorXd() : Eigen::VectorXd(b.col(0));
+	setRef(reference);											// Set the reference and init the buffers
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+//*****************************
+//***** Override Operator *****
+//*****************************
+///-------------------------------------------------------------------------------------------------
+std::stringstream CMatrixClassifierTSLR::printAdditional() const
+{
+	std::stringstream ss;
+	ss << "Solver : " << toString(m_solver) << std::endl;										// Solver
+	ss << "Reference matrix : " << std::endl << m_ref->format(MATRIX_FORMAT) << std::endl;		// Reference
+	ss << "Weight : " << std::endl << m_weight->format(MATRIX_FORMAT) << std::endl;				// Print Weight
+	ss << "Bias : " << std::endl << m_bias.transpose().format(MATRIX_FORMAT) << std::endl;		// Print Bias
+	return ss;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool CMatrixClassifierTSLR::isEqual(const CMatrixClassifierTSLR& obj, const double precision) const
+{
+	if (!IMatrixClassifier::isEqual(obj, precision)) { return false; }	// Compare base members
+	if (m_solver != obj.m_solver) { return false; }						// Compare Solver
+	if (!AreEquals(m_ref.get(), obj.m_ref.get(), precision)) { return false; }		// Compare Reference
+	if (!AreEquals(m_weight.get(), obj.m_weight.get(), precision)) { return false; }	// Compare Weight
+	if (!AreEquals(m_bias, obj.m_bias, precision)) { return false; }	// Compare Bias
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+void CMatrixClassifierTSLR::copy(const CMatrixClassifierTSLR& obj)
+{
+	IMatrixClassifier::copy(obj);
+	m_solver         = obj.m_solver;
+	m_regularization = obj.m_regularization;
+	m_maxIterations  = obj.m_maxIterations;
+	m_nbThreads      = obj.m_nbThreads;
+	m_ref            = obj.m_ref;
+	m_refIS          = obj.m_refIS;
+	m_weight         = obj.m_weight;
+	m_bias           = obj.m_bias;
+}
+///-------------------------------------------------------------------------------------------------
+
+}  // namespace Geometry
@@ -26,6 +26,40 @@ bool IMatrixClassifier::classify(const Eigen::MatrixXd& sample, size_t& classId,
 }
 ///-------------------------------------------------------------------------------------------------
 
+///-------------------------------------------------------------------------------------------------
+bool IMatrixClassifier::classify(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances,
+								 Eigen::MatrixXd& probabilities, const EAdaptations adaptation, const std::vector<size_t>& realClassIds, size_t /*nbThreads*/)
+{
+	if (!prepareBatch(samples, classIds, distances, probabilities, adaptation, realClassIds)) { return false; }
+	std::vector<double> distance, probability;
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		const size_t id = realClassIds.empty() ? std::numeric_limits<size_t>::max() : realClassIds[i];
+		if (!classify(samples[i], classIds[i], distance, probability, adaptation, id)) { return false; }
+		for (size_t k = 0; k < m_nbClass; ++k)
+		{
+			distances(i, k)     = distance[k];
+			probabilities(i, k) = probability[k];
+		}
+	}
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
+///-------------------------------------------------------------------------------------------------
+bool IMatrixClassifier::prepareBatch(const std::vector<Eigen::MatrixXd>& samples, std::vector<size_t>& classIds, Eigen::MatrixXd& distances,
+									 Eigen::MatrixXd& probabilities, const EAdaptations adaptation, const std::vector<size_t>& realClassIds) const
+{
+	if (adaptation == EAdaptations::Supervised && realClassIds.size() != samples.size()) { return false; }	// Expected classes needed
+	if (!realClassIds.empty() && realClassIds.size() != samples.size()) { return false; }
+	const Eigen::Index n = Eigen::Index(samples.size()), k = Eigen::Index(m_nbClass);
+	classIds.resize(samples.size());
+	if (distances.rows() != n || distances.cols() != k) { distances.resize(n, k); }
+	if (probabilities.rows() != n || probabilities.cols() != k) { probabilities.resize(n, k); }
+	return true;
+}
+///-------------------------------------------------------------------------------------------------
+
 //***********************
 //***** XML Manager *****
 //***********************
@@ -93,6 +127,7 @@ bool IMatrixClassifier::convertXMLFormatToMatrix(std::stringstream& in, Eigen::M
 bool IMatrixClassifier::saveMatrix(tinyxml2::XMLElement* element, const Eigen::MatrixXd& matrix)
 {
 	element->SetAttribute("size", int(matrix.rows()));	// Set Matrix size NxN
+	if (matrix.cols() != matrix.rows()) { element->SetAttribute("cols", int(matrix.cols())); }	// Set number of cols if Matrix isn't square
 	std::stringstream ss;
 	convertMatrixToXMLFormat(matrix, ss);
 	element->SetText(ss.str().c_str());					// Write Means Value
@@ -104,9 +139,10 @@ bool IMatrixClassifier::saveMatrix(tinyxml2::XMLElement* element, const Eigen::M
 bool IMatrixClassifier::loadMatrix(tinyxml2::XMLElement* element, Eigen::MatrixXd& matrix)
 {
 	const size_t size = element->IntAttribute("size");	// Get number of row/col
-	if (size == 0) { return true; }
+	const size_t cols = element->IntAttribute("cols", int(size));	// Get number of col (NxN if not set)
+	if (size == 0 || cols == 0) { return true; }
 	std::stringstream ss(element->GetText());			// String stream to parse Matrix value
-	convertXMLFormatToMatrix(ss, matrix, size, size);
+	convertXMLFormatToMatrix(ss, matrix, size, cols);
 	return true;
 }
 ///-------------------------------------------------------------------------------------------------
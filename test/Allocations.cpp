@@ -0,0 +1,18 @@
+#include "Allocations.hpp"
+
+namespace Allocations {
+std::atomic<bool> counting{ false };
+std::atomic<size_t> count{ 0 };
+}  // namespace Allocations
+
+#if defined(ALLOCATION_COUNTER)
+//---------------------------------------------------------------------------------------------------
+// malloc is replaced by a counter around the glibc allocator (the only definition of the program)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size)
+{
+	if (Allocations::counting.load(std::memory_order_relaxed)) { Allocations::count.fetch_add(1, std::memory_order_relaxed); }
+	return __libc_malloc(size);
+}
+//---------------------------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,40 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file Allocations.hpp
+/// \brief Allocation counter for google tests (used to check the functions without allocation).
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+/// \remarks The counter replaces <c>malloc</c> in <c>Allocations.cpp</c>, it's only available with the glibc (<c>ALLOCATION_COUNTER</c> is defined).
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(__GLIBC__)
+#define ALLOCATION_COUNTER
+#endif
+
+namespace Allocations {
+extern std::atomic<bool> counting;		///< Define if the allocations are counted.
+extern std::atomic<size_t> count;		///< Number of allocations since the last start.
+
+/// <summary>	Reset the counter and start to count the allocations. </summary>
+inline void Start()
+{
+	count    = 0;
+	counting = true;
+}
+
+/// <summary>	Stop to count the allocations. </summary>
+/// <returns>	The number of allocations since the start. </returns>
+inline size_t Stop()
+{
+	counting = false;
+	return count;
+}
+}  // namespace Allocations
@@ -4,6 +4,7 @@
 #include "test_Basics.hpp"
 #include "test_Covariance.hpp"
 #include "test_Mean.hpp"
+#include "test_Clustering.hpp"
 #include "test_Median.hpp"
 #include "test_Misc.hpp"
 #include "test_Distance.hpp"
@@ -12,6 +13,9 @@
 #include "test_Classifier.hpp"
 #include "test_MatrixClassifier.hpp"
 #include "test_ASR.hpp"
+#include "test_ASRStream.hpp"
+#include "test_ASRBank.hpp"
+#include "test_Potato.hpp"
 // ReSharper restore CppUnusedIncludeDirective
 
 int main(int argc, char** argv)
@@ -19,6 +19,7 @@
 
 #include <geometry/classifier/IMatrixClassifier.hpp>
 #include <geometry/artifacts/CASR.hpp>
+#include <geometry/artifacts/CPotato.hpp>
 
 const std::string SEP = "\n====================\n";
 
@@ -118,3 +119,12 @@ inline std::string ErrorMsg(const std::string& name, const Geometry::CASR& ref,
 	ss << SEP << name << " : " << std::endl << "********** Reference **********\n" << ref << std::endl << "********** Compute **********\n" << calc << SEP;
 	return ss.str();
 }
+
+/// <summary>	Error message for Potato. </summary>
+/// \copydetails ErrorMsg(const std::string&, const size_t, const size_t)
+inline std::string ErrorMsg(const std::string& name, const Geometry::CPotato& ref, const Geometry::CPotato& calc)
+{
+	std::stringstream ss;
+	ss << SEP << name << " : " << std::endl << "********** Reference **********\n" << ref << std::endl << "********** Compute **********\n" << calc << SEP;
+	return ss.str();
+}
@@ -15,9 +15,15 @@
 #include "gtest/gtest.h"
 #include "Init.hpp"
 #include "misc.hpp"
+#include "Allocations.hpp"
 
 #include <geometry/artifacts/CASR.hpp>
 #include <geometry/Basics.hpp>
+#include <geometry/Covariance.hpp>
+#include <geometry/Mean.hpp>
+#include <geometry/Misc.hpp>
+#include <cmath>
+#include <random>
 
 //---------------------------------------------------------------------------------------------------
 class Tests_ASR : public testing::Test
@@ -79,3 +85,209 @@ TEST_F(Tests_ASR, Save)
 	EXPECT_TRUE(ref == calc) << ErrorMsg("ASR Save", ref, calc);
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Process of the ASR with general solvers (mean of the covariances, non symmetric eigen decomposition and complete orthogonal pseudo inverse). </summary>
+static bool ReferenceProcess(const Geometry::CASR& asr, const Eigen::MatrixXd& in, Eigen::MatrixXd& out, Eigen::MatrixXd& r, Eigen::MatrixXd& cov, bool& trivial)
+{
+	out            = in;
+	const size_t n = asr.getChannelNumber(), nSample = in.cols();
+	if (r.size() == 0) { r = Eigen::MatrixXd::Identity(n, n); }
+	Eigen::MatrixXd c;
+	if (!Geometry::CovarianceMatrix(in, c, Geometry::EEstimator::LWF, Geometry::EStandardization::Center)) { return false; }
+	if (cov.size() == 0) { cov = c; }
+	else if (!Geometry::Mean({ cov, c }, cov, asr.getMetric())) { return false; }
+
+	Eigen::MatrixXd eigVector;
+	std::vector<double> eigValues;
+	Geometry::sortedEigenVector(cov, eigVector, eigValues, asr.getMetric());
+	const Eigen::MatrixXd threshold = (asr.getThresholdMatrix() * eigVector).cwiseAbs2();
+	std::vector<bool> keep(n, true);
+	bool isTrivial = true;
+	for (size_t i = 0; i < n; ++i) { if (eigValues[i] >= threshold.col(i).sum()) { keep[i] = isTrivial = false; } }
+
+	if (isTrivial) { r = Eigen::MatrixXd::Identity(n, n); }
+	else
+	{
+		Eigen::MatrixXd tmp = eigVector.transpose() * asr.getMedian();
+		for (size_t i = 0; i < n; ++i) { if (!keep[i]) { tmp.row(i).setZero(); } }
+		const Eigen::MatrixXd newR = asr.getMedian() * tmp.completeOrthogonalDecomposition().pseudoInverse() * eigVector.transpose();
+		if (!trivial)
+		{
+			for (size_t i = 0; i < nSample; ++i)
+			{
+				const double b = (1 - cos(M_PI * (double(i + 1) / double(nSample)))) / 2.0;
+				out.col(i)     = b * newR * in.col(i) + (1 - b) * r * in.col(i);
+			}
+		}
+		r = newR;
+	}
+	trivial = isTrivial;
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASR, Process_General_Solvers)
+{
+	m_dataset = InitDataset::FirstClassDataset();
+	for (const auto& metric : { Geometry::EMetric::Euclidian, Geometry::EMetric::Riemann })
+	{
+		Geometry::CASR calc(metric, m_dataset);
+		calc.setCacheTolerance(0);	// The reconstruction is rebuilt when the eigen vectors change
+		const Geometry::CASR ref = calc;
+		Eigen::MatrixXd r, cov;
+		bool trivial = true;
+
+		std::vector<Eigen::MatrixXd> testset = InitDataset::SecondClassDataset();
+		for (size_t i = 0; i < testset.size(); ++i)
+		{
+			if (i % 2 == 1) { testset[i] *= 3; }		// Alternate clean and artifacted chunks
+			Eigen::MatrixXd result, expected;
+			EXPECT_TRUE(calc.process(testset[i], result)) << "ASR Process fail for sample " << i;
+			EXPECT_TRUE(ReferenceProcess(ref, testset[i], expected, r, cov, trivial)) << "Reference Process fail for sample " << i;
+			EXPECT_TRUE((result - expected).norm() <= 1e-6 * expected.norm()) << ErrorMsg("ASR Process " + toString(metric) + " sample " + std::to_string(i), expected, result);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Chunks of a mix of uniform sources (deterministic), with an amplification of some channels. </summary>
+static std::vector<Eigen::MatrixXd> MixedSources(const size_t nChunk, const Eigen::Index nChannel, const Eigen::Index nSample, const std::vector<double>& gains, std::mt19937& gen)
+{
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	Eigen::MatrixXd mix(nChannel, nChannel);
+	for (Eigen::Index i = 0; i < mix.size(); ++i) { mix(i) = (i % (nChannel + 1) == 0 ? 2.0 : 0.0) + 0.3 * std::sin(double(i)); }	// Fixed mixing matrix
+	std::vector<Eigen::MatrixXd> result(nChunk, Eigen::MatrixXd(nChannel, nSample));
+	for (auto& m : result)
+	{
+		for (Eigen::Index i = 0; i < m.size(); ++i) { m(i) = dist(gen); }
+		m = mix * m;
+		for (size_t i = 0; i < gains.size(); ++i) { m.row(Eigen::Index(i)) *= gains[i]; }
+	}
+	return result;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASR, Process_Cache)
+{
+	std::mt19937 gen(42);
+	const Eigen::Index nChannel = 8, nSample = 32;
+	Geometry::CASR calc(Geometry::EMetric::Euclidian, MixedSources(50, nChannel, nSample, std::vector<double>(nChannel, 2.0), gen));
+	Geometry::CASR ref = calc;
+	ref.setCacheTolerance(0);
+
+	// Sustained artifact on the first channel, then on the first two channels and back to the first channel
+	std::vector<Eigen::MatrixXd> testset = MixedSources(10, nChannel, nSample, { 8 }, gen), phase = MixedSources(10, nChannel, nSample, { 8, 8 }, gen);
+	testset.insert(testset.end(), phase.begin(), phase.end());
+	phase = MixedSources(10, nChannel, nSample, { 8 }, gen);
+	testset.insert(testset.end(), phase.begin(), phase.end());
+	for (size_t i = 0; i < testset.size(); ++i)
+	{
+		Eigen::MatrixXd result, expected;
+		EXPECT_TRUE(calc.process(testset[i], result)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE(ref.process(testset[i], expected)) << "ASR Process fail for sample " << i;
+		// The reused reconstruction differs from the rebuilt one by the drift of the rejected components
+		EXPECT_TRUE((result - expected).norm() <= 0.05 * testset[i].norm()) << ErrorMsg("ASR Process with cache sample " + std::to_string(i), expected, result);
+	}
+	EXPECT_TRUE(calc.getCacheHits() > 0) << "No reconstruction reused";
+	EXPECT_TRUE(calc.getCacheUpdates() > 0) << "No reconstruction updated";
+	EXPECT_TRUE(calc.getCacheHits() + calc.getCacheUpdates() + calc.getCacheMisses() == ref.getCacheMisses())
+		<< "Bad number of reconstructions : " << calc.getCacheHits() << " hits, " << calc.getCacheUpdates() << " updates, " << calc.getCacheMisses() << " misses for " << ref.getCacheMisses() << " reconstructions";
+	EXPECT_TRUE(ref.getCacheHits() == 0 && ref.getCacheUpdates() == 0) << "Reconstruction reused without tolerance";
+
+	// The same artifact chunk again and again : the rejected subspace converges and the reconstruction is reused
+	calc.resetCacheStatistics();
+	for (size_t i = 0; i < 30; ++i)
+	{
+		Eigen::MatrixXd result, expected;
+		EXPECT_TRUE(calc.process(testset[0], result)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE(ref.process(testset[0], expected)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE((result - expected).norm() <= 0.05 * testset[0].norm()) << ErrorMsg("ASR Process with cache sample " + std::to_string(i), expected, result);
+	}
+	EXPECT_TRUE(calc.getCacheHits() >= 20) << "Only " << calc.getCacheHits() << " reconstructions reused for a sustained artifact";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASR, Process_In_Place)
+{
+	std::mt19937 gen(7);
+	const Eigen::Index nChannel = 8, nSample = 32;
+	Geometry::CASR ref(Geometry::EMetric::Riemann, MixedSources(50, nChannel, nSample, std::vector<double>(nChannel, 2.0), gen));
+	Geometry::CASR input = ref, window = ref, windowRef = ref;
+	const std::vector<Eigen::MatrixXd> testset = MixedSources(10, nChannel, 2 * nSample, { 8, 8 }, gen);
+	for (size_t i = 0; i < testset.size(); ++i)
+	{
+		// The output is the input
+		Eigen::MatrixXd expected, result = testset[i];
+		EXPECT_TRUE(ref.process(testset[i], expected)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE(input.process(result, result)) << "ASR Process in place fail for sample " << i;
+		EXPECT_TRUE(isAlmostEqual(expected, result)) << ErrorMsg("ASR Process in place sample " + std::to_string(i), expected, result);
+
+		// The output is the window
+		const Eigen::MatrixXd last = testset[i].rightCols(nSample);
+		result                     = testset[i];
+		EXPECT_TRUE(windowRef.process(testset[i], last, expected)) << "ASR Process with a window fail for sample " << i;
+		EXPECT_TRUE(window.process(result, last, result)) << "ASR Process in the window fail for sample " << i;
+		EXPECT_TRUE(isAlmostEqual(expected, result)) << ErrorMsg("ASR Process in the window sample " + std::to_string(i), expected, result);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASR, Process_Cholesky_Update)
+{
+	std::mt19937 gen(42);
+	const Eigen::Index nChannel = 8, nSample = 32;
+	Geometry::CASR ref(Geometry::EMetric::Riemann, MixedSources(50, nChannel, nSample, std::vector<double>(nChannel, 2.0), gen));
+	Geometry::CASR calc = ref;
+	calc.setCholeskyUpdate(true);
+	EXPECT_TRUE(calc.getCholeskyUpdate() && !ref.getCholeskyUpdate()) << "Bad Cholesky update setting";
+
+	// The Log-Cholesky midpoint is close to the Riemann midpoint, so the rejection is almost the same
+	std::vector<Eigen::MatrixXd> testset = MixedSources(10, nChannel, nSample, { 8 }, gen);
+	const std::vector<Eigen::MatrixXd> phase = MixedSources(10, nChannel, nSample, { 8, 8 }, gen);
+	testset.insert(testset.end(), phase.begin(), phase.end());
+	for (size_t i = 0; i < testset.size(); ++i)
+	{
+		Eigen::MatrixXd result, expected;
+		EXPECT_TRUE(calc.process(testset[i], result)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE(ref.process(testset[i], expected)) << "ASR Process fail for sample " << i;
+		EXPECT_TRUE((result - expected).norm() <= 0.05 * testset[i].norm()) << ErrorMsg("ASR Process with Cholesky update sample " + std::to_string(i), expected, result);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_COUNTER)
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASR, Process_No_Allocation)
+{
+	m_dataset = InitDataset::FirstClassDataset();
+	for (const auto& metric : { Geometry::EMetric::Euclidian, Geometry::EMetric::Riemann })
+	{
+		for (const bool cholesky : { false, true })
+		{
+			Geometry::CASR calc(metric, m_dataset);
+			calc.setCholeskyUpdate(cholesky);
+			std::vector<Eigen::MatrixXd> testset = InitDataset::SecondClassDataset();
+			Eigen::MatrixXd result;
+
+			// The first chunk can resize the buffers
+			EXPECT_TRUE(calc.process(testset[0], result)) << "ASR Process fail for the first sample";
+			for (size_t i = 1; i < testset.size(); ++i)
+			{
+				if (i % 2 == 1) { testset[i] *= 3; }		// Alternate clean and artifacted chunks
+				Allocations::Start();
+				const bool valid           = calc.process(testset[i], result);
+				const size_t nbAllocations = Allocations::Stop();
+				EXPECT_TRUE(valid) << "ASR Process fail for sample " << i;
+				EXPECT_TRUE(nbAllocations == 0) << "ASR Process " << toString(metric) << (cholesky ? " (Cholesky update)" : "") << " : " << nbAllocations << " allocations for the sample [" << i << "]";
+			}
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+#endif
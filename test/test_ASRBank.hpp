@@ -0,0 +1,150 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file test_ASRBank.hpp
+/// \brief Tests for Artifact Subspace Reconstruction on several streams.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "Init.hpp"
+#include "misc.hpp"
+
+#include <geometry/artifacts/CASRBank.hpp>
+
+//---------------------------------------------------------------------------------------------------
+class Tests_ASRBank : public testing::Test
+{
+protected:
+	static const size_t N_STREAM = 8, N_TICK = 4;
+	Geometry::CASR m_asr;
+	std::vector<std::vector<Eigen::MatrixXd>> m_ticks;	// Chunk of each stream for each tick
+
+	void SetUp() override
+	{
+		m_asr.setMetric(Geometry::EMetric::Euclidian);
+		m_asr.train(InitDataset::FirstClassDataset());
+		m_asr.setCacheTolerance(0);
+
+		// Each stream has its own artifacts
+		const std::vector<Eigen::MatrixXd> testset = InitDataset::SecondClassDataset();
+		m_ticks.resize(N_TICK, std::vector<Eigen::MatrixXd>(N_STREAM));
+		for (size_t t = 0; t < N_TICK; ++t)
+		{
+			for (size_t k = 0; k < N_STREAM; ++k) { m_ticks[t][k] = double(1 + k % 3) * testset[(t + k) % testset.size()]; }
+		}
+	}
+};
+
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRBank, Initialize)
+{
+	Geometry::CASRBank calc;
+	EXPECT_FALSE(calc.initialize(Geometry::CASR(), N_STREAM)) << "Initialize without trained ASR";
+	EXPECT_FALSE(calc.initialize(m_asr, 0)) << "Initialize without stream";
+	EXPECT_TRUE(calc.initialize(m_asr, N_STREAM));
+	EXPECT_EQ(calc.getStreamNumber(), size_t(N_STREAM));
+	EXPECT_EQ(calc.getChannelNumber(), m_asr.getChannelNumber());
+	EXPECT_TRUE(calc.getCovariance(0).size() == 0) << "Covariance before the first chunk";
+
+	std::vector<Eigen::MatrixXd> out;
+	EXPECT_FALSE(calc.process(std::vector<Eigen::MatrixXd>(N_STREAM - 1, m_ticks[0][0]), out)) << "Process with a wrong number of streams";
+	Eigen::MatrixXd packed;
+	EXPECT_FALSE(calc.process(m_ticks[0][0], packed)) << "Process with a wrong number of rows";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRBank, Process)
+{
+	// Each stream of the bank is an independent ASR with the same calibration
+	std::vector<Geometry::CASR> refs(N_STREAM, m_asr);
+	Geometry::CASRBank single(m_asr, N_STREAM), parallel(m_asr, N_STREAM);
+	for (size_t t = 0; t < N_TICK; ++t)
+	{
+		std::vector<Eigen::MatrixXd> result1, result2;
+		EXPECT_TRUE(single.process(m_ticks[t], result1, 1)) << "ASR Bank Process fail for tick " << t;
+		EXPECT_TRUE(parallel.process(m_ticks[t], result2, 3)) << "ASR Bank Process fail for tick " << t;
+		for (size_t k = 0; k < N_STREAM; ++k)
+		{
+			Eigen::MatrixXd expected;
+			EXPECT_TRUE(refs[k].process(m_ticks[t][k], expected));
+			const std::string title = "ASR Bank tick " + std::to_string(t) + " stream " + std::to_string(k);
+			EXPECT_TRUE(isAlmostEqual(expected, result1[k])) << ErrorMsg(title, expected, result1[k]);
+			EXPECT_TRUE(isAlmostEqual(expected, result2[k])) << ErrorMsg(title + " in parallel", expected, result2[k]);
+		}
+	}
+	for (size_t k = 0; k < N_STREAM; ++k)
+	{
+		const Geometry::CASR& ref = refs[k];
+		EXPECT_TRUE(isAlmostEqual(ref.getThresholdMatrix(), parallel.getCalibration().getThresholdMatrix()));
+		EXPECT_TRUE(isAlmostEqual(single.getCovariance(k), parallel.getCovariance(k))) << ErrorMsg("ASR Bank covariance", single.getCovariance(k), parallel.getCovariance(k));
+		EXPECT_TRUE(isAlmostEqual(single.getReconstruction(k), parallel.getReconstruction(k))) << ErrorMsg("ASR Bank reconstruction", single.getReconstruction(k), parallel.getReconstruction(k));
+	}
+
+	// Reset restarts all the streams
+	parallel.reset();
+	std::vector<Eigen::MatrixXd> result, expected;
+	EXPECT_TRUE(parallel.process(m_ticks[0], result));
+	EXPECT_TRUE(Geometry::CASRBank(m_asr, N_STREAM).process(m_ticks[0], expected));
+	for (size_t k = 0; k < N_STREAM; ++k) { EXPECT_TRUE(isAlmostEqual(expected[k], result[k])) << ErrorMsg("ASR Bank after reset", expected[k], result[k]); }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRBank, Process_Cache)
+{
+	// Each stream keeps its reconstruction cache : same output as independent ASR with the cache (the same chunks at each tick reuse the cache)
+	Geometry::CASR asr = m_asr;
+	asr.setCacheTolerance(0.1);
+	std::vector<Geometry::CASR> refs(N_STREAM, asr);
+	Geometry::CASRBank single(asr, N_STREAM), parallel(asr, N_STREAM);
+	EXPECT_TRUE(isAlmostEqual(asr.getCacheTolerance(), single.getCalibration().getCacheTolerance())) << "The bank must keep the cache tolerance of the calibration";
+	for (size_t t = 0; t < N_TICK; ++t)
+	{
+		std::vector<Eigen::MatrixXd> result1, result2;
+		EXPECT_TRUE(single.process(m_ticks[0], result1, 1)) << "ASR Bank Process fail for tick " << t;
+		EXPECT_TRUE(parallel.process(m_ticks[0], result2, 3)) << "ASR Bank Process fail for tick " << t;
+		for (size_t k = 0; k < N_STREAM; ++k)
+		{
+			Eigen::MatrixXd expected;
+			EXPECT_TRUE(refs[k].process(m_ticks[0][k], expected));
+			const std::string title = "ASR Bank with cache tick " + std::to_string(t) + " stream " + std::to_string(k);
+			EXPECT_TRUE(isAlmostEqual(expected, result1[k])) << ErrorMsg(title, expected, result1[k]);
+			EXPECT_TRUE(isAlmostEqual(expected, result2[k])) << ErrorMsg(title + " in parallel", expected, result2[k]);
+		}
+	}
+	size_t hits = 0;
+	for (const auto& ref : refs) { hits += ref.getCacheHits(); }
+	EXPECT_GT(hits, size_t(0)) << "The chunks must reuse the cache";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRBank, Process_Packed)
+{
+	// The streams stacked by rows give the same output as the vector of streams
+	const Eigen::Index n = Eigen::Index(m_asr.getChannelNumber());
+	Geometry::CASRBank ref(m_asr, N_STREAM), calc(m_asr, N_STREAM);
+	for (size_t t = 0; t < N_TICK; ++t)
+	{
+		Eigen::MatrixXd packed(n * Eigen::Index(N_STREAM), m_ticks[t][0].cols()), result;
+		for (size_t k = 0; k < N_STREAM; ++k) { packed.middleRows(Eigen::Index(k) * n, n) = m_ticks[t][k]; }
+		std::vector<Eigen::MatrixXd> expected;
+		EXPECT_TRUE(ref.process(m_ticks[t], expected));
+		EXPECT_TRUE(calc.process(packed, result, 3)) << "ASR Bank Process fail for tick " << t;
+		for (size_t k = 0; k < N_STREAM; ++k)
+		{
+			EXPECT_TRUE(isAlmostEqual(expected[k], result.middleRows(Eigen::Index(k) * n, n)))
+				<< ErrorMsg("ASR Bank packed tick " + std::to_string(t) + " stream " + std::to_string(k), expected[k], result.middleRows(Eigen::Index(k) * n, n));
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,265 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file test_ASRStream.hpp
+/// \brief Tests for Artifact Subspace Reconstruction on a stream and for the ring buffer.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "Init.hpp"
+#include "misc.hpp"
+
+#include <geometry/artifacts/CASRStream.hpp>
+#include <geometry/artifacts/CRingBuffer.hpp>
+#include <random>
+#include <thread>
+
+//---------------------------------------------------------------------------------------------------
+class Tests_ASRStream : public testing::Test
+{
+protected:
+	Geometry::CASR m_asr;
+	Eigen::MatrixXd m_signal;
+
+	void SetUp() override
+	{
+		m_asr.setMetric(Geometry::EMetric::Euclidian);
+		m_asr.train(InitDataset::FirstClassDataset());
+
+		// Signal : the second class with artifacts, three times
+		const std::vector<Eigen::MatrixXd> testset = InitDataset::SecondClassDataset();
+		const Eigen::Index nSample                 = testset[0].cols();
+		m_signal.resize(testset[0].rows(), Eigen::Index(3 * testset.size()) * nSample);
+		for (size_t i = 0; i < 3 * testset.size(); ++i) { m_signal.middleCols(Eigen::Index(i) * nSample, nSample) = 2 * testset[i % testset.size()]; }
+	}
+};
+
+/// <summary>	Sizes of packets between 1 and max samples until the size of the signal. </summary>
+static std::vector<Eigen::Index> RandomPackets(const Eigen::Index size, const int max, std::mt19937& gen)
+{
+	std::uniform_int_distribution<int> dist(1, max);
+	std::vector<Eigen::Index> packets;
+	for (Eigen::Index n = 0; n < size;)
+	{
+		packets.push_back(std::min(Eigen::Index(dist(gen)), size - n));
+		n += packets.back();
+	}
+	return packets;
+}
+
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, RingBuffer)
+{
+	Geometry::CRingBuffer buffer(2, 5);
+	EXPECT_TRUE(buffer.isLockFree());
+	Eigen::MatrixXd in(2, 3), out(2, 2), wrong(3, 1);
+	in << 1, 2, 3,
+			4, 5, 6;
+	EXPECT_TRUE(buffer.push(in));
+	EXPECT_FALSE(buffer.push(in)) << "Push in a full buffer";
+	EXPECT_FALSE(buffer.push(wrong)) << "Push with a wrong number of channels";
+	EXPECT_EQ(buffer.size(), size_t(3));
+	EXPECT_TRUE(buffer.pop(out));
+	EXPECT_TRUE(isAlmostEqual(in.leftCols(2), out)) << ErrorMsg("Ring buffer pop", in.leftCols(2), out);
+
+	// The samples go round the end of the buffer
+	EXPECT_TRUE(buffer.push(2 * in));
+	EXPECT_EQ(buffer.size(), size_t(4));
+	Eigen::MatrixXd all(2, 4), ref(2, 4);
+	ref << 3, 2, 4, 6,
+			6, 8, 10, 12;
+	Eigen::MatrixXd tooMuch(2, 5);
+	EXPECT_FALSE(buffer.pop(tooMuch)) << "Pop more than the size";
+	EXPECT_TRUE(buffer.pop(all));
+	EXPECT_TRUE(isAlmostEqual(ref, all)) << ErrorMsg("Ring buffer pop around the end", ref, all);
+	EXPECT_EQ(buffer.size(), size_t(0));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, RingBuffer_Threads)
+{
+	const Eigen::Index size = 5000;
+	Eigen::MatrixXd ref(2, size);
+	for (Eigen::Index i = 0; i < size; ++i) { ref.col(i) << double(i), -double(i); }
+	std::mt19937 gen(42);
+	const std::vector<Eigen::Index> pushes = RandomPackets(size, 64, gen), pops = RandomPackets(size, 64, gen);
+
+	Geometry::CRingBuffer buffer(2, 128);	// The largest push and the largest pop must fit together in the buffer
+	std::thread producer([&]()
+	{
+		Eigen::Index n = 0;
+		for (const auto& packet : pushes)
+		{
+			while (!buffer.push(ref.middleCols(n, packet))) { std::this_thread::yield(); }	// Wait the consumer if the buffer is full
+			n += packet;
+		}
+	});
+
+	Eigen::MatrixXd result(2, size);
+	Eigen::Index n = 0;
+	for (const auto& packet : pops)
+	{
+		while (!buffer.pop(result.middleCols(n, packet))) { std::this_thread::yield(); }	// Wait the producer if the buffer hasn't enough samples
+		n += packet;
+	}
+	producer.join();
+	EXPECT_TRUE(isAlmostEqual(ref, result)) << "The samples are lost or disordered between the threads";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, Initialize)
+{
+	Geometry::CASRStream calc;
+	EXPECT_FALSE(calc.initialize(Geometry::CASR(), 10, 5)) << "Initialize without trained ASR";
+	EXPECT_FALSE(calc.initialize(m_asr, 1, 1)) << "Initialize with a window of one sample";
+	EXPECT_FALSE(calc.initialize(m_asr, 10, 0)) << "Initialize with an empty step";
+	EXPECT_FALSE(calc.initialize(m_asr, 10, 11)) << "Initialize with a step larger than the window";
+	EXPECT_FALSE(calc.initialize(m_asr, 10, 5, 4)) << "Initialize with a buffer smaller than the step";
+	EXPECT_TRUE(calc.initialize(m_asr, 10, 5));
+	EXPECT_EQ(calc.getLatency(), size_t(4));
+	EXPECT_EQ(calc.getCapacity(), size_t(40));
+
+	Eigen::MatrixXd out;
+	EXPECT_FALSE(calc.process(Eigen::MatrixXd::Zero(3, 41), out)) << "Process a packet larger than the buffer";
+	EXPECT_FALSE(calc.process(Eigen::MatrixXd::Zero(2, 5), out)) << "Process with a wrong number of channels";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, Process_Chunks)
+{
+	// With a window of one step, the stream is the ASR on each chunk with the delay of the step
+	const Eigen::Index step = 10, latency = step - 1, size = m_signal.cols();
+	Geometry::CASR asr = m_asr;
+	Eigen::MatrixXd expected(m_signal.rows(), size), chunk;
+	for (Eigen::Index i = 0; i < size; i += step)
+	{
+		EXPECT_TRUE(asr.process(m_signal.middleCols(i, step), chunk));
+		expected.middleCols(i, step) = chunk;
+	}
+
+	Geometry::CASRStream calc(m_asr, step, step);
+	Eigen::MatrixXd result(m_signal.rows(), size), packet;
+	for (Eigen::Index i = 0; i < size; i += 6)
+	{
+		const Eigen::Index n = std::min(Eigen::Index(6), size - i);
+		EXPECT_TRUE(calc.process(m_signal.middleCols(i, n), packet));
+		ASSERT_EQ(packet.cols(), n);
+		result.middleCols(i, n) = packet;
+	}
+	EXPECT_TRUE(result.leftCols(latency).isZero()) << "The delay of the output isn't zero";
+	EXPECT_TRUE(isAlmostEqual(expected.leftCols(size - latency), result.rightCols(size - latency)))
+		<< ErrorMsg("ASR Stream with one chunk by step", expected.leftCols(size - latency), result.rightCols(size - latency));
+	EXPECT_FALSE(isAlmostEqual(m_signal.leftCols(size - latency), result.rightCols(size - latency))) << "The stream wasn't reconstructed";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, Process_Packets)
+{
+	// The output doesn't depend on the size of the packets
+	const Eigen::Index window = 20, step = 5, size = m_signal.cols();
+	Geometry::CASRStream ref(m_asr, window, step), calc(m_asr, window, step);
+	Eigen::MatrixXd expected(m_signal.rows(), size), result(m_signal.rows(), size), packet;
+	for (Eigen::Index i = 0; i < size; ++i)
+	{
+		EXPECT_TRUE(ref.process(m_signal.col(i), packet));
+		expected.col(i) = packet;
+	}
+
+	std::mt19937 gen(42);
+	Eigen::Index n = 0;
+	for (const auto& count : RandomPackets(size, 25, gen))
+	{
+		EXPECT_TRUE(calc.process(m_signal.middleCols(n, count), packet));
+		result.middleCols(n, count) = packet;
+		n += count;
+	}
+	EXPECT_TRUE(isAlmostEqual(expected, result)) << ErrorMsg("ASR Stream with irregular packets", expected, result);
+
+	// The samples of the first window are only delayed
+	const Eigen::Index latency = Eigen::Index(calc.getLatency()), warm = window - step;
+	EXPECT_TRUE(isAlmostEqual(m_signal.leftCols(warm), result.middleCols(latency, warm))) << ErrorMsg("ASR Stream first window", m_signal.leftCols(warm), result.middleCols(latency, warm));
+
+	// Reset restarts the stream
+	calc.reset();
+	EXPECT_TRUE(calc.process(m_signal.leftCols(window), packet));
+	EXPECT_TRUE(isAlmostEqual(expected.leftCols(window), packet)) << ErrorMsg("ASR Stream after reset", expected.leftCols(window), packet);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, Output_Full)
+{
+	// Packets pushed before process fill the output buffer : the steps wait in the input buffer and no sample is lost
+	const Eigen::Index window = 10, step = 5, size = 80;
+	Geometry::CASRStream ref(m_asr, window, step, size_t(size)), calc(m_asr, window, step);
+	Eigen::MatrixXd expected, result(m_signal.rows(), size + step - 1), packet;
+	EXPECT_TRUE(ref.process(m_signal.leftCols(size), expected));
+
+	EXPECT_TRUE(calc.push(m_signal.leftCols(35)));
+	EXPECT_TRUE(calc.process(m_signal.middleCols(35, step), packet));
+	result.leftCols(step) = packet;
+	EXPECT_TRUE(calc.push(m_signal.middleCols(40, 35)));
+	EXPECT_TRUE(calc.process(m_signal.middleCols(75, step), packet));	// The output buffer can receive only one of the eight steps
+	result.middleCols(step, step) = packet;
+	EXPECT_FALSE(calc.push(m_signal.leftCols(step + 1))) << "The steps waiting in the input buffer must keep it full";
+
+	Eigen::Index n = 2 * step;
+	while (n < size)
+	{
+		EXPECT_TRUE(calc.pull(packet));
+		ASSERT_LE(n + packet.cols(), result.cols());
+		ASSERT_GT(packet.cols(), 0);
+		result.middleCols(n, packet.cols()) = packet;
+		n += packet.cols();
+	}
+	EXPECT_TRUE(isAlmostEqual(expected, result.leftCols(size))) << ErrorMsg("ASR Stream with a full output buffer", expected, result.leftCols(size));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_ASRStream, Pull_Threads)
+{
+	// The acquisition and the cleaning in two threads give the same output as one thread
+	const Eigen::Index window = 20, step = 5, size = m_signal.cols();
+	Geometry::CASRStream ref(m_asr, window, step, size_t(size)), calc(m_asr, window, step, 64);
+	Eigen::MatrixXd expected;
+	EXPECT_TRUE(ref.process(m_signal, expected));
+
+	std::mt19937 gen(42);
+	const std::vector<Eigen::Index> packets = RandomPackets(size, 64 - step + 1, gen);	// The largest packet and an incomplete step must fit together in the buffer
+	std::thread producer([&]()
+	{
+		Eigen::Index n = 0;
+		for (const auto& packet : packets)
+		{
+			while (!calc.push(m_signal.middleCols(n, packet))) { std::this_thread::yield(); }	// Wait the cleaning if the buffer is full
+			n += packet;
+		}
+	});
+
+	Eigen::MatrixXd result(m_signal.rows(), size), packet;
+	Eigen::Index n = 0;
+	while (n < size)
+	{
+		EXPECT_TRUE(calc.pull(packet));
+		const Eigen::Index count = std::min(packet.cols(), size - n);
+		result.middleCols(n, count) = packet.leftCols(count);
+		n += count;
+		if (packet.cols() == 0) { std::this_thread::yield(); }
+	}
+	producer.join();
+	EXPECT_TRUE(isAlmostEqual(expected, result)) << ErrorMsg("ASR Stream in two threads", expected, result);
+}
+//---------------------------------------------------------------------------------------------------
@@ -148,3 +148,84 @@ TEST_F(Tests_Basics, Validation)
 	EXPECT_TRUE(vs.size() == 4 && vs[0] == "0" && vs[1] == "1" && vs[2] == "2" && vs[3] == "3.a") << vs.size() << " " << vs[0] << " " << vs[1] << " " << vs[2] << " " << vs[3] << std::endl;
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Basics, Self_Adjoint_Eigen_Values)
+{
+	// Symmetric matrices with known spectrum : random, ill-conditioned, repeated, clustered, semi-definite and diagonal
+	const Eigen::Index n = 12;
+	std::vector<Eigen::VectorXd> spectra;
+	Eigen::VectorXd spectrum(n);
+	spectrum.setRandom();
+	spectra.push_back(spectrum);
+	for (Eigen::Index i = 0; i < n; ++i) { spectrum[i] = std::pow(10.0, -12.0 * double(i) / double(n - 1)); }
+	spectra.push_back(spectrum);
+	spectrum << 1, 1, 1, 1, 2, 2, 2, 5, 5, 5, 5, 5;
+	spectra.push_back(spectrum);
+	for (Eigen::Index i = 0; i < n; ++i) { spectrum[i] = 1 + 1e-10 * double(i); }
+	spectra.push_back(spectrum);
+	spectrum << 0, 0, 0, 1e-14, 3, 3, 4, 4, 7, 1e3, 1e3, 1e6;
+	spectra.push_back(spectrum);
+	spectra.push_back(Eigen::VectorXd::Ones(n));
+
+	const Eigen::Index nbMatrices = Eigen::Index(2 * spectra.size());
+	Eigen::MatrixXd matrices(n, n * nbMatrices), values, buffer;
+	std::vector<Eigen::MatrixXd> refs(2 * spectra.size());
+	for (Eigen::Index k = 0; k < nbMatrices; ++k)
+	{
+		const Eigen::VectorXd& s = spectra[size_t(k) % spectra.size()];
+		if (k < Eigen::Index(spectra.size())) { refs[size_t(k)] = s.asDiagonal(); }	// Already diagonal
+		else																				// Random rotation
+		{
+			const Eigen::MatrixXd q = Eigen::HouseholderQR<Eigen::MatrixXd>(Eigen::MatrixXd::Random(n, n)).householderQ();
+			refs[size_t(k)]         = q * s.asDiagonal() * q.transpose();
+		}
+		matrices.middleCols(k * n, n) = refs[size_t(k)];
+	}
+
+	EXPECT_TRUE(Geometry::SelfAdjointEigenValues(matrices, values, buffer)) << "Error during Self Adjoint Eigen Values";
+	Eigen::VectorXd single, singleBuffer;
+	Eigen::MatrixXd vectors;
+	for (Eigen::Index k = 0; k < nbMatrices; ++k)
+	{
+		const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(refs[size_t(k)], Eigen::EigenvaluesOnly);
+		const Eigen::VectorXd& expected = solver.eigenvalues();
+		const double tolerance          = 1e-12 * expected.cwiseAbs().maxCoeff();	// Backward stable, the error is relative to the norm of the matrix
+		const std::string title         = "Self Adjoint Eigen Values matrix [" + std::to_string(k) + "]";
+		EXPECT_TRUE((values.col(k) - expected).cwiseAbs().maxCoeff() <= tolerance) << ErrorMsg(title, expected, values.col(k));
+
+		EXPECT_TRUE(Geometry::SelfAdjointEigen(refs[size_t(k)], single, vectors, singleBuffer, false)) << "Error during Self Adjoint Eigen";
+		EXPECT_TRUE((single - expected).cwiseAbs().maxCoeff() <= tolerance) << ErrorMsg(title + " without vectors", expected, single);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Basics, Thread_Pool)
+{
+	Geometry::CThreadPool pool;
+	for (size_t loop = 0; loop < 50; ++loop)
+	{
+		// Each index is made once by a job of the split of ParallelFor, the threads are kept between the loops
+		const size_t n = 1 + loop % 7, nbThreads = 1 + loop % 4, nbJobs = Geometry::ParallelThreadCount(n, nbThreads);
+		std::vector<size_t> count(n, 0), jobs(n, 0);
+		pool.run(n, [&](const size_t begin, const size_t end, const size_t job)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				++count[i];
+				jobs[i] = job;
+			}
+		}, nbThreads);
+		for (size_t i = 0; i < n; ++i)
+		{
+			EXPECT_TRUE(count[i] == 1) << "Thread Pool loop [" << loop << "] : index " << i << " made " << count[i] << " times";
+			EXPECT_TRUE(jobs[i] < nbJobs && (i == 0 || jobs[i] >= jobs[i - 1])) << "Thread Pool loop [" << loop << "] : bad job " << jobs[i] << " for the index " << i;
+		}
+		EXPECT_TRUE(pool.size() <= 3) << "Thread Pool loop [" << loop << "] : " << pool.size() << " threads for 4 jobs at most";
+	}
+	EXPECT_TRUE(pool.size() == 3) << "Thread Pool : " << pool.size() << " threads for 4 jobs";
+	const Geometry::CThreadPool copy = pool;
+	EXPECT_TRUE(copy.size() == 0) << "Thread Pool : " << copy.size() << " threads copied";
+}
+//---------------------------------------------------------------------------------------------------
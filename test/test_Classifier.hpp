@@ -51,3 +51,58 @@ TEST_F(Tests_Classifier, FgDACompute)
 	EXPECT_TRUE(isAlmostEqual(ref, calc)) << ErrorMsg("FgDA", ref, calc);
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Classifier, FgDACompute_LowRank)
+{
+	const Eigen::MatrixXd ref = InitClassif::FgDACompute::Reference();
+	Eigen::MatrixXd u, v;
+	Geometry::FgDACompute(m_dataSet, u, v);
+	EXPECT_TRUE(u.rows() == NB_FEATURES && v.rows() == NB_FEATURES && u.cols() == v.cols() && u.cols() < NB_CLASS + 1) << "Bad factors size";
+	const Eigen::MatrixXd calc = u * v.transpose();
+	EXPECT_TRUE(isAlmostEqual(ref, calc)) << ErrorMsg("FgDA Low Rank", ref, calc);
+
+	Eigen::MatrixXd fu, fv;
+	Geometry::FgDAFactorize(ref, fu, fv);
+	const Eigen::MatrixXd factorized = fu * fv.transpose();
+	EXPECT_TRUE(fu.cols() == u.cols()) << "Bad rank of factorized weight";
+	EXPECT_TRUE(isAlmostEqual(ref, factorized)) << ErrorMsg("FgDA Factorize", ref, factorized);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Classifier, FgDAApply_LowRank)
+{
+	Eigen::MatrixXd weight, u, v;
+	Geometry::FgDACompute(m_dataSet, weight);
+	Geometry::FgDACompute(m_dataSet, u, v);
+	for (const auto& samples : m_dataSet)
+	{
+		for (const auto& sample : samples)
+		{
+			Eigen::RowVectorXd ref, calc;
+			EXPECT_TRUE(Geometry::FgDAApply(sample, ref, weight));
+			EXPECT_TRUE(Geometry::FgDAApply(sample, calc, u, v));
+			EXPECT_TRUE(isAlmostEqual(ref, calc)) << ErrorMsg("FgDA Apply Low Rank", ref, calc);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Classifier, LSQR_Statistics)
+{
+	const Eigen::MatrixXd ref = InitClassif::LSQR::Reference();
+	std::vector<Geometry::CClassStatistics> statistics(m_dataSet.size());
+	for (size_t k = 0; k < m_dataSet.size(); ++k) { EXPECT_TRUE(statistics[k].add(m_dataSet[k])); }
+	Eigen::MatrixXd calc;
+	EXPECT_TRUE(Geometry::LSQR(statistics, calc));
+	EXPECT_TRUE(isAlmostEqual(ref, calc)) << ErrorMsg("LSQR Statistics", ref, calc);
+
+	Eigen::MatrixXd u, v, uRef, vRef;
+	EXPECT_TRUE(Geometry::FgDACompute(statistics, u, v));
+	Geometry::FgDACompute(m_dataSet, uRef, vRef);
+	const Eigen::MatrixXd weightRef = uRef * vRef.transpose(), weight = u * v.transpose();
+	EXPECT_TRUE(isAlmostEqual(weightRef, weight)) << ErrorMsg("FgDA Statistics", weightRef, weight);
+}
+//---------------------------------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file test_Clustering.hpp
+/// \brief Tests for Riemannian Geometry Utils : Clustering
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "misc.hpp"
+#include "Init.hpp"
+
+#include <geometry/Clustering.hpp>
+#include <geometry/Distance.hpp>
+#include <geometry/Mean.hpp>
+#include <geometry/classifier/CMatrixClassifierMDM.hpp>
+
+//---------------------------------------------------------------------------------------------------
+class Tests_Clustering : public testing::Test
+{
+protected:
+	std::vector<Eigen::MatrixXd> m_dataSet;
+
+	void SetUp() override { m_dataSet = Geometry::Vector2DTo1D(InitCovariance::LWF::Reference()); }
+};
+
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Clustering, BadInput)
+{
+	std::vector<Eigen::MatrixXd> centroids;
+	std::vector<size_t> labels;
+	EXPECT_FALSE(Geometry::KMeans(std::vector<Eigen::MatrixXd>(), 1, centroids, labels));
+	EXPECT_FALSE(Geometry::KMeans(m_dataSet, 0, centroids, labels));
+	EXPECT_FALSE(Geometry::KMeans(m_dataSet, m_dataSet.size() + 1, centroids, labels));
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Clustering, KMeans_Groups)
+{
+	// Three groups far from each other on the manifold
+	const std::vector<double> scales{ 1, 100, 10000 };
+	std::vector<Eigen::MatrixXd> set;
+	for (const auto& s : scales) { for (const auto& m : m_dataSet) { set.push_back(s * m); } }
+
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::LogDet })
+	{
+		std::vector<Eigen::MatrixXd> centroids;
+		std::vector<size_t> labels;
+		EXPECT_TRUE(Geometry::KMeans(set, scales.size(), centroids, labels, metric, 100, 42, 2)) << "Error during KMeans " << toString(metric);
+		ASSERT_EQ(centroids.size(), scales.size());
+		ASSERT_EQ(labels.size(), set.size());
+		for (size_t g = 0; g < scales.size(); ++g)
+		{
+			const size_t label = labels[g * m_dataSet.size()];
+			for (size_t i = 0; i < m_dataSet.size(); ++i) { EXPECT_EQ(labels[g * m_dataSet.size() + i], label) << "Group " << g << " split with " << toString(metric); }
+			Eigen::MatrixXd ref;
+			EXPECT_TRUE(Geometry::Mean(std::vector<Eigen::MatrixXd>(set.begin() + g * m_dataSet.size(), set.begin() + (g + 1) * m_dataSet.size()), ref, metric));
+			// The warm started mean stops at the tolerance of the iterative procedure around the same point (affine invariant distance to be independent of the scale)
+			EXPECT_LT(Geometry::Distance(ref, centroids[label], Geometry::EMetric::Riemann), 1e-3) << ErrorMsg("Centroid of group " + std::to_string(g) + " with " + toString(metric), ref, centroids[label]);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Clustering, KMeans_One_Cluster)
+{
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::Euclidian, Geometry::EMetric::Wasserstein })
+	{
+		std::vector<Eigen::MatrixXd> centroids;
+		std::vector<size_t> labels;
+		Eigen::MatrixXd ref;
+		EXPECT_TRUE(Geometry::Mean(m_dataSet, ref, metric));
+		EXPECT_TRUE(Geometry::KMeans(m_dataSet, 1, centroids, labels, metric)) << "Error during KMeans " << toString(metric);
+		ASSERT_EQ(centroids.size(), 1);
+		EXPECT_LT(Geometry::Distance(ref, centroids[0], Geometry::EMetric::Riemann), 1e-3) << ErrorMsg("Mean with " + toString(metric), ref, centroids[0]);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Clustering, KMeans_Deterministic)
+{
+	std::vector<Eigen::MatrixXd> c1, c2;
+	std::vector<size_t> l1, l2;
+	EXPECT_TRUE(Geometry::KMeans(m_dataSet, 3, c1, l1, Geometry::EMetric::Riemann, 100, 7, 1));
+	EXPECT_TRUE(Geometry::KMeans(m_dataSet, 3, c2, l2, Geometry::EMetric::Riemann, 100, 7, 4));
+	EXPECT_EQ(l1, l2) << "The labels depend on the number of threads";
+	for (size_t k = 0; k < c1.size(); ++k) { EXPECT_TRUE(isAlmostEqual(c1[k], c2[k])) << ErrorMsg("Centroid " + std::to_string(k), c1[k], c2[k]); }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Clustering, KMeans_Prototypes_MDM)
+{
+	const std::vector<std::vector<Eigen::MatrixXd>> dataset = InitCovariance::LWF::Reference();
+	std::vector<Eigen::MatrixXd> means;
+	std::vector<size_t> classes;
+	EXPECT_TRUE(Geometry::KMeansPrototypes(dataset, 2, means, classes, Geometry::EMetric::Riemann, 100, 0, 2));
+	ASSERT_EQ(means.size(), 2 * dataset.size());
+	ASSERT_EQ(classes.size(), means.size());
+	for (size_t i = 0; i < classes.size(); ++i) { EXPECT_EQ(classes[i], i / 2); }
+
+	Geometry::CMatrixClassifierMDM mdm(means.size(), Geometry::EMetric::Riemann);
+	mdm.setMeans(means);
+	size_t correct = 0, total = 0;
+	for (size_t k = 0; k < dataset.size(); ++k)
+	{
+		for (const auto& trial : dataset[k])
+		{
+			size_t prototype;
+			std::vector<double> distance, probability;
+			EXPECT_TRUE(mdm.classify(trial, prototype, distance, probability));
+			ASSERT_LT(prototype, classes.size());
+			if (classes[prototype] == k) { correct++; }
+			total++;
+		}
+	}
+	EXPECT_GT(2 * correct, total) << "Prototypes classify worse than chance on the training set";
+}
+//---------------------------------------------------------------------------------------------------
@@ -117,3 +117,56 @@ TEST_F(Tests_Distances, Identity)
 	}
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Distances, Factorized)
+{
+	const std::vector<Geometry::EMetric> metrics = { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Wasserstein };
+	const std::vector<std::vector<double>> refs  = { InitDistance::Riemann::Reference(), InitDistance::LogEuclidian::Reference(), InitDistance::Wasserstein::Reference() };
+	const std::vector<Eigen::MatrixXd> means     = { InitMeans::Riemann::Reference(), InitMeans::LogEuclidian::Reference(), InitMeans::Wasserstein::Reference() };
+	for (size_t m = 0; m < metrics.size(); ++m)
+	{
+		const std::string title = "Distance Factorized " + toString(metrics[m]);
+		Eigen::MatrixXd meanFactor, sampleFactor;
+		EXPECT_TRUE(Geometry::DistanceReferenceFactor(means[m], meanFactor, metrics[m])) << title + " Reference Factor";
+		for (size_t i = 0; i < m_dataSet.size(); ++i)
+		{
+			EXPECT_TRUE(Geometry::DistanceSampleFactor(m_dataSet[i], sampleFactor, metrics[m])) << title + " Sample Factor";
+			const double calc = Geometry::DistanceFactorized(m_dataSet[i], sampleFactor, means[m], meanFactor, metrics[m]);
+			EXPECT_TRUE(isAlmostEqual(refs[m][i], calc)) << ErrorMsg(title + " Sample [" + std::to_string(i) + "]", refs[m][i], calc);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Distances, DistanceMatrix)
+{
+	// Set larger than one tile with the scaled trials
+	std::vector<Eigen::MatrixXd> set = m_dataSet;
+	for (const double scale : { 2.0, 3.0 }) { for (const auto& m : m_dataSet) { set.push_back(scale * m); } }
+	std::vector<Eigen::MatrixXd> firsts;	// Other matrices than the set (the distance of a matrix with itself can be not a number)
+	for (size_t i = 0; i < 5; ++i) { firsts.push_back(0.5 * (set[i] + set[i + 1])); }
+
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Euclidian, Geometry::EMetric::Wasserstein,
+								Geometry::EMetric::LogDet, Geometry::EMetric::Kullback })
+	{
+		const std::string title = "Distance Matrix " + toString(metric);
+		const size_t n = set.size(), m = firsts.size();
+		Eigen::MatrixXd ref(n, n), refCross(m, n), calc, calcCross;
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j) { ref(i, j) = i == j ? 0 : Geometry::Distance(set[i], set[j], metric); }
+			for (size_t j = 0; j < m; ++j) { refCross(j, i) = Geometry::Distance(firsts[j], set[i], metric); }
+		}
+		EXPECT_TRUE(Geometry::DistanceMatrix(set, calc, metric, 3)) << title;
+		EXPECT_TRUE(calc.rows() == Eigen::Index(n) && (ref - calc).cwiseAbs().maxCoeff() < 1e-6) << ErrorMsg(title, ref, calc);
+		EXPECT_TRUE(Geometry::DistanceMatrix(firsts, set, calcCross, metric, 3)) << title + " Cross";
+		EXPECT_TRUE(calcCross.rows() == Eigen::Index(m) && (refCross - calcCross).cwiseAbs().maxCoeff() < 1e-6) << ErrorMsg(title + " Cross", refCross, calcCross);
+	}
+
+	Eigen::MatrixXd calc;
+	EXPECT_FALSE(Geometry::DistanceMatrix(std::vector<Eigen::MatrixXd>(), calc)) << "Distance Matrix of empty set";
+	EXPECT_FALSE(Geometry::DistanceMatrix({ m_dataSet[0], Eigen::MatrixXd::Identity(2, 2) }, calc)) << "Distance Matrix of matrices with different sizes";
+}
+//---------------------------------------------------------------------------------------------------
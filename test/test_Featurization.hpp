@@ -89,3 +89,41 @@ TEST_F(Tests_Featurization, UnSqueeze)
 	}
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Featurization, TangentKernel)
+{
+	const Eigen::MatrixXd mean = InitMeans::Riemann::Reference();
+	const size_t n             = m_dataSet.size();
+
+	// Same vectors as the Tangent Space of each matrix
+	Eigen::MatrixXd vectors;
+	EXPECT_TRUE(Geometry::TangentSpace(m_dataSet, vectors, mean, 2)) << "Error During Processing";
+	EXPECT_TRUE(vectors.rows() == Eigen::Index(n)) << ErrorMsg("Number of tangent vectors", n, size_t(vectors.rows()));
+	for (size_t i = 0; i < n; ++i)
+	{
+		Eigen::RowVectorXd ts;
+		EXPECT_TRUE(Geometry::TangentSpace(m_dataSet[i], ts, mean));
+		EXPECT_TRUE(isAlmostEqual(ts, vectors.row(i))) << ErrorMsg("Tangent Vector [" + std::to_string(i) + "]", ts, vectors.row(i));
+	}
+
+	// Kernel is the dot product of the tangent vectors, whatever the number of threads
+	const Eigen::MatrixXd ref = vectors * vectors.transpose();
+	for (const size_t nbThreads : { size_t(1), size_t(3), size_t(0) })
+	{
+		Eigen::MatrixXd calc;
+		EXPECT_TRUE(Geometry::TangentKernel(m_dataSet, calc, mean, nbThreads)) << "Error During Processing";
+		EXPECT_TRUE(isAlmostEqual(ref, calc)) << ErrorMsg("Tangent Kernel (" + std::to_string(nbThreads) + " threads)", ref, calc);
+	}
+
+	// Cross kernel is a block of the kernel
+	const std::vector<Eigen::MatrixXd> a(m_dataSet.begin(), m_dataSet.begin() + 3), b(m_dataSet.begin() + 3, m_dataSet.end());
+	Eigen::MatrixXd cross;
+	EXPECT_TRUE(Geometry::TangentKernel(a, b, cross, mean, 2)) << "Error During Processing";
+	const Eigen::MatrixXd block = ref.block(0, 3, 3, Eigen::Index(n) - 3);
+	EXPECT_TRUE(isAlmostEqual(block, cross)) << ErrorMsg("Cross Tangent Kernel", block, cross);
+
+	Eigen::MatrixXd bad;
+	EXPECT_FALSE(Geometry::TangentKernel(std::vector<Eigen::MatrixXd>(), bad, mean)) << "Kernel of an empty set";
+}
+//---------------------------------------------------------------------------------------------------
@@ -82,3 +82,31 @@ TEST_F(Tests_Geodesic, Identity)
 	}
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Geodesic, LogCholesky)
+{
+	const std::vector<Eigen::MatrixXd> ref = InitGeodesics::Riemann::Reference();
+	const Eigen::MatrixXd mean             = InitMeans::Riemann::Reference();
+	Geometry::SSymmetricBuffers buffers;
+	for (size_t i = 0; i < m_dataSet.size(); ++i)
+	{
+		Eigen::MatrixXd calc;
+		// The extremities are the matrices and the midpoint has the determinant of the Riemann midpoint
+		EXPECT_TRUE(GeodesicLogCholesky(mean, m_dataSet[i], calc, 0.0, buffers));
+		EXPECT_TRUE(isAlmostEqual(mean, calc)) << ErrorMsg("Geodesic LogCholesky Start Sample [" + std::to_string(i) + "]", mean, calc);
+		EXPECT_TRUE(GeodesicLogCholesky(mean, m_dataSet[i], calc, 1.0, buffers));
+		EXPECT_TRUE(isAlmostEqual(m_dataSet[i], calc)) << ErrorMsg("Geodesic LogCholesky End Sample [" + std::to_string(i) + "]", m_dataSet[i], calc);
+		calc = mean;
+		EXPECT_TRUE(GeodesicLogCholesky(calc, m_dataSet[i], calc, 0.5, buffers));
+		EXPECT_TRUE(isAlmostEqual(1.0, calc.determinant() / ref[i].determinant())) << ErrorMsg("Geodesic LogCholesky Determinant Sample [" + std::to_string(i) + "]", ref[i].determinant(), calc.determinant());
+	}
+
+	// Exact for diagonal matrices (geometric mean of the diagonals)
+	const Eigen::MatrixXd a = Eigen::Vector3d(1, 4, 9).asDiagonal(), b = Eigen::Vector3d(4, 1, 1).asDiagonal(), diag = Eigen::Vector3d(2, 2, 3).asDiagonal();
+	Eigen::MatrixXd calc;
+	EXPECT_TRUE(GeodesicLogCholesky(a, b, calc, 0.5, buffers));
+	EXPECT_TRUE(isAlmostEqual(diag, calc)) << ErrorMsg("Geodesic LogCholesky Diagonal", diag, calc);
+	EXPECT_FALSE(GeodesicLogCholesky(a, -b, calc, 0.5, buffers));
+}
+//---------------------------------------------------------------------------------------------------
@@ -18,12 +18,26 @@
 #include "gtest/gtest.h"
 #include "misc.hpp"
 #include "Init.hpp"
+#include "Allocations.hpp"
 
 #include <geometry/classifier/CMatrixClassifierMDM.hpp>
+#include <geometry/classifier/CMatrixClassifierMDMT.hpp>
 #include <geometry/classifier/CMatrixClassifierMDMRebias.hpp>
 #include <geometry/classifier/CMatrixClassifierFgMDM.hpp>
 #include <geometry/classifier/CMatrixClassifierFgMDMRT.hpp>
 #include <geometry/classifier/CMatrixClassifierFgMDMRTRebias.hpp>
+#include <geometry/classifier/CMatrixClassifierTSLR.hpp>
+#include <geometry/classifier/CMatrixClassifierKNN.hpp>
+#include <geometry/classifier/CMatrixClassifierTSKernel.hpp>
+#include <geometry/classifier/CClassifierSession.hpp>
+#include <geometry/classifier/CClassifierHandle.hpp>
+#include <geometry/classifier/CMDMBatch.hpp>
+#include <geometry/Featurization.hpp>
+#include <geometry/Geodesic.hpp>
+#include <unsupported/Eigen/MatrixFunctions>
+#include <iomanip>
+#include <thread>
+#include <atomic>
 
 static const std::vector<std::vector<double>> EMPTY_DIST;
 
@@ -54,6 +68,57 @@ static void TestClassify(Geometry::IMatrixClassifier& calc, const std::vector<st
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Check the batch classification with the classification of each sample in a loop (serial must be a copy of batch). </summary>
+static void TestBatch(Geometry::IMatrixClassifier& batch, Geometry::IMatrixClassifier& serial, const std::vector<std::vector<Eigen::MatrixXd>>& dataset,
+					  const Geometry::EAdaptations& adapt, const size_t nbThreads)
+{
+	std::vector<Eigen::MatrixXd> samples;
+	std::vector<size_t> labels, classIds;
+	for (size_t k = 0; k < dataset.size(); ++k)
+	{
+		for (const auto& trial : dataset[k])
+		{
+			samples.push_back(trial);
+			labels.push_back(k);
+		}
+	}
+	Eigen::MatrixXd distances, probabilities;
+	EXPECT_TRUE(batch.classify(samples, classIds, distances, probabilities, adapt, labels, nbThreads)) << "Error during Batch Classify " << batch.getType();
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		size_t classId = 0;
+		std::vector<double> distance, probability;
+		EXPECT_TRUE(serial.classify(samples[i], classId, distance, probability, adapt, labels[i])) << "Error during Classify " << serial.getType();
+		EXPECT_TRUE(classId == classIds[i]) << ErrorMsg(batch.getType() + " Batch Prediction " + std::to_string(i), classId, classIds[i]);
+		for (size_t k = 0; k < distance.size(); ++k)
+		{
+			EXPECT_TRUE(distance[k] == distances(i, k) && probability[k] == probabilities(i, k)) << batch.getType() << " Batch Distance " << i
+				<< " : " << std::setprecision(17) << distance[k] << " / " << distances(i, k);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Classifier defined out of the library, without predict (the default predict classifies a copy). </summary>
+class CCopiedClassifier final : public Geometry::IMatrixClassifier
+{
+public:
+	explicit CCopiedClassifier(const Geometry::CMatrixClassifierMDMRebias& model) : m_model(model) { }
+	bool train(const std::vector<std::vector<Eigen::MatrixXd>>& datasets) override { return m_model.train(datasets); }
+	bool classify(const Eigen::MatrixXd& sample, size_t& classId, std::vector<double>& distance, std::vector<double>& probability,
+				  const Geometry::EAdaptations adaptation, const size_t& realClassId) override
+	{
+		return m_model.classify(sample, classId, distance, probability, adaptation, realClassId);
+	}
+	std::unique_ptr<IMatrixClassifier> clone() const override { return std::unique_ptr<IMatrixClassifier>(new CCopiedClassifier(*this)); }
+	std::string getType() const override { return "Copied"; }
+
+	Geometry::CMatrixClassifierMDMRebias m_model;
+};
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 class Tests_MatrixClassifier : public testing::Test
 {
@@ -107,6 +172,63 @@ TEST_F(Tests_MatrixClassifier, MDM_Classifify_Adapt_Unsupervised)
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, MDM_Adapt_Block)
+{
+	std::vector<Eigen::MatrixXd> samples;
+	std::vector<size_t> labels;
+	for (size_t k = 0; k < m_dataSet.size(); ++k)
+	{
+		for (const auto& trial : m_dataSet[k])
+		{
+			samples.push_back(trial);
+			labels.push_back(k);
+		}
+	}
+
+	for (const auto& metric : { Geometry::EMetric::Euclidian, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Riemann })
+	{
+		const double precision = metric == Geometry::EMetric::Riemann ? 1e-3 : 1e-9;
+		Geometry::CMatrixClassifierMDM sequential(NB_CLASS, metric);
+		EXPECT_TRUE(sequential.train(m_dataSet)) << "Error during Training " << Geometry::toString(metric);
+		Geometry::CMatrixClassifierMDM block(sequential);
+
+		TestClassify(sequential, m_dataSet, {}, EMPTY_DIST, Geometry::EAdaptations::Supervised);
+		EXPECT_TRUE(block.adapt(samples, labels)) << "Error during Block Adaptation " << Geometry::toString(metric);
+		EXPECT_TRUE(block.isEqual(sequential, precision)) << ErrorMsg("MDM Block Adaptation " + Geometry::toString(metric), sequential, block);
+	}
+	Geometry::CMatrixClassifierMDM calc = InitMatrixClassif::MDM::Reference();
+	EXPECT_FALSE(calc.adapt(samples, { 0 })) << "Labels and samples sizes must match";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Rebias_Adapt_Block_Invalid)
+{
+	std::vector<Eigen::MatrixXd> samples = Geometry::Vector2DTo1D(m_dataSet);
+	std::vector<size_t> labels(samples.size(), 0);
+	std::vector<size_t> badLabels = labels;
+	badLabels.back()              = NB_CLASS;
+	std::vector<Eigen::MatrixXd> badSamples = samples;
+	badSamples.back()                       = Eigen::MatrixXd::Identity(NB_CHAN + 1, NB_CHAN + 1);
+
+	// A rejected block must not modify the bias (nor the means)
+	const Geometry::CMatrixClassifierMDMRebias mdmRef = InitMatrixClassif::MDMRebias::Reference();
+	Geometry::CMatrixClassifierMDMRebias mdm          = mdmRef;
+	EXPECT_FALSE(mdm.adapt(samples, { 0 })) << "MDM Rebias : Labels and samples sizes must match";
+	EXPECT_FALSE(mdm.adapt(samples, badLabels)) << "MDM Rebias : Labels must be lower than the number of classes";
+	EXPECT_FALSE(mdm.adapt(badSamples, labels)) << "MDM Rebias : Samples must have the size of the bias";
+	EXPECT_TRUE(mdmRef == mdm) << ErrorMsg("MDM Rebias rejected Block Adaptation", mdmRef, mdm);
+
+	const Geometry::CMatrixClassifierFgMDMRTRebias fgRef = InitMatrixClassif::FgMDMRTRebias::Reference();
+	Geometry::CMatrixClassifierFgMDMRTRebias fg          = fgRef;
+	EXPECT_FALSE(fg.adapt(samples, { 0 })) << "FgMDM RT Rebias : Labels and samples sizes must match";
+	EXPECT_FALSE(fg.adapt(samples, badLabels)) << "FgMDM RT Rebias : Labels must be lower than the number of classes";
+	EXPECT_FALSE(fg.adapt(badSamples, labels)) << "FgMDM RT Rebias : Samples must have the size of the bias";
+	EXPECT_TRUE(fgRef == fg) << ErrorMsg("FgMDM RT Rebias rejected Block Adaptation", fgRef, fg);
+}
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 TEST_F(Tests_MatrixClassifier, MDM_Save)
 {
@@ -169,6 +291,33 @@ TEST_F(Tests_MatrixClassifier, FgMDMRT_Save)
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, FgMDMRT_Load_Dense_Weight)
+{
+	// Rewrite the saved file with the dense weight format
+	const Geometry::CMatrixClassifierFgMDMRT ref = InitMatrixClassif::FgMDMRT::Reference();
+	EXPECT_TRUE(ref.saveXML("test_FgMDM_Dense.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	tinyxml2::XMLDocument xmlDoc;
+	EXPECT_TRUE(xmlDoc.LoadFile("test_FgMDM_Dense.xml") == tinyxml2::XML_SUCCESS);
+	tinyxml2::XMLElement* data = xmlDoc.RootElement()->FirstChildElement("Classifier-data");
+	data->DeleteChild(data->FirstChildElement("Weight-U"));
+	data->DeleteChild(data->FirstChildElement("Weight-V"));
+	const Eigen::MatrixXd dense = ref.getWeight();
+	std::stringstream ss;
+	ss << std::setprecision(17) << dense.format(MATRIX_FORMAT);
+	tinyxml2::XMLElement* weight = xmlDoc.NewElement("Weight");
+	weight->SetAttribute("size", int(dense.rows()));
+	weight->SetText(ss.str().c_str());
+	data->InsertAfterChild(data->FirstChildElement("Reference"), weight);
+	EXPECT_TRUE(xmlDoc.SaveFile("test_FgMDM_Dense.xml") == tinyxml2::XML_SUCCESS);
+
+	Geometry::CMatrixClassifierFgMDMRT calc;
+	EXPECT_TRUE(calc.loadXML("test_FgMDM_Dense.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(ref == calc) << ErrorMsg("FgMDM Load Dense Weight", ref, calc);
+	EXPECT_TRUE(calc.getWeightU().cols() < NB_CLASS + 1) << "Dense weight not factorized";
+}
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 TEST_F(Tests_MatrixClassifier, FgMDM_Classifify_Adapt_Supervised)
 {
@@ -189,6 +338,103 @@ TEST_F(Tests_MatrixClassifier, FgMDM_Classifify_Adapt_Unsupervised)
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, FgMDM_Adapt_Incremental)
+{
+	// Incremental adaptation gives the same filter as LSQR on all vectors in the tangent space of the reference
+	Geometry::CMatrixClassifierFgMDM calc;
+	EXPECT_TRUE(calc.train(m_dataSet));
+	const Eigen::MatrixXd ref = calc.getRef();
+	std::vector<std::vector<Eigen::RowVectorXd>> tsSample(NB_CLASS);
+	for (size_t k = 0; k < NB_CLASS; ++k)
+	{
+		for (const auto& m : m_dataSet[k])
+		{
+			Eigen::RowVectorXd ts;
+			Geometry::TangentSpace(m, ts, ref);
+			tsSample[k].push_back(ts);
+			tsSample[k].push_back(ts);		// Training trial and adapted trial
+		}
+	}
+	TestClassify(calc, m_dataSet, {}, EMPTY_DIST, Geometry::EAdaptations::Supervised);
+	Eigen::MatrixXd weight;
+	Geometry::FgDACompute(tsSample, weight);
+	const Eigen::MatrixXd calcWeight = calc.getWeight();
+	EXPECT_TRUE(isAlmostEqual(weight, calcWeight)) << ErrorMsg("FgMDM Incremental Weight", weight, calcWeight);
+	EXPECT_TRUE(calc.getDatasets()[0].size() == NB_TRIALS1) << "Datasets must not grow without re-anchoring";
+
+	// Re-anchoring each trial without memory cap is an exact retrain
+	Geometry::CMatrixClassifierFgMDM exact;
+	EXPECT_TRUE(exact.train(m_dataSet));
+	exact.setAnchorPeriod(1);
+	TestClassify(exact, m_dataSet, InitMatrixClassif::FgMDM::PredictionSupervised(), EMPTY_DIST, Geometry::EAdaptations::Supervised);
+	std::vector<std::vector<Eigen::MatrixXd>> doubled = m_dataSet;
+	for (size_t k = 0; k < NB_CLASS; ++k) { doubled[k].insert(doubled[k].end(), m_dataSet[k].begin(), m_dataSet[k].end()); }
+	Geometry::CMatrixClassifierFgMDM retrain;
+	EXPECT_TRUE(retrain.train(doubled));
+	EXPECT_TRUE(retrain == exact) << ErrorMsg("FgMDM Exact Re-anchoring", retrain, exact);
+
+	// Memory cap
+	Geometry::CMatrixClassifierFgMDM capped;
+	EXPECT_TRUE(capped.train(m_dataSet));
+	capped.setAnchorPeriod(4);
+	capped.setMemoryCap(NB_TRIALS2);
+	TestClassify(capped, m_dataSet, {}, EMPTY_DIST, Geometry::EAdaptations::Supervised);
+	for (const auto& trials : capped.getDatasets()) { EXPECT_TRUE(trials.size() <= NB_TRIALS2) << "Memory cap not respected"; }
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, FgMDM_Adapt_Filter_Period)
+{
+	// The filter is computed only at the end of the period, the exact filter of all the statistics
+	Geometry::CMatrixClassifierFgMDM calc, exact;
+	EXPECT_TRUE(calc.train(m_dataSet));
+	EXPECT_TRUE(exact.train(m_dataSet));
+	const Eigen::MatrixXd trained = calc.getWeight();
+	calc.setFilterPeriod(NB_TRIALS);
+	size_t classId;
+	std::vector<double> distance, probability;
+	EXPECT_TRUE(calc.classify(m_dataSet[0][0], classId, distance, probability, Geometry::EAdaptations::Supervised, 0));
+	EXPECT_TRUE(isAlmostEqual(trained, calc.getWeight())) << ErrorMsg("FgMDM Weight before the end of the period", trained, calc.getWeight());
+	EXPECT_TRUE(exact.classify(m_dataSet[0][0], classId, distance, probability, Geometry::EAdaptations::Supervised, 0));
+	for (size_t k = 0; k < NB_CLASS; ++k)
+	{
+		for (size_t i = (k == 0 ? 1 : 0); i < m_dataSet[k].size(); ++i)
+		{
+			EXPECT_TRUE(calc.classify(m_dataSet[k][i], classId, distance, probability, Geometry::EAdaptations::Supervised, k));
+			EXPECT_TRUE(exact.classify(m_dataSet[k][i], classId, distance, probability, Geometry::EAdaptations::Supervised, k));
+		}
+	}
+	EXPECT_TRUE(calc == exact) << ErrorMsg("FgMDM Filter Period", exact, calc);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, FgMDM_Save_Statistics)
+{
+	// The reloaded classifier continues the incremental adaptation as the original
+	Geometry::CMatrixClassifierFgMDM ref, calc;
+	EXPECT_TRUE(ref.train(m_dataSet));
+	size_t classId;
+	std::vector<double> distance, probability;
+	EXPECT_TRUE(ref.classify(m_dataSet[1][0], classId, distance, probability, Geometry::EAdaptations::Supervised, 1));
+	EXPECT_TRUE(ref.saveXML("test_FgMDM_Statistics.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	EXPECT_TRUE(calc.loadXML("test_FgMDM_Statistics.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(calc.getStatistics().size() == NB_CLASS) << "Statistics not loaded";
+	for (size_t k = 0; k < calc.getStatistics().size(); ++k)
+	{
+		EXPECT_TRUE(ref.getStatistics()[k] == calc.getStatistics()[k]) << "Bad statistics for the class " << k;
+	}
+	EXPECT_TRUE(ref == calc) << ErrorMsg("FgMDM Save Statistics", ref, calc);
+
+	TestClassify(ref, m_dataSet, {}, EMPTY_DIST, Geometry::EAdaptations::Supervised);
+	TestClassify(calc, m_dataSet, {}, EMPTY_DIST, Geometry::EAdaptations::Supervised);
+	EXPECT_TRUE(ref == calc) << ErrorMsg("FgMDM Adaptation after Load", ref, calc);
+	EXPECT_TRUE(isAlmostEqual(ref.getDrift(), calc.getDrift())) << ErrorMsg("FgMDM Drift after Load", ref.getDrift(), calc.getDrift());
+}
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 TEST_F(Tests_MatrixClassifier, MDM_Rebias_Train)
 {
@@ -294,3 +540,844 @@ TEST_F(Tests_MatrixClassifier, FgMDM_RT_Rebias_Classifify_Adapt_Unsupervised)
 	//EXPECT_TRUE(ref == calc) << ErrorMsg("FgMDM Rebias Adapt Classify after Unsupervised adaptation", ref, calc);
 }
 //---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, TSLR_Train_Classify)
+{
+	for (const auto& solver : { Geometry::ETangentSolver::LogisticRegression, Geometry::ETangentSolver::LDA })
+	{
+		Geometry::CMatrixClassifierTSLR calc(NB_CLASS, solver);
+		EXPECT_TRUE(calc.train(m_dataSet)) << "Error during Training " << Geometry::toString(solver);
+		EXPECT_TRUE(calc.getWeight().rows() == NB_CLASS && calc.getWeight().cols() == NB_FEATURES) << "Bad Weight size " << Geometry::toString(solver);
+
+		size_t nbGood = 0, nbTrials = 0;
+		for (size_t k = 0; k < m_dataSet.size(); ++k)
+		{
+			for (const auto& trial : m_dataSet[k])
+			{
+				size_t classid = 0;
+				std::vector<double> distance, probability;
+				EXPECT_TRUE(calc.classify(trial, classid, distance, probability)) << "Error during Classify " << Geometry::toString(solver);
+
+				// Same result as the Tangent Space function and a softmax
+				Eigen::RowVectorXd ts;
+				EXPECT_TRUE(Geometry::TangentSpace(trial, ts, calc.getRef()));
+				const Eigen::VectorXd scores = calc.getWeight() * ts.transpose() + calc.getBias();
+				const Eigen::VectorXd p      = (scores.array() - scores.maxCoeff()).exp().matrix() / (scores.array() - scores.maxCoeff()).exp().sum();
+				for (size_t c = 0; c < NB_CLASS; ++c)
+				{
+					EXPECT_TRUE(isAlmostEqual(p[c], probability[c])) << ErrorMsg("Probability", p[c], probability[c]);
+					EXPECT_TRUE(isAlmostEqual(-log(p[c]), distance[c])) << ErrorMsg("Distance", -log(p[c]), distance[c]);
+				}
+				if (classid == k) { nbGood++; }
+				nbTrials++;
+			}
+		}
+		EXPECT_TRUE(nbGood * 4 >= nbTrials * 3) << "Bad accuracy with " << Geometry::toString(solver) << " : " << nbGood << "/" << nbTrials;
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, TSLR_Save)
+{
+	Geometry::CMatrixClassifierTSLR ref(NB_CLASS, Geometry::ETangentSolver::LDA), calc;
+	EXPECT_TRUE(ref.train(m_dataSet)) << "Error during Training";
+	EXPECT_TRUE(ref.saveXML("test_TSLR_Save.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	EXPECT_TRUE(calc.loadXML("test_TSLR_Save.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(ref == calc) << ErrorMsg("TSLR Save", ref, calc);
+
+	size_t id1 = 0, id2 = 0;
+	std::vector<double> dist1, dist2, prob1, prob2;
+	EXPECT_TRUE(ref.classify(m_dataSet[0][0], id1, dist1, prob1));
+	EXPECT_TRUE(calc.classify(m_dataSet[0][0], id2, dist2, prob2));
+	EXPECT_TRUE(id1 == id2 && isAlmostEqual(prob1, prob2)) << ErrorMsg("TSLR Classify after Load", prob1, prob2);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Batch_Classify)
+{
+	for (const size_t nbThreads : { size_t(1), size_t(3) })
+	{
+		for (const auto& adapt : { Geometry::EAdaptations::None, Geometry::EAdaptations::Supervised, Geometry::EAdaptations::Unsupervised })
+		{
+			Geometry::CMatrixClassifierMDM mdm = InitMatrixClassif::MDM::Reference(), mdmSerial = mdm;
+			TestBatch(mdm, mdmSerial, m_dataSet, adapt, nbThreads);
+			Geometry::CMatrixClassifierFgMDMRT fgmdmrt = InitMatrixClassif::FgMDMRT::Reference(), fgmdmrtSerial = fgmdmrt;
+			TestBatch(fgmdmrt, fgmdmrtSerial, m_dataSet, adapt, nbThreads);
+			Geometry::CMatrixClassifierMDMRebias rebias = InitMatrixClassif::MDMRebias::Reference(), rebiasSerial = rebias;
+			TestBatch(rebias, rebiasSerial, m_dataSet, adapt, nbThreads);
+			Geometry::CMatrixClassifierFgMDMRTRebias fgRebias = InitMatrixClassif::FgMDMRTRebias::Reference(), fgRebiasSerial = fgRebias;
+			TestBatch(fgRebias, fgRebiasSerial, m_dataSet, adapt, nbThreads);
+		}
+		Geometry::CMatrixClassifierTSLR tslr(NB_CLASS);
+		EXPECT_TRUE(tslr.train(m_dataSet)) << "Error during Training TSLR";
+		Geometry::CMatrixClassifierTSLR tslrSerial = tslr;
+		TestBatch(tslr, tslrSerial, m_dataSet, Geometry::EAdaptations::None, nbThreads);
+	}
+
+	// Bad inputs
+	Geometry::CMatrixClassifierMDM calc = InitMatrixClassif::MDM::Reference();
+	std::vector<size_t> classIds;
+	Eigen::MatrixXd distances, probabilities;
+	EXPECT_FALSE(calc.classify(m_dataSet[0], classIds, distances, probabilities, Geometry::EAdaptations::Supervised)) << "Supervised batch needs labels";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Check the classification with sessions on a shared model with the classification of a copy of the model (in several threads). </summary>
+template <typename T>
+static void TestSession(const T& reference, const std::vector<std::vector<Eigen::MatrixXd>>& dataset, const Geometry::EAdaptations& adapt)
+{
+	const std::shared_ptr<const T> model = std::make_shared<const T>(reference);
+	std::vector<Geometry::CClassifierSession> sessions(3, Geometry::CClassifierSession(model));
+	std::vector<std::vector<size_t>> classIds(sessions.size());
+	std::vector<std::vector<std::vector<double>>> distances(sessions.size());
+	std::vector<std::thread> threads;
+	for (size_t s = 0; s < sessions.size(); ++s)
+	{
+		threads.emplace_back([&, s]()
+		{
+			for (size_t k = 0; k < dataset.size(); ++k)
+			{
+				for (const auto& trial : dataset[k])
+				{
+					size_t classId = 0;
+					std::vector<double> distance, probability;
+					if (!sessions[s].classify(trial, classId, distance, probability, adapt, k)) { return; }
+					classIds[s].push_back(classId);
+					distances[s].push_back(distance);
+				}
+			}
+		});
+	}
+	for (auto& t : threads) { t.join(); }
+
+	T serial = reference;
+	size_t idx = 0;
+	for (size_t k = 0; k < dataset.size(); ++k)
+	{
+		for (const auto& trial : dataset[k])
+		{
+			size_t classId = 0, predictId = 0;
+			std::vector<double> distance, probability, predictDistance, predictProbability;
+			EXPECT_TRUE(model->predict(trial, predictId, predictDistance, predictProbability)) << "Error during Predict " << reference.getType();
+			EXPECT_TRUE(serial.classify(trial, classId, distance, probability, adapt, k)) << "Error during Classify " << reference.getType();
+			for (size_t s = 0; s < sessions.size(); ++s)
+			{
+				ASSERT_TRUE(idx < classIds[s].size()) << "Error during Session Classify " << reference.getType();
+				EXPECT_TRUE(classIds[s][idx] == classId && isAlmostEqual(distances[s][idx], distance)) << ErrorMsg(reference.getType() + " Session", distance, distances[s][idx]);
+			}
+			idx++;
+		}
+	}
+	EXPECT_TRUE(*model == reference) << "The model must not change with the sessions";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Session_Classify)
+{
+	for (const auto& adapt : { Geometry::EAdaptations::None, Geometry::EAdaptations::Supervised, Geometry::EAdaptations::Unsupervised })
+	{
+		TestSession(InitMatrixClassif::MDM::Reference(), m_dataSet, adapt);
+		TestSession(InitMatrixClassif::FgMDMRT::Reference(), m_dataSet, adapt);
+		TestSession(InitMatrixClassif::MDMRebias::Reference(), m_dataSet, adapt);
+		TestSession(InitMatrixClassif::FgMDMRTRebias::Reference(), m_dataSet, adapt);
+	}
+
+	// The prediction doesn't update the bias
+	Geometry::CMatrixClassifierMDMRebias rebias = InitMatrixClassif::MDMRebias::Reference();
+	const Geometry::CMatrixClassifierMDMRebias ref = rebias;
+	size_t classId;
+	std::vector<double> distance, probability;
+	EXPECT_TRUE(rebias.predict(m_dataSet[0][0], classId, distance, probability));
+	EXPECT_TRUE(rebias == ref) << "The prediction must not change the classifier";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Predict_Default)
+{
+	const Geometry::CMatrixClassifierMDMRebias ref = InitMatrixClassif::MDMRebias::Reference();
+	const CCopiedClassifier copied(ref);
+	for (const auto& trials : m_dataSet)
+	{
+		for (const auto& trial : trials)
+		{
+			size_t classId, refId;
+			std::vector<double> distance, probability, refDistance, refProbability;
+			EXPECT_TRUE(copied.predict(trial, classId, distance, probability)) << "Error during the default Predict";
+			EXPECT_TRUE(ref.predict(trial, refId, refDistance, refProbability)) << "Error during Predict";
+			EXPECT_TRUE(classId == refId) << ErrorMsg("Default Predict", refId, classId);
+			EXPECT_TRUE(isAlmostEqual(refDistance, distance)) << ErrorMsg("Default Predict Distance", refDistance, distance);
+		}
+	}
+	EXPECT_TRUE(copied.m_model == ref) << "The default prediction must not change the classifier";
+
+	// Without copy, the default prediction fails
+	struct CUncopiable final : Geometry::IMatrixClassifier
+	{
+		bool train(const std::vector<std::vector<Eigen::MatrixXd>>& /*datasets*/) override { return true; }
+		bool classify(const Eigen::MatrixXd& /*sample*/, size_t& classId, std::vector<double>& /*distance*/, std::vector<double>& /*probability*/,
+					  const Geometry::EAdaptations /*adaptation*/, const size_t& /*realClassId*/) override
+		{
+			classId = 0;
+			return true;
+		}
+		std::string getType() const override { return "Uncopiable"; }
+	} uncopiable;
+	size_t classId;
+	std::vector<double> distance, probability;
+	EXPECT_FALSE(uncopiable.predict(m_dataSet[0][0], classId, distance, probability)) << "The default Predict without copy must fail";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Handle_Publish)
+{
+	const Geometry::CMatrixClassifierMDMRebias reference = InitMatrixClassif::MDMRebias::Reference();
+	Geometry::CClassifierHandle handle(std::make_shared<const Geometry::CMatrixClassifierMDMRebias>(reference));
+	EXPECT_TRUE(handle.getVersion() == 1) << "Bad version after the first publication";
+
+	// Reader thread during the publications
+	std::atomic<bool> stop(false), ok(true);
+	std::thread reader([&]()
+	{
+		Geometry::CClassifierSession session(handle);
+		size_t classId;
+		std::vector<double> distance, probability;
+		while (!stop.load()) { for (const auto& trial : m_dataSet[0]) { if (!session.classify(trial, classId, distance, probability)) { ok = false; } } }
+	});
+	std::weak_ptr<const Geometry::IMatrixClassifier> first = handle.acquire();
+	for (size_t i = 0; i < 20; ++i) { handle.publish(std::make_shared<const Geometry::CMatrixClassifierMDMRebias>(reference)); }
+	stop = true;
+	reader.join();
+	EXPECT_TRUE(ok.load()) << "Error during Classify with publications";
+	EXPECT_TRUE(handle.getVersion() == 21) << "Bad version after the publications";
+	EXPECT_TRUE(first.expired()) << "The first version must be reclaimed after its last reader";
+
+	// Adaptation state carried across a publication (bias and number of trials)
+	Geometry::CClassifierSession keep(handle), reset(handle, false);
+	size_t classId;
+	std::vector<double> distance, probability;
+	for (size_t k = 0; k < m_dataSet.size(); ++k)
+	{
+		for (const auto& trial : m_dataSet[k])
+		{
+			EXPECT_TRUE(keep.classify(trial, classId, distance, probability, Geometry::EAdaptations::Supervised, k));
+			EXPECT_TRUE(reset.classify(trial, classId, distance, probability, Geometry::EAdaptations::Supervised, k));
+		}
+	}
+	const Geometry::CBias bias                 = keep.getBias();
+	const std::vector<size_t> nbTrials         = keep.getTrialNumbers();
+	Geometry::CMatrixClassifierMDMRebias retrained = reference;
+	EXPECT_TRUE(retrained.train(m_dataSet));
+	handle.publish(std::make_shared<const Geometry::CMatrixClassifierMDMRebias>(retrained));
+
+	EXPECT_TRUE(keep.classify(m_dataSet[0][0], classId, distance, probability));
+	EXPECT_TRUE(reset.classify(m_dataSet[0][0], classId, distance, probability));
+	EXPECT_TRUE(keep.getModel() == handle.acquire() && reset.getModel() == handle.acquire()) << "The sessions must use the last version";
+	EXPECT_TRUE(keep.getTrialNumbers() == nbTrials) << "The number of trials must be kept";
+	EXPECT_TRUE(keep.getBias().getClassificationNumber() == bias.getClassificationNumber() + 1) << "The bias must be kept";
+	EXPECT_TRUE(reset.getTrialNumbers() == retrained.getTrialNumbers()) << "The number of trials must be reset";
+	EXPECT_TRUE(isAlmostEqual(keep.getMeans()[0], retrained.getMeans()[0])) << "The means must be taken from the new version";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Handle_Publish_Channel_Change)
+{
+	// Model of the same type and number of classes with one channel less
+	std::vector<std::vector<Eigen::MatrixXd>> reduced = m_dataSet;
+	for (auto& trials : reduced) { for (auto& trial : trials) { trial = Eigen::MatrixXd(trial.topLeftCorner(NB_CHAN - 1, NB_CHAN - 1)); } }
+	Geometry::CMatrixClassifierMDMRebias small = InitMatrixClassif::MDMRebias::Reference();
+	EXPECT_TRUE(small.train(reduced));
+
+	Geometry::CClassifierHandle handle(std::make_shared<const Geometry::CMatrixClassifierMDMRebias>(InitMatrixClassif::MDMRebias::Reference()));
+	Geometry::CClassifierSession session(handle);
+	size_t classId;
+	std::vector<double> distance, probability;
+	for (const auto& trial : m_dataSet[0]) { EXPECT_TRUE(session.classify(trial, classId, distance, probability, Geometry::EAdaptations::Supervised, 0)); }
+	const std::vector<size_t> nbTrials = session.getTrialNumbers();
+	handle.publish(std::make_shared<const Geometry::CMatrixClassifierMDMRebias>(small));
+
+	// The bias of the old size isn't kept and the samples of the old size are rejected
+	EXPECT_FALSE(session.classify(m_dataSet[0][0], classId, distance, probability)) << "A sample of the old size must be rejected";
+	EXPECT_TRUE(session.getBias().getBias().rows() == NB_CHAN - 1) << "The bias must have the size of the new model";
+	EXPECT_TRUE(session.getBias() == small.getBias()) << "The bias of the old size must not be kept";
+	EXPECT_TRUE(session.getTrialNumbers() == nbTrials) << "The number of trials must be kept";
+	EXPECT_TRUE(session.classify(reduced[0][0], classId, distance, probability, Geometry::EAdaptations::Supervised, 0));
+	EXPECT_TRUE(session.getBias().getClassificationNumber() == small.getBias().getClassificationNumber() + 1) << "The bias of the new model must be updated";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, MDM_Factors)
+{
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Wasserstein, Geometry::EMetric::Euclidian })
+	{
+		const std::string title = "MDM Factors " + toString(metric);
+		Geometry::CMatrixClassifierMDM calc(NB_CLASS, metric);
+		EXPECT_TRUE(calc.train(m_dataSet)) << "Error during Training " << title;
+		EXPECT_TRUE(calc.getFactors().size() == NB_CLASS) << title << " : factors not computed";
+
+		// The factors follow the adaptation of the means
+		for (const auto& trials : m_dataSet)
+		{
+			for (const auto& trial : trials)
+			{
+				size_t classId;
+				std::vector<double> distance, probability;
+				EXPECT_TRUE(calc.classify(trial, classId, distance, probability, Geometry::EAdaptations::Unsupervised)) << "Error during Classify " << title;
+				EXPECT_TRUE(calc.predict(trial, classId, distance, probability)) << "Error during Predict " << title;
+				for (size_t k = 0; k < NB_CLASS; ++k)
+				{
+					const double ref = Geometry::Distance(trial, calc.getMeans()[k], metric);
+					EXPECT_TRUE(isAlmostEqual(ref, distance[k])) << ErrorMsg(title + " Distance class " + std::to_string(k), ref, distance[k]);
+				}
+			}
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Bias_Update)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::Euclidian })
+	{
+		Geometry::CBias bias, deferred;
+		deferred.setDeferred(true);
+		Eigen::MatrixXd ref, out, outDeferred, outRef;
+		for (size_t i = 0; i < trials.size(); ++i)
+		{
+			// Reference update with the geodesic and the matrix functions
+			if (i == 0) { ref = trials[i]; }
+			else { Geometry::Geodesic(ref, trials[i], ref, metric, 1.0 / double(i + 1)); }
+			bias.updateBias(trials[i], metric);
+			deferred.updateBias(trials[i], metric);
+			if (i % 3 != 2) { continue; }						// Burst of updates for the deferred bias
+
+			const std::string text = toString(metric) + " sample [" + std::to_string(i) + "]";
+			const Eigen::MatrixXd isRef = ref.sqrt().inverse();
+			outRef                      = isRef * trials[0] * isRef.transpose();
+			bias.applyBias(trials[0], out);
+			deferred.applyBias(trials[0], outDeferred);
+			EXPECT_TRUE(isAlmostEqual(ref, bias.getBias())) << ErrorMsg("Bias Update " + text, ref, bias.getBias());
+			EXPECT_TRUE(isAlmostEqual(ref, deferred.getBias())) << ErrorMsg("Deferred Bias Update " + text, ref, deferred.getBias());
+			EXPECT_TRUE(isAlmostEqual(outRef, out)) << ErrorMsg("Bias Apply " + text, outRef, out);
+			EXPECT_TRUE(isAlmostEqual(outRef, outDeferred)) << ErrorMsg("Deferred Bias Apply " + text, outRef, outDeferred);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, MDM_Batch)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	const size_t nbModels                     = 5;
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Euclidian, Geometry::EMetric::Wasserstein, Geometry::EMetric::LogDet })
+	{
+		const std::string title = "MDM Batch " + toString(metric);
+		Geometry::CMatrixClassifierMDM base(NB_CLASS, metric);
+		EXPECT_TRUE(base.train(m_dataSet)) << "Error during Training " << title;
+
+		// Models with different adaptations
+		std::vector<Geometry::CMatrixClassifierMDM> models(nbModels, base);
+		Geometry::CMDMBatch batch;
+		std::vector<Eigen::MatrixXd> samples(nbModels);
+		for (size_t u = 0; u < nbModels; ++u)
+		{
+			size_t classId;
+			std::vector<double> distance, probability;
+			for (size_t i = 0; i < u; ++i) { models[u].classify(trials[i], classId, distance, probability, Geometry::EAdaptations::Unsupervised); }
+			EXPECT_TRUE(batch.addModel(models[u])) << "Error during Add Model " << title;
+			samples[u] = trials[(u + 3) % trials.size()];
+		}
+		EXPECT_TRUE(batch.getModelCount() == nbModels) << title << " : bad number of models";
+
+		for (size_t step = 0; step < 2; ++step)
+		{
+			std::vector<size_t> classIds;
+			std::vector<std::vector<double>> distances, probabilities;
+			EXPECT_TRUE(batch.classify(samples, classIds, distances, probabilities, 2)) << "Error during Classify " << title;
+			for (size_t u = 0; u < nbModels; ++u)
+			{
+				size_t classId;
+				std::vector<double> distance, probability;
+				EXPECT_TRUE(models[u].predict(samples[u], classId, distance, probability)) << "Error during Predict " << title;
+				EXPECT_TRUE(classId == classIds[u]) << ErrorMsg(title + " Class model [" + std::to_string(u) + "]", classId, classIds[u]);
+				for (size_t k = 0; k < NB_CLASS; ++k)
+				{
+					EXPECT_TRUE(isAlmostEqual(distance[k], distances[u][k])) << ErrorMsg(title + " Distance model [" + std::to_string(u) + "]", distance[k], distances[u][k]);
+					EXPECT_TRUE(isAlmostEqual(probability[k], probabilities[u][k])) << ErrorMsg(title + " Probability model [" + std::to_string(u) + "]", probability[k], probabilities[u][k]);
+				}
+			}
+
+			// Update of one model after an adaptation
+			size_t classId;
+			std::vector<double> distance, probability;
+			models[0].classify(trials.back(), classId, distance, probability, Geometry::EAdaptations::Supervised, 1);
+			EXPECT_TRUE(batch.setModel(0, models[0])) << "Error during Set Model " << title;
+		}
+	}
+
+	// Models with other geometry or with bias are refused
+	Geometry::CMDMBatch batch;
+	EXPECT_TRUE(batch.addModel(InitMatrixClassif::MDM::Reference())) << "Error during Add Model MDM Batch";
+	const Geometry::CMatrixClassifierMDM euclidian(NB_CLASS, Geometry::EMetric::Euclidian);
+	Geometry::CMatrixClassifierMDM other = euclidian;
+	EXPECT_TRUE(other.train(m_dataSet)) << "Error during Training MDM Batch";
+	EXPECT_FALSE(batch.addModel(other)) << "MDM Batch : model with another metric added";
+	EXPECT_FALSE(batch.addModel(InitMatrixClassif::MDMRebias::Reference())) << "MDM Batch : model with bias added";
+	EXPECT_TRUE(batch.getModelCount() == 1) << "MDM Batch : bad number of models";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, MDM_Pruning)
+{
+	// Many classes with two trials by class
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	const size_t nbClass                      = trials.size() / 2;
+	std::vector<std::vector<Eigen::MatrixXd>> dataset(nbClass);
+	for (size_t i = 0; i < 2 * nbClass; ++i) { dataset[i % nbClass].push_back(trials[i]); }
+
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::Wasserstein })
+	{
+		const std::string title = "MDM Pruning " + toString(metric);
+		Geometry::CMatrixClassifierMDM exhaustive(nbClass, metric);
+		EXPECT_TRUE(exhaustive.train(dataset)) << "Error during Training " << title;
+		Geometry::CMatrixClassifierMDM pruned = exhaustive;
+		pruned.setPruning(true);
+		EXPECT_TRUE(pruned.getClassDistances().rows() == Eigen::Index(nbClass)) << title << " : class distances not computed";
+		Geometry::CClassifierWorkspace workspace(pruned, size_t(trials[0].rows()));
+
+		for (size_t i = 0; i < trials.size(); ++i)
+		{
+			size_t id, prunedId, predictId;
+			std::vector<double> distance, prunedDistance, predictDistance, probability, prunedProbability;
+			const size_t label = i % nbClass;
+			EXPECT_TRUE(exhaustive.classify(trials[i], id, distance, probability, Geometry::EAdaptations::Supervised, label)) << "Error during Classify " << title;
+			EXPECT_TRUE(pruned.predict(trials[i], predictId, predictDistance, prunedProbability)) << "Error during Predict " << title;
+			EXPECT_TRUE(pruned.classify(trials[i], prunedId, prunedDistance, prunedProbability, Geometry::EAdaptations::Supervised, label)) << "Error during Classify " << title;
+			EXPECT_TRUE(id == prunedId) << ErrorMsg(title + " Class", id, prunedId);
+			EXPECT_TRUE(id == predictId) << ErrorMsg(title + " Class Predict", id, predictId);
+			double sum = 0;
+			for (size_t k = 0; k < nbClass; ++k)
+			{
+				// Exact distance, or pruned class without distance nor probability
+				const bool exact = isAlmostEqual(distance[k], prunedDistance[k]);
+				EXPECT_TRUE(exact || (std::isinf(prunedDistance[k]) && prunedProbability[k] == 0))
+					<< ErrorMsg(title + " Distance [" + std::to_string(k) + "]", distance[k], prunedDistance[k]);
+				EXPECT_TRUE(prunedProbability[k] <= prunedProbability[prunedId]) << title << " : probability [" << k << "] greater than the predicted class";
+				sum += prunedProbability[k];
+			}
+			EXPECT_TRUE(isAlmostEqual(sum, 1.0)) << ErrorMsg(title + " Sum of probabilities", 1.0, sum);
+		}
+		// Same classification with the workspace after the adaptations
+		for (size_t i = 0; i < trials.size(); ++i)
+		{
+			size_t id, prunedId;
+			std::vector<double> distance, prunedDistance, probability;
+			EXPECT_TRUE(exhaustive.predict(trials[i], id, distance, probability)) << "Error during Predict " << title;
+			EXPECT_TRUE(pruned.classify(trials[i], workspace, prunedId, prunedDistance, probability)) << "Error during Classify " << title;
+			EXPECT_TRUE(id == prunedId) << ErrorMsg(title + " Class Workspace", id, prunedId);
+			EXPECT_TRUE(isAlmostEqual(distance[id], prunedDistance[id])) << ErrorMsg(title + " Distance Workspace", distance[id], prunedDistance[id]);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, MDM_Fast_Prediction)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	Geometry::CMatrixClassifierMDM calc = InitMatrixClassif::MDM::Reference();
+	calc.setFastPrediction(true, 1e3);							// Always refined
+	for (const auto& trial : trials)
+	{
+		size_t id, fastId;
+		std::vector<double> distance, fastDistance, probability, fastProbability;
+		EXPECT_TRUE(calc.predict(trial, id, distance, probability)) << "Error during Predict MDM Fast Prediction";
+		EXPECT_TRUE(calc.predictFast(trial, fastId, fastDistance, fastProbability)) << "Error during Predict Fast MDM Fast Prediction";
+		EXPECT_TRUE(id == fastId) << ErrorMsg("MDM Fast Prediction Class", id, fastId);
+		for (size_t k = 0; k < NB_CLASS; ++k)
+		{
+			EXPECT_TRUE(isAlmostEqual(distance[k], fastDistance[k])) << ErrorMsg("MDM Fast Prediction Distance", distance[k], fastDistance[k]);
+			EXPECT_TRUE(isAlmostEqual(probability[k], fastProbability[k])) << ErrorMsg("MDM Fast Prediction Probability", probability[k], fastProbability[k]);
+		}
+	}
+	Geometry::CMatrixClassifierMDM::SFastCounters counters = calc.getFastCounters();
+	EXPECT_TRUE(counters.nbTrials == trials.size() && counters.nbRefined == trials.size() && counters.nbOverBudget == 0) << "MDM Fast Prediction : bad counters";
+
+	// Proxy only
+	calc.resetFastCounters();
+	calc.setFastPrediction(true, 0);
+	size_t id;
+	std::vector<double> distance, probability;
+	for (const auto& trial : trials) { EXPECT_TRUE(calc.predictFast(trial, id, distance, probability)) << "Error during Predict Fast MDM Fast Prediction"; }
+	counters = calc.getFastCounters();
+	EXPECT_TRUE(counters.nbTrials == trials.size() && counters.nbRefined == 0) << "MDM Fast Prediction : bad counters without refinement";
+
+	// Budget exceeded before the refinement
+	calc.resetFastCounters();
+	calc.setFastPrediction(true, 1e3);
+	for (const auto& trial : trials) { EXPECT_TRUE(calc.predictFast(trial, id, distance, probability, 1e-12)) << "Error during Predict Fast MDM Fast Prediction"; }
+	counters = calc.getFastCounters();
+	EXPECT_TRUE(counters.nbOverBudget == trials.size()) << "MDM Fast Prediction : bad counters with budget";
+
+	// Adaptation of the projected means
+	Geometry::CMatrixClassifierMDM adapted = calc;
+	for (const auto& trial : trials) { EXPECT_TRUE(adapted.classify(trial, id, distance, probability, Geometry::EAdaptations::Unsupervised)) << "Error during Classify MDM Fast Prediction"; }
+	Geometry::CMatrixClassifierMDM reference = adapted;
+	reference.setFastPrediction(true, 1e3);						// Projection computed again with the adapted means
+	for (const auto& trial : trials)
+	{
+		size_t fastId, referenceId;
+		std::vector<double> fastDistance;
+		EXPECT_TRUE(adapted.predictFast(trial, fastId, fastDistance, probability)) << "Error during Predict Fast MDM Fast Prediction";
+		EXPECT_TRUE(reference.predict(trial, referenceId, distance, probability)) << "Error during Predict MDM Fast Prediction";
+		EXPECT_TRUE(fastId == referenceId) << ErrorMsg("MDM Fast Prediction Adapted Class", referenceId, fastId);
+	}
+
+	// Partial refinement with many classes : the probabilities agree with the predicted class
+	const size_t nbClass = trials.size() / 2;
+	std::vector<std::vector<Eigen::MatrixXd>> dataset(nbClass);
+	for (size_t i = 0; i < 2 * nbClass; ++i) { dataset[i % nbClass].push_back(trials[i]); }
+	Geometry::CMatrixClassifierMDM many(nbClass, Geometry::EMetric::Riemann);
+	EXPECT_TRUE(many.train(dataset)) << "Error during Training MDM Fast Prediction";
+	many.setFastPrediction(true, 0.5);
+	for (const auto& trial : trials)
+	{
+		EXPECT_TRUE(many.predictFast(trial, id, distance, probability)) << "Error during Predict Fast MDM Fast Prediction";
+		double sum = 0;
+		for (size_t k = 0; k < nbClass; ++k)
+		{
+			EXPECT_TRUE(probability[k] <= probability[id]) << "MDM Fast Prediction : probability [" << k << "] greater than the predicted class";
+			EXPECT_TRUE(distance[k] >= distance[id]) << "MDM Fast Prediction : distance [" << k << "] lower than the predicted class";
+			EXPECT_TRUE(!std::isinf(distance[k]) || probability[k] == 0) << "MDM Fast Prediction : probability of a class without distance";
+			sum += probability[k];
+		}
+		EXPECT_TRUE(isAlmostEqual(sum, 1.0)) << ErrorMsg("MDM Fast Prediction Sum of probabilities", 1.0, sum);
+	}
+	EXPECT_TRUE(many.getFastCounters().nbRefined > 0) << "MDM Fast Prediction : no refinement with many classes";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, TSKernel_Train_Classify)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	for (const auto& kernel : { Geometry::ETangentKernel::Linear, Geometry::ETangentKernel::Gaussian })
+	{
+		Geometry::CMatrixClassifierTSKernel calc(NB_CLASS, kernel);
+		EXPECT_TRUE(calc.train(m_dataSet)) << "Error during Training " << Geometry::toString(kernel);
+		EXPECT_TRUE(calc.getSupport().rows() == Eigen::Index(trials.size()) && calc.getSupport().cols() == NB_FEATURES) << "Bad Support size " << Geometry::toString(kernel);
+		EXPECT_TRUE(calc.getDual().rows() == Eigen::Index(trials.size()) && calc.getDual().cols() == NB_CLASS) << "Bad Dual size " << Geometry::toString(kernel);
+
+		// Batch classification gives the same result as the single classification
+		std::vector<size_t> ids;
+		Eigen::MatrixXd distances, probabilities;
+		EXPECT_TRUE(calc.classify(trials, ids, distances, probabilities, Geometry::EAdaptations::None, {}, 2)) << "Error during Batch Classify " << Geometry::toString(kernel);
+
+		size_t nbGood = 0, idx = 0;
+		for (size_t k = 0; k < m_dataSet.size(); ++k)
+		{
+			for (const auto& trial : m_dataSet[k])
+			{
+				size_t classid = 0;
+				std::vector<double> distance, probability;
+				EXPECT_TRUE(calc.classify(trial, classid, distance, probability)) << "Error during Classify " << Geometry::toString(kernel);
+				EXPECT_TRUE(classid == ids[idx]) << ErrorMsg("Batch Class", classid, ids[idx]);
+				const Eigen::RowVectorXd p = Eigen::Map<const Eigen::RowVectorXd>(probability.data(), Eigen::Index(probability.size()));
+				EXPECT_TRUE(isAlmostEqual(p, probabilities.row(idx))) << ErrorMsg("Batch Probability", p, probabilities.row(idx));
+				if (classid == k) { nbGood++; }
+				idx++;
+			}
+		}
+		EXPECT_TRUE(nbGood * 4 >= idx * 3) << "Bad accuracy with " << Geometry::toString(kernel) << " : " << nbGood << "/" << idx;
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, TSKernel_Save)
+{
+	Geometry::CMatrixClassifierTSKernel ref(NB_CLASS, Geometry::ETangentKernel::Gaussian), calc;
+	EXPECT_TRUE(ref.train(m_dataSet)) << "Error during Training";
+	EXPECT_TRUE(ref.saveXML("test_TSKernel_Save.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	EXPECT_TRUE(calc.loadXML("test_TSKernel_Save.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(ref == calc) << ErrorMsg("TS Kernel Save", ref, calc);
+
+	size_t id1 = 0, id2 = 0;
+	std::vector<double> dist1, dist2, prob1, prob2;
+	EXPECT_TRUE(ref.classify(m_dataSet[0][0], id1, dist1, prob1));
+	EXPECT_TRUE(calc.classify(m_dataSet[0][0], id2, dist2, prob2));
+	EXPECT_TRUE(id1 == id2 && isAlmostEqual(prob1, prob2)) << ErrorMsg("TS Kernel Classify after Load", prob1, prob2);
+}
+//---------------------------------------------------------------------------------------------------
+
+#if defined(ALLOCATION_COUNTER)
+//---------------------------------------------------------------------------------------------------
+template <typename T>
+static void TestWorkspace(T& calc, const std::vector<Eigen::MatrixXd>& trials, const Geometry::EAdaptations adaptation, const std::string& title)
+{
+	T ref(calc);
+	Geometry::CClassifierWorkspace workspace(calc, size_t(trials[0].rows()));
+	size_t classId, refClassId;
+	std::vector<double> distance(calc.getClassCount()), probability(calc.getClassCount()), refDistance, refProbability;
+
+	// The first classification can resize the buffers
+	EXPECT_TRUE(calc.classify(trials[0], workspace, classId, distance, probability, adaptation)) << "Error during Classify " << title;
+	EXPECT_TRUE(ref.classify(trials[0], refClassId, refDistance, refProbability, adaptation)) << "Error during Classify " << title;
+
+	for (size_t i = 1; i < trials.size(); ++i)
+	{
+		Allocations::Start();
+		const bool valid           = calc.classify(trials[i], workspace, classId, distance, probability, adaptation);
+		const size_t nbAllocations = Allocations::Stop();
+		EXPECT_TRUE(valid) << "Error during Classify " << title;
+		EXPECT_TRUE(nbAllocations == 0) << title << " : " << nbAllocations << " allocations for the sample [" << i << "]";
+
+		EXPECT_TRUE(ref.classify(trials[i], refClassId, refDistance, refProbability, adaptation)) << "Error during Classify " << title;
+		EXPECT_TRUE(classId == refClassId) << ErrorMsg(title + " Class sample [" + std::to_string(i) + "]", refClassId, classId);
+		for (size_t k = 0; k < refDistance.size(); ++k)
+		{
+			EXPECT_TRUE(isAlmostEqual(refDistance[k], distance[k])) << ErrorMsg(title + " Distance sample [" + std::to_string(i) + "]", refDistance[k], distance[k]);
+		}
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Workspace_No_Allocation)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Euclidian, Geometry::EMetric::Wasserstein })
+	{
+		Geometry::CMatrixClassifierMDM calc(NB_CLASS, metric);
+		EXPECT_TRUE(calc.train(m_dataSet)) << "Error during Training MDM " << toString(metric);
+		TestWorkspace(calc, trials, Geometry::EAdaptations::Unsupervised, "Workspace MDM " + toString(metric));
+	}
+
+	Geometry::CMatrixClassifierFgMDMRT fgmdmRT = InitMatrixClassif::FgMDMRT::Reference();
+	TestWorkspace(fgmdmRT, trials, Geometry::EAdaptations::Unsupervised, "Workspace FgMDM RT");
+	Geometry::CMatrixClassifierMDMRebias rebias = InitMatrixClassif::MDMRebias::Reference();
+	TestWorkspace(rebias, trials, Geometry::EAdaptations::Unsupervised, "Workspace MDM Rebias");
+	Geometry::CMatrixClassifierFgMDMRTRebias fgmdmRTRebias = InitMatrixClassif::FgMDMRTRebias::Reference();
+	TestWorkspace(fgmdmRTRebias, trials, Geometry::EAdaptations::Unsupervised, "Workspace FgMDM RT Rebias");
+
+	Geometry::CMatrixClassifierFgMDM fgmdm(NB_CLASS, Geometry::EMetric::Riemann);
+	EXPECT_TRUE(fgmdm.train(m_dataSet)) << "Error during Training FgMDM";
+	TestWorkspace(fgmdm, trials, Geometry::EAdaptations::None, "Workspace FgMDM");
+
+	Geometry::CMatrixClassifierTSLR tslr(NB_CLASS);
+	EXPECT_TRUE(tslr.train(m_dataSet)) << "Error during Training TSLR";
+	TestWorkspace(tslr, trials, Geometry::EAdaptations::None, "Workspace TSLR");
+}
+//---------------------------------------------------------------------------------------------------
+#endif
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, Move_Copy_On_Write)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+
+	// A copy shares the heavy members until one side is modified
+	Geometry::CMatrixClassifierFgMDM calc(NB_CLASS, Geometry::EMetric::Riemann);
+	EXPECT_TRUE(calc.train(m_dataSet)) << "Error during Training FgMDM";
+	Geometry::CMatrixClassifierFgMDM copy(calc);
+	EXPECT_TRUE(copy == calc) << ErrorMsg("FgMDM Copy", calc, copy);
+	EXPECT_TRUE(copy.getRef().data() == calc.getRef().data()) << "Reference not shared by the copy";
+	EXPECT_TRUE(copy.getWeightU().data() == calc.getWeightU().data()) << "Weight not shared by the copy";
+	EXPECT_TRUE(&copy.getDatasets() == &calc.getDatasets()) << "Datasets not shared by the copy";
+	EXPECT_TRUE(&copy.getStatistics() == &calc.getStatistics()) << "Statistics not shared by the copy";
+
+	const Eigen::MatrixXd ref = calc.getRef(), weight = calc.getWeight();
+	const size_t count        = calc.getStatistics()[0].getCount();
+	size_t classId;
+	std::vector<double> distance, probability;
+	calc.setAnchorPeriod(1);
+	EXPECT_TRUE(calc.classify(trials[0], classId, distance, probability, Geometry::EAdaptations::Supervised, 0)) << "Error during Classify";
+	EXPECT_TRUE(copy.getRef().data() != calc.getRef().data()) << "Reference shared after the adaptation";
+	EXPECT_TRUE(copy.getDatasets()[0].size() + 1 == calc.getDatasets()[0].size()) << "Datasets shared after the adaptation";
+	EXPECT_TRUE(&copy.getStatistics() != &calc.getStatistics() && copy.getStatistics()[0].getCount() == count) << "Statistics shared after the adaptation";
+	EXPECT_TRUE(isAlmostEqual(ref, copy.getRef())) << ErrorMsg("Reference of the copy", ref, copy.getRef());
+	EXPECT_TRUE(isAlmostEqual(weight, copy.getWeight())) << ErrorMsg("Weight of the copy", weight, copy.getWeight());
+
+	// A moved classifier classifies as the original
+	Geometry::CMatrixClassifierFgMDM original(copy);
+	const Eigen::MatrixXd* data = &copy.getMeans()[0];
+	Geometry::CMatrixClassifierFgMDM moved(std::move(copy));
+	EXPECT_TRUE(&moved.getMeans()[0] == data) << "Means copied by the move";
+	EXPECT_TRUE(moved == original) << ErrorMsg("FgMDM Move", original, moved);
+	Geometry::CMatrixClassifierTSLR tslr(NB_CLASS), tslrMoved;
+	EXPECT_TRUE(tslr.train(m_dataSet)) << "Error during Training TSLR";
+	Geometry::CMatrixClassifierTSLR tslrOriginal(tslr);
+	tslrMoved = std::move(tslr);
+	for (const auto& trial : trials)
+	{
+		size_t id, refId;
+		std::vector<double> dist, prob, refDist, refProb;
+		EXPECT_TRUE(moved.classify(trial, id, dist, prob) && original.classify(trial, refId, refDist, refProb)) << "Error during Classify FgMDM";
+		EXPECT_TRUE(id == refId && isAlmostEqual(refDist, dist)) << ErrorMsg("FgMDM Move Classify", refDist, dist);
+		EXPECT_TRUE(tslrMoved.classify(trial, id, dist, prob) && tslrOriginal.classify(trial, refId, refDist, refProb)) << "Error during Classify TSLR";
+		EXPECT_TRUE(id == refId && isAlmostEqual(refProb, prob)) << ErrorMsg("TSLR Move Classify", refProb, prob);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+template <Geometry::EMetric M>
+static void TestCompileTimeMetric(const std::vector<std::vector<Eigen::MatrixXd>>& dataset, const std::vector<Eigen::MatrixXd>& trials)
+{
+	const std::string title = "MDM Compile Time " + toString(M);
+	Geometry::CMatrixClassifierMDM calc(NB_CLASS, M);
+	Geometry::CMatrixClassifierMDMT<M> calcT(NB_CLASS);
+	EXPECT_TRUE(calc.train(dataset) && calcT.train(dataset)) << "Error during Training " << title;
+	EXPECT_TRUE(calcT == calc) << ErrorMsg(title, calc, calcT);
+	EXPECT_TRUE(Geometry::Distance<M>(trials[0], trials[1]) == Geometry::Distance(trials[0], trials[1], M)) << "Distance " << title;
+
+	Geometry::CClassifierWorkspace workspace, workspaceT;
+	for (const auto& trial : trials)
+	{
+		size_t id, idT;
+		std::vector<double> dist, prob, distT, probT;
+		EXPECT_TRUE(calc.classify(trial, workspace, id, dist, prob, Geometry::EAdaptations::Unsupervised)) << "Error during Classify " << title;
+		EXPECT_TRUE(calcT.classify(trial, workspaceT, idT, distT, probT, Geometry::EAdaptations::Unsupervised)) << "Error during Classify " << title;
+		EXPECT_TRUE(id == idT && isAlmostEqual(dist, distT)) << ErrorMsg(title, dist, distT);
+	}
+	EXPECT_TRUE(calcT == calc) << ErrorMsg(title + " Adapted", calc, calcT);
+}
+
+TEST_F(Tests_MatrixClassifier, MDM_Compile_Time_Metric)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	TestCompileTimeMetric<Geometry::EMetric::Riemann>(m_dataSet, trials);
+	TestCompileTimeMetric<Geometry::EMetric::LogEuclidian>(m_dataSet, trials);
+	TestCompileTimeMetric<Geometry::EMetric::Euclidian>(m_dataSet, trials);
+	TestCompileTimeMetric<Geometry::EMetric::Wasserstein>(m_dataSet, trials);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Check the neighbours of the tree with the exhaustive search. </summary>
+static void TestNeighbors(const Geometry::CMatrixClassifierKNN& calc, const std::vector<Eigen::MatrixXd>& samples, const size_t k, const std::string& title)
+{
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		std::vector<double> ref;
+		for (const auto& trial : calc.getTrials())
+		{
+			const double d = Geometry::Distance(samples[i], trial, calc.getMetric());
+			ref.push_back(std::isnan(d) ? 0.0 : d);		// Rounding error of the distance of a trial with itself
+		}
+		std::sort(ref.begin(), ref.end());
+		ref.resize(std::min(k, ref.size()));
+
+		std::vector<size_t> indexes;
+		std::vector<double> distances;
+		EXPECT_TRUE(calc.findNeighbors(samples[i], k, indexes, distances)) << "Error during Search " << title;
+		EXPECT_TRUE(indexes.size() == ref.size()) << title << " : " << indexes.size() << " neighbours instead of " << ref.size();
+		for (size_t j = 0; j < std::min(ref.size(), distances.size()); ++j)
+		{
+			EXPECT_TRUE(isAlmostEqual(ref[j], distances[j], 1e-6)) << ErrorMsg(title + " Sample [" + std::to_string(i) + "] Neighbour [" + std::to_string(j) + "]", ref[j], distances[j]);
+		}
+	}
+}
+
+TEST_F(Tests_MatrixClassifier, KNN_Neighbors)
+{
+	// Dataset with the scaled trials to have a deeper tree
+	std::vector<std::vector<Eigen::MatrixXd>> dataset = m_dataSet;
+	for (size_t k = 0; k < NB_CLASS; ++k) { for (const double scale : { 0.5, 2.0, 3.0 }) { for (const auto& m : m_dataSet[k]) { dataset[k].push_back(scale * m); } } }
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	std::vector<Eigen::MatrixXd> samples;
+	for (size_t i = 0; i + 1 < trials.size(); ++i) { samples.push_back(0.7 * trials[i] + 0.3 * trials[i + 1]); }
+
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::LogEuclidian, Geometry::EMetric::Euclidian, Geometry::EMetric::Wasserstein,
+								Geometry::EMetric::LogDet })
+	{
+		const std::string title = "kNN " + toString(metric);
+		Geometry::CMatrixClassifierKNN calc(NB_CLASS, metric, 3);
+		EXPECT_TRUE(calc.train(dataset)) << "Error during Training " << title;
+		TestNeighbors(calc, samples, 1, title);
+		TestNeighbors(calc, samples, 5, title);
+		TestNeighbors(calc, trials, 3, title + " Trials");
+
+		// The inserted trials are found as the trials of the training
+		for (const auto& sample : samples)
+		{
+			size_t classId;
+			std::vector<double> distance, probability;
+			EXPECT_TRUE(calc.classify(sample, classId, distance, probability, Geometry::EAdaptations::Unsupervised)) << "Error during Classify " << title;
+			EXPECT_TRUE(classId == size_t(std::max_element(probability.begin(), probability.end()) - probability.begin())) << title << " : class isn't the most probable";
+		}
+		EXPECT_TRUE(calc.getTrialCount() == 4 * trials.size() + samples.size()) << title << " : trials not inserted";
+		TestNeighbors(calc, samples, 5, title + " Inserted");
+		TestNeighbors(calc, trials, 5, title + " Inserted Trials");
+	}
+
+	Geometry::CMatrixClassifierKNN kullback(NB_CLASS, Geometry::EMetric::Kullback);
+	EXPECT_FALSE(kullback.train(dataset)) << "kNN trained without a true metric";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, KNN_Save)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	Geometry::CMatrixClassifierKNN ref(NB_CLASS, Geometry::EMetric::Riemann, 3), calc;
+	EXPECT_TRUE(ref.train(m_dataSet)) << "Error during Training";
+	size_t classId;
+	std::vector<double> distance, probability;
+	EXPECT_TRUE(ref.classify(0.5 * (trials[0] + trials[1]), classId, distance, probability, Geometry::EAdaptations::Supervised, 1)) << "Error during Classify";
+	EXPECT_TRUE(ref.saveXML("test_KNN_Save.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	EXPECT_TRUE(calc.loadXML("test_KNN_Save.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(ref == calc) << ErrorMsg("kNN Save", ref, calc);
+
+	for (const auto& trial : trials)
+	{
+		size_t id1 = 0, id2 = 0;
+		std::vector<double> dist1, dist2, prob1, prob2;
+		EXPECT_TRUE(ref.predict(trial, id1, dist1, prob1) && calc.predict(trial, id2, dist2, prob2)) << "Error during Predict";
+		EXPECT_TRUE(id1 == id2 && isAlmostEqual(prob1, prob2)) << ErrorMsg("kNN Classify after Load", prob1, prob2);
+	}
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_MatrixClassifier, KNN_Load_Invalid_Tree)
+{
+	const std::vector<Eigen::MatrixXd> trials = Geometry::Vector2DTo1D(m_dataSet);
+	Geometry::CMatrixClassifierKNN ref(NB_CLASS, Geometry::EMetric::Riemann, 3);
+	EXPECT_TRUE(ref.train(m_dataSet)) << "Error during Training";
+	EXPECT_TRUE(ref.saveXML("test_KNN_Invalid.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+
+	// Saved trees with indexes in range but not a tree : a cycle to the root and a subtree shared by all the nodes
+	const Eigen::Index n = Eigen::Index(trials.size());
+	for (const double child : { 0.0, 1.0 })
+	{
+		Eigen::MatrixXd tree = Eigen::MatrixXd::Zero(n, 8);
+		for (Eigen::Index i = 0; i < n; ++i) { tree.row(i) << double(i), 1.0, child, -1.0, 0.0, 1.0, 0.0, 0.0; }
+		tinyxml2::XMLDocument xmlDoc;
+		EXPECT_TRUE(xmlDoc.LoadFile("test_KNN_Invalid.xml") == tinyxml2::XML_SUCCESS);
+		tinyxml2::XMLElement* element = xmlDoc.RootElement()->FirstChildElement("Classifier-data")->FirstChildElement("Tree");
+		std::stringstream ss;
+		ss << std::setprecision(17) << tree.format(MATRIX_FORMAT);
+		element->SetText(ss.str().c_str());
+		EXPECT_TRUE(xmlDoc.SaveFile("test_KNN_Invalid.xml") == tinyxml2::XML_SUCCESS);
+
+		// The invalid tree is replaced by a new tree
+		Geometry::CMatrixClassifierKNN calc;
+		EXPECT_TRUE(calc.loadXML("test_KNN_Invalid.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+		EXPECT_TRUE(ref == calc) << ErrorMsg("kNN Load Invalid Tree", ref, calc);
+		TestNeighbors(calc, trials, 3, "kNN Load Invalid Tree");
+	}
+}
+//---------------------------------------------------------------------------------------------------
@@ -18,6 +18,9 @@
 
 #include <geometry/Misc.hpp>
 #include <geometry/Basics.hpp>
+#include <boost/math/special_functions/gamma.hpp>
+#include <cmath>
+#include <random>
 
 //---------------------------------------------------------------------------------------------------
 class Tests_Misc : public testing::Test
@@ -118,6 +121,168 @@ TEST_F(Tests_Misc, Fit_Distribution)
 }
 //---------------------------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------------------------
+/// <summary>	Fit distribution with a histogram and the probabilities computed for each width (previous implementation). </summary>
+static bool ReferenceFitDistribution(const std::vector<double>& values, double& mu, double& sigma, const std::vector<double>& betas = Geometry::doubleRange(1.7, 3.5, 0.15),
+									 const double minQuant = 0.022, const double maxQuant = 0.60, const double minClean = 0.250, const double maxDropout = 0.10,
+									 const double stepBound = 0.010, const double stepScale = 0.01)
+{
+	if (values.empty() || betas.empty() || minQuant < 0 || minQuant > 1 || maxQuant < 0 || maxQuant > 1 || minClean < 0 || maxDropout < 0
+		|| stepBound < 0.0001 || stepBound > 0.1 || stepScale < 0.0001 || stepScale > 0.1) { return false; }
+
+	//========== Scales ==========
+	const size_t nBeta = betas.size();
+	// Scales is a vector for each beta as :
+	// scale = beta/(2*gamma(1/beta)) with gamma the function as gamma(n) = (n-1)! for all integer greater than 0
+	std::vector<double> scales;
+	scales.reserve(nBeta);
+	std::transform(betas.begin(), betas.end(), std::back_inserter(scales), [](const double beta) -> double { return beta / (2 * tgamma(1 / beta)); });
+
+	//========== zBounds ==========
+	// zBounds is a vector of lower and upper bounds for each beta as : sign(quants-1/2) * gammaincinv(sign(quants-1/2) * (2*quants-1), 1/beta)^(1/beta);
+	// with gammaincinv the Inverse incomplete gamma function, here quants are the quantiles limit (by default [0.022 0.6])
+	std::vector<std::vector<double>> zBounds(nBeta);
+	const int signMin    = (0.5 < minQuant) - (minQuant < 0.5), signMax          = (0.5 < maxQuant) - (maxQuant < 0.5);
+	const double coefMin = signMin * (2 * minQuant - 1), coefMax = signMax * (2 * maxQuant - 1);
+
+	for (size_t i = 0; i < nBeta; ++i)
+	{
+		if (betas[i] == 0) { zBounds[i] = { 0, 0 }; }
+		else
+		{
+			const double beta = 1 / betas[i];
+			zBounds[i]        = {
+				signMin * pow(boost::math::gamma_p_inv(beta, coefMin), beta),
+				signMax * pow(boost::math::gamma_p_inv(beta, coefMax), beta)
+			};
+		}
+	}
+
+	//========== Sort Values ==========
+	// We sort values to access quantiles directly
+	const size_t n                = values.size();
+	std::vector<double> newValues = values;
+	std::sort(newValues.begin(), newValues.end());
+
+	//========== Compute Index range ==========
+	// Width are the limit if all data is clean or artifacted. It's usefull for the for loop limit and step for each width possible
+	// Bounds are the range of begining value used to compute mu and sigma. It's usefull for the for loop limit and step for first index of value to take
+	// We create Vector for widths and bounds to precompute all round and avoid duplicate indexes in widths or bounds
+	std::vector<size_t> widths = Geometry::RoundIndexRange(n * (maxQuant - minQuant) * minClean, n * (maxQuant - minQuant), n * stepScale, true, false);
+	std::reverse(widths.begin(), widths.end());
+	const std::vector<size_t> bounds = Geometry::RoundIndexRange(n * minQuant, n * (minQuant + maxDropout), n * stepBound, true, false);
+	const size_t maxWidth            = std::max(widths.front(), widths.back());	// to prevent if widths is in descending or ascending order
+	const size_t nBound              = bounds.size();
+
+	//========== Compute Grid (with index range) ==========
+	// Create the Biggest table of data with width in column and bound in row
+	std::vector<std::vector<double>> grid(nBound);
+	std::vector<double> firsts(nBound);
+	for (size_t i = 0; i < nBound; ++i)
+	{
+		grid[i].reserve(maxWidth);
+		const auto first = newValues.begin() + bounds[i];
+		std::copy_n(first, maxWidth, std::back_inserter(grid[i]));
+		firsts[i] = grid[i][0];
+		for (auto& e : grid[i]) { e -= firsts[i]; }	// Substract first value on all element
+	}
+
+	//==========  Width Loop ==========
+	double bestKl   = std::numeric_limits<double>::max();
+	size_t bestBeta = 0, bestId = 0, bestWidth = 0;
+	// for each interval width...
+	for (const auto& w : widths)
+	{
+		const size_t nbins = size_t(std::round(3 * log2(1 + (double(w) / 2))));
+
+		//==========  Compute Histogramm ==========
+		std::vector<std::vector<double>> hist(nBound);
+		for (size_t i = 0; i < nBound; ++i)
+		{
+			hist[i].reserve(nbins);
+			std::vector<size_t> tmp = Geometry::BinHist(std::vector<double>(grid[i].begin(), grid[i].begin() + w), nbins);
+			std::transform(tmp.begin(), tmp.end(), std::back_inserter(hist[i]), [](const size_t e) -> double { return log(e + 0.01); });
+		}
+
+		//==========  Beta Loop ==========
+		for (size_t b = 0; b < nBeta; ++b)
+		{
+			//==========  Compute Probability ==========
+			std::vector<double> prob(nbins);
+			double sumprob = 0.0;
+			for (size_t i = 0; i < nbins; ++i)
+			{
+				prob[i] = std::exp(-std::pow(std::abs(zBounds[b][0] + (((i + 0.5) / nbins) * (zBounds[b][1] - zBounds[b][0]))), betas[b])) * scales[b];
+				sumprob += prob[i];
+			}
+			if (sumprob != 0) { for (auto& p : prob) { p /= sumprob; } }
+
+			//========== Compute the Kullback-Leibler divergences ==========
+			//kl = sum(prob * (log(prob) - hist)) + log(w));
+			std::vector<double> kl(nBound, log(w));
+			for (size_t i = 0; i < nBound; ++i) { for (size_t j = 0; j < nbins; ++j) { kl[i] += prob[j] * (log(prob[j]) - hist[i][j]); } }
+
+			// Update Parameters
+			auto minIt = std::min_element(kl.begin(), kl.end());
+			if (*minIt < bestKl)
+			{
+				bestKl    = *minIt;
+				bestBeta  = b;
+				bestId    = minIt - kl.begin();
+				bestWidth = w - 1;
+			}
+		}
+	}
+
+	double alpha = grid[bestId][bestWidth] / (zBounds[bestBeta][1] - zBounds[bestBeta][0]);
+	double beta  = betas[bestBeta];
+
+	mu    = firsts[bestId] - zBounds[bestBeta][0] * alpha;
+	sigma = sqrt(alpha * alpha * std::tgamma(3 / beta) / std::tgamma(1 / beta));
+
+	return true;
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Misc, Fit_Distributions)
+{
+	// Random values of several sizes and shapes (gaussian, with artifacts, with duplicate values)
+	std::mt19937 gen(42);
+	std::normal_distribution<double> normal(1.0, 0.5);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	for (const size_t n : { size_t(40), size_t(200), size_t(1000), size_t(3000) })
+	{
+		std::vector<std::vector<double>> dataset(6, std::vector<double>(n));
+		for (size_t i = 0; i < n; ++i)
+		{
+			dataset[0][i] = std::abs(normal(gen));
+			dataset[1][i] = std::abs(normal(gen)) + (uniform(gen) < 0.1 ? 20 * uniform(gen) : 0);
+			dataset[2][i] = std::round(10 * std::abs(normal(gen))) / 10;
+			dataset[3][i] = std::exp(normal(gen));
+			dataset[4][i] = uniform(gen) < 0.5 ? 1 : 1 + uniform(gen);
+			dataset[5][i] = std::sqrt(std::abs(normal(gen) * normal(gen)));
+		}
+
+		std::vector<double> mu, sigma;
+		EXPECT_TRUE(Geometry::FitDistributions(dataset, mu, sigma, Geometry::doubleRange(1.7, 3.5, 0.15), 0.022, 0.60, 0.250, 0.10, 0.010, 0.01, 3));
+		for (size_t c = 0; c < dataset.size(); ++c)
+		{
+			double refMu, refSigma, calcMu, calcSigma;
+			EXPECT_TRUE(ReferenceFitDistribution(dataset[c], refMu, refSigma));
+			EXPECT_TRUE(Geometry::FitDistribution(dataset[c], calcMu, calcSigma));
+			const std::string title = "Fit Distribution of " + std::to_string(n) + " values (shape " + std::to_string(c) + ")";
+			EXPECT_NEAR(refMu, calcMu, 1e-9 * std::max(1.0, std::abs(refMu))) << title;
+			EXPECT_NEAR(refSigma, calcSigma, 1e-9 * std::max(1.0, std::abs(refSigma))) << title;
+			EXPECT_NEAR(calcMu, mu[c], 1e-12 * std::max(1.0, std::abs(calcMu))) << title << " in parallel";
+			EXPECT_NEAR(calcSigma, sigma[c], 1e-12 * std::max(1.0, std::abs(calcSigma))) << title << " in parallel";
+		}
+	}
+	std::vector<double> mu, sigma;
+	EXPECT_FALSE(Geometry::FitDistributions({ std::vector<double>(100, 1.0), std::vector<double>(50, 1.0) }, mu, sigma)) << "Fit Distributions with different sizes";
+}
+//---------------------------------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------------------------------
 TEST_F(Tests_Misc, Sorted_Eigen_Vector_Euclidian)
 {
@@ -0,0 +1,110 @@
+///-------------------------------------------------------------------------------------------------
+///
+/// \file test_Potato.hpp
+/// \brief Tests for Riemannian Potato Artifact Detection.
+/// \author Thibaut Monseigne (Inria).
+/// \version 1.0.
+/// \date 19/10/2026.
+/// \copyright <a href="https://choosealicense.com/licenses/agpl-3.0/">GNU Affero General Public License v3.0</a>.
+///
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "Init.hpp"
+#include "misc.hpp"
+
+#include <geometry/artifacts/CPotato.hpp>
+#include <geometry/Basics.hpp>
+#include <geometry/Covariance.hpp>
+#include <geometry/Distance.hpp>
+#include <geometry/Mean.hpp>
+
+//---------------------------------------------------------------------------------------------------
+class Tests_Potato : public testing::Test
+{
+protected:
+	std::vector<Eigen::MatrixXd> m_dataset;
+
+	void SetUp() override { m_dataset = Geometry::Vector2DTo1D(InitDataset::Dataset()); }
+};
+
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Potato, Train)
+{
+	const Geometry::CPotato calc(Geometry::EMetric::Riemann, m_dataset);
+	std::vector<Eigen::MatrixXd> covs(m_dataset.size());
+	for (size_t i = 0; i < m_dataset.size(); ++i)
+	{
+		EXPECT_TRUE(Geometry::CovarianceMatrix(m_dataset[i], covs[i], Geometry::EEstimator::LWF, Geometry::EStandardization::Center));
+	}
+	Eigen::MatrixXd ref;
+	EXPECT_TRUE(Geometry::Mean(covs, ref, Geometry::EMetric::Riemann));
+	EXPECT_TRUE(isAlmostEqual(ref, calc.getReference())) << ErrorMsg("Potato Reference", ref, calc.getReference());
+	EXPECT_EQ(calc.getChannelNumber(), size_t(ref.rows()));
+	EXPECT_GT(calc.getStd(), 0.0);
+	EXPECT_GT(calc.getMean(), 0.0);
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Potato, Process)
+{
+	for (const auto& metric : { Geometry::EMetric::Riemann, Geometry::EMetric::Euclidian, Geometry::EMetric::LogEuclidian })
+	{
+		Geometry::CPotato calc(metric, m_dataset);
+		calc.setForgetting(0.05);
+
+		// Artifact : a channel with a huge amplitude
+		Eigen::MatrixXd artifact = m_dataset[0];
+		artifact.row(0) *= 100;
+		const Eigen::MatrixXd reference = calc.getReference();
+		bool clean;
+		double zScore;
+		EXPECT_TRUE(calc.process(artifact, clean, zScore)) << "Potato Process fail with " << toString(metric);
+		EXPECT_FALSE(clean) << "The artifact wasn't rejected with " << toString(metric) << " (z-score " << zScore << ")";
+		EXPECT_GT(zScore, calc.getThreshold());
+		EXPECT_TRUE(isAlmostEqual(reference, calc.getReference())) << ErrorMsg("A rejected epoch changes the reference", reference, calc.getReference());
+
+		// Clean epochs are accepted and update the reference
+		size_t nbClean = 0;
+		for (const auto& epoch : m_dataset)
+		{
+			EXPECT_TRUE(calc.process(epoch, clean, zScore)) << "Potato Process fail with " << toString(metric);
+			if (clean) { nbClean++; }
+		}
+		EXPECT_GT(nbClean, m_dataset.size() / 2) << "Too many training epochs rejected with " << toString(metric);
+		EXPECT_FALSE(isAlmostEqual(reference, calc.getReference())) << "The reference wasn't updated with " << toString(metric);
+	}
+
+	Geometry::CPotato untrained;
+	bool clean;
+	double zScore;
+	EXPECT_FALSE(untrained.process(m_dataset[0], clean, zScore)) << "Process without train";
+}
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+TEST_F(Tests_Potato, Save)
+{
+	Geometry::CPotato ref(Geometry::EMetric::Riemann, m_dataset), calc;
+	ref.setForgetting(0.1);
+	bool clean;
+	double zScore;
+	EXPECT_TRUE(ref.process(m_dataset[1], clean, zScore));
+	EXPECT_TRUE(ref.saveXML("test_Potato_Save.xml")) << "Error during Saving : " << std::endl << ref << std::endl;
+	EXPECT_TRUE(calc.loadXML("test_Potato_Save.xml")) << "Error during Loading : " << std::endl << calc << std::endl;
+	EXPECT_TRUE(ref == calc) << ErrorMsg("Potato Save", ref, calc);
+
+	// The loaded potato gives the same decision
+	bool clean1, clean2;
+	double z1, z2;
+	EXPECT_TRUE(ref.process(m_dataset[2], clean1, z1));
+	EXPECT_TRUE(calc.process(m_dataset[2], clean2, z2));
+	EXPECT_EQ(clean1, clean2);
+	EXPECT_NEAR(z1, z2, 1e-6);
+}
+//---------------------------------------------------------------------------------------------------